@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <ventilation/alarm.hpp>
+
+namespace {
+    // One tick of a typical rule set over range(0) beds
+    void
+    evaluate(benchmark::State& state) {
+        const std::size_t beds = state.range(0);
+        const ventilation::alarm::Rule rules[] = {
+              ventilation::alarm::Rule::above(ventilation::Pressure(35.0f), 3)
+            , ventilation::alarm::Rule::below(ventilation::Volume(0.2f), 5, true)
+            , ventilation::alarm::Rule::within(ventilation::Flow(-0.05f), ventilation::Flow(0.05f), 1000)
+        };
+        ventilation::alarm::Engine engine(rules, beds);
+
+        std::vector<ventilation::Pressure> pressure;
+        std::vector<ventilation::Flow> flow;
+        std::vector<ventilation::Volume> volume;
+        for (std::size_t i = 0; i < beds; i++) {
+            pressure.push_back(ventilation::Pressure(static_cast<float>(i % 40)));
+            flow.push_back(ventilation::Flow(static_cast<float>(i % 7) * 0.1f - 0.3f));
+            volume.push_back(ventilation::Volume(static_cast<float>(i % 10) * 0.1f));
+        }
+
+        std::vector<ventilation::alarm::Event> events;
+        for (auto _ : state) {
+            events.clear();
+            engine.evaluate(pressure, flow, volume, events);
+            benchmark::DoNotOptimize(events.data());
+        }
+        state.SetItemsProcessed(state.iterations() * beds * std::size(rules));
+    }
+} // namespace
+
+BENCHMARK(evaluate)->RangeMultiplier(4)->Range(64, 16384);
+
+BENCHMARK_MAIN();
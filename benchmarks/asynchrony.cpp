@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+#include <ventilation/asynchrony.hpp>
+
+namespace {
+    // One second at 1 kHz for range(0) beds, each with its own detector, on
+    // breaths of four seconds with an effort in every other one
+    void
+    stream(benchmark::State& state) {
+        const std::size_t beds = state.range(0);
+        std::vector<ventilation::Pressure> pressure;
+        std::vector<ventilation::Flow> flow;
+        for (int i = 0; i < 4000; i++) {
+            const float t = static_cast<float>(i % 4000) * 0.001f;
+            if (t < 1.0f) {
+                pressure.push_back(ventilation::Pressure(5.0f + 15.0f * t));
+                flow.push_back(ventilation::Flow(0.5f));
+            } else {
+                const float bump = (i / 4000) % 2 == 0 and t > 1.6f and t < 1.9f ? std::sin((t - 1.6f) * 10.47f) : 0.0f;
+                pressure.push_back(ventilation::Pressure(5.0f + 15.0f * std::exp(-(t - 1.0f) / 0.05f) - 1.5f * bump));
+                flow.push_back(ventilation::Flow(-std::exp(-(t - 1.0f) / 0.5f) - 0.01f + 0.25f * bump));
+            }
+        }
+
+        std::vector<ventilation::asynchrony::Detector> detectors(beds, ventilation::asynchrony::Detector(0.001f));
+        std::vector<ventilation::asynchrony::Breath> breaths;
+        std::size_t offset = 0;
+        for (auto _ : state) {
+            breaths.clear();
+            for (ventilation::asynchrony::Detector& detector : detectors) {
+                detector.push(
+                          std::span<const ventilation::Pressure>(pressure).subspan(offset, 1000)
+                        , std::span<const ventilation::Flow>(flow).subspan(offset, 1000)
+                        , breaths
+                        );
+            }
+            offset = (offset + 1000) % pressure.size();
+            benchmark::DoNotOptimize(breaths.data());
+        }
+        state.SetItemsProcessed(state.iterations() * beds * 1000);
+    }
+} // namespace
+
+BENCHMARK(stream)->RangeMultiplier(4)->Range(16, 1024);
+
+BENCHMARK_MAIN();
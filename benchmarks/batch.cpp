@@ -0,0 +1,183 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include <ventilation/batch.hpp>
+#include <ventilation/kernels.hpp>
+
+namespace {
+    std::vector<float>
+    samples(std::size_t size) {
+        std::vector<float> values(size);
+        for (std::size_t i = 0; i < size; i++) {
+            values[i] = static_cast<float>(static_cast<int>(i % 2000) - 1000) * 1e-3f;
+        }
+        return values;
+    }
+
+    std::vector<std::int64_t>
+    raw(std::size_t size) {
+        std::vector<std::int64_t> values(size);
+        for (std::size_t i = 0; i < size; i++) {
+            values[i] = (static_cast<std::int64_t>(i % 2000) - 1000) * 1000;
+        }
+        return values;
+    }
+
+    // Kernels are measured per variant so the dispatch choice can be checked
+    // against the alternatives on the machine running the suite.
+    void
+    finite(benchmark::State& state, const ventilation::kernels::Table& table) {
+        const std::vector<float> input = samples(state.range(0));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(table.finite(input.data(), input.size()));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void
+    forward(benchmark::State& state, const ventilation::kernels::Table& table) {
+        const std::vector<float> input = samples(state.range(0));
+        std::vector<std::int64_t> output(input.size());
+        for (auto _ : state) {
+            table.forward(input.data(), output.data(), input.size());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void
+    inverse(benchmark::State& state, const ventilation::kernels::Table& table) {
+        const std::vector<std::int64_t> input = raw(state.range(0));
+        std::vector<float> output(input.size());
+        for (auto _ : state) {
+            table.inverse(input.data(), output.data(), input.size());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void
+    scale(benchmark::State& state, const ventilation::kernels::Table& table) {
+        const std::vector<std::int64_t> input = raw(state.range(0));
+        std::vector<std::int64_t> output(input.size());
+        for (auto _ : state) {
+            table.scale(input.data(), 500000, output.data(), input.size());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void
+    compare(benchmark::State& state, const ventilation::kernels::Table& table) {
+        const std::vector<std::int64_t> lhs = raw(state.range(0));
+        const std::vector<std::int64_t> rhs(lhs.rbegin(), lhs.rend());
+        std::vector<std::int8_t> output(lhs.size());
+        for (auto _ : state) {
+            table.compare(lhs.data(), rhs.data(), output.data(), lhs.size());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void
+    sum(benchmark::State& state, const ventilation::kernels::Table& table) {
+        const std::vector<std::int64_t> input = raw(state.range(0));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(table.sum(input.data(), input.size()));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void
+    motion(benchmark::State& state, const ventilation::kernels::Table& table) {
+        const std::vector<std::int64_t> flow    = raw(state.range(0));
+        const std::vector<std::int64_t> volume  = raw(state.range(0));
+        std::vector<std::int64_t> output(flow.size());
+        for (auto _ : state) {
+            table.motion(flow.data(), volume.data(), 10000000, 20000000, 5000000, output.data(), flow.size());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void
+    saturating_add(benchmark::State& state, const ventilation::kernels::Table& table) {
+        const std::vector<std::int64_t> lhs = raw(state.range(0));
+        const std::vector<std::int64_t> rhs(lhs.rbegin(), lhs.rend());
+        std::vector<std::int64_t> output(lhs.size());
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(table.saturating_add(lhs.data(), rhs.data(), output.data(), lhs.size()));
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void
+    saturating_scale(benchmark::State& state, const ventilation::kernels::Table& table) {
+        const std::vector<std::int64_t> input = raw(state.range(0));
+        std::vector<std::int64_t> output(input.size());
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(table.saturating_scale(input.data(), 500000, output.data(), input.size()));
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // Typed entry points, including the size and finiteness checks
+    void
+    construct(benchmark::State& state) {
+        const std::vector<float> input = samples(state.range(0));
+        std::vector<ventilation::Flow> output(input.size());
+        for (auto _ : state) {
+            ventilation::batch::construct<ventilation::Flow>(input, output);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void
+    convert(benchmark::State& state) {
+        const std::vector<float> values = samples(state.range(0));
+        std::vector<ventilation::Flow> input(values.size());
+        std::vector<float> output(values.size());
+        ventilation::batch::construct<ventilation::Flow>(values, input);
+        for (auto _ : state) {
+            ventilation::batch::convert<ventilation::Flow>(input, output);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+} // namespace
+
+BENCHMARK(construct)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(convert)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+int
+main(int argc, char** argv) {
+    using Kernel = void (*)(benchmark::State&, const ventilation::kernels::Table&);
+    const std::pair<const char*, Kernel> kernels[] = {
+          {"finite",  finite}
+        , {"forward", forward}
+        , {"inverse", inverse}
+        , {"scale",   scale}
+        , {"compare", compare}
+        , {"sum",     sum}
+        , {"motion",  motion}
+        , {"saturating_add",   saturating_add}
+        , {"saturating_scale", saturating_scale}
+    };
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        for (const auto& [name, kernel] : kernels) {
+            std::string label = std::string(name) + "/" + table.name;
+            benchmark::RegisterBenchmark(label.c_str(), kernel, table)
+                ->RangeMultiplier(16)
+                ->Range(16, 1 << 20);
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <ventilation/calibration.hpp>
+
+namespace {
+    // Square-root flow sensor over a 16-bit converter, 33 points
+    std::vector<ventilation::calibration::Point>
+    sensor() {
+        std::vector<ventilation::calibration::Point> points;
+        for (std::int32_t count = 0; count <= 65536; count += 2048) {
+            points.push_back({count, 0.5f * std::sqrt(static_cast<float>(count))});
+        }
+        return points;
+    }
+
+    std::vector<std::int32_t>
+    counts(std::size_t size) {
+        std::vector<std::int32_t> counts(size);
+        std::uint32_t state = 1;
+        for (std::int32_t& count : counts) {
+            state = state * 1664525u + 1013904223u;
+            count = static_cast<std::int32_t>(state >> 16);
+        }
+        return counts;
+    }
+
+    // Per-sample binary search in float, then the checked constructor
+    void
+    search(benchmark::State& state) {
+        const std::vector<ventilation::calibration::Point> points = sensor();
+        const std::vector<std::int32_t> input = counts(state.range(0));
+        std::vector<ventilation::Flow> output(input.size());
+
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < input.size(); i++) {
+                auto upper = std::upper_bound(
+                          points.begin()
+                        , points.end()
+                        , input[i]
+                        , [](std::int32_t c, const ventilation::calibration::Point& p) { return c < p.count; }
+                        );
+                float value;
+                if (upper == points.begin())    { value = points.front().value; }
+                else if (upper == points.end()) { value = points.back().value; }
+                else {
+                    auto lower = upper - 1;
+                    float fraction = static_cast<float>(input[i] - lower->count) / static_cast<float>(upper->count - lower->count);
+                    value = lower->value + (upper->value - lower->value) * fraction;
+                }
+                output[i] = ventilation::Flow(value);
+            }
+            benchmark::DoNotOptimize(output.data());
+        }
+        state.SetItemsProcessed(state.iterations() * input.size());
+    }
+
+    void
+    table(benchmark::State& state) {
+        const ventilation::calibration::Table<ventilation::Flow> table(sensor(), 1024);
+        const std::vector<std::int32_t> input = counts(state.range(0));
+        std::vector<ventilation::Flow> output(input.size());
+
+        for (auto _ : state) {
+            table.convert(std::span<const std::int32_t>(input), std::span<ventilation::Flow>(output));
+            benchmark::DoNotOptimize(output.data());
+        }
+        state.SetItemsProcessed(state.iterations() * input.size());
+    }
+} // namespace
+
+BENCHMARK(search)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK(table)->RangeMultiplier(8)->Range(64, 32768);
+
+BENCHMARK_MAIN();
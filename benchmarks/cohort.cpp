@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <ventilation/cohort.hpp>
+
+namespace {
+    // Four million breaths of 5000 patients over 30 days, grouped by
+    // compliance decile and day; range(0) selects whether medians are asked
+    void
+    deciles(benchmark::State& state) {
+        constexpr std::size_t ROWS = 4000000;
+        std::vector<std::int64_t> day(ROWS);
+        std::vector<ventilation::Compliance> compliance(ROWS);
+        std::vector<ventilation::Pressure> driving(ROWS);
+        std::uint64_t random = 0x2545f4914f6cdd1dull;
+        for (std::size_t i = 0; i < ROWS; i++) {
+            random ^= random << 13;
+            random ^= random >> 7;
+            random ^= random << 17;
+            day[i]          = static_cast<std::int64_t>(random % 30);
+            compliance[i]   = ventilation::Compliance(0.01f + static_cast<float>((random >> 8) % 800) * 0.0001f);
+            driving[i]      = ventilation::Pressure(5.0f + static_cast<float>((random >> 24) % 2000) * 0.01f);
+        }
+        const std::vector<ventilation::Compliance> edges = ventilation::cohort::quantiles<ventilation::Compliance>(compliance, 10);
+        std::vector<std::int64_t> decile(ROWS);
+        ventilation::cohort::quantize<ventilation::Compliance>(compliance, edges, decile);
+
+        const std::span<const std::int64_t> keys[] = {decile, day};
+        const std::span<const std::int64_t> columns[] = {
+            ventilation::fixed::Access::raw(std::span<const ventilation::Pressure>(driving))
+        };
+        const ventilation::cohort::Aggregation simple[] = {
+              {0, ventilation::cohort::Function::mean}
+            , {0, ventilation::cohort::Function::maximum}
+        };
+        const ventilation::cohort::Aggregation median[] = {{0, ventilation::cohort::Function::median}};
+
+        for (auto _ : state) {
+            ventilation::cohort::Result result = ventilation::cohort::group(
+                    keys
+                    , columns
+                    , state.range(0) == 0 ? std::span<const ventilation::cohort::Aggregation>(simple) : median
+                    );
+            benchmark::DoNotOptimize(result.groups());
+        }
+        state.SetItemsProcessed(state.iterations() * ROWS);
+    }
+} // namespace
+
+BENCHMARK(deciles)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include <ventilation/comparison.hpp>
+
+namespace {
+    // An hour of pressure, flow and volume at 1 kHz against a golden file of
+    // the same recording, flow drifted by less than a step; range(0) is the
+    // tolerance, so at 0 the drifted chunks are compared sample by sample
+    void
+    golden(benchmark::State& state) {
+        constexpr std::size_t SAMPLES = 3600000;
+        std::vector<ventilation::Pressure> pressure(SAMPLES);
+        std::vector<ventilation::Flow> flow(SAMPLES);
+        std::vector<ventilation::Volume> volume(SAMPLES);
+        for (std::size_t i = 0; i < SAMPLES; i++) {
+            const float phase = static_cast<float>(i % 4000) * 0.00025f;
+            pressure[i] = ventilation::Pressure(5.0f + 20.0f * phase);
+            flow[i]     = ventilation::Flow(0.5f - phase);
+            volume[i]   = ventilation::Volume(0.5f * phase);
+        }
+        const ventilation::comparison::Channel recorded[] = {
+              ventilation::comparison::Channel::of<ventilation::Pressure>(pressure)
+            , ventilation::comparison::Channel::of<ventilation::Flow>(flow)
+            , ventilation::comparison::Channel::of<ventilation::Volume>(volume)
+        };
+        const std::filesystem::path path = std::filesystem::temp_directory_path()
+            / ("benchmark-" + std::to_string(::getpid()) + ".golden");
+        ventilation::comparison::Golden::write(path, recorded);
+        const ventilation::comparison::Golden file(path);
+        std::filesystem::remove(path);
+
+        for (ventilation::Flow& sample : flow) {
+            sample = sample + ventilation::Flow(0.0004f);
+        }
+        for (auto _ : state) {
+            std::vector<ventilation::comparison::Report> reports = ventilation::comparison::compare(
+                      recorded
+                    , file.channels()
+                    , static_cast<std::uint64_t>(state.range(0))
+                    );
+            benchmark::DoNotOptimize(reports.data());
+        }
+        state.SetItemsProcessed(state.iterations() * 3 * SAMPLES);
+        state.SetBytesProcessed(state.iterations() * 6 * SAMPLES * sizeof(std::int64_t));
+    }
+} // namespace
+
+BENCHMARK(golden)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
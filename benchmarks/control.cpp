@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <ventilation/control.hpp>
+
+namespace {
+    const ventilation::model::Settings SETTINGS;
+
+    ventilation::control::Plant
+    patient() {
+        return {ventilation::Resistance(10.0f), ventilation::Compliance(0.05f)};
+    }
+
+    // Ten breaths at 1 kHz in fast mode, per controller
+    template <typename C>
+    void
+    breaths(benchmark::State& state, C prototype) {
+        ventilation::control::Options options;
+        options.steps = 10 * 3200;
+        ventilation::control::Timing timing;
+        for (auto _ : state) {
+            ventilation::control::Lung lung(patient());
+            C controller = prototype;
+            ventilation::control::Delivery delivery = ventilation::control::run(controller, lung, options, timing);
+            benchmark::DoNotOptimize(delivery);
+        }
+        state.SetItemsProcessed(state.iterations() * options.steps);
+        state.counters["p50_ns"] = static_cast<double>(timing.latency.quantile(0.5));
+        state.counters["p99_ns"] = static_cast<double>(timing.latency.quantile(0.99));
+    }
+
+    // Batch validation of a thousand patients over a grid of mechanics
+    void
+    validate(benchmark::State& state) {
+        std::vector<ventilation::control::Plant> plants;
+        for (int i = 0; i < 1000; i++) {
+            plants.push_back({
+                  ventilation::Resistance(5.0f + static_cast<float>(i % 20))
+                , ventilation::Compliance(0.02f + 0.002f * static_cast<float>(i / 20))
+            });
+        }
+        ventilation::control::Options options;
+        options.steps = 5 * 3200;
+        for (auto _ : state) {
+            ventilation::control::Timing timing;
+            std::vector<ventilation::control::Delivery> deliveries = ventilation::control::validate(
+                      std::span<const ventilation::control::Plant>(plants)
+                    , [](const ventilation::control::Plant&) {
+                        return ventilation::control::Adaptive(
+                                  SETTINGS
+                                , ventilation::Volume(0.5f)
+                                , ventilation::Pressure(5.0f)
+                                , ventilation::Pressure(10.0f)
+                                );
+                    }
+                    , options
+                    , timing
+                    );
+            benchmark::DoNotOptimize(deliveries.data());
+        }
+        state.SetItemsProcessed(state.iterations() * plants.size() * options.steps);
+    }
+} // namespace
+
+BENCHMARK_CAPTURE(breaths, pressure, ventilation::control::PressureControl(SETTINGS, ventilation::Pressure(15.0f), ventilation::Pressure(5.0f)));
+BENCHMARK_CAPTURE(breaths, volume, ventilation::control::VolumeControl(SETTINGS, ventilation::Volume(0.5f), ventilation::Pressure(5.0f)));
+BENCHMARK_CAPTURE(breaths, adaptive, ventilation::control::Adaptive(SETTINGS, ventilation::Volume(0.5f), ventilation::Pressure(5.0f), ventilation::Pressure(10.0f)));
+BENCHMARK(validate)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
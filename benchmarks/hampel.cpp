@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <ventilation/hampel.hpp>
+
+namespace {
+    std::vector<ventilation::Pressure>
+    recording() {
+        std::vector<ventilation::Pressure> pressure;
+        for (int i = 0; i < 100000; i++) {
+            const float spike = i % 211 == 0 ? 40.0f : 0.0f;
+            pressure.push_back(ventilation::Pressure(10.0f + 5.0f * std::sin(static_cast<float>(i) * 0.00785f) + spike));
+        }
+        return pressure;
+    }
+
+    // Copies and sorts the window of 2 * range(0) + 1 samples for every
+    // sample, twice: once for the median, once for the deviation
+    void
+    sorting(benchmark::State& state) {
+        const std::size_t half = state.range(0);
+        const std::vector<ventilation::Pressure> input = recording();
+        std::vector<ventilation::Pressure> output(input);
+        std::vector<std::int64_t> window(2 * half + 1);
+        for (auto _ : state) {
+            for (std::size_t i = half; i + half < input.size(); i++) {
+                for (std::size_t j = 0; j < window.size(); j++) {
+                    window[j] = ventilation::fixed::Access::raw(input[i - half + j]);
+                }
+                std::sort(window.begin(), window.end());
+                const std::int64_t median = window[half];
+                for (std::int64_t& value : window) {
+                    value = value > median ? value - median : median - value;
+                }
+                std::sort(window.begin(), window.end());
+                const std::int64_t center = ventilation::fixed::Access::raw(input[i]);
+                const double distance = std::abs(static_cast<double>(center - median));
+                if (distance > 3.0 * 1.4826 * static_cast<double>(window[half])) {
+                    output[i] = ventilation::fixed::Access::make<ventilation::Pressure>(median);
+                }
+            }
+            benchmark::DoNotOptimize(output.data());
+        }
+        state.SetItemsProcessed(state.iterations() * input.size());
+    }
+
+    void
+    skiplist(benchmark::State& state) {
+        const std::size_t half = state.range(0);
+        const std::vector<ventilation::Pressure> input = recording();
+        std::vector<ventilation::Pressure> output(input.size());
+        for (auto _ : state) {
+            ventilation::hampel::filter<ventilation::Pressure>(input, output, half);
+            benchmark::DoNotOptimize(output.data());
+        }
+        state.SetItemsProcessed(state.iterations() * input.size());
+    }
+
+    // range(0) channels of the recording, half window of 15
+    void
+    channels(benchmark::State& state) {
+        const std::vector<ventilation::Pressure> input = recording();
+        std::vector<std::vector<ventilation::Pressure>> outputs(state.range(0), std::vector<ventilation::Pressure>(input.size()));
+        std::vector<std::span<const ventilation::Pressure>> in(state.range(0), input);
+        std::vector<std::span<ventilation::Pressure>> out;
+        for (std::vector<ventilation::Pressure>& output : outputs) {
+            out.push_back(output);
+        }
+        for (auto _ : state) {
+            ventilation::hampel::filter<ventilation::Pressure>(in, out, 15);
+            benchmark::DoNotOptimize(outputs.data());
+        }
+        state.SetItemsProcessed(state.iterations() * input.size() * state.range(0));
+    }
+} // namespace
+
+BENCHMARK(sorting)->Arg(5)->Arg(15)->Arg(50);
+BENCHMARK(skiplist)->Arg(5)->Arg(15)->Arg(50);
+BENCHMARK(channels)->Arg(1)->Arg(8)->Arg(32);
+
+BENCHMARK_MAIN();
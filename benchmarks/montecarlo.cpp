@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+#include <thread>
+#include <ventilation/montecarlo.hpp>
+
+namespace {
+    const ventilation::montecarlo::Population population = {
+          {10.0f, 0.3f}
+        , {0.05f, 0.25f}
+        , ventilation::Pressure(5.0f)
+        , ventilation::Volume(0.5f)
+    };
+
+    // Second argument is the pool size
+    void
+    run(benchmark::State& state) {
+        ventilation::parallel::Pool pool(state.range(1));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(ventilation::montecarlo::run(
+                          population
+                        , ventilation::model::Settings()
+                        , state.range(0)
+                        , 1
+                        , ventilation::Pressure(25.0f)
+                        , pool
+                        ));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void
+    threads(benchmark::internal::Benchmark* benchmark) {
+        long hardware = std::max(1u, std::thread::hardware_concurrency());
+        for (long count = 1; count < hardware; count *= 2) {
+            benchmark->Args({1 << 20, count});
+        }
+        benchmark->Args({1 << 20, hardware});
+    }
+} // namespace
+
+BENCHMARK(run)->Apply(threads)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
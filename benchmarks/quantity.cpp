@@ -0,0 +1,156 @@
+#include <benchmark/benchmark.h>
+#include <sstream>
+#include <vector>
+#include <ventilation/ventilation.hpp>
+
+namespace {
+    // Inputs cycle through a small table so values are not constant folded,
+    // and every iteration processes state.range(0) elements.
+    std::vector<float>
+    samples(std::size_t size) {
+        std::vector<float> values(size);
+        for (std::size_t i = 0; i < size; i++) {
+            values[i] = static_cast<float>(static_cast<int>(i % 2000) - 1000) * 1e-3f;
+        }
+        return values;
+    }
+
+    template <typename T>
+    std::vector<T>
+    quantities(std::size_t size) {
+        std::vector<T> values;
+        values.reserve(size);
+        for (float v : samples(size)) { values.emplace_back(v); }
+        return values;
+    }
+
+    template <typename T>
+    void
+    construct(benchmark::State& state) {
+        const std::vector<float> input = samples(state.range(0));
+        for (auto _ : state) {
+            for (float v : input) {
+                T quantity(v);
+                benchmark::DoNotOptimize(quantity);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template <typename T>
+    void
+    convert(benchmark::State& state) {
+        const std::vector<T> input = quantities<T>(state.range(0));
+        for (auto _ : state) {
+            for (const T& quantity : input) {
+                benchmark::DoNotOptimize(static_cast<float>(quantity));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template <typename T>
+    void
+    add(benchmark::State& state) {
+        const std::vector<T> input = quantities<T>(state.range(0));
+        for (auto _ : state) {
+            T accumulator;
+            for (const T& quantity : input) { accumulator = accumulator + quantity; }
+            benchmark::DoNotOptimize(accumulator);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template <typename T>
+    void
+    subtract(benchmark::State& state) {
+        const std::vector<T> input = quantities<T>(state.range(0));
+        for (auto _ : state) {
+            T accumulator;
+            for (const T& quantity : input) { accumulator = accumulator - quantity; }
+            benchmark::DoNotOptimize(accumulator);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template <typename T>
+    void
+    negate(benchmark::State& state) {
+        const std::vector<T> input = quantities<T>(state.range(0));
+        for (auto _ : state) {
+            for (const T& quantity : input) {
+                benchmark::DoNotOptimize(-quantity);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template <typename T>
+    void
+    multiply(benchmark::State& state) {
+        const std::vector<T> input = quantities<T>(state.range(0));
+        for (auto _ : state) {
+            for (const T& quantity : input) {
+                benchmark::DoNotOptimize(quantity * 0.5f);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template <typename T>
+    void
+    compare(benchmark::State& state) {
+        const std::vector<T> input = quantities<T>(state.range(0));
+        const T threshold(0.25f);
+        for (auto _ : state) {
+            for (const T& quantity : input) {
+                benchmark::DoNotOptimize(quantity <=> threshold);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template <typename T>
+    void
+    format(benchmark::State& state) {
+        const std::vector<T> input = quantities<T>(state.range(0));
+        std::ostringstream os;
+        for (auto _ : state) {
+            os.str("");
+            for (const T& quantity : input) { os << quantity; }
+            benchmark::DoNotOptimize(os);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+} // namespace
+
+#define VENTILATION_SIZES RangeMultiplier(16)->Range(16, 1 << 16)
+
+#define VENTILATION_QUANTITY(T)                                             \
+    BENCHMARK_TEMPLATE(construct,   T)->VENTILATION_SIZES;                  \
+    BENCHMARK_TEMPLATE(convert,     T)->VENTILATION_SIZES;                  \
+    BENCHMARK_TEMPLATE(multiply,    T)->VENTILATION_SIZES;                  \
+    BENCHMARK_TEMPLATE(compare,     T)->VENTILATION_SIZES;                  \
+    BENCHMARK_TEMPLATE(format,      T)->RangeMultiplier(16)->Range(16, 1 << 12);
+
+#define VENTILATION_ADDITIVE(T)                                             \
+    BENCHMARK_TEMPLATE(add,         T)->VENTILATION_SIZES;                  \
+    BENCHMARK_TEMPLATE(subtract,    T)->VENTILATION_SIZES;                  \
+    BENCHMARK_TEMPLATE(negate,      T)->VENTILATION_SIZES;
+
+VENTILATION_QUANTITY(ventilation::Compliance)
+VENTILATION_QUANTITY(ventilation::Elastance)
+VENTILATION_QUANTITY(ventilation::Flow)
+VENTILATION_QUANTITY(ventilation::Power)
+VENTILATION_QUANTITY(ventilation::Pressure)
+VENTILATION_QUANTITY(ventilation::Resistance)
+VENTILATION_QUANTITY(ventilation::Volume)
+VENTILATION_QUANTITY(ventilation::Work)
+
+VENTILATION_ADDITIVE(ventilation::Flow)
+VENTILATION_ADDITIVE(ventilation::Power)
+VENTILATION_ADDITIVE(ventilation::Pressure)
+VENTILATION_ADDITIVE(ventilation::Volume)
+VENTILATION_ADDITIVE(ventilation::Work)
+
+BENCHMARK_MAIN();
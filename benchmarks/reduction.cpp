@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+#include <thread>
+#include <vector>
+#include <ventilation/reduction.hpp>
+
+namespace {
+    std::vector<float>
+    samples(std::size_t size) {
+        std::vector<float> values(size);
+        for (std::size_t i = 0; i < size; i++) {
+            values[i] = static_cast<float>(static_cast<int>(i % 2000) - 1000) * 1e-3f;
+        }
+        return values;
+    }
+
+    std::vector<ventilation::Flow>
+    flows(std::size_t size) {
+        std::vector<ventilation::Flow> values;
+        values.reserve(size);
+        for (float value : samples(size)) {
+            values.push_back(ventilation::Flow(value));
+        }
+        return values;
+    }
+
+    // The single-threaded float loop the reductions replace
+    void
+    baseline(benchmark::State& state) {
+        const std::vector<float> input = samples(state.range(0));
+        for (auto _ : state) {
+            float accumulator = 0.0f;
+            for (float value : input) { accumulator += value; }
+            benchmark::DoNotOptimize(accumulator);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // Second argument is the pool size
+    void
+    sum(benchmark::State& state) {
+        const std::vector<ventilation::Flow> input = flows(state.range(0));
+        ventilation::parallel::Pool pool(state.range(1));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(ventilation::reduction::sum<ventilation::Flow>(input, pool));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void
+    extrema(benchmark::State& state) {
+        const std::vector<ventilation::Flow> input = flows(state.range(0));
+        ventilation::parallel::Pool pool(state.range(1));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(ventilation::reduction::extrema<ventilation::Flow>(input, pool));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void
+    dot(benchmark::State& state) {
+        const std::vector<ventilation::Flow> flow = flows(state.range(0));
+        std::vector<ventilation::Pressure> pressure;
+        for (float value : samples(state.range(0))) {
+            pressure.push_back(ventilation::Pressure(value * 20.0f));
+        }
+        ventilation::parallel::Pool pool(state.range(1));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(ventilation::reduction::dot(flow, pressure, pool));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void
+    threads(benchmark::internal::Benchmark* benchmark) {
+        long hardware = std::max(1u, std::thread::hardware_concurrency());
+        for (long size : {1 << 16, 1 << 22}) {
+            for (long count = 1; count < hardware; count *= 2) {
+                benchmark->Args({size, count});
+            }
+            benchmark->Args({size, hardware});
+        }
+    }
+} // namespace
+
+BENCHMARK(baseline)->Arg(1 << 16)->Arg(1 << 22);
+BENCHMARK(sum)->Apply(threads)->UseRealTime();
+BENCHMARK(extrema)->Apply(threads)->UseRealTime();
+BENCHMARK(dot)->Apply(threads)->UseRealTime();
+
+BENCHMARK_MAIN();
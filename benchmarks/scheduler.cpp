@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <ventilation/model.hpp>
+#include <ventilation/parallel.hpp>
+
+namespace {
+    // One tick of per-bed analysis where a tenth of the beds, adjacent as in
+    // a ward, run an estimator costing ten times plain monitoring. The
+    // counters give the distribution of tick latency.
+    constexpr std::size_t BEDS  = 256;
+    constexpr std::size_t HEAVY = 10;
+
+    const ventilation::model::Waveforms&
+    waveforms() {
+        static const ventilation::model::Waveforms w = ventilation::model::simulate(
+                  {
+                      ventilation::Resistance(10.0f)
+                    , ventilation::Compliance(0.05f)
+                    , ventilation::Pressure(5.0f)
+                    , ventilation::Volume(0.5f)
+                  }
+                , ventilation::model::Settings()
+                );
+        return w;
+    }
+
+    void
+    analyze(std::size_t bed) {
+        const ventilation::model::Waveforms& w = waveforms();
+        std::size_t repeats = bed < BEDS / HEAVY ? HEAVY : 1;
+        for (std::size_t i = 0; i < repeats; i++) {
+            benchmark::DoNotOptimize(ventilation::mechanics::analyze(w.pressure, w.flow, w.volume, 0.01f));
+        }
+    }
+
+    void
+    report(benchmark::State& state, std::vector<double>& latencies) {
+        std::sort(latencies.begin(), latencies.end());
+        auto at = [&](double q) { return latencies[static_cast<std::size_t>(q * (latencies.size() - 1))]; };
+        state.counters["p50_us"]    = at(0.50);
+        state.counters["p99_us"]    = at(0.99);
+        state.counters["max_us"]    = latencies.back();
+        state.SetItemsProcessed(state.iterations() * BEDS);
+    }
+
+    template <typename F>
+    void
+    measure(benchmark::State& state, F&& tick) {
+        std::vector<double> latencies;
+        for (auto _ : state) {
+            auto start = std::chrono::steady_clock::now();
+            tick();
+            std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+            latencies.push_back(elapsed.count());
+        }
+        report(state, latencies);
+    }
+
+    // Beds split evenly by count between the threads, argument is the pool size
+    void
+    partitioned(benchmark::State& state) {
+        ventilation::parallel::Pool pool(state.range(0));
+        const std::size_t threads = pool.size();
+        measure(state, [&] {
+            pool.run(threads, [&](std::size_t t) {
+                for (std::size_t bed = BEDS * t / threads; bed < BEDS * (t + 1) / threads; bed++) { analyze(bed); }
+            });
+        });
+    }
+
+    // One index per bed, rebalanced by the pool's work stealing
+    void
+    stealing(benchmark::State& state) {
+        ventilation::parallel::Pool pool(state.range(0));
+        measure(state, [&] { pool.run(BEDS, [](std::size_t bed) { analyze(bed); }); });
+    }
+
+    void
+    threads(benchmark::internal::Benchmark* benchmark) {
+        long hardware = std::max(1u, std::thread::hardware_concurrency());
+        for (long count = 1; count < hardware; count *= 2) {
+            benchmark->Arg(count);
+        }
+        benchmark->Arg(hardware);
+    }
+} // namespace
+
+BENCHMARK(partitioned)->Apply(threads)->UseRealTime();
+BENCHMARK(stealing)->Apply(threads)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+#include <ventilation/tracing.hpp>
+
+namespace {
+    // Cost of one empty span, nothing at all when tracing is compiled out;
+    // spans are collected outside the timing so rings never wrap
+    void
+    span(benchmark::State& state) {
+        ventilation::tracing::Trace trace;
+        std::size_t spans = 0;
+        for (auto _ : state) {
+            VENTILATION_TRACE("benchmark::span");
+            if (++spans == ventilation::tracing::CAPACITY) {
+                state.PauseTiming();
+                trace.collect();
+                trace.clear();
+                spans = 0;
+                state.ResumeTiming();
+            }
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.counters["enabled"] = ventilation::tracing::ENABLED ? 1.0 : 0.0;
+    }
+
+    // Draining a full ring into events and histograms
+    void
+    collect(benchmark::State& state) {
+        ventilation::tracing::Trace trace;
+        for (auto _ : state) {
+            state.PauseTiming();
+            trace.clear();
+            for (std::size_t i = 0; i < ventilation::tracing::CAPACITY; i++) {
+                VENTILATION_TRACE("benchmark::collect");
+            }
+            state.ResumeTiming();
+            trace.collect();
+        }
+        state.SetItemsProcessed(state.iterations() * ventilation::tracing::CAPACITY);
+    }
+} // namespace
+
+BENCHMARK(span);
+BENCHMARK(collect)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
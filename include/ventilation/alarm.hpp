@@ -0,0 +1,196 @@
+#ifndef VENTILATION_ALARM_HPP__
+#define VENTILATION_ALARM_HPP__
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace alarm {
+    // Waveform a rule watches
+    enum class Signal : std::uint8_t {
+        pressure    = 0,
+        flow        = 1,
+        volume      = 2,
+    };
+
+    template <typename T>
+    concept Monitored = std::same_as<T, Pressure> or std::same_as<T, Flow> or std::same_as<T, Volume>;
+
+    // Alarm condition on one signal, compiled from the comparison operators
+    // into an inclusive interval of raw values, so evaluation needs neither
+    // the divisions of operator<=> nor a branch per comparison. A rule fires
+    // once its condition holds for `debounce` consecutive samples; a
+    // latching rule then stays active until acknowledged.
+    struct Rule {
+        Signal          signal;
+        std::int64_t    low;
+        std::int64_t    high;
+        std::uint32_t   debounce    = 1;
+        bool            latching    = false;
+
+        // value > threshold, e.g. high airway pressure
+        template <Monitored T>
+        static Rule
+        above(const T& threshold, std::uint32_t debounce = 1, bool latching = false);
+
+        // value < threshold, e.g. low delivered volume
+        template <Monitored T>
+        static Rule
+        below(const T& threshold, std::uint32_t debounce = 1, bool latching = false);
+
+        // lower < value < upper, e.g. apnea as flow near zero for a while
+        template <Monitored T>
+        static Rule
+        within(const T& lower, const T& upper, std::uint32_t debounce = 1, bool latching = false);
+
+        // True when the condition holds for value, by the operators of T
+        template <Monitored T>
+        bool
+        holds(const T& value) const;
+    };
+
+    enum class Edge : std::uint8_t {
+        raised  = 0,
+        cleared = 1,
+    };
+
+    struct Event {
+        std::uint64_t   tick;   // evaluations so far, including the one raising the event
+        std::size_t     bed;
+        std::size_t     rule;
+        Edge            edge;
+    };
+
+    // Evaluates every rule for every bed, one sample per bed per tick. State
+    // is kept as a structure of arrays, rule-major, so a rule is evaluated
+    // over all beds by a single vectorized kernel call. Only changes of
+    // alarm state are reported.
+    class Engine {
+        public:
+            // Every bed starts with the thresholds of the given rules. Throws
+            // std::invalid_argument on a rule with zero debounce.
+            Engine(std::span<const Rule> rules, std::size_t beds);
+
+            std::size_t
+            rules() const { return rules_.size(); }
+
+            std::size_t
+            beds() const { return beds_; }
+
+            // Evaluations so far
+            std::uint64_t
+            tick() const { return tick_; }
+
+            // Replaces the thresholds of one rule for one bed with those of
+            // `thresholds`, which must watch the same signal
+            void
+            configure(std::size_t rule, std::size_t bed, const Rule& thresholds);
+
+            // Advances one tick with the latest sample of every bed and
+            // appends an event for every alarm raised or cleared
+            void
+            evaluate(
+                  std::span<const Pressure> pressure
+                , std::span<const Flow> flow
+                , std::span<const Volume> volume
+                , std::vector<Event>& events
+                );
+
+            bool
+            active(std::size_t rule, std::size_t bed) const;
+
+            // Releases a latched alarm. It clears at once, with an event,
+            // unless its condition still holds.
+            void
+            acknowledge(std::size_t rule, std::size_t bed, std::vector<Event>& events);
+        private:
+            std::size_t
+            index(std::size_t rule, std::size_t bed) const;
+
+            std::vector<Rule>           rules_;
+            std::size_t                 beds_;
+            std::uint64_t               tick_ = 0;
+            std::vector<std::int64_t>   low_;
+            std::vector<std::int64_t>   high_;
+            std::vector<std::uint32_t>  count_;
+            std::vector<std::uint8_t>   state_;
+    };
+
+namespace detail {
+    // Raw bounds equivalent to the comparison operators, which compare
+    // values truncated toward zero to a multiple of fixed::PRECISION. The
+    // bounds may lie outside the int64 range.
+
+    // Smallest raw value x with x > threshold
+    __int128
+    above(std::int64_t threshold);
+
+    // Largest raw value x with x < threshold
+    __int128
+    below(std::int64_t threshold);
+
+    // Rule over [low, high] clipped to the int64 range, never matching when
+    // the clipped interval is empty
+    Rule
+    rule(Signal signal, __int128 low, __int128 high, std::uint32_t debounce, bool latching);
+
+    template <Monitored T>
+    constexpr Signal
+    signal() {
+        if constexpr (std::same_as<T, Pressure>)    { return Signal::pressure; }
+        else if constexpr (std::same_as<T, Flow>)   { return Signal::flow; }
+        else                                        { return Signal::volume; }
+    }
+} // namespace detail
+
+    template <Monitored T>
+    Rule
+    Rule::above(const T& threshold, std::uint32_t debounce, bool latching) {
+        return detail::rule(
+                detail::signal<T>()
+                , detail::above(fixed::Access::raw(threshold))
+                , std::numeric_limits<std::int64_t>::max()
+                , debounce
+                , latching
+                );
+    }
+
+    template <Monitored T>
+    Rule
+    Rule::below(const T& threshold, std::uint32_t debounce, bool latching) {
+        return detail::rule(
+                detail::signal<T>()
+                , std::numeric_limits<std::int64_t>::min()
+                , detail::below(fixed::Access::raw(threshold))
+                , debounce
+                , latching
+                );
+    }
+
+    template <Monitored T>
+    Rule
+    Rule::within(const T& lower, const T& upper, std::uint32_t debounce, bool latching) {
+        return detail::rule(
+                detail::signal<T>()
+                , detail::above(fixed::Access::raw(lower))
+                , detail::below(fixed::Access::raw(upper))
+                , debounce
+                , latching
+                );
+    }
+
+    template <Monitored T>
+    bool
+    Rule::holds(const T& value) const {
+        std::int64_t raw = fixed::Access::raw(value);
+        return signal == detail::signal<T>() and low <= raw and raw <= high;
+    }
+} // namespace alarm
+} // namespace ventilation
+
+#endif // VENTILATION_ALARM_HPP__
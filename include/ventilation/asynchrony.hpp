@@ -0,0 +1,130 @@
+#ifndef VENTILATION_ASYNCHRONY_HPP__
+#define VENTILATION_ASYNCHRONY_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include "ventilation/parallel.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace asynchrony {
+    // Kind of patient-ventilator asynchrony seen in a breath. When several
+    // apply, the first one listed here after normal is reported.
+    enum class Type : std::uint8_t {
+        normal          = 0,
+        double_trigger  = 1,    // next breath triggered before expiration was done
+        premature       = 2,    // effort right after cycling, the breath ended too soon
+        ineffective     = 3,    // effort during expiration that did not trigger a breath
+    };
+
+    // Shapes that count as a patient effort during expiration: expiratory
+    // flow bumping up by `effort` and falling back, while airway pressure
+    // dips and recovers by `dip`, as inspiratory muscles briefly pull
+    // against the exhalation
+    struct Thresholds {
+        Flow        effort  = Flow(0.1f);
+        Pressure    dip     = Pressure(0.5f);
+        float       early   = 0.3f;     // seconds after cycling within which an effort is premature cycling
+        float       ratio   = 0.5f;     // expiratory over inspiratory time below which a breath is double triggered
+    };
+
+    // Summary of one breath, from an inspiratory onset (flow turning
+    // positive) up to the next. Expiration starts at the first sample
+    // without positive flow.
+    struct Breath {
+        std::uint64_t   start;          // sample of the onset, counted from the start of the stream
+        std::uint32_t   inspiration;    // samples
+        std::uint32_t   expiration;     // samples
+        Flow            peak;           // highest inspiratory flow
+        Pressure        pressure;       // highest airway pressure
+        Volume          inspired;
+        Volume          expired;
+        std::uint32_t   efforts;        // efforts detected during expiration
+        Type            type;
+    };
+
+    // Classifies breaths as their samples arrive. Every feature is updated
+    // once per sample, running extrema and volumes included, so a breath is
+    // classified at the onset of the next one without looking back at its
+    // samples, and a detector holds no sample buffer. Samples before the
+    // first onset are skipped, and the breath in progress is only reported
+    // once the next one starts.
+    class Detector {
+        public:
+            // Throws std::domain_error when the period is not finite and
+            // positive, std::invalid_argument when a threshold is negative
+            explicit Detector(float period, const Thresholds& thresholds = Thresholds());
+
+            // The breath this sample ends, if it is an onset
+            std::optional<Breath>
+            push(const Pressure& pressure, const Flow& flow);
+
+            // Appends every breath the samples end. Sizes must match.
+            void
+            push(std::span<const Pressure> pressure, std::span<const Flow> flow, std::vector<Breath>& output);
+
+            // Samples pushed so far
+            std::uint64_t
+            samples() const { return samples_; }
+        private:
+            void
+            begin();
+
+            void
+            rearm(std::int64_t pressure, std::int64_t flow);
+
+            Breath
+            finish() const;
+
+            // Settings, raw
+            double          period_;
+            std::int64_t    effort_;
+            std::int64_t    dip_;
+            std::uint32_t   early_;
+            double          ratio_;
+
+            std::uint64_t   samples_    = 0;
+            bool            started_    = false;
+            bool            positive_   = true;     // no onset on the very first sample
+
+            // Breath in progress
+            std::uint64_t   start_      = 0;
+            std::uint32_t   inspiration_;
+            std::uint32_t   expiration_;
+            std::int64_t    peak_;
+            std::int64_t    pressure_;
+            std::int64_t    inspired_;              // sums of flow
+            std::int64_t    expired_;
+            std::uint32_t   efforts_;
+            std::uint32_t   premature_;             // efforts within early_ of cycling
+
+            // Effort tracking during expiration. An effort is a bump of flow:
+            // a rise by effort_ above its lowest value, then a fall by half
+            // as much from the crest, while pressure recovers by dip_ from
+            // its lowest value. Passive exhalation only ever rises.
+            bool            rising_;
+            std::int64_t    lowest_;
+            std::int64_t    crest_;
+            std::uint32_t   summit_;                // expiratory sample of the crest
+            std::int64_t    trough_;
+            std::int64_t    recovery_;
+    };
+
+    // Classifies a whole recording, as a detector fed every sample would.
+    // Since a breath depends only on its own samples, the recording is cut
+    // at onsets into parts classified across the pool.
+    std::vector<Breath>
+    classify(
+          std::span<const Pressure> pressure
+        , std::span<const Flow> flow
+        , float period
+        , const Thresholds& thresholds = Thresholds()
+        , parallel::Pool& pool = parallel::shared()
+        );
+} // namespace asynchrony
+} // namespace ventilation
+
+#endif // VENTILATION_ASYNCHRONY_HPP__
@@ -0,0 +1,371 @@
+#ifndef VENTILATION_BATCH_HPP__
+#define VENTILATION_BATCH_HPP__
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include "ventilation/instrumentation.hpp"
+#include "ventilation/kernels.hpp"
+#include "ventilation/saturating.hpp"
+#include "ventilation/span.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace batch {
+    // Element-wise equivalents of the scalar constructors and operators, run
+    // through the best kernel variant for the current CPU.
+
+    // output[i] = T(input[i])
+    template <Quantity T>
+    void
+    construct(std::span<const float> input, std::span<T> output) {
+        if (input.size() != output.size()) {
+            throw std::invalid_argument("input and output must have the same size");
+        }
+        const kernels::Table& table = kernels::active();
+        if (not table.finite(input.data(), input.size())) {
+            instrumentation::increment(instrumentation::Counter::domain);
+            throw std::domain_error("values must be finite");
+        }
+        table.forward(input.data(), fixed::Access::raw(output).data(), input.size());
+    }
+
+    // output[i] = static_cast<float>(input[i])
+    template <Quantity T>
+    void
+    convert(std::span<const T> input, std::span<float> output) {
+        if (input.size() != output.size()) {
+            throw std::invalid_argument("input and output must have the same size");
+        }
+        kernels::active().inverse(fixed::Access::raw(input).data(), output.data(), input.size());
+    }
+
+    // output[i] = input[i] * scalar
+    template <Quantity T>
+    void
+    scale(std::span<const T> input, float scalar, std::span<T> output) {
+        if (input.size() != output.size()) {
+            throw std::invalid_argument("input and output must have the same size");
+        }
+        if (not std::isfinite(scalar)) {
+            instrumentation::increment(instrumentation::Counter::domain);
+            throw std::domain_error("scalar value must be finite");
+        }
+        std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
+        std::int64_t converted  = static_cast<std::int64_t>(scalar * forward);
+
+        kernels::active().scale(
+                fixed::Access::raw(input).data()
+                , converted
+                , fixed::Access::raw(output).data()
+                , input.size()
+                );
+    }
+
+    // output[i] = -1, 0 or 1 as lhs[i] <=> rhs[i] is less, equal or greater
+    template <Quantity T>
+    void
+    compare(std::span<const T> lhs, std::span<const T> rhs, std::span<std::int8_t> output) {
+        if (lhs.size() != rhs.size() or lhs.size() != output.size()) {
+            throw std::invalid_argument("lhs, rhs and output must have the same size");
+        }
+        kernels::active().compare(
+                fixed::Access::raw(lhs).data()
+                , fixed::Access::raw(rhs).data()
+                , output.data()
+                , lhs.size()
+                );
+    }
+
+    // input[0] + input[1] + ... + input[n - 1]
+    template <Quantity T>
+    T
+    sum(std::span<const T> input) {
+        return fixed::Access::make<T>(
+                kernels::active().sum(fixed::Access::raw(input).data(), input.size())
+                );
+    }
+
+    // Equation of motion, output[i] = resistance * flow[i] + elastance * volume[i] + peep
+    inline void
+    motion(
+          std::span<const Flow> flow
+        , std::span<const Volume> volume
+        , const Resistance& resistance
+        , const Elastance& elastance
+        , const Pressure& peep
+        , std::span<Pressure> output
+        )
+    {
+        if (flow.size() != volume.size() or flow.size() != output.size()) {
+            throw std::invalid_argument("flow, volume and output must have the same size");
+        }
+        kernels::active().motion(
+                fixed::Access::raw(flow).data()
+                , fixed::Access::raw(volume).data()
+                , fixed::Access::raw(resistance)
+                , fixed::Access::raw(elastance)
+                , fixed::Access::raw(peep)
+                , fixed::Access::raw(output).data()
+                , flow.size()
+                );
+    }
+
+    // Overloads for QuantitySpan views. Contiguous views of native values go
+    // straight to the kernels; any other view is decoded BLOCK elements at a
+    // time into a stack buffer, so no full-size intermediate copy is made.
+    inline constexpr std::size_t BLOCK = 256;
+
+    // Calls f(offset, values) over consecutive runs of the view
+    template <View V, typename F>
+    void
+    blocks(const V& input, F&& f) {
+        using T = typename V::quantity;
+
+        if (input.contiguous()) {
+            f(std::size_t(0), input.span());
+            return;
+        }
+        std::array<T, BLOCK> buffer;
+        for (std::size_t offset = 0; offset < input.size(); offset += BLOCK) {
+            std::size_t count = std::min(BLOCK, input.size() - offset);
+            for (std::size_t i = 0; i < count; i++) {
+                buffer[i] = input[offset + i];
+            }
+            f(offset, std::span<const T>(buffer.data(), count));
+        }
+    }
+
+    // Calls f(offset, lhs values, rhs values) over consecutive runs of both views
+    template <View L, View R, typename F>
+    void
+    blocks(const L& lhs, const R& rhs, F&& f) {
+        using X = typename L::quantity;
+        using Y = typename R::quantity;
+
+        if (lhs.size() != rhs.size()) {
+            throw std::invalid_argument("views must have the same size");
+        }
+        if (lhs.contiguous() and rhs.contiguous()) {
+            f(std::size_t(0), lhs.span(), rhs.span());
+            return;
+        }
+        std::array<X, BLOCK> xs;
+        std::array<Y, BLOCK> ys;
+        for (std::size_t offset = 0; offset < lhs.size(); offset += BLOCK) {
+            std::size_t count = std::min(BLOCK, lhs.size() - offset);
+            for (std::size_t i = 0; i < count; i++) {
+                xs[i] = lhs[offset + i];
+                ys[i] = rhs[offset + i];
+            }
+            f(offset, std::span<const X>(xs.data(), count), std::span<const Y>(ys.data(), count));
+        }
+    }
+
+    // output[i] = input[i], decoding the view
+    template <View V>
+    void
+    construct(const V& input, std::span<typename V::quantity> output) {
+        using T = typename V::quantity;
+
+        if (input.size() != output.size()) {
+            throw std::invalid_argument("input and output must have the same size");
+        }
+        if constexpr (std::same_as<typename V::source, float>) {
+            if (input.stride() == 1) {
+                construct<T>(std::span<const float>(input.data(), input.size()), output);
+                return;
+            }
+        }
+        for (std::size_t i = 0; i < input.size(); i++) {
+            output[i] = input[i];
+        }
+    }
+
+    template <View V>
+    void
+    convert(const V& input, std::span<float> output) {
+        using T = typename V::quantity;
+
+        if (input.size() != output.size()) {
+            throw std::invalid_argument("input and output must have the same size");
+        }
+        blocks(input, [&](std::size_t offset, std::span<const T> values) {
+            convert<T>(values, output.subspan(offset, values.size()));
+        });
+    }
+
+    template <View V>
+    void
+    scale(const V& input, float scalar, std::span<typename V::quantity> output) {
+        using T = typename V::quantity;
+
+        if (input.size() != output.size()) {
+            throw std::invalid_argument("input and output must have the same size");
+        }
+        blocks(input, [&](std::size_t offset, std::span<const T> values) {
+            scale<T>(values, scalar, output.subspan(offset, values.size()));
+        });
+    }
+
+    template <View L, View R>
+    requires std::same_as<typename L::quantity, typename R::quantity>
+    void
+    compare(const L& lhs, const R& rhs, std::span<std::int8_t> output) {
+        using T = typename L::quantity;
+
+        if (lhs.size() != output.size()) {
+            throw std::invalid_argument("lhs, rhs and output must have the same size");
+        }
+        blocks(lhs, rhs, [&](std::size_t offset, std::span<const T> xs, std::span<const T> ys) {
+            compare<T>(xs, ys, output.subspan(offset, xs.size()));
+        });
+    }
+
+    template <View V>
+    typename V::quantity
+    sum(const V& input) {
+        using T = typename V::quantity;
+
+        std::uint64_t accumulator = 0;
+        blocks(input, [&](std::size_t, std::span<const T> values) {
+            accumulator += static_cast<std::uint64_t>(fixed::Access::raw(sum<T>(values)));
+        });
+        return fixed::Access::make<T>(static_cast<std::int64_t>(accumulator));
+    }
+
+    template <View F, View V>
+    requires std::same_as<typename F::quantity, Flow> and std::same_as<typename V::quantity, Volume>
+    void
+    motion(
+          const F& flow
+        , const V& volume
+        , const Resistance& resistance
+        , const Elastance& elastance
+        , const Pressure& peep
+        , std::span<Pressure> output
+        )
+    {
+        if (flow.size() != output.size()) {
+            throw std::invalid_argument("flow, volume and output must have the same size");
+        }
+        blocks(flow, volume, [&](std::size_t offset, std::span<const Flow> fs, std::span<const Volume> vs) {
+            motion(fs, vs, resistance, elastance, peep, output.subspan(offset, fs.size()));
+        });
+    }
+
+namespace saturating {
+    // Element-wise equivalents of ventilation::saturating, clamping instead
+    // of wrapping on overflow.
+
+    // output[i] = saturating::add(lhs[i], rhs[i])
+    template <Quantity T>
+    void
+    add(std::span<const T> lhs, std::span<const T> rhs, std::span<T> output) requires requires(const T& x) { x + x; } {
+        if (lhs.size() != rhs.size() or lhs.size() != output.size()) {
+            throw std::invalid_argument("lhs, rhs and output must have the same size");
+        }
+        std::size_t saturated = kernels::active().saturating_add(
+                fixed::Access::raw(lhs).data()
+                , fixed::Access::raw(rhs).data()
+                , fixed::Access::raw(output).data()
+                , lhs.size()
+                );
+        instrumentation::increment(instrumentation::Counter::saturation, saturated);
+    }
+
+    // output[i] = saturating::subtract(lhs[i], rhs[i])
+    template <Quantity T>
+    void
+    subtract(std::span<const T> lhs, std::span<const T> rhs, std::span<T> output) requires requires(const T& x) { x - x; } {
+        if (lhs.size() != rhs.size() or lhs.size() != output.size()) {
+            throw std::invalid_argument("lhs, rhs and output must have the same size");
+        }
+        std::size_t saturated = kernels::active().saturating_subtract(
+                fixed::Access::raw(lhs).data()
+                , fixed::Access::raw(rhs).data()
+                , fixed::Access::raw(output).data()
+                , lhs.size()
+                );
+        instrumentation::increment(instrumentation::Counter::saturation, saturated);
+    }
+
+    // output[i] = saturating::multiply(input[i], scalar)
+    template <Quantity T>
+    void
+    scale(std::span<const T> input, float scalar, std::span<T> output) {
+        if (input.size() != output.size()) {
+            throw std::invalid_argument("input and output must have the same size");
+        }
+        if (not std::isfinite(scalar)) {
+            instrumentation::increment(instrumentation::Counter::domain);
+            throw std::domain_error("scalar value must be finite");
+        }
+        float converted = scalar * fixed::FORWARD;
+        if (not (std::abs(converted) < 0x1p63f)) {
+            // The factor does not fit the kernels; such scalars clamp nearly
+            // every value, so each element takes the scalar path
+            std::span<const std::int64_t> values = fixed::Access::raw(input);
+            std::span<std::int64_t> results = fixed::Access::raw(output);
+            for (std::size_t i = 0; i < values.size(); i++) {
+                results[i] = ventilation::saturating::multiply(values[i], scalar);
+            }
+            return;
+        }
+
+        std::size_t saturated = kernels::active().saturating_scale(
+                fixed::Access::raw(input).data()
+                , static_cast<std::int64_t>(converted)
+                , fixed::Access::raw(output).data()
+                , input.size()
+                );
+        instrumentation::increment(instrumentation::Counter::saturation, saturated);
+    }
+
+    template <View L, View R>
+    requires std::same_as<typename L::quantity, typename R::quantity>
+    void
+    add(const L& lhs, const R& rhs, std::span<typename L::quantity> output) {
+        using T = typename L::quantity;
+
+        if (lhs.size() != output.size()) {
+            throw std::invalid_argument("lhs, rhs and output must have the same size");
+        }
+        blocks(lhs, rhs, [&](std::size_t offset, std::span<const T> xs, std::span<const T> ys) {
+            add<T>(xs, ys, output.subspan(offset, xs.size()));
+        });
+    }
+
+    template <View L, View R>
+    requires std::same_as<typename L::quantity, typename R::quantity>
+    void
+    subtract(const L& lhs, const R& rhs, std::span<typename L::quantity> output) {
+        using T = typename L::quantity;
+
+        if (lhs.size() != output.size()) {
+            throw std::invalid_argument("lhs, rhs and output must have the same size");
+        }
+        blocks(lhs, rhs, [&](std::size_t offset, std::span<const T> xs, std::span<const T> ys) {
+            subtract<T>(xs, ys, output.subspan(offset, xs.size()));
+        });
+    }
+
+    template <View V>
+    void
+    scale(const V& input, float scalar, std::span<typename V::quantity> output) {
+        using T = typename V::quantity;
+
+        if (input.size() != output.size()) {
+            throw std::invalid_argument("input and output must have the same size");
+        }
+        blocks(input, [&](std::size_t offset, std::span<const T> values) {
+            scale<T>(values, scalar, output.subspan(offset, values.size()));
+        });
+    }
+} // namespace saturating
+} // namespace batch
+} // namespace ventilation
+
+#endif // VENTILATION_BATCH_HPP__
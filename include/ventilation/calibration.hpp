@@ -0,0 +1,179 @@
+#ifndef VENTILATION_CALIBRATION_HPP__
+#define VENTILATION_CALIBRATION_HPP__
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "ventilation/kernels.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace calibration {
+    // One measured point of a sensor: the raw ADC count and the value it
+    // stands for, in the unit of the quantity
+    struct Point {
+        std::int32_t    count;
+        float           value;
+    };
+
+    // Piecewise-linear curve resampled on uniform segments of counts, in raw
+    // fixed-point values
+    struct Knots {
+        std::int32_t                base;   // first count
+        std::int32_t                last;   // last count
+        std::uint32_t               shift;
+        std::vector<std::int64_t>   values;
+        std::int64_t                error;  // largest deviation at the points
+    };
+
+    // Resamples the curve through (counts[i], values[i]) on `segments`
+    // segments from the first count, widened to powers of two so that every
+    // count up to the last one is covered, and rounded to the nearest raw
+    // value. The curve is flat beyond its ends.
+    Knots
+    compile(std::span<const std::int32_t> counts, std::span<const std::int64_t> values, std::uint32_t segments);
+
+    // Calibration curve compiled into a lookup table indexed by the count
+    // itself: the segment is count >> shift, so converting a sample is a
+    // clamp, two loads and a multiply, without any search. The table differs
+    // from the curve only between its knots, by at most error().
+    template <Quantity T>
+    class Table {
+        public:
+            // Points must have strictly increasing counts, at least two of
+            // them, and segments must be a power of two
+            Table(std::span<const Point> points, std::uint32_t segments) {
+                if (points.size() < 2) {
+                    throw std::invalid_argument("calibration needs at least two points");
+                }
+                if (segments == 0 or (segments & (segments - 1)) != 0) {
+                    throw std::invalid_argument("segments must be a power of two");
+                }
+                std::vector<std::int32_t> counts(points.size());
+                std::vector<std::int64_t> values(points.size());
+                for (std::size_t i = 0; i < points.size(); i++) {
+                    counts[i] = points[i].count;
+                    values[i] = fixed::Access::raw(T(points[i].value));
+                }
+                knots_ = compile(counts, values, segments);
+            }
+
+            // Fewest segments, doubling from one, whose table stays within
+            // `tolerance` of the curve
+            static Table
+            fit(std::span<const Point> points, const T& tolerance) {
+                for (std::uint32_t segments = 1; segments <= LIMIT; segments *= 2) {
+                    Table table(points, segments);
+                    if (table.error() <= tolerance) { return table; }
+                }
+                throw std::invalid_argument("tolerance cannot be met");
+            }
+
+            T
+            operator()(std::int32_t count) const {
+                std::int64_t value;
+                kernels::reference().interpolate(
+                          &count
+                        , knots_.base
+                        , knots_.shift
+                        , segments()
+                        , knots_.values.data()
+                        , &value
+                        , 1
+                        );
+                return fixed::Access::make<T>(value);
+            }
+
+            // Sizes must match
+            void
+            convert(std::span<const std::int32_t> counts, std::span<T> output) const {
+                if (counts.size() != output.size()) {
+                    throw std::invalid_argument("input and output sizes differ");
+                }
+                kernels::active().interpolate(
+                          counts.data()
+                        , knots_.base
+                        , knots_.shift
+                        , segments()
+                        , knots_.values.data()
+                        , fixed::Access::raw(output).data()
+                        , counts.size()
+                        );
+            }
+
+            // Counts of a 16-bit converter, widened a block at a time
+            void
+            convert(std::span<const std::uint16_t> counts, std::span<T> output) const {
+                if (counts.size() != output.size()) {
+                    throw std::invalid_argument("input and output sizes differ");
+                }
+                std::int32_t wide[BLOCK];
+                for (std::size_t i = 0; i < counts.size(); i += BLOCK) {
+                    const std::size_t size = std::min(BLOCK, counts.size() - i);
+                    std::copy_n(counts.begin() + i, size, wide);
+                    convert(std::span<const std::int32_t>(wide, size), output.subspan(i, size));
+                }
+            }
+
+            // Counts below lower() read as the first point, above upper() as
+            // the last one
+            std::int32_t
+            lower() const { return knots_.base; }
+
+            std::int32_t
+            upper() const { return knots_.last; }
+
+            std::uint32_t
+            segments() const { return static_cast<std::uint32_t>(knots_.values.size() - 1); }
+
+            // Largest deviation from the curve through the points
+            T
+            error() const { return fixed::Access::make<T>(knots_.error); }
+        private:
+            static constexpr std::uint32_t  LIMIT = 1u << 20;
+            static constexpr std::size_t    BLOCK = 256;
+
+            Knots knots_;
+    };
+
+    // Table of one sensor that can be replaced while samples stream through
+    // it. A conversion reads the table once per buffer, so each buffer is
+    // converted entirely with either the old or the new table, and the old
+    // one lives until the last conversion using it returns.
+    template <Quantity T>
+    class Calibration {
+        public:
+            explicit Calibration(Table<T> table) : table_(std::make_shared<const Table<T>>(std::move(table))) {}
+
+            Calibration(const Calibration&)             = delete;
+            Calibration& operator=(const Calibration&)  = delete;
+
+            // Takes effect from the next buffer, from any thread
+            void
+            install(Table<T> table) {
+                table_.store(std::make_shared<const Table<T>>(std::move(table)), std::memory_order_release);
+            }
+
+            std::shared_ptr<const Table<T>>
+            table() const { return table_.load(std::memory_order_acquire); }
+
+            T
+            operator()(std::int32_t count) const { return (*table())(count); }
+
+            template <typename Count>
+            void
+            convert(std::span<const Count> counts, std::span<T> output) const {
+                table()->convert(counts, output);
+            }
+        private:
+            std::atomic<std::shared_ptr<const Table<T>>> table_;
+    };
+} // namespace calibration
+} // namespace ventilation
+
+#endif // VENTILATION_CALIBRATION_HPP__
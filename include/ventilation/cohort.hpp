@@ -0,0 +1,196 @@
+#ifndef VENTILATION_COHORT_HPP__
+#define VENTILATION_COHORT_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "ventilation/parallel.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace cohort {
+    // Group-by aggregation over columns of breath records, such as the
+    // median driving pressure by compliance decile by day. Keys are integer
+    // codes: patient and day numbers as they are, quantities quantized with
+    // quantize(). Aggregated columns are raw values, fixed::Access::raw() of
+    // a span of quantities, and are aggregated exactly.
+
+    enum class Function : std::uint8_t {
+        count   = 0,    // records of the group, the column is ignored
+        sum     = 1,
+        minimum = 2,
+        maximum = 3,
+        mean    = 4,    // exact sum over the count, truncated toward zero
+        median  = 5,    // lower median
+    };
+
+    struct Aggregation {
+        std::size_t column;
+        Function    function;
+    };
+
+    // Granularity of the runs of rows the pool participants aggregate
+    inline constexpr std::size_t CHUNK = 65536;
+
+    // Groups in increasing lexicographic order of their keys, with the
+    // aggregations of each
+    class Result {
+        public:
+            std::size_t
+            groups() const { return counts_.size(); }
+
+            // Key columns
+            std::size_t
+            width() const { return width_; }
+
+            std::size_t
+            aggregations() const { return functions_.size(); }
+
+            // Throws std::out_of_range beyond the groups
+            std::span<const std::int64_t>
+            key(std::size_t group) const;
+
+            std::uint64_t
+            count(std::size_t group) const;
+
+            // Exact raw sum of the column of an aggregation over the group,
+            // whatever its function
+            __int128
+            total(std::size_t group, std::size_t aggregation) const;
+
+            // Result of an aggregation as a quantity. Throws
+            // std::invalid_argument for a count and std::out_of_range when a
+            // sum does not fit.
+            template <Quantity T>
+            T
+            value(std::size_t group, std::size_t aggregation) const;
+
+            // Index of the group with the given key, or groups() when absent
+            std::size_t
+            find(std::span<const std::int64_t> key) const;
+        private:
+            friend Result
+            group(
+                  std::span<const std::span<const std::int64_t>>
+                , std::span<const std::span<const std::int64_t>>
+                , std::span<const Aggregation>
+                , parallel::Pool&
+                );
+
+            std::int64_t
+            raw(std::size_t group, std::size_t aggregation) const;
+
+            std::size_t                 width_ = 0;
+            std::vector<Function>       functions_;
+            std::vector<std::int64_t>   keys_;      // group-major
+            std::vector<std::uint64_t>  counts_;
+            std::vector<__int128>       sums_;      // group-major
+            std::vector<std::int64_t>   values_;    // minimum, maximum, mean or median
+    };
+
+    // Groups the rows by their codes in the key columns and aggregates the
+    // value columns over each group. Each pool participant aggregates a
+    // contiguous run of whole CHUNKs into its own hash table of partial
+    // counts, exact sums and extrema; the partials are then merged across
+    // the pool by hash partition, each partition folding them in row order.
+    // Aggregates are exact and groups sorted, so the result does not depend
+    // on the pool size. Medians gather the values of each group with a
+    // counting sort and select within each group across the pool. Throws
+    // std::invalid_argument when the columns differ in size or medians are
+    // asked of more than 2^32 - 1 rows, and std::out_of_range when an
+    // aggregation refers to a missing column.
+    Result
+    group(
+          std::span<const std::span<const std::int64_t>> keys
+        , std::span<const std::span<const std::int64_t>> columns
+        , std::span<const Aggregation> aggregations
+        , parallel::Pool& pool = parallel::shared()
+        );
+
+    // Codes floor(value / width), by raw value. Throws std::invalid_argument
+    // when the sizes differ or the width is not positive.
+    template <Quantity T>
+    void
+    quantize(std::span<const T> values, const T& width, std::span<std::int64_t> output);
+
+    // Codes counting the edges at or below each value, by raw value, so n
+    // sorted edges give codes 0 to n. Throws std::invalid_argument when the
+    // sizes differ or the edges are not sorted.
+    template <Quantity T>
+    void
+    quantize(std::span<const T> values, std::span<const T> edges, std::span<std::int64_t> output);
+
+    // The parts - 1 edges splitting the values into `parts` groups of equal
+    // size, e.g. deciles with 10 parts, for quantize(). Throws
+    // std::invalid_argument when there are no values or no parts.
+    template <Quantity T>
+    std::vector<T>
+    quantiles(std::span<const T> values, std::size_t parts);
+
+    template <Quantity T>
+    T
+    Result::value(std::size_t group, std::size_t aggregation) const {
+        return fixed::Access::make<T>(raw(group, aggregation));
+    }
+
+    template <Quantity T>
+    void
+    quantize(std::span<const T> values, const T& width, std::span<std::int64_t> output) {
+        if (values.size() != output.size()) {
+            throw std::invalid_argument("values and output sizes differ");
+        }
+        const std::int64_t w = fixed::Access::raw(width);
+        if (w <= 0) {
+            throw std::invalid_argument("width must be positive");
+        }
+        std::span<const std::int64_t> raw = fixed::Access::raw(values);
+        for (std::size_t i = 0; i < raw.size(); i++) {
+            const std::int64_t quotient = raw[i] / w;
+            output[i] = quotient - (raw[i] % w < 0 ? 1 : 0);
+        }
+    }
+
+    template <Quantity T>
+    void
+    quantize(std::span<const T> values, std::span<const T> edges, std::span<std::int64_t> output) {
+        if (values.size() != output.size()) {
+            throw std::invalid_argument("values and output sizes differ");
+        }
+        std::span<const std::int64_t> bounds = fixed::Access::raw(edges);
+        if (not std::is_sorted(bounds.begin(), bounds.end())) {
+            throw std::invalid_argument("edges must be sorted");
+        }
+        std::span<const std::int64_t> raw = fixed::Access::raw(values);
+        for (std::size_t i = 0; i < raw.size(); i++) {
+            output[i] = std::upper_bound(bounds.begin(), bounds.end(), raw[i]) - bounds.begin();
+        }
+    }
+
+    template <Quantity T>
+    std::vector<T>
+    quantiles(std::span<const T> values, std::size_t parts) {
+        if (values.empty() or parts == 0) {
+            throw std::invalid_argument("quantiles need values and parts");
+        }
+        std::span<const std::int64_t> raw = fixed::Access::raw(values);
+        std::vector<std::int64_t> sorted(raw.begin(), raw.end());
+        std::vector<T> edges;
+        auto first = sorted.begin();
+        for (std::size_t part = 1; part < parts; part++) {
+            const std::size_t rank = static_cast<std::size_t>(
+                    static_cast<unsigned __int128>(part) * sorted.size() / parts
+                    );
+            auto nth = sorted.begin() + static_cast<std::ptrdiff_t>(std::min(rank, sorted.size() - 1));
+            std::nth_element(first, nth, sorted.end());
+            edges.push_back(fixed::Access::make<T>(*nth));
+            first = nth;
+        }
+        return edges;
+    }
+} // namespace cohort
+} // namespace ventilation
+
+#endif // VENTILATION_COHORT_HPP__
@@ -0,0 +1,142 @@
+#ifndef VENTILATION_COMPARISON_HPP__
+#define VENTILATION_COMPARISON_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "ventilation/alarm.hpp"
+#include "ventilation/parallel.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace comparison {
+    // Bulk comparison of recorded waveforms against golden copies. Two
+    // samples match when their values truncated to a multiple of
+    // fixed::PRECISION, as operator== compares them, differ by at most
+    // `tolerance` such steps; a tolerance of zero is operator== itself.
+
+    // Outcome of comparing one channel against its golden copy
+    struct Report {
+        std::size_t                 actual      = 0;    // samples
+        std::size_t                 expected    = 0;
+        std::size_t                 mismatches  = 0;    // including samples only one side has
+        std::optional<std::size_t>  first;              // first mismatching sample
+        std::uint64_t               deviation   = 0;    // largest raw |actual - expected| over common samples
+
+        bool
+        matches() const { return mismatches == 0; }
+    };
+
+    // Samples compared per pool task, regardless of the pool
+    inline constexpr std::size_t CHUNK = 65536;
+
+    // One channel of a recording
+    struct Channel {
+        alarm::Signal                   signal;
+        std::span<const std::int64_t>   raw;
+
+        template <alarm::Monitored T>
+        static Channel
+        of(std::span<const T> samples);
+    };
+
+    // Compares chunk by chunk across the pool. A vectorized kernel first
+    // bounds each chunk: values within tolerance steps of raw units never
+    // truncate further apart than the tolerance, so only chunks holding a
+    // larger raw difference are compared again sample by sample.
+    Report
+    compare(
+          std::span<const std::int64_t> actual
+        , std::span<const std::int64_t> expected
+        , std::uint64_t tolerance = 0
+        , parallel::Pool& pool = parallel::shared()
+        );
+
+    template <Quantity T>
+    Report
+    compare(
+          std::span<const T> actual
+        , std::span<const T> expected
+        , std::uint64_t tolerance = 0
+        , parallel::Pool& pool = parallel::shared()
+        )
+    {
+        return compare(fixed::Access::raw(actual), fixed::Access::raw(expected), tolerance, pool);
+    }
+
+    // Compares every channel with the golden channel at the same position,
+    // the chunks of all channels spread over the pool together. Throws
+    // std::invalid_argument when the channel counts or signals differ.
+    std::vector<Report>
+    compare(
+          std::span<const Channel> actual
+        , std::span<const Channel> expected
+        , std::uint64_t tolerance = 0
+        , parallel::Pool& pool = parallel::shared()
+        );
+
+    // Golden recording mapped read-only from a file, so comparisons read it
+    // straight from the page cache. The file holds an 8-byte magic, a
+    // version and a channel count, then for every channel its signal and
+    // sample count, then the raw samples of each channel in turn, all in
+    // native byte order.
+    class Golden {
+        public:
+            // Throws std::system_error when the file cannot be opened or
+            // mapped, std::invalid_argument when it is not a golden recording
+            explicit Golden(const std::filesystem::path& path);
+
+            ~Golden();
+
+            Golden(const Golden&)               = delete;
+            Golden& operator=(const Golden&)    = delete;
+
+            Golden(Golden&& other) noexcept;
+
+            Golden&
+            operator=(Golden&& other) noexcept;
+
+            std::span<const Channel>
+            channels() const { return channels_; }
+
+            // Samples of one channel. Throws std::out_of_range beyond the
+            // channels and std::invalid_argument when T is not its signal.
+            template <alarm::Monitored T>
+            std::span<const T>
+            channel(std::size_t index) const;
+
+            // Writes the channels as a golden file. Throws std::system_error
+            // when the file cannot be written.
+            static void
+            write(const std::filesystem::path& path, std::span<const Channel> channels);
+        private:
+            void*                   data_ = nullptr;
+            std::size_t             size_ = 0;
+            std::vector<Channel>    channels_;
+    };
+
+    template <alarm::Monitored T>
+    Channel
+    Channel::of(std::span<const T> samples) {
+        return Channel{alarm::detail::signal<T>(), fixed::Access::raw(samples)};
+    }
+
+    template <alarm::Monitored T>
+    std::span<const T>
+    Golden::channel(std::size_t index) const {
+        if (index >= channels_.size()) {
+            throw std::out_of_range("no such channel");
+        }
+        if (channels_[index].signal != alarm::detail::signal<T>()) {
+            throw std::invalid_argument("channel holds another signal");
+        }
+        return fixed::Access::view<T>(channels_[index].raw);
+    }
+} // namespace comparison
+} // namespace ventilation
+
+#endif // VENTILATION_COMPARISON_HPP__
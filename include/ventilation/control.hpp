@@ -0,0 +1,347 @@
+#ifndef VENTILATION_CONTROL_HPP__
+#define VENTILATION_CONTROL_HPP__
+
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "ventilation/instrumentation.hpp"
+#include "ventilation/model.hpp"
+#include "ventilation/parallel.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace control {
+    // Closed-loop simulation of ventilator controllers against the
+    // single-compartment lung. Every step a controller reads a Sample and
+    // commands a blower pressure, which the lung integrates over one control
+    // period. Breath timing comes from model::Settings; its period is not
+    // used, the control period being given to run().
+
+    // Measurement at the start of a step
+    struct Sample {
+        float       time;       // seconds since the start of the run
+        Pressure    pressure;   // airway pressure, at the blower
+        Flow        flow;       // into the lung
+        Volume      volume;     // above the relaxation volume
+    };
+
+    // Patient and blower driven by a controller
+    struct Plant {
+        Resistance  resistance;
+        Compliance  compliance;
+        float       lag         = 0.02f;    // blower time constant, in seconds
+    };
+
+    // Blower pressure following the command as a first-order lag, driving
+    // flow through the airway resistance into the compliance. Each step holds
+    // the command and advances the state by the exact solution of the two
+    // linear stages, so the result does not depend on the control period.
+    class Lung {
+        public:
+            // Throws std::invalid_argument on non-positive resistance or
+            // compliance, or a negative lag
+            explicit Lung(const Plant& plant);
+
+            Sample
+            sample() const;
+
+            // Throws std::domain_error when the period is not finite and
+            // positive
+            void
+            step(const Pressure& command, float period);
+        private:
+            double  resistance_;    // cmH2O.s/L
+            double  compliance_;    // L/cmH2O
+            double  lag_;
+            double  blower_ = 0.0;  // cmH2O
+            double  volume_ = 0.0;  // L
+            double  time_   = 0.0;
+
+            // Decays over the last period, recomputed when it changes
+            float   period_     = 0.0f;
+            double  lung_       = 0.0;
+            double  decay_      = 0.0;
+            double  coupling_   = 0.0;  // volume per cmH2O of blower excess
+    };
+
+    // Breath phase at a time since the start of the run
+    enum class Phase : std::uint8_t {
+        inspiration = 0,
+        pause       = 1,
+        expiration  = 2,
+    };
+
+    Phase
+    phase(float time, const model::Settings& settings);
+
+    // Seconds since the start of the current breath
+    float
+    elapsed(float time, const model::Settings& settings);
+
+    // Proportional-integral-derivative law on an error, its output clamped
+    // to [low, high]. The integral only accumulates while the output is not
+    // held at a limit in the direction of the error, so it does not wind up.
+    class Pid {
+        public:
+            struct Gains {
+                float proportional;
+                float integral;
+                float derivative;
+            };
+
+            // Throws std::invalid_argument on negative gains or low > high
+            Pid(const Gains& gains, float low, float high);
+
+            float
+            update(float error, float period);
+
+            void
+            reset();
+        private:
+            Gains   gains_;
+            float   low_;
+            float   high_;
+            float   integral_   = 0.0f;
+            float   previous_   = 0.0f;
+            bool    started_    = false;
+    };
+
+    // Highest pressure any controller commands, in cmH2O
+    inline constexpr float LIMIT = 60.0f;
+
+    // Pressure control: airway pressure at `inspiratory` above PEEP through
+    // inspiration and pause, PEEP through expiration. The target is fed
+    // forward and a PID on the pressure error corrects for the blower lag.
+    class PressureControl {
+        public:
+            PressureControl(
+                  const model::Settings& settings
+                , const Pressure& inspiratory
+                , const Pressure& peep
+                , const Pid::Gains& gains = {0.2f, 5.0f, 0.0f}
+                );
+
+            Pressure
+            step(const Sample& sample, float period);
+
+            Pressure
+            target(float time) const;
+
+            // Pressure above PEEP during inspiration, which Adaptive retunes
+            void
+            inspiratory(const Pressure& pressure) { inspiratory_ = pressure; }
+
+            const Pressure&
+            inspiratory() const { return inspiratory_; }
+        private:
+            model::Settings settings_;
+            Pressure        inspiratory_;
+            Pressure        peep_;
+            Pid             pid_;
+    };
+
+    // Volume control: constant inspiratory flow delivering the tidal volume,
+    // zero flow through the pause, then PEEP through expiration. A PID on the
+    // flow error sets the command above PEEP; its integral builds up the
+    // elastic pressure, and holds it through the pause. The default gains
+    // suit blowers lagging 10 to 50 ms; with an ideal blower the
+    // proportional gain must stay below twice the resistance.
+    class VolumeControl {
+        public:
+            VolumeControl(
+                  const model::Settings& settings
+                , const Volume& tidal
+                , const Pressure& peep
+                , const Pid::Gains& gains = {40.0f, 8000.0f, 0.0f}
+                );
+
+            Pressure
+            step(const Sample& sample, float period);
+
+            // Flow target during inspiration and pause
+            Flow
+            target(float time) const;
+        private:
+            model::Settings settings_;
+            Volume          tidal_;
+            Pressure        peep_;
+            Pid             pid_;
+    };
+
+    // Adaptive pressure control toward a tidal volume, as pressure-regulated
+    // volume control: after every breath the inspiratory pressure becomes the
+    // one the compliance shown by that breath needs for the tidal volume,
+    // moving at most `slew` per breath and staying within [0, LIMIT - peep].
+    class Adaptive {
+        public:
+            Adaptive(
+                  const model::Settings& settings
+                , const Volume& tidal
+                , const Pressure& peep
+                , const Pressure& initial
+                , const Pressure& slew = Pressure(3.0f)
+                );
+
+            Pressure
+            step(const Sample& sample, float period);
+
+            // Pressure above PEEP the next inspiration will target
+            const Pressure&
+            inspiratory() const { return inner_.inspiratory(); }
+        private:
+            model::Settings settings_;
+            Volume          tidal_;
+            Pressure        peep_;
+            Pressure        slew_;
+            PressureControl inner_;
+            float           start_      = 0.0f;     // volume at the start of the breath, L
+            float           highest_    = 0.0f;     // volume reached so far in the breath, L
+            Phase           previous_   = Phase::expiration;
+            bool            started_    = false;
+    };
+
+    template <typename C>
+    concept Controller = requires(C& controller, const Sample& sample, float period) {
+        { controller.step(sample, period) } -> std::convertible_to<Pressure>;
+    };
+
+    enum class Mode : std::uint8_t {
+        realtime    = 0,    // step k released at k periods of the steady clock
+        fast        = 1,    // steps back to back, for batch validation
+    };
+
+    struct Options {
+        float                       period      = 0.001f;   // control period, in seconds
+        std::uint64_t               steps       = 0;
+        Mode                        mode        = Mode::fast;
+        std::chrono::nanoseconds    deadline    = std::chrono::nanoseconds(0);  // after release, zero for the period
+    };
+
+    // Timing of the steps of one or more runs. Latency is the time a step
+    // spends in the controller and the plant; response runs from the release
+    // of a step to its completion and is recorded in real time only, where a
+    // step completing after its deadline counts as a miss.
+    struct Timing {
+        std::uint64_t               steps   = 0;
+        std::uint64_t               misses  = 0;
+        instrumentation::Latency    latency;
+        instrumentation::Latency    response;
+
+        void
+        merge(const Timing& other);
+    };
+
+    // Extremes of what the lung received over a run
+    struct Delivery {
+        Pressure    peak;
+        Volume      highest;
+        Volume      lowest;
+        Sample      last;
+    };
+
+    namespace detail {
+        // Throws std::domain_error when the period is not finite and
+        // positive, std::invalid_argument on a negative deadline
+        std::chrono::nanoseconds
+        validate(const Options& options);
+
+        void
+        observe(Delivery& delivery, const Sample& sample);
+    } // namespace detail
+
+    // Runs the controller against the lung for options.steps steps, adding
+    // to the timing. Waveforms of the samples are appended to `record`
+    // when given.
+    template <Controller C>
+    Delivery
+    run(
+          C& controller
+        , Lung& lung
+        , const Options& options
+        , Timing& timing
+        , model::Waveforms* record = nullptr
+        )
+    {
+        using Clock = std::chrono::steady_clock;
+        const std::chrono::nanoseconds deadline = detail::validate(options);
+        const std::chrono::nanoseconds interval = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::duration<double>(options.period)
+                );
+
+        Sample sample = lung.sample();
+        Delivery delivery{sample.pressure, sample.volume, sample.volume, sample};
+        const Clock::time_point start = Clock::now();
+        for (std::uint64_t k = 0; k < options.steps; k++) {
+            const Clock::time_point release = start + interval * static_cast<std::int64_t>(k);
+            if (options.mode == Mode::realtime) {
+                std::this_thread::sleep_until(release);
+            }
+            const Clock::time_point begin = Clock::now();
+            const Pressure command = controller.step(sample, options.period);
+            lung.step(command, options.period);
+            sample = lung.sample();
+            const Clock::time_point end = Clock::now();
+
+            timing.latency.record(end - begin);
+            if (options.mode == Mode::realtime) {
+                timing.response.record(end - release);
+                if (end - release > deadline) { timing.misses++; }
+            }
+            detail::observe(delivery, sample);
+            if (record != nullptr) {
+                record->pressure.push_back(sample.pressure);
+                record->flow.push_back(sample.flow);
+                record->volume.push_back(sample.volume);
+            }
+        }
+        timing.steps += options.steps;
+        return delivery;
+    }
+
+    // Scenarios per pool task in validate()
+    inline constexpr std::size_t BLOCK = 16;
+
+    // Runs a controller made by `make(plant)` against every plant, fast, in
+    // blocks across the pool, and returns what each lung received. Each block
+    // keeps its own timing; they are merged into `timing` in block order.
+    template <typename Factory>
+        requires Controller<std::invoke_result_t<Factory&, const Plant&>>
+    std::vector<Delivery>
+    validate(
+          std::span<const Plant> plants
+        , Factory&& make
+        , const Options& options
+        , Timing& timing
+        , parallel::Pool& pool = parallel::shared()
+        )
+    {
+        Options fast = options;
+        fast.mode = Mode::fast;
+        detail::validate(fast);
+
+        std::vector<Delivery> deliveries(plants.size());
+        const std::size_t blocks = (plants.size() + BLOCK - 1) / BLOCK;
+        std::vector<Timing> timings(blocks);
+        pool.run(blocks, [&](std::size_t block) {
+            const std::size_t last = std::min(plants.size(), (block + 1) * BLOCK);
+            for (std::size_t i = block * BLOCK; i < last; i++) {
+                Lung lung(plants[i]);
+                auto controller = make(plants[i]);
+                deliveries[i] = run(controller, lung, fast, timings[block]);
+            }
+        });
+        for (const Timing& partial : timings) {
+            timing.merge(partial);
+        }
+        return deliveries;
+    }
+} // namespace control
+} // namespace ventilation
+
+#endif // VENTILATION_CONTROL_HPP__
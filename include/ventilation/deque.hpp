@@ -0,0 +1,139 @@
+#ifndef VENTILATION_DEQUE_HPP__
+#define VENTILATION_DEQUE_HPP__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace ventilation {
+namespace parallel {
+    // Lock-free work-stealing deque (Chase and Lev, with the memory orders of
+    // Le et al., PPoPP'13). The owning thread pushes and pops at the bottom,
+    // any other thread steals from the top, so the owner works on its most
+    // recent items while thieves take the oldest. Grows without bound;
+    // replaced buffers are kept until destruction, since a thief may still be
+    // reading one.
+    template <typename T>
+    class Deque {
+        static_assert(std::is_trivially_copyable_v<T>);
+        public:
+            // Capacity must be a power of two
+            explicit Deque(std::size_t capacity = 64) {
+                if (capacity == 0 or (capacity & (capacity - 1)) != 0) {
+                    throw std::invalid_argument("capacity must be a power of two");
+                }
+                buffers_.push_back(std::make_unique<Buffer>(capacity));
+                buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+            }
+
+            Deque(const Deque&)             = delete;
+            Deque& operator=(const Deque&)  = delete;
+
+            // Owner only
+            void
+            push(T item) {
+                std::int64_t b  = bottom_.load(std::memory_order_relaxed);
+                std::int64_t t  = top_.load(std::memory_order_acquire);
+                Buffer* buffer  = buffer_.load(std::memory_order_relaxed);
+                if (b - t > static_cast<std::int64_t>(buffer->mask)) {
+                    buffer = grow(buffer, t, b);
+                }
+                buffer->at(b).store(item, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                bottom_.store(b + 1, std::memory_order_relaxed);
+            }
+
+            // Owner only, most recently pushed item first
+            std::optional<T>
+            pop() {
+                std::int64_t b  = bottom_.load(std::memory_order_relaxed) - 1;
+                Buffer* buffer  = buffer_.load(std::memory_order_relaxed);
+                bottom_.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                std::int64_t t  = top_.load(std::memory_order_relaxed);
+
+                if (t > b) {
+                    bottom_.store(b + 1, std::memory_order_relaxed);
+                    return std::nullopt;
+                }
+                T item = buffer->at(b).load(std::memory_order_relaxed);
+                if (t == b) {
+                    // Last item, race any thief for it
+                    bool won = top_.compare_exchange_strong(
+                              t
+                            , t + 1
+                            , std::memory_order_seq_cst
+                            , std::memory_order_relaxed
+                            );
+                    bottom_.store(b + 1, std::memory_order_relaxed);
+                    if (not won) { return std::nullopt; }
+                }
+                return item;
+            }
+
+            // Any thread, oldest item first. Also empty when another thread
+            // won the race for the item.
+            std::optional<T>
+            steal() {
+                std::int64_t t = top_.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                std::int64_t b = bottom_.load(std::memory_order_acquire);
+
+                if (t >= b) { return std::nullopt; }
+                Buffer* buffer  = buffer_.load(std::memory_order_acquire);
+                T item          = buffer->at(t).load(std::memory_order_relaxed);
+                if (not top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    return std::nullopt;
+                }
+                return item;
+            }
+
+            // A snapshot, exact only when no other thread is using the deque
+            std::size_t
+            size() const {
+                std::int64_t b = bottom_.load(std::memory_order_relaxed);
+                std::int64_t t = top_.load(std::memory_order_relaxed);
+                return b > t ? static_cast<std::size_t>(b - t) : 0;
+            }
+
+            bool
+            empty() const { return size() == 0; }
+        private:
+            struct Buffer {
+                explicit Buffer(std::size_t capacity)
+                    : mask(capacity - 1)
+                    , items(std::make_unique<std::atomic<T>[]>(capacity))
+                {}
+
+                std::atomic<T>&
+                at(std::int64_t i) { return items[static_cast<std::size_t>(i) & mask]; }
+
+                std::size_t                         mask;
+                std::unique_ptr<std::atomic<T>[]>   items;
+            };
+
+            Buffer*
+            grow(Buffer* buffer, std::int64_t t, std::int64_t b) {
+                auto larger = std::make_unique<Buffer>(2 * (buffer->mask + 1));
+                for (std::int64_t i = t; i < b; i++) {
+                    larger->at(i).store(buffer->at(i).load(std::memory_order_relaxed), std::memory_order_relaxed);
+                }
+                buffers_.push_back(std::move(larger));
+                buffer_.store(buffers_.back().get(), std::memory_order_release);
+                return buffers_.back().get();
+            }
+
+            alignas(64) std::atomic<std::int64_t>   top_    = 0;
+            alignas(64) std::atomic<std::int64_t>   bottom_ = 0;
+            std::atomic<Buffer*>                    buffer_;
+            std::vector<std::unique_ptr<Buffer>>    buffers_;
+    };
+} // namespace parallel
+} // namespace ventilation
+
+#endif // VENTILATION_DEQUE_HPP__
@@ -0,0 +1,122 @@
+#ifndef VENTILATION_EXPIRATION_HPP__
+#define VENTILATION_EXPIRATION_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include "ventilation/parallel.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace expiration {
+    // Passive exhalation is a single exponential: flow decays as
+    // exp(-t / tau), tau = resistance * compliance, towards the relaxation
+    // volume. Its logarithm is linear in time, so tau comes from a least
+    // squares line through (t, ln -flow), and once tau is known every sample
+    // gives the relaxation volume as volume + tau * flow. Whatever remains
+    // above it when the next breath starts is trapped, and holds the alveoli
+    // at an intrinsic PEEP of trapped volume over compliance.
+
+    // Samples of an expiration that enter the fit
+    struct Window {
+        float   delay   = 0.1f;         // seconds skipped after cycling, while the valve opens
+        Flow    floor   = Flow(0.02f);  // smallest expiratory flow fitted, below it noise dominates the logarithm
+    };
+
+    // Mechanics of one exhalation. With fewer than three fitted samples, or
+    // flow that does not decay, tau and everything derived from it is zero.
+    struct Estimate {
+        float           tau;            // expiratory time constant, in seconds
+        Resistance      resistance;     // tau over compliance
+        Volume          trapped;        // volume above relaxation at the end of expiration
+        Pressure        intrinsic;      // auto-PEEP, trapped volume over compliance
+        Flow            end;            // flow at the end of expiration
+        std::uint32_t   samples;        // samples fitted
+    };
+
+namespace detail {
+    // Running sums of the fit, updated once per expiratory sample. Time is
+    // the sample index, so its sums are exact integers.
+    struct Sums {
+        std::uint64_t   index   = 0;    // expiratory samples so far
+        std::uint64_t   count   = 0;    // fitted samples
+        std::uint64_t   time    = 0;
+        __int128        squares = 0;
+        double          log     = 0.0;
+        double          product = 0.0;
+        __int128        volume  = 0;
+        __int128        flow    = 0;
+        std::int64_t    last    = 0;    // volume of the latest sample
+        std::int64_t    end     = 0;    // flow of the latest sample
+
+        void
+        push(std::int64_t flow, std::int64_t volume, std::uint64_t delay, std::int64_t floor);
+
+        Estimate
+        finish(double period, float compliance) const;
+    };
+} // namespace detail
+
+    // Fits every exhalation of a stream as its samples arrive, keeping only
+    // the sums of the fit. Expiration runs from the first sample without
+    // positive flow to the next inspiratory onset, where its estimate is
+    // complete.
+    class Estimator {
+        public:
+            // Throws std::domain_error when the period is not finite and
+            // positive, std::invalid_argument when the compliance is not
+            // positive or the window is negative
+            Estimator(float period, const Compliance& compliance, const Window& window = Window());
+
+            // The estimate of the exhalation this sample ends, if it is an
+            // inspiratory onset following one
+            std::optional<Estimate>
+            push(const Flow& flow, const Volume& volume);
+
+            // Estimate of the exhalation in progress, from its samples so far
+            Estimate
+            current() const;
+        private:
+            double          period_;
+            float           compliance_;
+            std::uint64_t   delay_;
+            std::int64_t    floor_;
+
+            bool            positive_       = false;
+            bool            expiration_     = false;
+            detail::Sums    sums_;
+    };
+
+    // Fits the exhalation of one breath, the samples from the first one
+    // without positive flow onwards. Throws std::invalid_argument when the
+    // sizes differ, and as Estimator does on its other arguments.
+    Estimate
+    fit(
+          std::span<const Flow> flow
+        , std::span<const Volume> volume
+        , float period
+        , const Compliance& compliance
+        , const Window& window = Window()
+        );
+
+    // Fits consecutive breaths of the same recording, breath i spanning
+    // samples [boundaries[i], boundaries[i + 1]). Breaths are spread over the
+    // pool; each result is the same as fit() on that breath alone. Throws as
+    // mechanics::detail::validate() does for boundaries that are not
+    // consecutive non-empty breaths.
+    void
+    fit(
+          std::span<const Flow> flow
+        , std::span<const Volume> volume
+        , std::span<const std::size_t> boundaries
+        , float period
+        , const Compliance& compliance
+        , std::span<Estimate> output
+        , const Window& window = Window()
+        , parallel::Pool& pool = parallel::shared()
+        );
+} // namespace expiration
+} // namespace ventilation
+
+#endif // VENTILATION_EXPIRATION_HPP__
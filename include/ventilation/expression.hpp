@@ -0,0 +1,275 @@
+#ifndef VENTILATION_EXPRESSION_HPP__
+#define VENTILATION_EXPRESSION_HPP__
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include "ventilation/instrumentation.hpp"
+#include "ventilation/span.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace expression {
+    // Lazy element-wise arithmetic over spans of quantities. Building an
+    // expression records the operands only; assign() evaluates the whole
+    // tree in one loop, with no temporary per operator. Each element is
+    // computed with exactly the fixed-point steps of the scalar operators.
+
+    template <typename E>
+    concept Node = requires(const E& e, std::size_t i) {
+        typename E::quantity;
+        { E::sized } -> std::convertible_to<bool>;
+        { e[i] } -> std::same_as<std::int64_t>;
+    };
+
+    template <typename E>
+    concept Additive = Node<E> and requires(const typename E::quantity& x) { x + x; x - x; -x; };
+
+    template <Quantity T>
+    class Terminal {
+        public:
+            using quantity = T;
+            static constexpr bool sized = true;
+
+            explicit Terminal(std::span<const T> values) : values_(fixed::Access::raw(values)) {}
+
+            std::size_t
+            size() const { return values_.size(); }
+
+            std::int64_t
+            operator[](std::size_t i) const { return values_[i]; }
+        private:
+            std::span<const std::int64_t> values_;
+    };
+
+    // Elements of a QuantitySpan, decoded as the loop reaches them
+    template <View V>
+    class Decoded {
+        public:
+            using quantity = typename V::quantity;
+            static constexpr bool sized = true;
+
+            explicit Decoded(const V& view) : view_(view) {}
+
+            std::size_t
+            size() const { return view_.size(); }
+
+            std::int64_t
+            operator[](std::size_t i) const { return view_.raw(i); }
+        private:
+            V view_;
+    };
+
+    // A single quantity broadcast against every element
+    template <Quantity T>
+    class Constant {
+        public:
+            using quantity = T;
+            static constexpr bool sized = false;
+
+            explicit Constant(const T& value) : value_(fixed::Access::raw(value)) {}
+
+            std::size_t
+            size() const { return 0; }
+
+            std::int64_t
+            operator[](std::size_t) const { return value_; }
+        private:
+            std::int64_t value_;
+    };
+
+    template <Node L, Node R>
+    std::size_t
+    extent(const L& lhs, const R& rhs) {
+        if constexpr (L::sized and R::sized) {
+            if (lhs.size() != rhs.size()) {
+                throw std::invalid_argument("operands must have the same size");
+            }
+        }
+        return L::sized ? lhs.size() : rhs.size();
+    }
+
+    template <Node L, Node R>
+    class Sum {
+        public:
+            using quantity = typename L::quantity;
+            static constexpr bool sized = L::sized or R::sized;
+
+            Sum(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs), size_(extent(lhs, rhs)) {}
+
+            std::size_t
+            size() const { return size_; }
+
+            std::int64_t
+            operator[](std::size_t i) const {
+                return static_cast<std::int64_t>(
+                        static_cast<std::uint64_t>(lhs_[i]) + static_cast<std::uint64_t>(rhs_[i])
+                        );
+            }
+        private:
+            L           lhs_;
+            R           rhs_;
+            std::size_t size_;
+    };
+
+    template <Node L, Node R>
+    class Difference {
+        public:
+            using quantity = typename L::quantity;
+            static constexpr bool sized = L::sized or R::sized;
+
+            Difference(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs), size_(extent(lhs, rhs)) {}
+
+            std::size_t
+            size() const { return size_; }
+
+            std::int64_t
+            operator[](std::size_t i) const {
+                return static_cast<std::int64_t>(
+                        static_cast<std::uint64_t>(lhs_[i]) - static_cast<std::uint64_t>(rhs_[i])
+                        );
+            }
+        private:
+            L           lhs_;
+            R           rhs_;
+            std::size_t size_;
+    };
+
+    template <Node E>
+    class Negation {
+        public:
+            using quantity = typename E::quantity;
+            static constexpr bool sized = E::sized;
+
+            explicit Negation(const E& operand) : operand_(operand) {}
+
+            std::size_t
+            size() const { return operand_.size(); }
+
+            std::int64_t
+            operator[](std::size_t i) const {
+                return static_cast<std::int64_t>(0 - static_cast<std::uint64_t>(operand_[i]));
+            }
+        private:
+            E operand_;
+    };
+
+    template <Node E>
+    class Product {
+        public:
+            using quantity = typename E::quantity;
+            static constexpr bool sized = E::sized;
+
+            // The scalar is converted once, as operator* does for each call
+            Product(const E& operand, float scalar) : operand_(operand) {
+                if (not std::isfinite(scalar)) {
+                    instrumentation::increment(instrumentation::Counter::domain);
+                    throw std::domain_error("scalar value must be finite");
+                }
+                converted_ = static_cast<std::int64_t>(scalar * FORWARD);
+            }
+
+            std::size_t
+            size() const { return operand_.size(); }
+
+            std::int64_t
+            operator[](std::size_t i) const {
+                std::int64_t product = static_cast<std::int64_t>(
+                        static_cast<std::uint64_t>(operand_[i]) * static_cast<std::uint64_t>(converted_)
+                        );
+                return product / FORWARD;
+            }
+        private:
+            static constexpr std::int64_t FORWARD = static_cast<std::int64_t>(fixed::FORWARD);
+
+            E               operand_;
+            std::int64_t    converted_;
+    };
+
+    template <Additive L, Additive R>
+    requires std::same_as<typename L::quantity, typename R::quantity>
+    Sum<L, R>
+    operator+(const L& lhs, const R& rhs) { return Sum<L, R>(lhs, rhs); }
+
+    template <Additive L>
+    Sum<L, Constant<typename L::quantity>>
+    operator+(const L& lhs, const typename L::quantity& rhs) {
+        return Sum<L, Constant<typename L::quantity>>(lhs, Constant<typename L::quantity>(rhs));
+    }
+
+    template <Additive R>
+    Sum<Constant<typename R::quantity>, R>
+    operator+(const typename R::quantity& lhs, const R& rhs) {
+        return Sum<Constant<typename R::quantity>, R>(Constant<typename R::quantity>(lhs), rhs);
+    }
+
+    template <Additive L, Additive R>
+    requires std::same_as<typename L::quantity, typename R::quantity>
+    Difference<L, R>
+    operator-(const L& lhs, const R& rhs) { return Difference<L, R>(lhs, rhs); }
+
+    template <Additive L>
+    Difference<L, Constant<typename L::quantity>>
+    operator-(const L& lhs, const typename L::quantity& rhs) {
+        return Difference<L, Constant<typename L::quantity>>(lhs, Constant<typename L::quantity>(rhs));
+    }
+
+    template <Additive R>
+    Difference<Constant<typename R::quantity>, R>
+    operator-(const typename R::quantity& lhs, const R& rhs) {
+        return Difference<Constant<typename R::quantity>, R>(Constant<typename R::quantity>(lhs), rhs);
+    }
+
+    template <Additive E>
+    Negation<E>
+    operator-(const E& operand) { return Negation<E>(operand); }
+
+    template <Node E>
+    Product<E>
+    operator*(const E& operand, float scalar) { return Product<E>(operand, scalar); }
+
+    template <Node E>
+    Product<E>
+    operator*(float scalar, const E& operand) { return Product<E>(operand, scalar); }
+} // namespace expression
+
+    // Starts an expression over existing values, which must outlive it
+    template <std::ranges::contiguous_range R>
+    requires Quantity<std::ranges::range_value_t<R>>
+    expression::Terminal<std::ranges::range_value_t<R>>
+    lazy(const R& values) {
+        using T = std::ranges::range_value_t<R>;
+        return expression::Terminal<T>(std::span<const T>(std::ranges::data(values), std::ranges::size(values)));
+    }
+
+    template <View V>
+    expression::Decoded<V>
+    lazy(const V& view) {
+        return expression::Decoded<V>(view);
+    }
+
+    // Evaluates an expression into output in a single pass
+    template <std::ranges::contiguous_range R, expression::Node E>
+    requires std::same_as<std::ranges::range_value_t<R>, typename E::quantity>
+    void
+    assign(R&& values, const E& e) {
+        using T = std::ranges::range_value_t<R>;
+        std::span<T> output(std::ranges::data(values), std::ranges::size(values));
+
+        if (not E::sized) {
+            throw std::invalid_argument("expression has no span operand");
+        }
+        if (output.size() != e.size()) {
+            throw std::invalid_argument("output and expression must have the same size");
+        }
+        std::span<std::int64_t> raw = fixed::Access::raw(output);
+        for (std::size_t i = 0; i < raw.size(); i++) {
+            raw[i] = e[i];
+        }
+    }
+} // namespace ventilation
+
+#endif // VENTILATION_EXPRESSION_HPP__
@@ -0,0 +1,48 @@
+#ifndef VENTILATION_FFT_HPP__
+#define VENTILATION_FFT_HPP__
+
+#include <complex>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace ventilation {
+namespace fft {
+    using Complex = std::complex<double>;
+
+    // Discrete Fourier transform of one size, X[k] = sum x[n] exp(-2 pi i k n / N),
+    // by mixed-radix decimation in time. The size is split into factors of 4,
+    // 2 and then odd primes; 4 and 2 have dedicated butterflies, any other
+    // prime a direct one, so every size works and sizes with small factors
+    // run in O(N log N). Twiddles are computed once per plan, and a plan can
+    // be shared by threads.
+    class Plan {
+        public:
+            // Throws std::invalid_argument on size zero
+            explicit Plan(std::size_t size);
+
+            std::size_t
+            size() const { return size_; }
+
+            // Input and output must have the plan size and must not overlap
+            void
+            forward(std::span<const Complex> input, std::span<Complex> output) const;
+
+            // Inverse transform, scaled by 1 / N so it undoes forward()
+            void
+            inverse(std::span<const Complex> input, std::span<Complex> output) const;
+        private:
+            void
+            transform(const Complex* input, Complex* output, std::size_t stride, std::size_t factor) const;
+
+            void
+            butterfly(Complex* output, std::size_t stride, std::size_t radix, std::size_t m) const;
+
+            std::size_t                 size_;
+            std::vector<std::size_t>    factors_;   // radix of each stage, outermost first
+            std::vector<Complex>        twiddles_;  // exp(-2 pi i k / N)
+    };
+} // namespace fft
+} // namespace ventilation
+
+#endif // VENTILATION_FFT_HPP__
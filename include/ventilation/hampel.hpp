@@ -0,0 +1,261 @@
+#ifndef VENTILATION_HAMPEL_HPP__
+#define VENTILATION_HAMPEL_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "ventilation/parallel.hpp"
+#include "ventilation/tracing.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace hampel {
+    // The latest `capacity` raw values in order, kept in an indexable skip
+    // list: each link also records how many values it skips, so the value
+    // of any rank is found in O(log w) expected steps, as is the insertion
+    // of a new value and the removal of the oldest one it replaces.
+    class Window {
+        public:
+            // Throws std::invalid_argument when the capacity is zero
+            explicit Window(std::size_t capacity);
+
+            // Evicts the oldest value once full
+            void
+            push(std::int64_t value);
+
+            void
+            clear();
+
+            std::size_t
+            size() const { return size_; }
+
+            std::size_t
+            capacity() const { return ring_.size(); }
+
+            // Value of rank `rank` in increasing order, throws
+            // std::out_of_range beyond the size
+            std::int64_t
+            select(std::size_t rank) const;
+
+            // Value pushed `age` pushes ago, zero being the latest, throws
+            // std::out_of_range beyond the size
+            std::int64_t
+            back(std::size_t age) const;
+
+            // Values within [lower, upper], zero when lower > upper
+            std::size_t
+            count(std::int64_t lower, std::int64_t upper) const;
+
+            // Lower median, the window must not be empty
+            std::int64_t
+            median() const;
+
+            // Lower median of the distances to the median. The distances
+            // below and above the median form two sorted runs, read through
+            // select(), so their median takes O(log w) selections.
+            std::int64_t
+            deviation() const;
+        private:
+            static constexpr std::uint32_t HEAD = 0;
+            static constexpr std::uint32_t TAIL = 1;
+
+            bool
+            before(std::uint32_t lhs, std::uint32_t rhs) const;
+
+            // Values below `value`
+            std::size_t
+            rank(std::int64_t value) const;
+
+            void
+            insert(std::uint32_t node);
+
+            void
+            erase(std::uint32_t node);
+
+            std::uint32_t&
+            next(std::uint32_t node, std::size_t level) { return next_[node * levels_ + level]; }
+
+            std::uint32_t
+            next(std::uint32_t node, std::size_t level) const { return next_[node * levels_ + level]; }
+
+            std::uint32_t&
+            width(std::uint32_t node, std::size_t level) { return width_[node * levels_ + level]; }
+
+            std::uint32_t
+            width(std::uint32_t node, std::size_t level) const { return width_[node * levels_ + level]; }
+
+            std::size_t                 levels_;
+            std::vector<std::int64_t>   values_;        // per node, head and tail first
+            std::vector<std::uint64_t>  sequence_;      // per node, breaks ties in push order
+            std::vector<std::uint32_t>  next_;          // node * levels + level
+            std::vector<std::uint32_t>  width_;
+            std::vector<std::uint32_t>  ring_;          // nodes in push order
+            std::size_t                 position_   = 0;    // ring slot of the next push
+            std::size_t                 size_       = 0;
+            std::uint64_t               pushed_     = 0;
+            std::uint64_t               random_     = 0x9e3779b97f4a7c15ull;
+    };
+
+    // Hampel filter over a centered window of 2 * half + 1 samples: a sample
+    // further than threshold * 1.4826 * MAD from the median of its window is
+    // an artifact and replaced by that median. The factor makes the median
+    // absolute deviation estimate the standard deviation of normal noise.
+    // Output lags input by `half` samples. The first and last `half`
+    // samples have no full window and pass unchanged.
+    //
+    // The MAD itself is never formed: with k the largest integer such that
+    // threshold * 1.4826 * k < |x - median|, the sample is replaced exactly
+    // when MAD <= k, that is when at least half the window lies within k of
+    // the median, which takes two rank queries.
+    template <Quantity T>
+    class Filter {
+        public:
+            // Throws std::invalid_argument when half is zero or the threshold
+            // is not finite and non-negative
+            Filter(std::size_t half, float threshold = 3.0f)
+                : half_(half)
+                , window_(2 * half + 1)
+            {
+                if (half == 0) {
+                    throw std::invalid_argument("half window must be positive");
+                }
+                if (not std::isfinite(threshold) or not (threshold >= 0.0f)) {
+                    throw std::invalid_argument("threshold must be finite and non-negative");
+                }
+                threshold_ = static_cast<double>(threshold) * 1.4826;
+            }
+
+            // The sample pushed `half` pushes ago, filtered, once there is one
+            std::optional<T>
+            push(const T& value) {
+                window_.push(fixed::Access::raw(value));
+                if (++pushed_ <= half_) { return std::nullopt; }
+
+                const std::int64_t center = window_.back(half_);
+                if (window_.size() < window_.capacity()) {
+                    return fixed::Access::make<T>(center);
+                }
+                const std::int64_t median = window_.median();
+                const std::int64_t bound  = within(center, median);
+                if (bound >= 0 and (bound == UNBOUNDED or window_.count(lower(median, bound), upper(median, bound)) > half_)) {
+                    replaced_++;
+                    return fixed::Access::make<T>(median);
+                }
+                return fixed::Access::make<T>(center);
+            }
+
+            // Appends the samples still held back, unchanged, and starts over
+            void
+            flush(std::vector<T>& output) {
+                const std::size_t held = static_cast<std::size_t>(std::min<std::uint64_t>(half_, pushed_));
+                for (std::size_t age = held; age-- > 0;) {
+                    output.push_back(fixed::Access::make<T>(window_.back(age)));
+                }
+                window_.clear();
+                pushed_ = 0;
+            }
+
+            // Samples replaced so far
+            std::uint64_t
+            replaced() const { return replaced_; }
+        private:
+            static constexpr std::int64_t UNBOUNDED = std::numeric_limits<std::int64_t>::max();
+
+            // Largest k with threshold * k < |center - median|, -1 if none and
+            // UNBOUNDED when every k qualifies or k does not fit
+            std::int64_t
+            within(std::int64_t center, std::int64_t median) const {
+                const double distance = std::abs(static_cast<double>(center) - static_cast<double>(median));
+                if (not (distance > 0.0)) { return -1; }
+                const double limit = distance / threshold_;
+                if (not (limit < 4.0e18)) { return UNBOUNDED; }
+
+                std::int64_t k = static_cast<std::int64_t>(std::ceil(limit)) - 1;
+                while (threshold_ * static_cast<double>(k + 1) < distance) { k++; }
+                while (k >= 0 and not (threshold_ * static_cast<double>(k) < distance)) { k--; }
+                return k;
+            }
+
+            static std::int64_t
+            lower(std::int64_t median, std::int64_t bound) {
+                return median < std::numeric_limits<std::int64_t>::min() + bound ? std::numeric_limits<std::int64_t>::min() : median - bound;
+            }
+
+            static std::int64_t
+            upper(std::int64_t median, std::int64_t bound) {
+                return median > std::numeric_limits<std::int64_t>::max() - bound ? std::numeric_limits<std::int64_t>::max() : median + bound;
+            }
+
+            std::size_t     half_;
+            double          threshold_;
+            Window          window_;
+            std::uint64_t   pushed_     = 0;
+            std::uint64_t   replaced_   = 0;
+    };
+
+    // Filters a whole channel, output[i] being the filtered input[i].
+    // Returns how many samples were replaced.
+    template <Quantity T>
+    std::uint64_t
+    filter(std::span<const T> input, std::span<T> output, std::size_t half, float threshold = 3.0f) {
+        if (input.size() != output.size()) {
+            throw std::invalid_argument("input and output sizes differ");
+        }
+        VENTILATION_TRACE("hampel::filter");
+        Filter<T> filter(half, threshold);
+        std::size_t written = 0;
+        for (const T& value : input) {
+            if (std::optional<T> result = filter.push(value)) {
+                output[written++] = *result;
+            }
+        }
+        std::vector<T> rest;
+        filter.flush(rest);
+        for (const T& value : rest) {
+            output[written++] = value;
+        }
+        return filter.replaced();
+    }
+
+    // Filters many channels, one pool task per channel. Returns how many
+    // samples were replaced over all of them.
+    template <Quantity T>
+    std::uint64_t
+    filter(
+          std::span<const std::span<const T>> inputs
+        , std::span<const std::span<T>> outputs
+        , std::size_t half
+        , float threshold = 3.0f
+        , parallel::Pool& pool = parallel::shared()
+        )
+    {
+        if (inputs.size() != outputs.size()) {
+            throw std::invalid_argument("input and output channel counts differ");
+        }
+        for (std::size_t c = 0; c < inputs.size(); c++) {
+            if (inputs[c].size() != outputs[c].size()) {
+                throw std::invalid_argument("input and output sizes differ");
+            }
+        }
+        Filter<T> validated(half, threshold);
+
+        std::vector<std::uint64_t> replaced(inputs.size(), 0);
+        pool.run(inputs.size(), [&](std::size_t c) {
+            replaced[c] = filter(inputs[c], outputs[c], half, threshold);
+        });
+        std::uint64_t total = 0;
+        for (std::uint64_t count : replaced) {
+            total += count;
+        }
+        return total;
+    }
+} // namespace hampel
+} // namespace ventilation
+
+#endif // VENTILATION_HAMPEL_HPP__
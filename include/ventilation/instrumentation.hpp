@@ -0,0 +1,144 @@
+#ifndef VENTILATION_INSTRUMENTATION_HPP__
+#define VENTILATION_INSTRUMENTATION_HPP__
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <vector>
+
+namespace ventilation {
+namespace instrumentation {
+    // Events counted on the hot path. Counting is compiled in only when the
+    // library is built with VENTILATION_INSTRUMENTATION (meson option
+    // `instrumentation`); otherwise increment() is an empty inline function.
+    enum class Counter : std::size_t {
+        domain      = 0,    // non-finite value rejected by a constructor or scaling
+        overflow    = 1,    // int64 overflow of the scaling product in operator*
+        range       = 2,    // value rejected by a checked policy conversion
+        saturation  = 3,    // result clamped by saturating arithmetic
+    };
+
+    inline constexpr std::size_t COUNTERS = 4;
+
+#if defined(VENTILATION_INSTRUMENTATION)
+    inline constexpr bool ENABLED = true;
+
+    void
+    increment(Counter counter, std::uint64_t count = 1);
+#else
+    inline constexpr bool ENABLED = false;
+
+    inline void
+    increment(Counter, std::uint64_t = 1) {}
+#endif
+
+    // Totals over every thread, including threads that have already exited
+    struct Snapshot {
+        std::array<std::uint64_t, COUNTERS> values = {};
+
+        std::uint64_t
+        operator[](Counter counter) const { return values[static_cast<std::size_t>(counter)]; }
+    };
+
+    Snapshot
+    snapshot();
+
+    // Subsequent snapshots count from the current totals
+    void
+    reset();
+
+    const char*
+    name(Counter counter);
+
+    // Prometheus text exposition format, one counter per metric
+    void
+    prometheus(std::ostream& os, const Snapshot& snapshot);
+
+    // Single JSON object keyed by counter name
+    void
+    json(std::ostream& os, const Snapshot& snapshot);
+
+    // Latencies in nanoseconds over log-linear buckets, as in HdrHistogram:
+    // values below 2^SIGNIFICANT have a bucket each, and every higher power
+    // of two is split into 2^(SIGNIFICANT - 1) equal buckets, so a value is
+    // known to within 1/64 of itself across the whole 64-bit range.
+    // Recording is an index computation and an increment; histograms of
+    // separate threads or runs are combined with merge().
+    class Latency {
+        public:
+            static constexpr unsigned       SIGNIFICANT = 7;
+            static constexpr std::size_t    HALF        = std::size_t{1} << (SIGNIFICANT - 1);
+            static constexpr std::size_t    BUCKETS     = (66 - SIGNIFICANT) * HALF;
+
+            Latency() : counts_(BUCKETS, 0) {}
+
+            void
+            record(std::uint64_t nanoseconds) {
+                counts_[index(nanoseconds)]++;
+                count_++;
+                sum_        += nanoseconds;
+                minimum_    = nanoseconds < minimum_ ? nanoseconds : minimum_;
+                maximum_    = nanoseconds > maximum_ ? nanoseconds : maximum_;
+            }
+
+            void
+            record(std::chrono::nanoseconds duration) {
+                record(static_cast<std::uint64_t>(duration.count() < 0 ? 0 : duration.count()));
+            }
+
+            void
+            merge(const Latency& other);
+
+            void
+            reset();
+
+            std::uint64_t
+            count() const { return count_; }
+
+            // Zero when empty
+            std::uint64_t
+            minimum() const { return count_ == 0 ? 0 : minimum_; }
+
+            std::uint64_t
+            maximum() const { return maximum_; }
+
+            double
+            mean() const;
+
+            // Largest value of the bucket holding the value of rank
+            // ceil(q * count), at most maximum(); zero when empty. Throws
+            // std::invalid_argument unless q is within [0, 1].
+            std::uint64_t
+            quantile(double q) const;
+
+            std::span<const std::uint64_t>
+            counts() const { return counts_; }
+
+            static std::size_t
+            index(std::uint64_t value) {
+                if (value < 2 * HALF) { return static_cast<std::size_t>(value); }
+                const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - SIGNIFICANT;
+                return shift * HALF + static_cast<std::size_t>(value >> shift);
+            }
+
+            // Smallest and largest values of a bucket
+            static std::uint64_t
+            lower(std::size_t index);
+
+            static std::uint64_t
+            upper(std::size_t index);
+        private:
+            std::vector<std::uint64_t>  counts_;
+            std::uint64_t               count_      = 0;
+            unsigned __int128           sum_        = 0;
+            std::uint64_t               minimum_    = UINT64_MAX;
+            std::uint64_t               maximum_    = 0;
+    };
+} // namespace instrumentation
+} // namespace ventilation
+
+#endif // VENTILATION_INSTRUMENTATION_HPP__
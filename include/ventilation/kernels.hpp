@@ -0,0 +1,127 @@
+#ifndef VENTILATION_KERNELS_HPP__
+#define VENTILATION_KERNELS_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace ventilation {
+namespace kernels {
+    // Bulk operations on the raw fixed-point representation. Every entry has
+    // the same semantics as the corresponding scalar operator, and every
+    // variant must produce bit-identical results to the scalar reference.
+    struct Table {
+        const char* name;
+
+        bool
+        (*finite)(const float* input, std::size_t size);
+
+        void
+        (*forward)(const float* input, std::int64_t* output, std::size_t size);
+
+        void
+        (*inverse)(const std::int64_t* input, float* output, std::size_t size);
+
+        void
+        (*scale)(const std::int64_t* input, std::int64_t factor, std::int64_t* output, std::size_t size);
+
+        void
+        (*compare)(const std::int64_t* lhs, const std::int64_t* rhs, std::int8_t* output, std::size_t size);
+
+        std::int64_t
+        (*sum)(const std::int64_t* input, std::size_t size);
+
+        void
+        (*motion)(
+              const std::int64_t* flow
+            , const std::int64_t* volume
+            , std::int64_t resistance
+            , std::int64_t elastance
+            , std::int64_t peep
+            , std::int64_t* output
+            , std::size_t size
+            );
+
+        // Saturating variants return how many results were clamped
+        std::size_t
+        (*saturating_add)(const std::int64_t* lhs, const std::int64_t* rhs, std::int64_t* output, std::size_t size);
+
+        std::size_t
+        (*saturating_subtract)(const std::int64_t* lhs, const std::int64_t* rhs, std::int64_t* output, std::size_t size);
+
+        std::size_t
+        (*saturating_scale)(const std::int64_t* input, std::int64_t factor, std::int64_t* output, std::size_t size);
+
+        // Exact sum, split as high * 2^32 + low so both halves accumulate in
+        // 64-bit lanes. Exact for sizes below 2^32.
+        void
+        (*total)(const std::int64_t* input, std::size_t size, std::int64_t* high, std::uint64_t* low);
+
+        // Smallest and largest raw values, size must be positive
+        void
+        (*extrema)(const std::int64_t* input, std::size_t size, std::int64_t* minimum, std::int64_t* maximum);
+
+        // Exact sum of lhs[i] * rhs[i], before any rescaling
+        __int128
+        (*dot)(const std::int64_t* lhs, const std::int64_t* rhs, std::size_t size);
+
+        // One step of a debounced threshold alarm per element. The condition
+        // low[i] <= value[i] <= high[i] must hold for `debounce` consecutive
+        // steps to activate; a latching alarm then stays active. Bit 0 of
+        // state[i] is the alarm, bit 1 is set when this step changed it.
+        // Returns how many alarms changed.
+        std::size_t
+        (*debounce)(
+              const std::int64_t* value
+            , const std::int64_t* low
+            , const std::int64_t* high
+            , std::uint32_t debounce
+            , bool latching
+            , std::uint32_t* count
+            , std::uint8_t* state
+            , std::size_t size
+            );
+
+        // Piecewise-linear lookup over `segments` uniform segments of 2^shift
+        // counts starting at `base`, through knots[0] ... knots[segments],
+        // with shift below 32. Counts outside the table clamp to its ends.
+        // Each result is rounded toward negative infinity.
+        void
+        (*interpolate)(
+              const std::int32_t* counts
+            , std::int32_t base
+            , std::uint32_t shift
+            , std::uint32_t segments
+            , const std::int64_t* knots
+            , std::int64_t* output
+            , std::size_t size
+            );
+
+        // Elements with |lhs[i] - rhs[i]| > threshold, the difference taken
+        // exactly as an unsigned magnitude; the largest magnitude of all is
+        // stored in `maximum`
+        std::size_t
+        (*deviation)(
+              const std::int64_t* lhs
+            , const std::int64_t* rhs
+            , std::uint64_t threshold
+            , std::uint64_t* maximum
+            , std::size_t size
+            );
+    };
+
+    // Plain scalar loops, the definition every other variant is checked against.
+    const Table&
+    reference();
+
+    // Best variant supported by the running CPU, selected once on first use.
+    const Table&
+    active();
+
+    // Reference first, followed by every variant the running CPU supports.
+    std::span<const Table>
+    available();
+} // namespace kernels
+} // namespace ventilation
+
+#endif // VENTILATION_KERNELS_HPP__
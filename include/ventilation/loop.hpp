@@ -0,0 +1,120 @@
+#ifndef VENTILATION_LOOP_HPP__
+#define VENTILATION_LOOP_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "ventilation/parallel.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace loop {
+    // Area enclosed by the pressure-volume loop of one breath, closed from
+    // the last sample back to the first, by the shoelace formula on the raw
+    // values. The area is the energy lost to hysteresis over the breath and
+    // is returned unsigned, whatever the direction of the loop.
+    Work
+    area(std::span<const Volume> volume, std::span<const Pressure> pressure);
+
+    // Areas of consecutive breaths, breath i spanning samples
+    // [boundaries[i], boundaries[i + 1]), spread over the pool. Breaths must
+    // be non-empty, as for mechanics::analyze(); throws as
+    // mechanics::detail::validate() does otherwise.
+    void
+    area(
+          std::span<const Volume> volume
+        , std::span<const Pressure> pressure
+        , std::span<const std::size_t> boundaries
+        , std::span<Work> output
+        , parallel::Pool& pool = parallel::shared()
+        );
+
+    // Evenly spaced bins over [lower, upper)
+    template <Quantity T>
+    struct Axis {
+        T           lower;
+        T           upper;
+        std::size_t bins;
+    };
+
+    // Counts of (volume, pressure) samples over a two-dimensional grid, with
+    // volume bins as rows. Samples outside either axis are counted apart.
+    // Counts are 64-bit, so a histogram can keep accumulating across calls.
+    class Histogram {
+        public:
+            // Throws std::invalid_argument when an axis has no bins or an
+            // empty range
+            Histogram(const Axis<Volume>& volume, const Axis<Pressure>& pressure);
+
+            // Adds every sample pair. Each pool thread fills a private tile,
+            // with no locking, and tiles are summed into the grid at the end.
+            void
+            accumulate(
+                  std::span<const Volume> volume
+                , std::span<const Pressure> pressure
+                , parallel::Pool& pool = parallel::shared()
+                );
+
+            // Adds the counts of a histogram over the same axes
+            void
+            merge(const Histogram& other);
+
+            // Count of volume bin v and pressure bin p, throws std::out_of_range
+            std::uint64_t
+            at(std::size_t v, std::size_t p) const;
+
+            // Row-major counts, volume bins by pressure bins
+            std::span<const std::uint64_t>
+            counts() const { return counts_; }
+
+            std::uint64_t
+            outside() const { return outside_; }
+
+            // Samples accumulated so far, inside or outside the grid
+            std::uint64_t
+            total() const;
+
+            const Axis<Volume>&
+            volume() const { return volume_; }
+
+            const Axis<Pressure>&
+            pressure() const { return pressure_; }
+        private:
+            // Raw-unit origin and bins of an axis. When the range does not
+            // divide evenly the remainder is spread one raw unit each over
+            // the first bins, `wide` wide and ending at `split`; the others
+            // are `narrow`. Bins beyond a range of fewer raw units than bins
+            // stay empty.
+            struct Scale {
+                std::int64_t    lower;
+                std::uint64_t   range;
+                std::uint64_t   wide;
+                std::uint64_t   narrow;
+                std::uint64_t   split;
+                std::uint64_t   remainder;  // bins before the split
+                std::size_t     bins;
+
+                // Bin of an offset below the range
+                std::size_t
+                bin(std::uint64_t offset) const {
+                    bool first = offset < split;
+                    return (offset - (first ? 0 : split)) / (first ? wide : narrow) + (first ? 0 : remainder);
+                }
+            };
+
+            template <Quantity T>
+            static Scale
+            scale(const Axis<T>& axis);
+
+            Axis<Volume>                volume_;
+            Axis<Pressure>              pressure_;
+            Scale                       rows_;
+            Scale                       columns_;
+            std::vector<std::uint64_t>  counts_;
+            std::uint64_t               outside_ = 0;
+    };
+} // namespace loop
+} // namespace ventilation
+
+#endif // VENTILATION_LOOP_HPP__
@@ -0,0 +1,95 @@
+#ifndef VENTILATION_MECHANICS_HPP__
+#define VENTILATION_MECHANICS_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include "ventilation/parallel.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace mechanics {
+namespace detail {
+    // Breaths handed to a pool task at a time, enough to amortise dispatch
+    inline constexpr std::size_t BREATHS = 64;
+
+    // Throws std::invalid_argument unless boundaries has one more entry than
+    // there are breaths and every breath is non-empty and in order, and
+    // std::out_of_range when the last breath ends past the samples
+    void
+    validate(std::span<const std::size_t> boundaries, std::size_t breaths, std::size_t samples);
+
+    // Validates the boundaries, then calls f(i, offset, size) for every
+    // breath i, BREATHS of them per pool task. Shared by the batch analyses
+    // of the recordings cut into breaths.
+    template <typename F>
+    void
+    breaths(
+          std::span<const std::size_t> boundaries
+        , std::size_t count
+        , std::size_t samples
+        , parallel::Pool& pool
+        , F&& f
+        )
+    {
+        validate(boundaries, count, samples);
+
+        std::size_t tasks = (count + BREATHS - 1) / BREATHS;
+        pool.run(tasks, [&](std::size_t task) {
+            std::size_t last = std::min(count, (task + 1) * BREATHS);
+            for (std::size_t i = task * BREATHS; i < last; i++) {
+                f(i, boundaries[i], boundaries[i + 1] - boundaries[i]);
+            }
+        });
+    }
+} // namespace detail
+
+    // Respiratory mechanics of a single breath. Inspiration runs from the
+    // first sample up to the first sample with negative flow; the plateau is
+    // the pressure at the last inspiratory sample and the end-expiratory
+    // pressure the one at the last sample of the breath.
+    struct Breath {
+        Work        work;       // inspiratory work, the integral of pressure over volume
+        Power       power;      // work over the duration of the whole breath
+        Pressure    peak;       // highest pressure of the breath
+        Pressure    plateau;    // end-inspiratory pressure
+        Pressure    driving;    // plateau minus end-expiratory pressure
+    };
+
+    // Converts twice an exact pressure-volume integral, in raw units, to
+    // work; trapezoidal and shoelace sums both come out doubled. Throws
+    // std::out_of_range when the result does not fit.
+    Work
+    energy(__int128 doubled);
+
+    // Analyzes one breath sampled every `period` seconds, in a single pass
+    // over the three waveforms. Throws std::invalid_argument when the sizes
+    // differ or the breath is empty, std::domain_error when the period is
+    // not finite and positive.
+    Breath
+    analyze(
+          std::span<const Pressure> pressure
+        , std::span<const Flow> flow
+        , std::span<const Volume> volume
+        , float period
+        );
+
+    // Analyzes consecutive breaths of the same recording, breath i spanning
+    // samples [boundaries[i], boundaries[i + 1]). Breaths are spread over the
+    // pool; each result is the same as analyze() on that breath alone. Throws
+    // as detail::validate() does for boundaries that are not consecutive
+    // non-empty breaths.
+    void
+    analyze(
+          std::span<const Pressure> pressure
+        , std::span<const Flow> flow
+        , std::span<const Volume> volume
+        , std::span<const std::size_t> boundaries
+        , float period
+        , std::span<Breath> output
+        , parallel::Pool& pool = parallel::shared()
+        );
+} // namespace mechanics
+} // namespace ventilation
+
+#endif // VENTILATION_MECHANICS_HPP__
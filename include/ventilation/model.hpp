@@ -0,0 +1,76 @@
+#ifndef VENTILATION_MODEL_HPP__
+#define VENTILATION_MODEL_HPP__
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "ventilation/mechanics.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace model {
+    // Single-compartment lung on volume-controlled ventilation: constant
+    // inspiratory flow delivering the tidal volume, an end-inspiratory pause
+    // and passive exhalation down to PEEP. Airway pressure follows the
+    // equation of motion, resistance * flow + volume / compliance + peep.
+    struct Parameters {
+        Resistance  resistance;
+        Compliance  compliance;
+        Pressure    peep;
+        Volume      tidal;
+
+        friend bool
+        operator==(const Parameters& lhs, const Parameters& rhs) = default;
+    };
+
+    // Breath timing, in seconds
+    struct Settings {
+        float inspiration   = 1.0f;
+        float pause         = 0.2f;
+        float expiration    = 2.0f;
+        float period        = 0.01f;
+
+        friend bool
+        operator==(const Settings& lhs, const Settings& rhs) = default;
+    };
+
+    struct Waveforms {
+        std::vector<Pressure>   pressure;
+        std::vector<Flow>       flow;
+        std::vector<Volume>     volume;
+    };
+
+    // Peak airway pressure, without simulating the breath. It grows with
+    // resistance, peep and tidal volume, and falls with compliance.
+    Pressure
+    peak(const Parameters& parameters, const Settings& settings);
+
+    // Samples one breath. Throws std::invalid_argument on non-positive
+    // resistance, compliance or timing.
+    Waveforms
+    simulate(const Parameters& parameters, const Settings& settings);
+
+    // Mechanics of the simulated breath
+    mechanics::Breath
+    breath(const Parameters& parameters, const Settings& settings);
+} // namespace model
+} // namespace ventilation
+
+template <>
+struct std::hash<ventilation::model::Parameters> {
+    std::size_t
+    operator()(const ventilation::model::Parameters& parameters) const noexcept {
+        std::size_t seed = std::hash<ventilation::Resistance>()(parameters.resistance);
+        for (std::size_t h : {
+                  std::hash<ventilation::Compliance>()(parameters.compliance)
+                , std::hash<ventilation::Pressure>()(parameters.peep)
+                , std::hash<ventilation::Volume>()(parameters.tidal)
+                })
+        {
+            seed ^= h + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+        }
+        return seed;
+    }
+};
+
+#endif // VENTILATION_MODEL_HPP__
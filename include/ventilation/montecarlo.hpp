@@ -0,0 +1,83 @@
+#ifndef VENTILATION_MONTECARLO_HPP__
+#define VENTILATION_MONTECARLO_HPP__
+
+#include <cstdint>
+#include <limits>
+#include "ventilation/model.hpp"
+#include "ventilation/parallel.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace montecarlo {
+    // Log-normal distribution given by its median, in the unit of the
+    // quantity, and the standard deviation of its logarithm
+    struct Lognormal {
+        float median;
+        float sigma;
+    };
+
+    // Virtual patients ventilated with the same settings, whose resistance
+    // and compliance are drawn independently
+    struct Population {
+        Lognormal   resistance;
+        Lognormal   compliance;
+        Pressure    peep;
+        Volume      tidal;
+    };
+
+    // Running count, mean, variance and range of a series of values, kept
+    // with Welford's update so it never stores the values
+    struct Statistics {
+        std::uint64_t   count   = 0;
+        double          mean    = 0.0;
+        double          squares = 0.0;
+        double          minimum = std::numeric_limits<double>::infinity();
+        double          maximum = -std::numeric_limits<double>::infinity();
+
+        void
+        push(double value);
+
+        // Combines with the statistics of a later part of the series
+        void
+        merge(const Statistics& other);
+
+        // Sample variance, zero below two values
+        double
+        variance() const;
+    };
+
+    // Distribution of the breath of each patient, in the units of the types
+    // the values come from
+    struct Summary {
+        Statistics      resistance;     // cmH2O.s/L
+        Statistics      compliance;     // L/cmH2O
+        Statistics      peak;           // cmH2O
+        Statistics      plateau;        // cmH2O
+        Statistics      driving;        // cmH2O
+        Statistics      work;           // J
+        std::uint64_t   exceeding = 0;  // patients whose peak is above the limit
+    };
+
+    // Parameters of patient `index`, the same ones run() draws. Each patient
+    // reads its own block of a Philox stream keyed on the seed.
+    model::Parameters
+    patient(const Population& population, std::uint64_t seed, std::uint64_t index);
+
+    // Simulates patients [0, count) and summarises them. Breaths use the
+    // closed forms of the single-compartment model for constant-flow volume
+    // control, evaluated for batches of patients laid out as arrays. Patients
+    // are cut into fixed blocks whose summaries are merged in order, so the
+    // result is identical for any pool size.
+    Summary
+    run(
+          const Population& population
+        , const model::Settings& settings
+        , std::uint64_t count
+        , std::uint64_t seed
+        , const Pressure& limit
+        , parallel::Pool& pool = parallel::shared()
+        );
+} // namespace montecarlo
+} // namespace ventilation
+
+#endif // VENTILATION_MONTECARLO_HPP__
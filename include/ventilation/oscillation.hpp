@@ -0,0 +1,100 @@
+#ifndef VENTILATION_OSCILLATION_HPP__
+#define VENTILATION_OSCILLATION_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "ventilation/fft.hpp"
+#include "ventilation/parallel.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace oscillation {
+    // Forced oscillation technique: a small sinusoidal flow is superimposed
+    // on breathing and the respiratory impedance Z = pressure / flow is read
+    // at its frequencies. The real part of Z is the resistance; the
+    // imaginary part is w I - E / w, so at the low frequencies used the
+    // elastance is -w Im(Z), w being the angular frequency.
+
+    // Impedance at one frequency
+    struct Point {
+        float       frequency;      // Hz
+        Resistance  resistance;
+        Elastance   elastance;
+        float       coherence;      // of pressure with flow, from 0 to 1
+    };
+
+    // Welch averaging: Hann-windowed segments, each shifted by segment -
+    // overlap samples from the previous one
+    struct Welch {
+        std::size_t segment = 1024;
+        std::size_t overlap = 512;
+    };
+
+    // Impedance at every frequency k / (segment * period), 0 < k <= segment / 2,
+    // from the cross-spectrum of flow and pressure over the flow spectrum,
+    // each averaged over the segments. Segments are transformed across the
+    // pool in fixed blocks, summed in order, so the result does not depend
+    // on the pool size. Frequencies without flow are reported as zero.
+    // Throws std::invalid_argument when the sizes differ, the settings are
+    // inconsistent or the recording is shorter than a segment, and
+    // std::domain_error when the period is not finite and positive.
+    std::vector<Point>
+    impedance(
+          std::span<const Pressure> pressure
+        , std::span<const Flow> flow
+        , float period
+        , const Welch& welch = Welch()
+        , parallel::Pool& pool = parallel::shared()
+        );
+
+    // Impedance at a few frequencies over the latest `window` samples,
+    // updated with each sample by a sliding DFT: a tracked bin is rotated
+    // by one sample and corrected by the samples entering and leaving the
+    // window, O(1) per frequency. Every `window` samples the bins are
+    // recomputed from the window, so rounding never accumulates. The window
+    // is rectangular, so a frequency should fit a whole number of periods
+    // in it.
+    class Tracker {
+        public:
+            // Each frequency is rounded to the nearest k / (window * period).
+            // Throws std::invalid_argument when k is zero or above window / 2,
+            // std::domain_error when the period is not finite and positive.
+            Tracker(std::span<const float> frequencies, std::size_t window, float period);
+
+            void
+            push(const Pressure& pressure, const Flow& flow);
+
+            // True once a whole window has been pushed
+            bool
+            ready() const { return count_ >= window_; }
+
+            // Tracked frequencies
+            std::size_t
+            size() const { return bins_.size(); }
+
+            // Impedance at tracked frequency i. A single window is not
+            // averaged, so its coherence is always one.
+            Point
+            operator[](std::size_t i) const;
+        private:
+            void
+            refresh();
+
+            std::size_t                 window_;
+            double                      period_;
+            std::vector<std::size_t>    bins_;
+            std::vector<fft::Complex>   rotations_;     // exp(2 pi i k / window) of each bin
+            std::vector<fft::Complex>   twiddles_;      // exp(-2 pi i n / window)
+            std::vector<fft::Complex>   pressures_;     // current bins
+            std::vector<fft::Complex>   flows_;
+            std::vector<std::int64_t>   pressure_;      // window, raw
+            std::vector<std::int64_t>   flow_;
+            std::size_t                 position_   = 0;    // oldest sample of the window
+            std::uint64_t               count_      = 0;
+    };
+} // namespace oscillation
+} // namespace ventilation
+
+#endif // VENTILATION_OSCILLATION_HPP__
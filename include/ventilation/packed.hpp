@@ -0,0 +1,176 @@
+#ifndef VENTILATION_PACKED_HPP__
+#define VENTILATION_PACKED_HPP__
+
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include "ventilation/instrumentation.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace fixed {
+    // Converts a raw value between two policies, truncating toward zero like
+    // the float constructors do. Throws when the result does not fit.
+    template <typename To, typename From>
+    typename To::representation
+    rescale(typename From::representation value) {
+        using representation = typename To::representation;
+
+        __int128 scaled = (static_cast<__int128>(value) * To::forward) / From::forward;
+        if (    scaled < std::numeric_limits<representation>::min()
+            or  scaled > std::numeric_limits<representation>::max())
+        {
+            instrumentation::increment(instrumentation::Counter::range);
+            throw std::out_of_range("value does not fit the target representation");
+        }
+        return static_cast<representation>(scaled);
+    }
+} // namespace fixed
+
+    // Quantity T stored under policy P. Every operator of T is available, with
+    // the width and scale of P; conversions to and from T, or between packed
+    // types of different policies, are range checked.
+    template <Quantity T, typename P = fixed::Default>
+    class Packed {
+        public:
+            using quantity          = T;
+            using policy            = P;
+            using representation    = typename P::representation;
+
+            Packed() : value_(0) {}
+
+            explicit Packed(float v) {
+                constexpr float lower = static_cast<float>(std::numeric_limits<representation>::min());
+                constexpr float upper = static_cast<float>(std::numeric_limits<representation>::max());
+
+                if (not std::isfinite(v)) {
+                    instrumentation::increment(instrumentation::Counter::domain);
+                    throw std::domain_error("packed value must be finite");
+                }
+                float scaled = v * static_cast<float>(P::forward);
+                if (not (scaled >= lower and scaled < upper)) {
+                    instrumentation::increment(instrumentation::Counter::range);
+                    throw std::out_of_range("packed value does not fit the representation");
+                }
+                value_ = static_cast<representation>(scaled);
+            }
+
+            explicit Packed(const T& quantity)
+                : value_(fixed::rescale<P, fixed::Default>(fixed::Access::raw(quantity)))
+            {}
+
+            template <typename Q>
+            explicit Packed(const Packed<T, Q>& other)
+                : value_(fixed::rescale<P, Q>(fixed::Access::raw(other)))
+            {}
+
+            explicit operator float() const {
+                return static_cast<float>(value_) * (1.0f / static_cast<float>(P::forward));
+            }
+
+            explicit operator T() const {
+                return fixed::Access::make<T>(fixed::rescale<fixed::Default, P>(value_));
+            }
+
+            friend std::strong_ordering
+            operator<=>(const Packed& lhs, const Packed& rhs) {
+                representation xs = lhs.value_ / P::precision;
+                representation ys = rhs.value_ / P::precision;
+
+                return (xs <=> ys);
+            }
+
+            friend bool
+            operator==(const Packed& lhs, const Packed& rhs) {
+                return (lhs <=> rhs) == std::strong_ordering::equal;
+            }
+
+            friend bool
+            operator!=(const Packed& lhs, const Packed& rhs) {
+                return (lhs <=> rhs) != std::strong_ordering::equal;
+            }
+
+            friend bool
+            operator<(const Packed& lhs, const Packed& rhs) {
+                return (lhs <=> rhs) == std::strong_ordering::less;
+            }
+
+            friend bool
+            operator<=(const Packed& lhs, const Packed& rhs) {
+                return (lhs <=> rhs) != std::strong_ordering::greater;
+            }
+
+            friend bool
+            operator>(const Packed& lhs, const Packed& rhs) {
+                return (lhs <=> rhs) == std::strong_ordering::greater;
+            }
+
+            friend bool
+            operator>=(const Packed& lhs, const Packed& rhs) {
+                return (lhs <=> rhs) != std::strong_ordering::less;
+            }
+
+            friend Packed
+            operator+(const Packed& lhs, const Packed& rhs) requires requires(const T& x) { x + x; } {
+                return Packed(static_cast<representation>(static_cast<std::int64_t>(lhs.value_) + rhs.value_));
+            }
+
+            friend Packed
+            operator-(const Packed& lhs) requires requires(const T& x) { -x; } {
+                return Packed(static_cast<representation>(-static_cast<std::int64_t>(lhs.value_)));
+            }
+
+            friend Packed
+            operator-(const Packed& lhs, const Packed& rhs) requires requires(const T& x) { x - x; } {
+                return Packed(static_cast<representation>(static_cast<std::int64_t>(lhs.value_) - rhs.value_));
+            }
+
+            // Exact product in 128 bits, range checked like rescale() instead
+            // of wrapping into the representation
+            friend Packed
+            operator*(const Packed& packed, float scalar) {
+                constexpr float limit = 0x1p63f;
+
+                if (not std::isfinite(scalar)) {
+                    instrumentation::increment(instrumentation::Counter::domain);
+                    throw std::domain_error("scalar value must be finite");
+                }
+                std::int64_t forward    = static_cast<std::int64_t>(P::forward);
+                float scaled            = scalar * static_cast<float>(forward);
+                if (not (scaled > -limit and scaled < limit)) {
+                    instrumentation::increment(instrumentation::Counter::range);
+                    throw std::out_of_range("packed product does not fit the representation");
+                }
+                std::int64_t converted  = static_cast<std::int64_t>(scaled);
+
+                __int128 product = (static_cast<__int128>(packed.value_) * converted) / forward;
+                if (    product < std::numeric_limits<representation>::min()
+                    or  product > std::numeric_limits<representation>::max())
+                {
+                    instrumentation::increment(instrumentation::Counter::range);
+                    throw std::out_of_range("packed product does not fit the representation");
+                }
+                return Packed(static_cast<representation>(product));
+            }
+
+            friend Packed
+            operator*(float scalar, const Packed& packed) {
+                return packed * scalar;
+            }
+
+            friend std::ostream&
+            operator<<(std::ostream& os, const Packed& packed) {
+                return os << static_cast<T>(packed);
+            }
+        private:
+            friend struct fixed::Access;
+
+            Packed(representation v) : value_(v) {}
+
+            representation value_;
+    };
+} // namespace ventilation
+
+#endif // VENTILATION_PACKED_HPP__
@@ -0,0 +1,152 @@
+#ifndef VENTILATION_PARALLEL_HPP__
+#define VENTILATION_PARALLEL_HPP__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ventilation {
+namespace parallel {
+    // Where a thread runs: a CPU and the NUMA node it belongs to
+    struct Placement {
+        unsigned        cpu;
+        std::size_t     node;
+    };
+
+    // CPUs this process may run on, grouped by NUMA node
+    struct Topology {
+        std::vector<std::vector<unsigned>> nodes;
+
+        // Read from /sys/devices/system/node once, restricted to the process
+        // affinity mask; a single node of every allowed CPU when unavailable
+        static const Topology&
+        system();
+
+        std::size_t
+        cpus() const;
+
+        // Places `threads` threads, dealing them over the nodes in turn so
+        // each node gets its share, and over the CPUs of a node in order
+        std::vector<Placement>
+        place(std::size_t threads) const;
+    };
+
+    // CPUs of a kernel cpulist such as "0-3,8,10-11"
+    std::vector<unsigned>
+    cpus(std::string_view list);
+
+    // Order in which thread `self` tries to steal from the others: first the
+    // threads on its own node, then the rest, each group starting after self
+    std::vector<std::size_t>
+    victims(std::span<const Placement> placement, std::size_t self);
+
+    // Restricts a thread to one CPU; false when the system refuses
+    bool
+    pin(std::thread& thread, unsigned cpu);
+
+    // Fixed set of worker threads running the indices of a task by work
+    // stealing. Each participant starts on its own contiguous share of the
+    // indices and takes them in order; once done it steals the upper half of
+    // what remains to another participant, preferring those on its NUMA node.
+    // Uneven task costs are thus rebalanced without a shared queue, and each
+    // participant mostly touches adjacent data. The calling thread works
+    // alongside the workers, so a pool of size 1 has no workers and runs
+    // everything inline.
+    class Pool {
+        public:
+            // Defaults to one thread per hardware thread
+            explicit Pool(std::size_t threads = std::thread::hardware_concurrency());
+
+            // Workers are pinned to their placement when the topology spans
+            // more than one node, and left to the OS otherwise
+            Pool(std::size_t threads, const Topology& topology);
+
+            ~Pool();
+
+            Pool(const Pool&)               = delete;
+            Pool& operator=(const Pool&)    = delete;
+
+            // Threads taking part in run(), the caller included
+            std::size_t
+            size() const { return workers_.size() + 1; }
+
+            // Calls task(i) once for every i in [0, count) and returns when all
+            // calls have finished. Which thread runs which index is unspecified.
+            // The first exception thrown by a task is rethrown here, after the
+            // remaining indices have been abandoned. A task may call run() on
+            // the pool executing it, as library algorithms on the shared pool
+            // do; the nested indices then run inline on the task's thread.
+            template <typename F>
+            void
+            run(std::size_t count, F&& task) {
+                auto invoke = [](const void* context, std::size_t i) {
+                    (*static_cast<const std::remove_reference_t<F>*>(context))(i);
+                };
+                dispatch(count, invoke, &task);
+            }
+        private:
+            using Invoke = void (*)(const void*, std::size_t);
+
+            // Half-open range of indices, packed into one word so the owner
+            // and thieves can update it with a single compare-and-swap
+            struct alignas(64) Range {
+                std::atomic<std::uint64_t> bounds{0};
+
+                static std::uint64_t
+                pack(std::uint64_t begin, std::uint64_t end) { return (begin << 32) | end; }
+
+                // Takes the first index, as the owner does
+                bool
+                pop(std::size_t& index);
+
+                // Takes the upper half, as a thief does
+                bool
+                steal(std::uint64_t& begin, std::uint64_t& end);
+            };
+
+            struct Job {
+                Invoke              invoke  = nullptr;
+                const void*         context = nullptr;
+                std::size_t         offset  = 0;
+                std::atomic<bool>   failed  = false;
+                std::exception_ptr  error;
+            };
+
+            void
+            dispatch(std::size_t count, Invoke invoke, const void* context);
+
+            void
+            work(Job& job, std::size_t self);
+
+            void
+            loop(std::size_t self);
+
+            std::vector<std::thread>        workers_;
+            std::vector<std::size_t>        order_;         // victims of each participant, concatenated
+            std::unique_ptr<Range[]>        ranges_;
+            std::mutex                      mutex_;
+            std::mutex                      submit_;
+            std::condition_variable         wake_;
+            std::condition_variable         finished_;
+            Job*                            job_        = nullptr;
+            std::uint64_t                   generation_ = 0;
+            std::size_t                     active_     = 0;
+            bool                            stop_       = false;
+    };
+
+    // Process-wide pool, created on first use with the default size
+    Pool&
+    shared();
+} // namespace parallel
+} // namespace ventilation
+
+#endif // VENTILATION_PARALLEL_HPP__
@@ -0,0 +1,401 @@
+#ifndef VENTILATION_PIPELINE_HPP__
+#define VENTILATION_PIPELINE_HPP__
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "ventilation/deque.hpp"
+#include "ventilation/parallel.hpp"
+#include "ventilation/tracing.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace pipeline {
+    // Streaming processing chains built from coroutines. A stage is a
+    // coroutine returning Stream<T>: it pulls batches from its input with
+    // `co_await input.next()` and hands each result downstream with
+    // `co_yield`. Control passes between stages by symmetric transfer, and a
+    // yielded batch is lent by reference, so it stays valid until the
+    // consumer asks for the next one and is never copied. A stage only runs
+    // when its consumer is waiting, which is the backpressure within a chain.
+    //
+    // The chain of one bed is driven by a Task spawned on an Executor. When
+    // its Channel is empty the whole chain suspends without holding a thread,
+    // so many beds share a few threads.
+
+    class Executor;
+
+    // Lazily started, single-consumer stream of values lent by reference
+    template <typename T>
+    class Stream {
+        public:
+            struct promise_type;
+            using handle = std::coroutine_handle<promise_type>;
+
+            // Resumes the coroutine that is waiting on this stream
+            struct Transfer {
+                bool
+                await_ready() const noexcept { return false; }
+
+                std::coroutine_handle<>
+                await_suspend(handle h) noexcept { return h.promise().consumer; }
+
+                void
+                await_resume() const noexcept {}
+            };
+
+            struct promise_type {
+                const T*                current = nullptr;
+                std::coroutine_handle<> consumer;
+                std::exception_ptr      error;
+
+                Stream
+                get_return_object() { return Stream(handle::from_promise(*this)); }
+
+                std::suspend_always
+                initial_suspend() const noexcept { return {}; }
+
+                Transfer
+                final_suspend() noexcept {
+                    current = nullptr;
+                    return {};
+                }
+
+                // The value must outlive the suspension, which holds for
+                // locals of the stage and for temporaries in the co_yield
+                Transfer
+                yield_value(const T& value) noexcept {
+                    current = &value;
+                    return {};
+                }
+
+                void
+                return_void() const noexcept {}
+
+                void
+                unhandled_exception() { error = std::current_exception(); }
+            };
+
+            struct Next {
+                handle producer;
+
+                bool
+                await_ready() const noexcept { return producer.done(); }
+
+                std::coroutine_handle<>
+                await_suspend(std::coroutine_handle<> consumer) noexcept {
+                    producer.promise().consumer = consumer;
+                    return producer;
+                }
+
+                // Null once the stream has ended
+                const T*
+                await_resume() const {
+                    promise_type& promise = producer.promise();
+                    if (promise.error) { std::rethrow_exception(std::exchange(promise.error, nullptr)); }
+                    return producer.done() ? nullptr : promise.current;
+                }
+            };
+
+            Stream(Stream&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+            Stream&
+            operator=(Stream&& other) noexcept {
+                if (this != &other) {
+                    if (handle_) { handle_.destroy(); }
+                    handle_ = std::exchange(other.handle_, nullptr);
+                }
+                return *this;
+            }
+
+            ~Stream() {
+                if (handle_) { handle_.destroy(); }
+            }
+
+            // Awaitable for the next value; the previous one is released
+            Next
+            next() {
+                if (not handle_) { throw std::logic_error("stream has been moved from"); }
+                return Next{handle_};
+            }
+        private:
+            explicit Stream(handle h) : handle_(h) {}
+
+            handle handle_;
+    };
+
+    // Top-level coroutine of one pipeline, owned by the executor once spawned
+    class Task {
+        public:
+            struct promise_type;
+            using handle = std::coroutine_handle<promise_type>;
+
+            struct Final {
+                bool
+                await_ready() const noexcept { return false; }
+
+                void
+                await_suspend(handle h) noexcept;
+
+                void
+                await_resume() const noexcept {}
+            };
+
+            struct promise_type {
+                Executor*           executor = nullptr;
+                std::exception_ptr  error;
+
+                Task
+                get_return_object() { return Task(handle::from_promise(*this)); }
+
+                std::suspend_always
+                initial_suspend() const noexcept { return {}; }
+
+                Final
+                final_suspend() const noexcept { return {}; }
+
+                void
+                return_void() const noexcept {}
+
+                void
+                unhandled_exception() { error = std::current_exception(); }
+            };
+
+            Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+            Task& operator=(Task&&) = delete;
+
+            ~Task() {
+                if (handle_) { handle_.destroy(); }
+            }
+        private:
+            friend class Executor;
+
+            explicit Task(handle h) : handle_(h) {}
+
+            handle handle_;
+    };
+
+    // Fixed set of threads resuming ready coroutines. Each thread has its own
+    // deque: a coroutine woken by one of the threads is queued there and runs
+    // next on it, while the acquisition threads feed a shared queue. A thread
+    // with nothing left steals from the others, its own NUMA node first.
+    class Executor {
+        public:
+            explicit Executor(std::size_t threads = 2);
+
+            // Threads are pinned to their placement when the topology spans
+            // more than one node, and left to the OS otherwise
+            Executor(std::size_t threads, const parallel::Topology& topology);
+
+            // Every spawned task must have finished, see wait()
+            ~Executor();
+
+            Executor(const Executor&)               = delete;
+            Executor& operator=(const Executor&)    = delete;
+
+            std::size_t
+            size() const { return threads_.size(); }
+
+            // Starts a task; its coroutine frame is destroyed when it returns
+            void
+            spawn(Task task);
+
+            // Queues a suspended coroutine to be resumed on one of the threads
+            void
+            schedule(std::coroutine_handle<> coroutine);
+
+            // Blocks until every spawned task has returned, then rethrows the
+            // first exception that escaped any of them
+            void
+            wait();
+        private:
+            friend struct Task::Final;
+
+            struct alignas(64) Worker {
+                parallel::Deque<void*>      deque;
+                std::vector<std::size_t>    victims;
+            };
+
+            void
+            finished(std::exception_ptr error);
+
+            std::coroutine_handle<>
+            take(std::size_t self);
+
+            void
+            loop(std::size_t self);
+
+            std::vector<std::unique_ptr<Worker>>    workers_;
+            std::vector<std::thread>                threads_;
+            std::mutex                              mutex_;
+            std::condition_variable                 ready_;
+            std::condition_variable                 idle_;
+            std::deque<std::coroutine_handle<>>     queue_;             // scheduled from outside
+            std::atomic<std::size_t>                injected_   = 0;    // size of queue_
+            std::atomic<std::size_t>                pending_    = 0;    // scheduled, not yet taken
+            std::atomic<std::size_t>                sleeping_   = 0;
+            std::size_t                             tasks_      = 0;
+            std::exception_ptr                      error_;
+            bool                                    stop_       = false;
+    };
+
+    // Bounded queue from an acquisition thread into one pipeline. Values are
+    // moved in and lent to the consumer, which holds at most one at a time.
+    template <typename T>
+    class Channel {
+        public:
+            Channel(Executor& executor, std::size_t capacity) : executor_(executor), capacity_(capacity) {
+                if (capacity == 0) { throw std::invalid_argument("capacity must be positive"); }
+            }
+
+            Channel(const Channel&)             = delete;
+            Channel& operator=(const Channel&)  = delete;
+
+            std::size_t
+            capacity() const { return capacity_; }
+
+            // Blocks while the channel is full. Must not be called from a task
+            // of the executor, which could be the one that would drain it.
+            void
+            push(T value) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                space_.wait(lock, [&] { return closed_ or queue_.size() < capacity_; });
+                enqueue(std::move(value), lock);
+            }
+
+            // Returns false, leaving value untouched, when the channel is full
+            bool
+            try_push(T& value) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (not closed_ and queue_.size() >= capacity_) { return false; }
+                enqueue(std::move(value), lock);
+                return true;
+            }
+
+            // The consumer sees the values already queued, then the end
+            void
+            close() {
+                std::unique_lock<std::mutex> lock(mutex_);
+                closed_ = true;
+                space_.notify_all();
+                wake(lock);
+            }
+
+            struct Receive {
+                Channel& channel;
+
+                bool
+                await_ready() const noexcept { return false; }
+
+                bool
+                await_suspend(std::coroutine_handle<> consumer) {
+                    std::lock_guard<std::mutex> lock(channel.mutex_);
+                    if (channel.closed_ or not channel.queue_.empty()) { return false; }
+                    channel.waiter_ = consumer;
+                    return true;
+                }
+
+                // Null once the channel is closed and drained
+                const T*
+                await_resume() {
+                    std::lock_guard<std::mutex> lock(channel.mutex_);
+                    if (channel.queue_.empty()) { return nullptr; }
+                    channel.current_ = std::move(channel.queue_.front());
+                    channel.queue_.pop_front();
+                    channel.space_.notify_one();
+                    return &channel.current_;
+                }
+            };
+
+            // Awaitable for the next value; the previous one is released.
+            // Only one coroutine may receive from a channel.
+            Receive
+            receive() { return Receive{*this}; }
+        private:
+            void
+            enqueue(T&& value, std::unique_lock<std::mutex>& lock) {
+                if (closed_) { throw std::logic_error("channel is closed"); }
+                queue_.push_back(std::move(value));
+                wake(lock);
+            }
+
+            void
+            wake(std::unique_lock<std::mutex>& lock) {
+                std::coroutine_handle<> waiter = std::exchange(waiter_, nullptr);
+                lock.unlock();
+                if (waiter) { executor_.schedule(waiter); }
+            }
+
+            Executor&                   executor_;
+            std::size_t                 capacity_;
+            std::mutex                  mutex_;
+            std::condition_variable     space_;
+            std::deque<T>               queue_;
+            T                           current_{};
+            std::coroutine_handle<>     waiter_;
+            bool                        closed_ = false;
+    };
+
+    // Batches of quantity samples, lent by the stage that produced them
+    template <Quantity T>
+    using Batch = std::span<const T>;
+
+    // Every value received from the channel
+    template <typename T>
+    Stream<T>
+    source(Channel<T>& channel) {
+        while (const T* value = co_await channel.receive()) {
+            co_yield *value;
+        }
+    }
+
+    template <Quantity T>
+    Stream<Batch<T>>
+    source(Channel<std::vector<T>>& channel) {
+        while (const std::vector<T>* value = co_await channel.receive()) {
+            co_yield Batch<T>(*value);
+        }
+    }
+
+    // Element-wise stage, f(input, output) fills an output of the same size.
+    // The output buffer belongs to the stage and is reused for every batch.
+    template <Quantity Out, Quantity In, typename F>
+    Stream<Batch<Out>>
+    transform(Stream<Batch<In>> input, F f) {
+        std::vector<Out> buffer;
+        while (const Batch<In>* batch = co_await input.next()) {
+            {
+                VENTILATION_TRACE("pipeline::transform");
+                buffer.resize(batch->size());
+                f(*batch, std::span<Out>(buffer));
+            }
+            co_yield Batch<Out>(buffer);
+        }
+    }
+
+    // Running volume from flow sampled every `period` seconds, starting from
+    // `initial`, with the rectangle rule v[i] = v[i - 1] + flow[i] * period.
+    // Each volume is rounded from the exact raw sum of the flow so far, so
+    // rounding does not accumulate along the stream.
+    Stream<Batch<Volume>>
+    integrate(Stream<Batch<Flow>> flow, float period, Volume initial = Volume(0.0f));
+
+    // Whole breaths, each from one inspiratory onset (flow turning positive)
+    // up to the next. Samples before the first onset, and the unfinished
+    // breath at the end of the stream, are dropped.
+    Stream<Batch<Flow>>
+    segment(Stream<Batch<Flow>> flow);
+} // namespace pipeline
+} // namespace ventilation
+
+#endif // VENTILATION_PIPELINE_HPP__
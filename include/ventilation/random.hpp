@@ -0,0 +1,80 @@
+#ifndef VENTILATION_RANDOM_HPP__
+#define VENTILATION_RANDOM_HPP__
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <utility>
+
+namespace ventilation {
+namespace random {
+    // Philox4x32-10 counter-based generator (Salmon et al., SC'11). Each
+    // (stream, index) pair maps to a block of four independent 32-bit values
+    // through a keyed bijection, so any draw can be computed on its own, by
+    // any thread, in any order, without shared state.
+    class Philox {
+        public:
+            using Block = std::array<std::uint32_t, 4>;
+
+            explicit constexpr Philox(std::uint64_t seed)
+                : key_{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)}
+            {}
+
+            constexpr Block
+            operator()(std::uint64_t stream, std::uint64_t index) const {
+                return operator()({
+                          static_cast<std::uint32_t>(index)
+                        , static_cast<std::uint32_t>(index >> 32)
+                        , static_cast<std::uint32_t>(stream)
+                        , static_cast<std::uint32_t>(stream >> 32)
+                        });
+            }
+
+            // The raw bijection of a 128-bit counter
+            constexpr Block
+            operator()(Block counter) const {
+                std::uint32_t k0 = key_[0];
+                std::uint32_t k1 = key_[1];
+                for (int round = 0; round < 10; round++) {
+                    std::uint64_t p0 = static_cast<std::uint64_t>(M0) * counter[0];
+                    std::uint64_t p1 = static_cast<std::uint64_t>(M1) * counter[2];
+
+                    counter = {
+                          static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ k0
+                        , static_cast<std::uint32_t>(p1)
+                        , static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ k1
+                        , static_cast<std::uint32_t>(p0)
+                    };
+                    k0 += W0;
+                    k1 += W1;
+                }
+                return counter;
+            }
+        private:
+            static constexpr std::uint32_t M0 = 0xD2511F53u;
+            static constexpr std::uint32_t M1 = 0xCD9E8D57u;
+            static constexpr std::uint32_t W0 = 0x9E3779B9u;
+            static constexpr std::uint32_t W1 = 0xBB67AE85u;
+
+            std::array<std::uint32_t, 2> key_;
+    };
+
+    // Uniform on the open interval (0, 1), from the top 23 bits so that the
+    // half-step offset keeps the largest value below 1 in float
+    inline constexpr float
+    uniform(std::uint32_t bits) {
+        return (static_cast<float>(bits >> 9) + 0.5f) * 0x1.0p-23f;
+    }
+
+    // Two independent standard normal values, by the Box-Muller transform
+    inline std::pair<float, float>
+    normal(std::uint32_t first, std::uint32_t second) {
+        float radius    = std::sqrt(-2.0f * std::log(uniform(first)));
+        float angle     = 2.0f * std::numbers::pi_v<float> * uniform(second);
+        return {radius * std::cos(angle), radius * std::sin(angle)};
+    }
+} // namespace random
+} // namespace ventilation
+
+#endif // VENTILATION_RANDOM_HPP__
@@ -0,0 +1,269 @@
+#ifndef VENTILATION_REDUCTION_HPP__
+#define VENTILATION_REDUCTION_HPP__
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "ventilation/batch.hpp"
+#include "ventilation/instrumentation.hpp"
+#include "ventilation/kernels.hpp"
+#include "ventilation/parallel.hpp"
+#include "ventilation/span.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace reduction {
+    // Parallel reductions over spans of quantities. The input is cut into
+    // CHUNK-sized pieces regardless of the pool, each piece is reduced with
+    // the active kernel variant and the partial results are combined in
+    // index order with exact integer arithmetic. The result is therefore the
+    // same bit for bit for every thread count, and equal to the sequential
+    // result.
+    inline constexpr std::size_t CHUNK = 16384;
+
+    // Applies reduce(offset, count) to each chunk of a size-element input and
+    // returns the partial results in chunk order
+    template <typename R, typename F>
+    std::vector<R>
+    chunks(std::size_t size, parallel::Pool& pool, F&& reduce) {
+        std::size_t count = (size + CHUNK - 1) / CHUNK;
+        std::vector<R> partials(count);
+        pool.run(count, [&](std::size_t i) {
+            std::size_t offset = i * CHUNK;
+            partials[i] = reduce(offset, std::min(CHUNK, size - offset));
+        });
+        return partials;
+    }
+
+    namespace detail {
+        // Exact sum of count raw values
+        inline __int128
+        partial(const std::int64_t* raw, std::size_t count) {
+            std::int64_t high   = 0;
+            std::uint64_t low   = 0;
+            kernels::active().total(raw, count, &high, &low);
+            return static_cast<__int128>(high) * (__int128(1) << 32) + low;
+        }
+
+        // Throws std::out_of_range when an exact sum does not fit T
+        template <Quantity T>
+        T
+        fit(__int128 accumulator) {
+            if (    accumulator < std::numeric_limits<std::int64_t>::min()
+                or  accumulator > std::numeric_limits<std::int64_t>::max())
+            {
+                instrumentation::increment(instrumentation::Counter::range);
+                throw std::out_of_range("sum does not fit the representation");
+            }
+            return fixed::Access::make<T>(static_cast<std::int64_t>(accumulator));
+        }
+
+        using Extrema = std::pair<std::int64_t, std::int64_t>;
+
+        // Smallest and largest of count raw values, count > 0
+        inline Extrema
+        partial_extrema(const std::int64_t* raw, std::size_t count) {
+            Extrema range;
+            kernels::active().extrema(raw, count, &range.first, &range.second);
+            return range;
+        }
+
+        template <Quantity T>
+        std::pair<T, T>
+        combine(const std::vector<Extrema>& partials) {
+            Extrema range = partials.front();
+            for (const Extrema& p : partials) {
+                range.first     = std::min(range.first, p.first);
+                range.second    = std::max(range.second, p.second);
+            }
+            return {fixed::Access::make<T>(range.first), fixed::Access::make<T>(range.second)};
+        }
+
+        inline __int128
+        add(const std::vector<__int128>& partials) {
+            __int128 accumulator = 0;
+            for (__int128 p : partials) {
+                accumulator += p;
+            }
+            return accumulator;
+        }
+
+        // Exact sum of products in raw units, in cmH2O.L/s
+        inline double
+        power(const std::vector<__int128>& partials) {
+            constexpr double scale = static_cast<double>(fixed::FORWARD) * static_cast<double>(fixed::FORWARD);
+            return static_cast<double>(add(partials)) / scale;
+        }
+    } // namespace detail
+
+    // Exact sum of the raw values
+    template <Quantity T>
+    __int128
+    total(std::span<const T> input, parallel::Pool& pool = parallel::shared()) {
+        const std::int64_t* raw = fixed::Access::raw(input).data();
+        std::vector<__int128> partials = chunks<__int128>(input.size(), pool, [&](std::size_t offset, std::size_t count) {
+            return detail::partial(raw + offset, count);
+        });
+        return detail::add(partials);
+    }
+
+    // input[0] + input[1] + ... + input[n - 1], without intermediate overflow.
+    // Throws std::out_of_range when the sum itself does not fit.
+    template <Quantity T>
+    T
+    sum(std::span<const T> input, parallel::Pool& pool = parallel::shared()) {
+        return detail::fit<T>(total(input, pool));
+    }
+
+    // Exact sum divided by the size, truncated toward zero
+    template <Quantity T>
+    T
+    mean(std::span<const T> input, parallel::Pool& pool = parallel::shared()) {
+        if (input.empty()) { throw std::invalid_argument("mean of an empty span"); }
+
+        __int128 accumulator = total(input, pool);
+        return fixed::Access::make<T>(static_cast<std::int64_t>(accumulator / static_cast<__int128>(input.size())));
+    }
+
+    // Smallest and largest elements, by raw value
+    template <Quantity T>
+    std::pair<T, T>
+    extrema(std::span<const T> input, parallel::Pool& pool = parallel::shared()) {
+        if (input.empty()) { throw std::invalid_argument("extrema of an empty span"); }
+
+        const std::int64_t* raw = fixed::Access::raw(input).data();
+        return detail::combine<T>(chunks<detail::Extrema>(input.size(), pool, [&](std::size_t offset, std::size_t count) {
+            return detail::partial_extrema(raw + offset, count);
+        }));
+    }
+
+    template <Quantity T>
+    T
+    minimum(std::span<const T> input, parallel::Pool& pool = parallel::shared()) {
+        return extrema(input, pool).first;
+    }
+
+    template <Quantity T>
+    T
+    maximum(std::span<const T> input, parallel::Pool& pool = parallel::shared()) {
+        return extrema(input, pool).second;
+    }
+
+    // Sum of flow[i] * pressure[i] in cmH2O.L/s, the mechanical power summed
+    // over the samples; multiplied by the sampling period it is the work of
+    // breathing. The products are accumulated exactly and converted once.
+    inline double
+    dot(std::span<const Flow> flow, std::span<const Pressure> pressure, parallel::Pool& pool = parallel::shared()) {
+        if (flow.size() != pressure.size()) {
+            throw std::invalid_argument("flow and pressure must have the same size");
+        }
+        const std::int64_t* xs = fixed::Access::raw(flow).data();
+        const std::int64_t* ys = fixed::Access::raw(pressure).data();
+        return detail::power(chunks<__int128>(flow.size(), pool, [&](std::size_t offset, std::size_t count) {
+            return kernels::active().dot(xs + offset, ys + offset, count);
+        }));
+    }
+
+    // Overloads for QuantitySpan views. Contiguous views of native values
+    // take the span path in place; any other view is cut into the same
+    // chunks, each decoded through batch::blocks, so no full-size copy is
+    // made and the result is the same.
+    template <View V>
+    __int128
+    total(const V& input, parallel::Pool& pool = parallel::shared()) {
+        using T = typename V::quantity;
+
+        if (input.contiguous()) { return total<T>(input.span(), pool); }
+        std::vector<__int128> partials = chunks<__int128>(input.size(), pool, [&](std::size_t offset, std::size_t count) {
+            __int128 accumulator = 0;
+            batch::blocks(input.subspan(offset, count), [&](std::size_t, std::span<const T> values) {
+                accumulator += detail::partial(fixed::Access::raw(values).data(), values.size());
+            });
+            return accumulator;
+        });
+        return detail::add(partials);
+    }
+
+    template <View V>
+    typename V::quantity
+    sum(const V& input, parallel::Pool& pool = parallel::shared()) {
+        return detail::fit<typename V::quantity>(total(input, pool));
+    }
+
+    template <View V>
+    typename V::quantity
+    mean(const V& input, parallel::Pool& pool = parallel::shared()) {
+        if (input.empty()) { throw std::invalid_argument("mean of an empty span"); }
+
+        __int128 accumulator = total(input, pool);
+        return fixed::Access::make<typename V::quantity>(
+                static_cast<std::int64_t>(accumulator / static_cast<__int128>(input.size()))
+                );
+    }
+
+    template <View V>
+    std::pair<typename V::quantity, typename V::quantity>
+    extrema(const V& input, parallel::Pool& pool = parallel::shared()) {
+        using T = typename V::quantity;
+
+        if (input.empty()) { throw std::invalid_argument("extrema of an empty span"); }
+        if (input.contiguous()) { return extrema<T>(input.span(), pool); }
+
+        return detail::combine<T>(chunks<detail::Extrema>(input.size(), pool, [&](std::size_t offset, std::size_t count) {
+            detail::Extrema range = {std::numeric_limits<std::int64_t>::max(), std::numeric_limits<std::int64_t>::min()};
+            batch::blocks(input.subspan(offset, count), [&](std::size_t, std::span<const T> values) {
+                detail::Extrema p       = detail::partial_extrema(fixed::Access::raw(values).data(), values.size());
+                range.first     = std::min(range.first, p.first);
+                range.second    = std::max(range.second, p.second);
+            });
+            return range;
+        }));
+    }
+
+    template <View V>
+    typename V::quantity
+    minimum(const V& input, parallel::Pool& pool = parallel::shared()) {
+        return extrema(input, pool).first;
+    }
+
+    template <View V>
+    typename V::quantity
+    maximum(const V& input, parallel::Pool& pool = parallel::shared()) {
+        return extrema(input, pool).second;
+    }
+
+    template <View F, View P>
+    requires std::same_as<typename F::quantity, Flow> and std::same_as<typename P::quantity, Pressure>
+    double
+    dot(const F& flow, const P& pressure, parallel::Pool& pool = parallel::shared()) {
+        if (flow.size() != pressure.size()) {
+            throw std::invalid_argument("flow and pressure must have the same size");
+        }
+        if (flow.contiguous() and pressure.contiguous()) { return dot(flow.span(), pressure.span(), pool); }
+
+        return detail::power(chunks<__int128>(flow.size(), pool, [&](std::size_t offset, std::size_t count) {
+            __int128 accumulator = 0;
+            batch::blocks(
+                  flow.subspan(offset, count)
+                , pressure.subspan(offset, count)
+                , [&](std::size_t, std::span<const Flow> xs, std::span<const Pressure> ys) {
+                    accumulator += kernels::active().dot(
+                            fixed::Access::raw(xs).data()
+                            , fixed::Access::raw(ys).data()
+                            , xs.size()
+                            );
+                }
+                );
+            return accumulator;
+        }));
+    }
+} // namespace reduction
+} // namespace ventilation
+
+#endif // VENTILATION_REDUCTION_HPP__
@@ -0,0 +1,127 @@
+#ifndef VENTILATION_SATURATING_HPP__
+#define VENTILATION_SATURATING_HPP__
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include "ventilation/instrumentation.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace saturating {
+    // Opt-in alternative to the operators of the quantity types: results that
+    // do not fit in int64 clamp to the nearest limit instead of wrapping.
+    // Whenever the regular operator does not overflow both give the same
+    // value. add() and subtract() select the limit with conditional moves,
+    // as the batch add and subtract kernels do, without branching on the
+    // data. scale() divides in 128 bits, a call to __divti3, and multiply()
+    // branches on whether the converted scalar is below 2^63 in magnitude.
+
+    inline std::int64_t
+    add(std::int64_t lhs, std::int64_t rhs) {
+        std::int64_t result;
+        bool overflow       = __builtin_add_overflow(lhs, rhs, &result);
+        std::int64_t limit  = (lhs >> 63) ^ std::numeric_limits<std::int64_t>::max();
+
+        if constexpr (instrumentation::ENABLED) {
+            if (overflow) { instrumentation::increment(instrumentation::Counter::saturation); }
+        }
+        return overflow ? limit : result;
+    }
+
+    inline std::int64_t
+    subtract(std::int64_t lhs, std::int64_t rhs) {
+        std::int64_t result;
+        bool overflow       = __builtin_sub_overflow(lhs, rhs, &result);
+        std::int64_t limit  = (lhs >> 63) ^ std::numeric_limits<std::int64_t>::max();
+
+        if constexpr (instrumentation::ENABLED) {
+            if (overflow) { instrumentation::increment(instrumentation::Counter::saturation); }
+        }
+        return overflow ? limit : result;
+    }
+
+    // (value * factor) / forward. The product is formed in 128 bits, so
+    // only a quotient that does not fit clamps.
+    inline std::int64_t
+    scale(std::int64_t value, std::int64_t factor, std::int64_t forward) {
+        __int128 quotient   = static_cast<__int128>(value) * factor / forward;
+        bool overflow       = quotient > std::numeric_limits<std::int64_t>::max()
+                           or quotient < std::numeric_limits<std::int64_t>::min();
+        std::int64_t limit  = quotient < 0 ? std::numeric_limits<std::int64_t>::min()
+                                           : std::numeric_limits<std::int64_t>::max();
+
+        if constexpr (instrumentation::ENABLED) {
+            if (overflow) { instrumentation::increment(instrumentation::Counter::saturation); }
+        }
+        return overflow ? limit : static_cast<std::int64_t>(quotient);
+    }
+
+    // Raw value times a scalar, as the operators scale it. A scalar whose
+    // fixed-point factor exceeds int64 multiplies in 128 bits, and beyond
+    // 2^127 every nonzero value clamps. Throws std::domain_error when the
+    // scalar is not finite.
+    inline std::int64_t
+    multiply(std::int64_t value, float scalar) {
+        if (not std::isfinite(scalar)) {
+            instrumentation::increment(instrumentation::Counter::domain);
+            throw std::domain_error("scalar value must be finite");
+        }
+        std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
+        float converted         = scalar * fixed::FORWARD;
+        if (std::abs(converted) < 0x1p63f) {
+            return scale(value, static_cast<std::int64_t>(converted), forward);
+        }
+
+        __int128 product    = 0;
+        bool overflow       = value != 0 and (
+                                   std::abs(converted) >= 0x1p127f
+                                or __builtin_mul_overflow(static_cast<__int128>(value), static_cast<__int128>(converted), &product)
+                                );
+        __int128 quotient   = product / forward;
+        overflow            = overflow
+                           or quotient > std::numeric_limits<std::int64_t>::max()
+                           or quotient < std::numeric_limits<std::int64_t>::min();
+        std::int64_t limit  = (value < 0) != (converted < 0) ? std::numeric_limits<std::int64_t>::min()
+                                                             : std::numeric_limits<std::int64_t>::max();
+
+        if constexpr (instrumentation::ENABLED) {
+            if (overflow) { instrumentation::increment(instrumentation::Counter::saturation); }
+        }
+        return overflow ? limit : static_cast<std::int64_t>(quotient);
+    }
+
+    template <Quantity T>
+    T
+    add(const T& lhs, const T& rhs) requires requires(const T& x) { x + x; } {
+        return fixed::Access::make<T>(add(fixed::Access::raw(lhs), fixed::Access::raw(rhs)));
+    }
+
+    template <Quantity T>
+    T
+    subtract(const T& lhs, const T& rhs) requires requires(const T& x) { x - x; } {
+        return fixed::Access::make<T>(subtract(fixed::Access::raw(lhs), fixed::Access::raw(rhs)));
+    }
+
+    template <Quantity T>
+    T
+    negate(const T& quantity) requires requires(const T& x) { -x; } {
+        return fixed::Access::make<T>(subtract(0, fixed::Access::raw(quantity)));
+    }
+
+    template <Quantity T>
+    T
+    multiply(const T& quantity, float scalar) {
+        return fixed::Access::make<T>(multiply(fixed::Access::raw(quantity), scalar));
+    }
+
+    template <Quantity T>
+    T
+    multiply(float scalar, const T& quantity) {
+        return multiply(quantity, scalar);
+    }
+} // namespace saturating
+} // namespace ventilation
+
+#endif // VENTILATION_SATURATING_HPP__
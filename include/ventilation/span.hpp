@@ -0,0 +1,126 @@
+#ifndef VENTILATION_SPAN_HPP__
+#define VENTILATION_SPAN_HPP__
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include "ventilation/packed.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+    // Zero-copy view of a raw buffer in the library's own representation
+    template <Quantity T>
+    std::span<const T>
+    reinterpret(std::span<const std::int64_t> buffer) {
+        static_assert(sizeof(T) == sizeof(std::int64_t));
+        return {reinterpret_cast<const T*>(buffer.data()), buffer.size()};
+    }
+
+    template <Quantity T>
+    std::span<T>
+    reinterpret(std::span<std::int64_t> buffer) {
+        static_assert(sizeof(T) == sizeof(std::int64_t));
+        return {reinterpret_cast<T*>(buffer.data()), buffer.size()};
+    }
+
+    // Non-owning, possibly strided view of raw samples. Integer sources hold
+    // raw fixed-point values under policy P, float sources hold values in the
+    // quantity's unit; either way elements are decoded on access, nothing is
+    // copied up front. A stride selects one channel of interleaved frames.
+    // Integer sources must fit P's representation, which decoding converts
+    // them to.
+    template <Quantity T, typename Source = std::int64_t, typename P = fixed::Default>
+    requires    (std::signed_integral<Source> and sizeof(Source) <= sizeof(typename P::representation))
+            or  std::same_as<Source, float>
+    class QuantitySpan {
+        public:
+            using quantity  = T;
+            using source    = Source;
+            using policy    = P;
+
+            // True when elements can be used in place as a std::span<const T>
+            static constexpr bool NATIVE =
+                    std::same_as<Source, std::int64_t> and std::same_as<P, fixed::Default>;
+
+            QuantitySpan() : data_(nullptr), size_(0), stride_(1) {}
+
+            QuantitySpan(const Source* data, std::size_t size, std::size_t stride = 1)
+                : data_(data)
+                , size_(size)
+                , stride_(stride)
+            {
+                if (stride == 0) { throw std::invalid_argument("stride must be positive"); }
+            }
+
+            explicit QuantitySpan(std::span<const Source> values)
+                : QuantitySpan(values.data(), values.size(), 1)
+            {}
+
+            // One channel of `count` interleaved frames of `channels` samples each
+            static QuantitySpan
+            interleaved(const Source* frames, std::size_t count, std::size_t channels, std::size_t channel) {
+                if (channel >= channels) { throw std::out_of_range("channel out of range"); }
+                return QuantitySpan(frames + channel, count, channels);
+            }
+
+            const Source*
+            data() const { return data_; }
+
+            std::size_t
+            size() const { return size_; }
+
+            std::size_t
+            stride() const { return stride_; }
+
+            bool
+            empty() const { return size_ == 0; }
+
+            bool
+            contiguous() const { return NATIVE and stride_ == 1; }
+
+            // Raw value of element i in the default representation
+            std::int64_t
+            raw(std::size_t i) const {
+                if constexpr (std::same_as<Source, float>) {
+                    return fixed::Access::raw(T(data_[i * stride_]));
+                } else if constexpr (std::same_as<P, fixed::Default>) {
+                    return static_cast<std::int64_t>(data_[i * stride_]);
+                } else {
+                    return fixed::rescale<fixed::Default, P>(data_[i * stride_]);
+                }
+            }
+
+            T
+            operator[](std::size_t i) const { return fixed::Access::make<T>(raw(i)); }
+
+            QuantitySpan
+            subspan(std::size_t offset, std::size_t count) const {
+                if (offset > size_ or count > size_ - offset) { throw std::out_of_range("subspan out of range"); }
+                return QuantitySpan(data_ + offset * stride_, count, stride_);
+            }
+
+            // The elements in place, only for contiguous views of native values
+            std::span<const T>
+            span() const {
+                if constexpr (NATIVE) {
+                    if (stride_ == 1) { return reinterpret<T>(std::span<const std::int64_t>(data_, size_)); }
+                }
+                throw std::logic_error("view is not contiguous in the native representation");
+            }
+        private:
+            const Source*   data_;
+            std::size_t     size_;
+            std::size_t     stride_;
+    };
+
+    template <typename V>
+    concept View = requires {
+        typename V::quantity;
+        typename V::source;
+        typename V::policy;
+    } and std::same_as<V, QuantitySpan<typename V::quantity, typename V::source, typename V::policy>>;
+} // namespace ventilation
+
+#endif // VENTILATION_SPAN_HPP__
@@ -0,0 +1,95 @@
+#ifndef VENTILATION_SWEEP_HPP__
+#define VENTILATION_SWEEP_HPP__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "ventilation/mechanics.hpp"
+#include "ventilation/model.hpp"
+#include "ventilation/parallel.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace sweep {
+    // Cartesian product of parameter axes. Points are numbered with tidal
+    // volume varying fastest, then peep, compliance and resistance.
+    struct Grid {
+        std::vector<Resistance> resistance;
+        std::vector<Compliance> compliance;
+        std::vector<Pressure>   peep;
+        std::vector<Volume>     tidal;
+
+        std::size_t
+        size() const;
+
+        // Parameters of point i, throws std::out_of_range
+        model::Parameters
+        operator[](std::size_t i) const;
+    };
+
+    enum class Status : std::uint8_t {
+        computed    = 0,    // simulated by this run
+        cached      = 1,    // found in the cache
+        pruned      = 2,    // peak pressure above the limit, not simulated
+    };
+
+    struct Result {
+        model::Parameters   parameters;
+        Status              status;
+        mechanics::Breath   breath;     // left default when pruned
+    };
+
+    // Simulated breaths keyed on their parameters, at comparison granularity,
+    // for one set of breath timings. Safe to share between threads and to
+    // keep across runs, so a sweep that changes one axis only simulates the
+    // points that are new.
+    class Cache {
+        public:
+            explicit Cache(const model::Settings& settings);
+
+            const model::Settings&
+            settings() const { return settings_; }
+
+            std::optional<mechanics::Breath>
+            find(const model::Parameters& parameters) const;
+
+            void
+            insert(const model::Parameters& parameters, const mechanics::Breath& breath);
+
+            std::size_t
+            size() const;
+
+            void
+            clear();
+        private:
+            // Entries spread over independently locked shards, so concurrent
+            // lookups of different points rarely contend
+            static constexpr std::size_t SHARDS = 64;
+
+            struct alignas(64) Shard {
+                mutable std::mutex                                          mutex;
+                std::unordered_map<model::Parameters, mechanics::Breath>    entries;
+            };
+
+            Shard&
+            shard(const model::Parameters& parameters) const;
+
+            model::Settings                 settings_;
+            mutable std::array<Shard, SHARDS> shards_;
+    };
+
+    // Simulates every point of the grid, in grid order, with the settings of
+    // the cache. Points whose model::peak() exceeds `limit` are pruned along
+    // with every point of larger tidal volume on the same line, since peak
+    // pressure only grows with it. Lines of the grid are spread over the
+    // pool threads, which steal from each other when they run out.
+    std::vector<Result>
+    run(const Grid& grid, const Pressure& limit, Cache& cache, parallel::Pool& pool = parallel::shared());
+} // namespace sweep
+} // namespace ventilation
+
+#endif // VENTILATION_SWEEP_HPP__
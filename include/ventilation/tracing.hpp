@@ -0,0 +1,144 @@
+#ifndef VENTILATION_TRACING_HPP__
+#define VENTILATION_TRACING_HPP__
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "ventilation/instrumentation.hpp"
+
+namespace ventilation {
+namespace tracing {
+    // Scoped spans timing the stages of the library. Tracing is compiled in
+    // only when the library is built with VENTILATION_TRACING (meson option
+    // `tracing`); otherwise Scope is an empty object and VENTILATION_TRACE
+    // expands to a no-op that does not evaluate its name.
+    //
+    // A span costs two clock reads and a few stores into a ring buffer owned
+    // by its thread. The first span of a thread registers its ring, taking a
+    // lock and allocating CAPACITY slots of 32 bytes; every later span takes
+    // no lock and allocates nothing. Trace::collect() drains the rings of
+    // every thread into events, for export as a Chrome trace, and into a
+    // latency histogram per span name. A ring holds CAPACITY spans; older
+    // spans not yet collected are overwritten and counted as dropped. A ring
+    // is freed when its thread exits, its spans not yet collected kept for
+    // the next collection, up to CAPACITY spans over all exited threads.
+
+    // Spans a thread keeps between collections
+    inline constexpr std::size_t CAPACITY = 65536;
+
+    // Nanoseconds on the steady clock
+    inline std::uint64_t
+    now() noexcept {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+                ).count());
+    }
+
+#if defined(VENTILATION_TRACING)
+    inline constexpr bool ENABLED = true;
+
+    // Registers the ring of the calling thread now rather than at its first
+    // span, for threads such as control loops that must not lock or allocate
+    // once running
+    void
+    prepare();
+
+    // Records a span on the calling thread. The name must outlive every
+    // Trace that collects it, as string literals do.
+    void
+    record(const char* name, std::uint64_t begin, std::uint64_t end) noexcept;
+
+    // Span from construction to destruction
+    class Scope {
+        public:
+            explicit Scope(const char* name) noexcept : name_(name), begin_(now()) {}
+
+            ~Scope() { record(name_, begin_, now()); }
+
+            Scope(const Scope&)             = delete;
+            Scope& operator=(const Scope&)  = delete;
+        private:
+            const char*     name_;
+            std::uint64_t   begin_;
+    };
+
+#define VENTILATION_TRACE_JOIN_(a, b) a##b
+#define VENTILATION_TRACE_JOIN(a, b) VENTILATION_TRACE_JOIN_(a, b)
+#define VENTILATION_TRACE(name) \
+    const ::ventilation::tracing::Scope VENTILATION_TRACE_JOIN(ventilation_trace_, __LINE__)(name)
+#else
+    inline constexpr bool ENABLED = false;
+
+    inline void
+    prepare() {}
+
+    class Scope {
+        public:
+            explicit Scope(const char*) noexcept {}
+    };
+
+#define VENTILATION_TRACE(name) static_cast<void>(0)
+#endif
+
+    struct Event {
+        const char*     name;
+        std::uint64_t   begin;      // ns on the steady clock
+        std::uint64_t   duration;   // ns
+        std::uint32_t   thread;     // numbered from 1 in order of first span
+    };
+
+    // Latency of every span of one name
+    struct Summary {
+        std::string_view            name;
+        instrumentation::Latency    latency;
+    };
+
+    // Spans collected from every thread, in collection order per thread
+    class Trace {
+        public:
+            // Moves the spans recorded since the last collection, by this or
+            // any other Trace, into this one, those of exited threads first.
+            // Threads keep recording meanwhile; a span overwritten while
+            // being read is dropped.
+            void
+            collect();
+
+            std::span<const Event>
+            events() const { return events_; }
+
+            // Summaries in order of the first collection of each name
+            std::span<const Summary>
+            summaries() const { return summaries_; }
+
+            // Nullptr when no span of that name was collected
+            const instrumentation::Latency*
+            latency(std::string_view name) const;
+
+            // Spans overwritten, or discarded from exited threads, before
+            // they could be collected
+            std::uint64_t
+            dropped() const { return dropped_; }
+
+            // Forgets the events, keeping the summaries
+            void
+            clear() { events_.clear(); }
+        private:
+            std::vector<Event>                                  events_;
+            std::vector<Summary>                                summaries_;
+            std::unordered_map<std::string_view, std::size_t>   index_;     // summary of each name
+            std::uint64_t                                       dropped_ = 0;
+    };
+
+    // Chrome trace event format, complete events in microseconds, for
+    // chrome://tracing and Perfetto
+    void
+    chrome(std::ostream& os, const Trace& trace);
+} // namespace tracing
+} // namespace ventilation
+
+#endif // VENTILATION_TRACING_HPP__
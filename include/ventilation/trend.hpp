@@ -0,0 +1,247 @@
+#ifndef VENTILATION_TREND_HPP__
+#define VENTILATION_TREND_HPP__
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "ventilation/alarm.hpp"
+#include "ventilation/ventilation.hpp"
+
+namespace ventilation {
+namespace trend {
+    // Summary of one breath, as shown on trend screens. Times are in
+    // milliseconds from any fixed epoch.
+    struct Record {
+        std::int64_t    time;           // start of the breath
+        Volume          tidal;
+        Pressure        peak;
+        Pressure        plateau;
+        Resistance      resistance;
+        Compliance      compliance;
+    };
+
+    enum class Column : std::uint8_t {
+        tidal       = 0,
+        peak        = 1,
+        plateau     = 2,
+        resistance  = 3,
+        compliance  = 4,
+    };
+
+    constexpr std::size_t COLUMNS = 5;
+
+    // Records per block of the time index and of the block statistics
+    constexpr std::size_t BLOCK = 1024;
+
+    constexpr std::int64_t HOUR = 3600000;
+    constexpr std::int64_t DAY  = 24 * HOUR;
+
+    // Condition on one column, compiled like alarm::Rule into an inclusive
+    // interval of raw values equivalent to the comparison operators, so it
+    // can be checked against block minima and maxima as well as records.
+    // Throws std::invalid_argument when T is not the type of the column.
+    struct Predicate {
+        Column          column;
+        std::int64_t    low;
+        std::int64_t    high;
+
+        // value > threshold, e.g. plateau above 30 cmH2O
+        template <Quantity T>
+        static Predicate
+        above(Column column, const T& threshold);
+
+        // value < threshold
+        template <Quantity T>
+        static Predicate
+        below(Column column, const T& threshold);
+
+        // lower < value < upper
+        template <Quantity T>
+        static Predicate
+        within(Column column, const T& lower, const T& upper);
+    };
+
+    // Minimum, maximum and exact raw sum of one column over a rollup
+    template <Quantity T>
+    struct Aggregate {
+        T           minimum;
+        T           maximum;
+        __int128    sum     = 0;
+
+        // Rounded toward zero, the count must be positive
+        T
+        mean(std::uint64_t count) const {
+            return fixed::Access::make<T>(static_cast<std::int64_t>(sum / static_cast<__int128>(count)));
+        }
+    };
+
+    // Records of one hour or one day
+    struct Rollup {
+        std::int64_t            start;      // a multiple of the period
+        std::uint64_t           count       = 0;
+        Aggregate<Volume>       tidal;
+        Aggregate<Pressure>     peak;
+        Aggregate<Pressure>     plateau;
+        Aggregate<Resistance>   resistance;
+        Aggregate<Compliance>   compliance;
+    };
+
+    // Rows [begin, end) of a store
+    struct Rows {
+        std::size_t begin;
+        std::size_t end;
+
+        std::size_t
+        size() const { return end - begin; }
+    };
+
+    // Append-only store of breath summaries in columnar layout, kept in time
+    // order. Every BLOCK records form a block with the minimum and maximum
+    // of each column, so a predicate skips whole blocks it cannot match and
+    // accepts whole blocks it always matches; the first time of every block
+    // forms a small sorted index, searched before the time column itself.
+    // Hourly and daily rollups are updated with every append.
+    class Store {
+        public:
+            // Throws std::invalid_argument when the record is older than the
+            // latest one
+            void
+            append(const Record& record);
+
+            std::size_t
+            size() const { return time_.size(); }
+
+            Record
+            operator[](std::size_t row) const;
+
+            std::span<const std::int64_t>
+            time() const { return time_; }
+
+            std::span<const Volume>
+            tidal() const { return tidal_; }
+
+            std::span<const Pressure>
+            peak() const { return peak_; }
+
+            std::span<const Pressure>
+            plateau() const { return plateau_; }
+
+            std::span<const Resistance>
+            resistance() const { return resistance_; }
+
+            std::span<const Compliance>
+            compliance() const { return compliance_; }
+
+            // Rows with from <= time < to
+            Rows
+            rows(std::int64_t from, std::int64_t to) const;
+
+            // Appends the rows within `rows` matching every predicate, in
+            // order. Returns how many blocks were skipped without reading a
+            // record.
+            std::size_t
+            select(std::span<const Predicate> predicates, Rows rows, std::vector<std::size_t>& output) const;
+
+            // Rollups in time order, only for periods holding records
+            std::span<const Rollup>
+            hourly() const { return hours_; }
+
+            std::span<const Rollup>
+            daily() const { return days_; }
+
+            // Rollups starting within [from, to)
+            std::span<const Rollup>
+            hourly(std::int64_t from, std::int64_t to) const;
+
+            std::span<const Rollup>
+            daily(std::int64_t from, std::int64_t to) const;
+        private:
+            struct Block {
+                std::array<std::int64_t, COLUMNS>   minimum;
+                std::array<std::int64_t, COLUMNS>   maximum;
+            };
+
+            std::span<const std::int64_t>
+            raw(Column column) const;
+
+            std::vector<std::int64_t>   time_;
+            std::vector<Volume>         tidal_;
+            std::vector<Pressure>       peak_;
+            std::vector<Pressure>       plateau_;
+            std::vector<Resistance>     resistance_;
+            std::vector<Compliance>     compliance_;
+            std::vector<Block>          blocks_;
+            std::vector<std::int64_t>   index_;     // first time of every block
+            std::vector<Rollup>         hours_;
+            std::vector<Rollup>         days_;
+    };
+
+namespace detail {
+    template <Quantity T>
+    bool
+    holds(Column column) {
+        switch (column) {
+            case Column::tidal:         return std::same_as<T, Volume>;
+            case Column::peak:          return std::same_as<T, Pressure>;
+            case Column::plateau:       return std::same_as<T, Pressure>;
+            case Column::resistance:    return std::same_as<T, Resistance>;
+            case Column::compliance:    return std::same_as<T, Compliance>;
+        }
+        return false;
+    }
+
+    // Predicate over [low, high] clipped to the int64 range, never matching
+    // when the clipped interval is empty
+    Predicate
+    predicate(Column column, __int128 low, __int128 high);
+
+    template <Quantity T>
+    void
+    validate(Column column) {
+        if (not holds<T>(column)) {
+            throw std::invalid_argument("quantity does not match the column");
+        }
+    }
+} // namespace detail
+
+    template <Quantity T>
+    Predicate
+    Predicate::above(Column column, const T& threshold) {
+        detail::validate<T>(column);
+        return detail::predicate(
+                column
+                , alarm::detail::above(fixed::Access::raw(threshold))
+                , std::numeric_limits<std::int64_t>::max()
+                );
+    }
+
+    template <Quantity T>
+    Predicate
+    Predicate::below(Column column, const T& threshold) {
+        detail::validate<T>(column);
+        return detail::predicate(
+                column
+                , std::numeric_limits<std::int64_t>::min()
+                , alarm::detail::below(fixed::Access::raw(threshold))
+                );
+    }
+
+    template <Quantity T>
+    Predicate
+    Predicate::within(Column column, const T& lower, const T& upper) {
+        detail::validate<T>(column);
+        return detail::predicate(
+                column
+                , alarm::detail::above(fixed::Access::raw(lower))
+                , alarm::detail::below(fixed::Access::raw(upper))
+                );
+    }
+} // namespace trend
+} // namespace ventilation
+
+#endif // VENTILATION_TREND_HPP__
@@ -1,19 +1,54 @@
 #ifndef VENTILATION_HPP__
 #define VENTILATION_HPP__
 
+#include <concepts>
 #include <cstdint>
 #include <cmath>
+#include <span>
 #include <stdexcept>
 #include <format>
+#include <functional>
+#include <type_traits>
+#include <utility>
 
 namespace ventilation {
+namespace fixed {
+    // Storage width, scale and comparison granularity of a fixed-point
+    // representation: a value v is stored as v * Forward, and two values
+    // compare equal when they agree after division by Precision.
+    template <std::signed_integral Rep, Rep Forward, Rep Precision>
+    struct Policy {
+        static_assert(Forward > 0, "scale must be positive");
+        static_assert(Precision > 0, "precision must be positive");
+
+        using representation = Rep;
+
+        static constexpr Rep forward    = Forward;
+        static constexpr Rep precision  = Precision;
+    };
+
+    // Representation of every quantity class below
+    using Default   = Policy<std::int64_t, 1000000, 1000>;
+    // Half-width storage with the same comparison granularity, for waveforms
+    using Narrow    = Policy<std::int32_t, 1000, 1>;
+
+    inline constexpr float FORWARD          = 1e+6f;
+    inline constexpr float INVERSE          = 1e-6f;
+    inline constexpr std::int64_t PRECISION = Default::precision;
+
+    static_assert(FORWARD == static_cast<float>(Default::forward));
+
+    struct Access;
+} // namespace fixed
     // Forward declaration
     class Compliance;
     class Elastance;
     class Flow;
+    class Power;
     class Pressure;
     class Resistance;
     class Volume;
+    class Work;
 
     class Compliance {
         public:
@@ -51,6 +86,7 @@ namespace ventilation {
             friend std::ostream&
             operator<<(std::ostream& os, const Compliance& compliance);
         private:
+            friend struct fixed::Access;
 
             Compliance(std::int64_t v);
 
@@ -93,6 +129,8 @@ namespace ventilation {
             friend std::ostream&
             operator<<(std::ostream& os, const Elastance& elastance);
         private:
+            friend struct fixed::Access;
+
             Elastance(std::int64_t v);
 
             std::int64_t value_;
@@ -143,11 +181,65 @@ namespace ventilation {
             friend std::ostream&
             operator<<(std::ostream& os, const Flow& flow);
         private:
+            friend struct fixed::Access;
+
             Flow(std::int64_t v);
 
             std::int64_t value_;
     };
 
+    class Power {
+        public:
+            Power();
+            explicit Power(float v);
+            explicit operator float() const;
+
+            friend std::strong_ordering
+            operator<=>(const Power& lhs, const Power& rhs);
+
+            friend bool
+            operator==(const Power& lhs, const Power& rhs);
+
+            friend bool
+            operator!=(const Power& lhs, const Power& rhs);
+
+            friend bool
+            operator<(const Power& lhs, const Power& rhs);
+
+            friend bool
+            operator<=(const Power& lhs, const Power& rhs);
+
+            friend bool
+            operator>(const Power& lhs, const Power& rhs);
+
+            friend bool
+            operator>=(const Power& lhs, const Power& rhs);
+
+            friend Power
+            operator+(const Power& lhs, const Power& rhs);
+
+            friend Power
+            operator-(const Power& lhs);
+
+            friend Power
+            operator-(const Power& lhs, const Power& rhs);
+
+            friend Power
+            operator*(const Power& power, float scalar);
+
+            friend Power
+            operator*(float scalar, const Power& power);
+
+            friend std::ostream&
+            operator<<(std::ostream& os, const Power& power);
+        private:
+            friend struct fixed::Access;
+
+            Power(std::int64_t v);
+
+            std::int64_t value_;
+    };
+
     class Pressure {
         public:
             Pressure();
@@ -193,6 +285,8 @@ namespace ventilation {
             friend std::ostream&
             operator<<(std::ostream& os, const Pressure& pressure);
         private:
+            friend struct fixed::Access;
+
             Pressure(std::int64_t v);
 
             std::int64_t value_;
@@ -234,6 +328,8 @@ namespace ventilation {
             friend std::ostream&
             operator<<(std::ostream& os, const Resistance& resistance);
         private:
+            friend struct fixed::Access;
+
             Resistance(std::int64_t v);
 
             std::int64_t value_;
@@ -284,10 +380,134 @@ namespace ventilation {
             friend std::ostream&
             operator<<(std::ostream& os, const Volume& volume);
         private:
+            friend struct fixed::Access;
+
             Volume(std::int64_t v);
 
             std::int64_t value_;
     };
+
+    class Work {
+        public:
+            Work();
+            explicit Work(float v);
+            explicit operator float() const;
+
+            friend std::strong_ordering
+            operator<=>(const Work& lhs, const Work& rhs);
+
+            friend bool
+            operator==(const Work& lhs, const Work& rhs);
+
+            friend bool
+            operator!=(const Work& lhs, const Work& rhs);
+
+            friend bool
+            operator<(const Work& lhs, const Work& rhs);
+
+            friend bool
+            operator<=(const Work& lhs, const Work& rhs);
+
+            friend bool
+            operator>(const Work& lhs, const Work& rhs);
+
+            friend bool
+            operator>=(const Work& lhs, const Work& rhs);
+
+            friend Work
+            operator+(const Work& lhs, const Work& rhs);
+
+            friend Work
+            operator-(const Work& lhs);
+
+            friend Work
+            operator-(const Work& lhs, const Work& rhs);
+
+            friend Work
+            operator*(const Work& work, float scalar);
+
+            friend Work
+            operator*(float scalar, const Work& work);
+
+            friend std::ostream&
+            operator<<(std::ostream& os, const Work& work);
+        private:
+            friend struct fixed::Access;
+
+            Work(std::int64_t v);
+
+            std::int64_t value_;
+    };
+
+    template <typename T>
+    concept Quantity =
+           std::same_as<T, Compliance>
+        or std::same_as<T, Elastance>
+        or std::same_as<T, Flow>
+        or std::same_as<T, Power>
+        or std::same_as<T, Pressure>
+        or std::same_as<T, Resistance>
+        or std::same_as<T, Volume>
+        or std::same_as<T, Work>;
+
+namespace fixed {
+    // Raw access to the fixed-point representation, for batch kernels, packed
+    // storage and views that operate on whole arrays of quantities at once.
+    struct Access {
+        template <typename T>
+        using representation = decltype(std::declval<const T&>().value_);
+
+        template <typename T>
+        static representation<T>
+        raw(const T& quantity) { return quantity.value_; }
+
+        template <typename T>
+        static T
+        make(representation<T> value) { return T(value); }
+
+        template <typename T>
+        static std::span<const representation<T>>
+        raw(std::span<const T> quantities) {
+            static_assert(sizeof(T) == sizeof(representation<T>));
+            static_assert(std::is_standard_layout_v<T>);
+            return {reinterpret_cast<const representation<T>*>(quantities.data()), quantities.size()};
+        }
+
+        template <typename T>
+        static std::span<representation<T>>
+        raw(std::span<T> quantities) {
+            static_assert(sizeof(T) == sizeof(representation<T>));
+            static_assert(std::is_standard_layout_v<T>);
+            return {reinterpret_cast<representation<T>*>(quantities.data()), quantities.size()};
+        }
+
+        // Quantities over raw values, such as a mapped file
+        template <typename T>
+        static std::span<const T>
+        view(std::span<const representation<T>> values) {
+            static_assert(sizeof(T) == sizeof(representation<T>));
+            static_assert(std::is_standard_layout_v<T>);
+            return {reinterpret_cast<const T*>(values.data()), values.size()};
+        }
+    };
+
+    // Same test as quantity > T(0) on a raw value, without the division of
+    // operator<=>
+    inline bool
+    positive(std::int64_t value) {
+        return value >= PRECISION;
+    }
+} // namespace fixed
 } // namespace ventilation
 
+// Hashes the value at comparison granularity, so values that compare equal
+// hash equal
+template <ventilation::Quantity T>
+struct std::hash<T> {
+    std::size_t
+    operator()(const T& quantity) const noexcept {
+        return std::hash<std::int64_t>()(ventilation::fixed::Access::raw(quantity) / ventilation::fixed::PRECISION);
+    }
+};
+
 #endif // VENTILATION_HPP__
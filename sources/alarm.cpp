@@ -0,0 +1,136 @@
+#include "ventilation/alarm.hpp"
+#include "ventilation/kernels.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace ventilation {
+namespace alarm {
+namespace detail {
+    __int128
+    above(std::int64_t threshold) {
+        // x / P > q exactly when x / P >= q + 1; truncation toward zero makes
+        // the quotient q + 1 start P - 1 below (q + 1) * P when it is not positive
+        const __int128 precision = fixed::PRECISION;
+        __int128 quotient = threshold / fixed::PRECISION + 1;
+        return quotient > 0 ? quotient * precision : quotient * precision - (precision - 1);
+    }
+
+    __int128
+    below(std::int64_t threshold) {
+        // x / P < q exactly when x / P <= q - 1
+        const __int128 precision = fixed::PRECISION;
+        __int128 quotient = threshold / fixed::PRECISION - 1;
+        return quotient < 0 ? quotient * precision : quotient * precision + (precision - 1);
+    }
+
+    Rule
+    rule(Signal signal, __int128 low, __int128 high, std::uint32_t debounce, bool latching) {
+        constexpr std::int64_t minimum = std::numeric_limits<std::int64_t>::min();
+        constexpr std::int64_t maximum = std::numeric_limits<std::int64_t>::max();
+
+        if (low > maximum or high < minimum or low > high) {
+            return {signal, maximum, minimum, debounce, latching};
+        }
+        return {
+              signal
+            , static_cast<std::int64_t>(low < minimum ? minimum : low)
+            , static_cast<std::int64_t>(high > maximum ? maximum : high)
+            , debounce
+            , latching
+        };
+    }
+} // namespace detail
+
+    Engine::Engine(std::span<const Rule> rules, std::size_t beds)
+        : rules_(rules.begin(), rules.end())
+        , beds_(beds)
+        , low_(rules.size() * beds)
+        , high_(rules.size() * beds)
+        , count_(rules.size() * beds, 0)
+        , state_(rules.size() * beds, 0)
+    {
+        for (std::size_t r = 0; r < rules_.size(); r++) {
+            if (rules_[r].debounce == 0) {
+                throw std::invalid_argument("rule debounce must be at least one sample");
+            }
+            std::fill_n(low_.begin() + r * beds_, beds_, rules_[r].low);
+            std::fill_n(high_.begin() + r * beds_, beds_, rules_[r].high);
+        }
+    }
+
+    std::size_t
+    Engine::index(std::size_t rule, std::size_t bed) const {
+        if (rule >= rules_.size() or bed >= beds_) {
+            throw std::out_of_range("rule or bed out of range");
+        }
+        return rule * beds_ + bed;
+    }
+
+    void
+    Engine::configure(std::size_t rule, std::size_t bed, const Rule& thresholds) {
+        std::size_t i = index(rule, bed);
+        if (thresholds.signal != rules_[rule].signal) {
+            throw std::invalid_argument("thresholds must watch the same signal as the rule");
+        }
+        low_[i]     = thresholds.low;
+        high_[i]    = thresholds.high;
+    }
+
+    void
+    Engine::evaluate(
+          std::span<const Pressure> pressure
+        , std::span<const Flow> flow
+        , std::span<const Volume> volume
+        , std::vector<Event>& events
+        )
+    {
+        if (pressure.size() != beds_ or flow.size() != beds_ or volume.size() != beds_) {
+            throw std::invalid_argument("every signal must have one sample per bed");
+        }
+        const std::int64_t* signals[] = {
+              fixed::Access::raw(pressure).data()
+            , fixed::Access::raw(flow).data()
+            , fixed::Access::raw(volume).data()
+        };
+        const kernels::Table& table = kernels::active();
+
+        tick_++;
+        for (std::size_t r = 0; r < rules_.size(); r++) {
+            std::size_t offset = r * beds_;
+            std::size_t changed = table.debounce(
+                    signals[static_cast<std::size_t>(rules_[r].signal)]
+                    , low_.data() + offset
+                    , high_.data() + offset
+                    , rules_[r].debounce
+                    , rules_[r].latching
+                    , count_.data() + offset
+                    , state_.data() + offset
+                    , beds_
+                    );
+            // Edges are rare, the scan only runs for rules that have any
+            for (std::size_t bed = 0; changed > 0 and bed < beds_; bed++) {
+                std::uint8_t& state = state_[offset + bed];
+                if (state & 2) {
+                    state &= 1;
+                    events.push_back({tick_, bed, r, (state & 1) ? Edge::raised : Edge::cleared});
+                    changed--;
+                }
+            }
+        }
+    }
+
+    bool
+    Engine::active(std::size_t rule, std::size_t bed) const {
+        return state_[index(rule, bed)] & 1;
+    }
+
+    void
+    Engine::acknowledge(std::size_t rule, std::size_t bed, std::vector<Event>& events) {
+        std::size_t i = index(rule, bed);
+        if ((state_[i] & 1) and count_[i] < rules_[rule].debounce) {
+            state_[i] = 0;
+            events.push_back({tick_, bed, rule, Edge::cleared});
+        }
+    }
+} // namespace alarm
+} // namespace ventilation
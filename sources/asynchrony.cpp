@@ -0,0 +1,201 @@
+#include "ventilation/asynchrony.hpp"
+#include "ventilation/instrumentation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace ventilation {
+namespace asynchrony {
+namespace {
+    // Parts per pool thread in classify(), so uneven breaths still balance
+    constexpr std::size_t PARTS = 4;
+
+    Volume
+    volume(std::int64_t sum, double period) {
+        return fixed::Access::make<Volume>(static_cast<std::int64_t>(std::llround(static_cast<double>(sum) * period)));
+    }
+} // namespace
+    Detector::Detector(float period, const Thresholds& thresholds) {
+        if (not std::isfinite(period) or not (period > 0.0f)) {
+            instrumentation::increment(instrumentation::Counter::domain);
+            throw std::domain_error("sampling period must be finite and positive");
+        }
+        if (    thresholds.effort < Flow(0.0f)
+            or  thresholds.dip < Pressure(0.0f)
+            or  not (thresholds.early >= 0.0f) or not std::isfinite(thresholds.early)
+            or  not (thresholds.ratio >= 0.0f) or not std::isfinite(thresholds.ratio))
+        {
+            throw std::invalid_argument("thresholds must be finite and non-negative");
+        }
+        period_ = period;
+        effort_ = fixed::Access::raw(thresholds.effort);
+        dip_    = fixed::Access::raw(thresholds.dip);
+        early_  = static_cast<std::uint32_t>(std::min(std::llround(thresholds.early / period), 0xffffffffll));
+        ratio_  = thresholds.ratio;
+    }
+
+    std::optional<Breath>
+    Detector::push(const Pressure& pressure, const Flow& flow) {
+        const std::int64_t p    = fixed::Access::raw(pressure);
+        const std::int64_t f    = fixed::Access::raw(flow);
+        const bool now          = fixed::positive(f);
+
+        std::optional<Breath> result;
+        if (now and not positive_) {
+            if (started_) { result = finish(); }
+            started_    = true;
+            start_      = samples_;
+            begin();
+        }
+        positive_ = now;
+        samples_++;
+        if (not started_) { return result; }
+
+        pressure_ = std::max(pressure_, p);
+        if (expiration_ == 0 and now) {
+            inspiration_++;
+            peak_       = std::max(peak_, f);
+            inspired_  += f;
+            return result;
+        }
+
+        if (expiration_ == 0) { rearm(p, f); }
+        expiration_++;
+        expired_   -= f;
+
+        trough_     = std::min(trough_, p);
+        recovery_   = std::max(recovery_, p - trough_);
+        if (not rising_) {
+            lowest_ = std::min(lowest_, f);
+            if (f - lowest_ >= effort_) {
+                rising_ = true;
+                crest_  = f;
+                summit_ = expiration_;
+            }
+        } else {
+            if (f > crest_) {
+                crest_  = f;
+                summit_ = expiration_;
+            }
+            if (2 * (crest_ - f) >= effort_) {
+                if (recovery_ >= dip_) {
+                    efforts_++;
+                    if (summit_ <= early_) { premature_++; }
+                }
+                rearm(p, f);
+            }
+        }
+        return result;
+    }
+
+    void
+    Detector::push(std::span<const Pressure> pressure, std::span<const Flow> flow, std::vector<Breath>& output) {
+        if (pressure.size() != flow.size()) {
+            throw std::invalid_argument("pressure and flow sizes differ");
+        }
+        for (std::size_t i = 0; i < flow.size(); i++) {
+            if (std::optional<Breath> breath = push(pressure[i], flow[i])) {
+                output.push_back(*breath);
+            }
+        }
+    }
+
+    void
+    Detector::begin() {
+        inspiration_    = 0;
+        expiration_     = 0;
+        peak_           = 0;
+        pressure_       = std::numeric_limits<std::int64_t>::min();
+        inspired_       = 0;
+        expired_        = 0;
+        efforts_        = 0;
+        premature_      = 0;
+    }
+
+    void
+    Detector::rearm(std::int64_t pressure, std::int64_t flow) {
+        rising_     = false;
+        lowest_     = flow;
+        crest_      = flow;
+        summit_     = expiration_;
+        trough_     = pressure;
+        recovery_   = 0;
+    }
+
+    Breath
+    Detector::finish() const {
+        Breath breath;
+        breath.start        = start_;
+        breath.inspiration  = inspiration_;
+        breath.expiration   = expiration_;
+        breath.peak         = fixed::Access::make<Flow>(peak_);
+        breath.pressure     = fixed::Access::make<Pressure>(pressure_);
+        breath.inspired     = volume(inspired_, period_);
+        breath.expired      = volume(expired_, period_);
+        breath.efforts      = efforts_;
+
+        if (static_cast<double>(expiration_) < ratio_ * static_cast<double>(inspiration_)) {
+            breath.type = Type::double_trigger;
+        } else if (premature_ > 0) {
+            breath.type = Type::premature;
+        } else if (efforts_ > 0) {
+            breath.type = Type::ineffective;
+        } else {
+            breath.type = Type::normal;
+        }
+        return breath;
+    }
+
+    std::vector<Breath>
+    classify(
+          std::span<const Pressure> pressure
+        , std::span<const Flow> flow
+        , float period
+        , const Thresholds& thresholds
+        , parallel::Pool& pool
+        )
+    {
+        if (pressure.size() != flow.size()) {
+            throw std::invalid_argument("pressure and flow sizes differ");
+        }
+        const Detector prototype(period, thresholds);
+        std::span<const std::int64_t> raw = fixed::Access::raw(flow);
+
+        // Every part but the first starts at an onset, the later the part
+        // the later the onset
+        const std::size_t size  = raw.size();
+        const std::size_t parts = std::min(pool.size() * PARTS, std::max<std::size_t>(size / 4096, 1));
+        std::vector<std::size_t> cuts = {0};
+        for (std::size_t k = 1; k < parts; k++) {
+            std::size_t i = std::max(k * size / parts, cuts.back() + 1);
+            while (i < size and not (fixed::positive(raw[i]) and not fixed::positive(raw[i - 1]))) {
+                i++;
+            }
+            if (i >= size) { break; }
+            cuts.push_back(i);
+        }
+
+        // A part also takes the sample before its first onset, so the onset
+        // is seen as one, and the onset after its end, which closes its last
+        // breath
+        std::vector<std::vector<Breath>> breaths(cuts.size());
+        pool.run(cuts.size(), [&](std::size_t k) {
+            const std::size_t from  = k == 0 ? 0 : cuts[k] - 1;
+            const std::size_t to    = k + 1 == cuts.size() ? size : cuts[k + 1] + 1;
+
+            Detector detector = prototype;
+            detector.push(pressure.subspan(from, to - from), flow.subspan(from, to - from), breaths[k]);
+            for (Breath& breath : breaths[k]) {
+                breath.start += from;
+            }
+        });
+
+        std::vector<Breath> result;
+        for (const std::vector<Breath>& part : breaths) {
+            result.insert(result.end(), part.begin(), part.end());
+        }
+        return result;
+    }
+} // namespace asynchrony
+} // namespace ventilation
@@ -0,0 +1,94 @@
+#include "ventilation/calibration.hpp"
+#include "ventilation/instrumentation.hpp"
+#include "ventilation/tracing.hpp"
+#include <cstdlib>
+#include <limits>
+
+namespace ventilation {
+namespace calibration {
+namespace {
+    // numerator / denominator to the nearest integer, halves upward, for a
+    // positive denominator
+    std::int64_t
+    divide(__int128 numerator, __int128 denominator) {
+        __int128 n = 2 * numerator + denominator;
+        __int128 d = 2 * denominator;
+        __int128 q = n / d;
+        if (n % d < 0) { q--; }
+        return static_cast<std::int64_t>(q);
+    }
+} // namespace
+    Knots
+    compile(std::span<const std::int32_t> counts, std::span<const std::int64_t> values, std::uint32_t segments) {
+        VENTILATION_TRACE("calibration::compile");
+        if (counts.size() != values.size()) {
+            throw std::invalid_argument("counts and values sizes differ");
+        }
+        if (counts.size() < 2) {
+            throw std::invalid_argument("calibration needs at least two points");
+        }
+        for (std::size_t i = 1; i < counts.size(); i++) {
+            if (counts[i] <= counts[i - 1]) {
+                throw std::invalid_argument("counts must be strictly increasing");
+            }
+        }
+
+        // Segments of 2^shift counts, at most 2^31 so the kernels can split
+        // their products into 32-bit halves
+        const std::int64_t span = static_cast<std::int64_t>(counts.back()) - counts.front();
+        std::uint32_t shift = 0;
+        while ((static_cast<std::int64_t>(segments) << shift) < span) {
+            shift++;
+        }
+        if (shift > 31) {
+            segments <<= shift - 31;
+            shift = 31;
+        }
+
+        Knots knots;
+        knots.base  = counts.front();
+        knots.last  = counts.back();
+        knots.shift = shift;
+        knots.values.resize(static_cast<std::size_t>(segments) + 1);
+
+        std::size_t j = 0;
+        for (std::size_t k = 0; k <= segments; k++) {
+            const std::int64_t count = knots.base + (static_cast<std::int64_t>(k) << shift);
+            if (count >= counts.back()) {
+                knots.values[k] = values.back();
+                continue;
+            }
+            while (counts[j + 1] <= count) { j++; }
+            const __int128 rise = static_cast<__int128>(values[j + 1]) - values[j];
+            const __int128 run  = static_cast<__int128>(counts[j + 1]) - counts[j];
+            knots.values[k] = values[j] + divide(rise * (count - counts[j]), run);
+        }
+
+        // A difference times a fraction of up to 2^shift must fit the kernels
+        const __int128 steepest = std::numeric_limits<std::int64_t>::max() >> shift;
+        for (std::size_t k = 0; k < segments; k++) {
+            const __int128 rise = static_cast<__int128>(knots.values[k + 1]) - knots.values[k];
+            if (rise > steepest or -rise > steepest) {
+                instrumentation::increment(instrumentation::Counter::range);
+                throw std::out_of_range("calibration curve too steep for its segments");
+            }
+        }
+
+        std::vector<std::int64_t> table(counts.size());
+        kernels::reference().interpolate(
+                  counts.data()
+                , knots.base
+                , knots.shift
+                , segments
+                , knots.values.data()
+                , table.data()
+                , counts.size()
+                );
+        knots.error = 0;
+        for (std::size_t i = 0; i < counts.size(); i++) {
+            knots.error = std::max(knots.error, std::abs(table[i] - values[i]));
+        }
+        return knots;
+    }
+} // namespace calibration
+} // namespace ventilation
@@ -0,0 +1,376 @@
+#include "ventilation/cohort.hpp"
+#include "ventilation/instrumentation.hpp"
+#include <limits>
+#include <numeric>
+
+namespace ventilation {
+namespace cohort {
+namespace {
+    // Open-addressing hash table of composite keys, `width` codes each,
+    // numbering them in order of first appearance
+    class Table {
+        public:
+            explicit Table(std::size_t width) : width_(width), slots_(16, 0) {}
+
+            std::size_t
+            size() const { return size_; }
+
+            std::span<const std::int64_t>
+            key(std::size_t id) const { return {keys_.data() + id * width_, width_}; }
+
+            // Id of the key, inserting it when new
+            std::uint32_t
+            find(const std::int64_t* key) {
+                if (2 * (size_ + 1) > slots_.size()) { grow(); }
+
+                const std::size_t mask = slots_.size() - 1;
+                for (std::size_t slot = hash(key) & mask;; slot = (slot + 1) & mask) {
+                    const std::uint32_t entry = slots_[slot];
+                    if (entry == 0) {
+                        keys_.insert(keys_.end(), key, key + width_);
+                        slots_[slot] = static_cast<std::uint32_t>(++size_);
+                        return static_cast<std::uint32_t>(size_ - 1);
+                    }
+                    if (std::equal(key, key + width_, keys_.data() + (entry - 1) * width_)) {
+                        return entry - 1;
+                    }
+                }
+            }
+
+            std::uint64_t
+            hash(const std::int64_t* key) const {
+                std::uint64_t h = 0x9e3779b97f4a7c15ull;
+                for (std::size_t k = 0; k < width_; k++) {
+                    h = (h ^ static_cast<std::uint64_t>(key[k])) * 0xbf58476d1ce4e5b9ull;
+                    h ^= h >> 31;
+                }
+                return h;
+            }
+        private:
+            void
+            grow() {
+                std::vector<std::uint32_t> slots(slots_.size() * 2, 0);
+                const std::size_t mask = slots.size() - 1;
+                for (std::size_t id = 0; id < size_; id++) {
+                    std::size_t slot = hash(keys_.data() + id * width_) & mask;
+                    while (slots[slot] != 0) { slot = (slot + 1) & mask; }
+                    slots[slot] = static_cast<std::uint32_t>(id + 1);
+                }
+                slots_.swap(slots);
+            }
+
+            std::size_t                 width_;
+            std::vector<std::int64_t>   keys_;
+            std::vector<std::uint32_t>  slots_;     // id + 1, zero when empty
+            std::size_t                 size_ = 0;
+    };
+
+    // Groups of a table with their counts, exact sums and extrema of every
+    // aggregation, group-major
+    struct Groups {
+        Table                       table;
+        std::size_t                 count;
+        std::vector<std::uint64_t>  counts;
+        std::vector<__int128>       sums;
+        std::vector<std::int64_t>   minimum;
+        std::vector<std::int64_t>   maximum;
+
+        Groups(std::size_t width, std::size_t count) : table(width), count(count) {}
+
+        // Id of the key, with empty aggregates when new
+        std::uint32_t
+        find(const std::int64_t* key) {
+            const std::uint32_t id = table.find(key);
+            if (id == counts.size()) {
+                counts.push_back(0);
+                sums.resize(sums.size() + count, 0);
+                minimum.resize(minimum.size() + count, std::numeric_limits<std::int64_t>::max());
+                maximum.resize(maximum.size() + count, std::numeric_limits<std::int64_t>::min());
+            }
+            return id;
+        }
+
+        // Adds the aggregates of a group of another table to those of group id
+        void
+        merge(std::uint32_t id, const Groups& other, std::size_t from) {
+            counts[id] += other.counts[from];
+            for (std::size_t a = 0; a < count; a++) {
+                sums[id * count + a]    += other.sums[from * count + a];
+                minimum[id * count + a] = std::min(minimum[id * count + a], other.minimum[from * count + a]);
+                maximum[id * count + a] = std::max(maximum[id * count + a], other.maximum[from * count + a]);
+            }
+        }
+    };
+
+    // Partial aggregates of the rows of one pool participant
+    struct Partial {
+        Groups                                  groups;
+        std::vector<std::uint32_t>              ids;        // local group of every row, for medians
+        std::vector<std::vector<std::uint32_t>> buckets;    // local groups of each partition
+
+        Partial(std::size_t width, std::size_t count) : groups(width, count) {}
+    };
+
+    // Partition of a key among `partitions`, by the high bits of its hash as
+    // the low ones place it within a table
+    std::size_t
+    partition(const Table& table, std::size_t id, std::size_t partitions) {
+        return static_cast<std::size_t>(table.hash(table.key(id).data()) >> 32) % partitions;
+    }
+} // namespace
+
+    Result
+    group(
+          std::span<const std::span<const std::int64_t>> keys
+        , std::span<const std::span<const std::int64_t>> columns
+        , std::span<const Aggregation> aggregations
+        , parallel::Pool& pool
+        )
+    {
+        std::size_t rows = 0;
+        if (not keys.empty()) {
+            rows = keys.front().size();
+        } else if (not columns.empty()) {
+            rows = columns.front().size();
+        }
+        for (std::span<const std::int64_t> column : keys) {
+            if (column.size() != rows) { throw std::invalid_argument("columns must have the same size"); }
+        }
+        for (std::span<const std::int64_t> column : columns) {
+            if (column.size() != rows) { throw std::invalid_argument("columns must have the same size"); }
+        }
+        bool medians = false;
+        for (const Aggregation& aggregation : aggregations) {
+            if (aggregation.function != Function::count and aggregation.column >= columns.size()) {
+                throw std::out_of_range("aggregation of a missing column");
+            }
+            medians = medians or aggregation.function == Function::median;
+        }
+        if (medians and rows > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::invalid_argument("too many rows for medians");
+        }
+
+        const std::size_t width = keys.size();
+        const std::size_t count = aggregations.size();
+        // Column of every aggregation, counts reading none
+        std::vector<const std::int64_t*> sources(count, nullptr);
+        for (std::size_t a = 0; a < count; a++) {
+            if (aggregations[a].function != Function::count) {
+                sources[a] = columns[aggregations[a].column].data();
+            }
+        }
+
+        // Partial aggregates per participant, each over a contiguous run of
+        // chunks, bucketed by partition for the merge
+        const std::size_t chunks        = (rows + CHUNK - 1) / CHUNK;
+        const std::size_t participants  = std::min(pool.size(), chunks);
+        std::vector<Partial> partials(participants, Partial(width, count));
+        pool.run(participants, [&](std::size_t p) {
+            Partial& partial    = partials[p];
+            Groups& groups      = partial.groups;
+            const std::size_t first = chunks * p / participants * CHUNK;
+            const std::size_t last  = std::min(rows, chunks * (p + 1) / participants * CHUNK);
+            if (medians) { partial.ids.resize(last - first); }
+
+            std::vector<std::int64_t> key(width);
+            for (std::size_t row = first; row < last; row++) {
+                for (std::size_t k = 0; k < width; k++) {
+                    key[k] = keys[k][row];
+                }
+                const std::uint32_t id = groups.find(key.data());
+                if (medians) { partial.ids[row - first] = id; }
+
+                groups.counts[id]++;
+                const std::size_t base = static_cast<std::size_t>(id) * count;
+                for (std::size_t a = 0; a < count; a++) {
+                    if (sources[a] == nullptr) { continue; }
+                    const std::int64_t value = sources[a][row];
+                    groups.sums[base + a]       += value;
+                    groups.minimum[base + a]    = std::min(groups.minimum[base + a], value);
+                    groups.maximum[base + a]    = std::max(groups.maximum[base + a], value);
+                }
+            }
+
+            partial.buckets.resize(participants);
+            for (std::uint32_t id = 0; id < groups.table.size(); id++) {
+                partial.buckets[partition(groups.table, id, participants)].push_back(id);
+            }
+        });
+
+        // Merged in parallel by partition, each folding the participants in
+        // row order; local ids are mapped to ids within their partition
+        std::vector<Groups> merged(participants, Groups(width, count));
+        std::vector<std::vector<std::uint32_t>> mapping(participants);
+        for (std::size_t p = 0; p < participants; p++) {
+            mapping[p].resize(partials[p].groups.table.size());
+        }
+        pool.run(participants, [&](std::size_t q) {
+            Groups& target = merged[q];
+            for (std::size_t p = 0; p < participants; p++) {
+                const Groups& groups = partials[p].groups;
+                for (std::uint32_t id : partials[p].buckets[q]) {
+                    const std::uint32_t m = target.find(groups.table.key(id).data());
+                    target.merge(m, groups, id);
+                    mapping[p][id] = m;
+                }
+            }
+        });
+        std::vector<std::size_t> bases(participants + 1, 0);
+        for (std::size_t q = 0; q < participants; q++) {
+            bases[q + 1] = bases[q] + merged[q].table.size();
+        }
+        const std::size_t groups = bases[participants];
+
+        // Groups in key order
+        std::vector<const std::int64_t*> found(groups);
+        for (std::size_t q = 0; q < participants; q++) {
+            for (std::size_t m = 0; m < merged[q].table.size(); m++) {
+                found[bases[q] + m] = merged[q].table.key(m).data();
+            }
+        }
+        std::vector<std::uint32_t> order(groups);
+        std::iota(order.begin(), order.end(), 0u);
+        std::sort(order.begin(), order.end(), [&](std::uint32_t lhs, std::uint32_t rhs) {
+            return std::lexicographical_compare(found[lhs], found[lhs] + width, found[rhs], found[rhs] + width);
+        });
+        std::vector<std::uint32_t> rank(groups);
+        for (std::size_t g = 0; g < groups; g++) {
+            rank[order[g]] = static_cast<std::uint32_t>(g);
+        }
+        for (std::size_t p = 0; p < participants; p++) {
+            for (std::size_t q = 0; q < participants; q++) {
+                for (std::uint32_t id : partials[p].buckets[q]) {
+                    mapping[p][id] = rank[bases[q] + mapping[p][id]];
+                }
+            }
+        }
+
+        Result result;
+        result.width_       = width;
+        result.functions_.resize(count);
+        for (std::size_t a = 0; a < count; a++) {
+            result.functions_[a] = aggregations[a].function;
+        }
+        result.keys_.resize(groups * width);
+        result.counts_.assign(groups, 0);
+        result.sums_.assign(groups * count, 0);
+        result.values_.assign(groups * count, 0);
+        pool.run(participants, [&](std::size_t q) {
+            const Groups& source = merged[q];
+            for (std::size_t m = 0; m < source.table.size(); m++) {
+                const std::size_t g = rank[bases[q] + m];
+                const std::int64_t* key = found[bases[q] + m];
+                std::copy(key, key + width, result.keys_.begin() + static_cast<std::ptrdiff_t>(g * width));
+                result.counts_[g] = source.counts[m];
+                for (std::size_t a = 0; a < count; a++) {
+                    const std::size_t i = g * count + a;
+                    const std::size_t j = m * count + a;
+                    result.sums_[i] = source.sums[j];
+                    switch (aggregations[a].function) {
+                        case Function::minimum: result.values_[i] = source.minimum[j]; break;
+                        case Function::maximum: result.values_[i] = source.maximum[j]; break;
+                        case Function::mean:
+                            result.values_[i] = static_cast<std::int64_t>(
+                                    source.sums[j] / static_cast<__int128>(source.counts[m])
+                                    );
+                            break;
+                        default: break;
+                    }
+                }
+            }
+        });
+        if (not medians) { return result; }
+
+        // Rows of each group contiguous, in row order, by a counting sort
+        std::vector<std::size_t> offsets(groups + 1, 0);
+        for (std::size_t g = 0; g < groups; g++) {
+            offsets[g + 1] = offsets[g] + result.counts_[g];
+        }
+        std::vector<std::size_t> positions(offsets.begin(), offsets.end() - 1);
+        std::vector<std::uint32_t> members(rows);
+        for (std::size_t p = 0, row = 0; p < participants; p++) {
+            const Partial& partial = partials[p];
+            for (std::size_t i = 0; i < partial.ids.size(); i++, row++) {
+                members[positions[mapping[p][partial.ids[i]]]++] = static_cast<std::uint32_t>(row);
+            }
+        }
+
+        pool.run(groups, [&](std::size_t g) {
+            std::vector<std::int64_t> values(result.counts_[g]);
+            for (std::size_t a = 0; a < count; a++) {
+                if (aggregations[a].function != Function::median) { continue; }
+                for (std::size_t i = 0; i < values.size(); i++) {
+                    values[i] = sources[a][members[offsets[g] + i]];
+                }
+                auto nth = values.begin() + static_cast<std::ptrdiff_t>((values.size() - 1) / 2);
+                std::nth_element(values.begin(), nth, values.end());
+                result.values_[g * count + a] = *nth;
+            }
+        });
+        return result;
+    }
+
+    std::span<const std::int64_t>
+    Result::key(std::size_t group) const {
+        if (group >= groups()) {
+            throw std::out_of_range("no such group");
+        }
+        return {keys_.data() + group * width_, width_};
+    }
+
+    std::uint64_t
+    Result::count(std::size_t group) const {
+        if (group >= groups()) {
+            throw std::out_of_range("no such group");
+        }
+        return counts_[group];
+    }
+
+    __int128
+    Result::total(std::size_t group, std::size_t aggregation) const {
+        if (group >= groups() or aggregation >= aggregations()) {
+            throw std::out_of_range("no such group or aggregation");
+        }
+        return sums_[group * aggregations() + aggregation];
+    }
+
+    std::int64_t
+    Result::raw(std::size_t group, std::size_t aggregation) const {
+        const __int128 sum = total(group, aggregation);
+        switch (functions_[aggregation]) {
+            case Function::count:
+                throw std::invalid_argument("a count is not a quantity");
+            case Function::sum:
+                if (    sum < std::numeric_limits<std::int64_t>::min()
+                    or  sum > std::numeric_limits<std::int64_t>::max())
+                {
+                    instrumentation::increment(instrumentation::Counter::range);
+                    throw std::out_of_range("sum does not fit the representation");
+                }
+                return static_cast<std::int64_t>(sum);
+            default:
+                return values_[group * aggregations() + aggregation];
+        }
+    }
+
+    std::size_t
+    Result::find(std::span<const std::int64_t> key) const {
+        if (key.size() != width_) { return groups(); }
+        std::size_t lo = 0;
+        std::size_t hi = groups();
+        while (lo < hi) {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            std::span<const std::int64_t> k = {keys_.data() + mid * width_, width_};
+            if (std::lexicographical_compare(k.begin(), k.end(), key.begin(), key.end())) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo < groups() and std::equal(key.begin(), key.end(), keys_.data() + lo * width_)) {
+            return lo;
+        }
+        return groups();
+    }
+} // namespace cohort
+} // namespace ventilation
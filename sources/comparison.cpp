@@ -0,0 +1,288 @@
+#include "ventilation/comparison.hpp"
+#include "ventilation/kernels.hpp"
+#include "ventilation/tracing.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+
+namespace ventilation {
+namespace comparison {
+namespace {
+    constexpr char          MAGIC[8]    = {'V', 'E', 'N', 'T', 'G', 'O', 'L', 'D'};
+    constexpr std::uint32_t VERSION     = 1;
+
+    struct Header {
+        char            magic[8];
+        std::uint32_t   version;
+        std::uint32_t   channels;
+    };
+
+    struct Entry {
+        std::uint8_t    signal;
+        std::uint8_t    padding[7];
+        std::uint64_t   samples;
+    };
+
+    static_assert(sizeof(Header) == 16 and sizeof(Entry) == 16);
+
+    // Mismatches of one chunk of one channel
+    struct Partial {
+        std::size_t                 mismatches  = 0;
+        std::optional<std::size_t>  first;
+        std::uint64_t               deviation   = 0;
+    };
+
+    std::system_error
+    failure(const char* what) {
+        return std::system_error(errno, std::generic_category(), what);
+    }
+
+    // Raw units of `tolerance` steps, saturated
+    std::uint64_t
+    threshold(std::uint64_t tolerance) {
+        constexpr std::uint64_t precision = static_cast<std::uint64_t>(fixed::PRECISION);
+        if (tolerance > std::numeric_limits<std::uint64_t>::max() / precision) {
+            return std::numeric_limits<std::uint64_t>::max();
+        }
+        return tolerance * precision;
+    }
+
+    Partial
+    chunk(
+          const std::int64_t* actual
+        , const std::int64_t* expected
+        , std::size_t offset
+        , std::size_t size
+        , std::uint64_t tolerance
+        )
+    {
+        VENTILATION_TRACE("comparison::chunk");
+        Partial partial;
+        const std::size_t candidates = kernels::active().deviation(
+                  actual + offset
+                , expected + offset
+                , threshold(tolerance)
+                , &partial.deviation
+                , size
+                );
+        if (candidates == 0) { return partial; }
+
+        for (std::size_t i = offset; i < offset + size; i++) {
+            const std::int64_t lhs = actual[i] / fixed::PRECISION;
+            const std::int64_t rhs = expected[i] / fixed::PRECISION;
+            const std::uint64_t steps = lhs >= rhs
+                ? static_cast<std::uint64_t>(lhs - rhs)
+                : static_cast<std::uint64_t>(rhs - lhs);
+            if (steps > tolerance) {
+                if (not partial.first) { partial.first = i; }
+                partial.mismatches++;
+            }
+        }
+        return partial;
+    }
+
+    void
+    put(int descriptor, const void* data, std::size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        while (size > 0) {
+            const ::ssize_t written = ::write(descriptor, bytes, size);
+            if (written < 0) {
+                if (errno == EINTR) { continue; }
+                throw failure("cannot write golden file");
+            }
+            bytes   += written;
+            size    -= static_cast<std::size_t>(written);
+        }
+    }
+} // namespace
+
+    Report
+    compare(
+          std::span<const std::int64_t> actual
+        , std::span<const std::int64_t> expected
+        , std::uint64_t tolerance
+        , parallel::Pool& pool
+        )
+    {
+        const Channel lhs[] = {{alarm::Signal::pressure, actual}};
+        const Channel rhs[] = {{alarm::Signal::pressure, expected}};
+        return compare(lhs, rhs, tolerance, pool).front();
+    }
+
+    std::vector<Report>
+    compare(
+          std::span<const Channel> actual
+        , std::span<const Channel> expected
+        , std::uint64_t tolerance
+        , parallel::Pool& pool
+        )
+    {
+        if (actual.size() != expected.size()) {
+            throw std::invalid_argument("channel counts differ");
+        }
+        // First task of every channel, so chunks of all channels share one run
+        std::vector<std::size_t> offsets(actual.size() + 1, 0);
+        for (std::size_t c = 0; c < actual.size(); c++) {
+            if (actual[c].signal != expected[c].signal) {
+                throw std::invalid_argument("channel signals differ");
+            }
+            const std::size_t common = std::min(actual[c].raw.size(), expected[c].raw.size());
+            offsets[c + 1] = offsets[c] + (common + CHUNK - 1) / CHUNK;
+        }
+
+        std::vector<Partial> partials(offsets.back());
+        pool.run(partials.size(), [&](std::size_t task) {
+            const std::size_t c = static_cast<std::size_t>(
+                    std::upper_bound(offsets.begin(), offsets.end(), task) - offsets.begin() - 1
+                    );
+            const std::size_t common = std::min(actual[c].raw.size(), expected[c].raw.size());
+            const std::size_t first  = (task - offsets[c]) * CHUNK;
+            partials[task] = chunk(
+                      actual[c].raw.data()
+                    , expected[c].raw.data()
+                    , first
+                    , std::min(CHUNK, common - first)
+                    , tolerance
+                    );
+        });
+
+        std::vector<Report> reports(actual.size());
+        for (std::size_t c = 0; c < actual.size(); c++) {
+            Report& report  = reports[c];
+            report.actual   = actual[c].raw.size();
+            report.expected = expected[c].raw.size();
+            for (std::size_t task = offsets[c]; task < offsets[c + 1]; task++) {
+                const Partial& partial = partials[task];
+                if (not report.first) { report.first = partial.first; }
+                report.mismatches   += partial.mismatches;
+                report.deviation    = std::max(report.deviation, partial.deviation);
+            }
+            const std::size_t common = std::min(report.actual, report.expected);
+            if (report.actual != report.expected) {
+                if (not report.first) { report.first = common; }
+                report.mismatches += std::max(report.actual, report.expected) - common;
+            }
+        }
+        return reports;
+    }
+
+    Golden::Golden(const std::filesystem::path& path) {
+        const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (descriptor < 0) { throw failure("cannot open golden file"); }
+
+        struct ::stat status;
+        if (::fstat(descriptor, &status) != 0) {
+            const std::system_error error = failure("cannot stat golden file");
+            ::close(descriptor);
+            throw error;
+        }
+        size_ = static_cast<std::size_t>(status.st_size);
+        if (size_ < sizeof(Header)) {
+            ::close(descriptor);
+            throw std::invalid_argument("not a golden file");
+        }
+        data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (data_ == MAP_FAILED) {
+            data_ = nullptr;
+            const std::system_error error = failure("cannot map golden file");
+            ::close(descriptor);
+            throw error;
+        }
+        ::close(descriptor);
+        ::madvise(data_, size_, MADV_SEQUENTIAL);
+
+        try {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data_);
+            Header header;
+            std::memcpy(&header, bytes, sizeof(Header));
+            if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 or header.version != VERSION) {
+                throw std::invalid_argument("not a golden file");
+            }
+            if (header.channels > (size_ - sizeof(Header)) / sizeof(Entry)) {
+                throw std::invalid_argument("golden file is truncated");
+            }
+            std::size_t offset = sizeof(Header) + header.channels * sizeof(Entry);
+            channels_.reserve(header.channels);
+            for (std::size_t c = 0; c < header.channels; c++) {
+                Entry entry;
+                std::memcpy(&entry, bytes + sizeof(Header) + c * sizeof(Entry), sizeof(Entry));
+                if (entry.signal > static_cast<std::uint8_t>(alarm::Signal::volume)) {
+                    throw std::invalid_argument("unknown signal in golden file");
+                }
+                if (entry.samples > (size_ - offset) / sizeof(std::int64_t)) {
+                    throw std::invalid_argument("golden file is truncated");
+                }
+                channels_.push_back(Channel{
+                      static_cast<alarm::Signal>(entry.signal)
+                    , {reinterpret_cast<const std::int64_t*>(bytes + offset), entry.samples}
+                });
+                offset += entry.samples * sizeof(std::int64_t);
+            }
+            if (offset != size_) {
+                throw std::invalid_argument("trailing bytes in golden file");
+            }
+        } catch (...) {
+            ::munmap(data_, size_);
+            throw;
+        }
+    }
+
+    Golden::~Golden() {
+        if (data_ != nullptr) { ::munmap(data_, size_); }
+    }
+
+    Golden::Golden(Golden&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+        , channels_(std::move(other.channels_))
+    {}
+
+    Golden&
+    Golden::operator=(Golden&& other) noexcept {
+        if (this != &other) {
+            if (data_ != nullptr) { ::munmap(data_, size_); }
+            data_       = std::exchange(other.data_, nullptr);
+            size_       = std::exchange(other.size_, 0);
+            channels_   = std::move(other.channels_);
+        }
+        return *this;
+    }
+
+    void
+    Golden::write(const std::filesystem::path& path, std::span<const Channel> channels) {
+        if (channels.size() > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::invalid_argument("too many channels");
+        }
+        const int descriptor = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (descriptor < 0) { throw failure("cannot create golden file"); }
+
+        try {
+            Header header;
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version  = VERSION;
+            header.channels = static_cast<std::uint32_t>(channels.size());
+            put(descriptor, &header, sizeof(Header));
+            for (const Channel& channel : channels) {
+                Entry entry{};
+                entry.signal    = static_cast<std::uint8_t>(channel.signal);
+                entry.samples   = channel.raw.size();
+                put(descriptor, &entry, sizeof(Entry));
+            }
+            for (const Channel& channel : channels) {
+                put(descriptor, channel.raw.data(), channel.raw.size_bytes());
+            }
+        } catch (...) {
+            ::close(descriptor);
+            throw;
+        }
+        if (::close(descriptor) != 0) { throw failure("cannot write golden file"); }
+    }
+} // namespace comparison
+} // namespace ventilation
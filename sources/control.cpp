@@ -0,0 +1,253 @@
+#include "ventilation/control.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace ventilation {
+namespace control {
+namespace {
+    float
+    cycle(const model::Settings& settings) {
+        return settings.inspiration + settings.pause + settings.expiration;
+    }
+} // namespace
+
+    Lung::Lung(const Plant& plant)
+        : resistance_(static_cast<float>(plant.resistance))
+        , compliance_(static_cast<float>(plant.compliance))
+        , lag_(plant.lag)
+    {
+        if (not (resistance_ > 0.0) or not (compliance_ > 0.0)) {
+            throw std::invalid_argument("resistance and compliance must be positive");
+        }
+        if (not (lag_ >= 0.0) or not std::isfinite(lag_)) {
+            throw std::invalid_argument("blower lag must not be negative");
+        }
+    }
+
+    Sample
+    Lung::sample() const {
+        return Sample{
+              static_cast<float>(time_)
+            , Pressure(static_cast<float>(blower_))
+            , Flow(static_cast<float>((blower_ - volume_ / compliance_) / resistance_))
+            , Volume(static_cast<float>(volume_))
+        };
+    }
+
+    void
+    Lung::step(const Pressure& command, float period) {
+        if (not (period > 0.0f) or not std::isfinite(period)) {
+            throw std::domain_error("period must be finite and positive");
+        }
+        if (period != period_) {
+            // The blower excess d decays as e^(-t/lag) and drives the lung
+            // with it: the volume gains d * coupling over the period
+            const double h          = period;
+            const double constant   = resistance_ * compliance_;
+            lung_ = std::exp(-h / constant);
+            if (lag_ == 0.0) {
+                decay_      = 0.0;
+                coupling_   = 0.0;
+            } else if (std::abs(lag_ - constant) > 1e-6 * constant) {
+                decay_      = std::exp(-h / lag_);
+                coupling_   = compliance_ * lag_ / (lag_ - constant) * (decay_ - lung_);
+            } else {
+                decay_      = std::exp(-h / lag_);
+                coupling_   = compliance_ * (h / constant) * lung_;
+            }
+            period_ = period;
+        }
+        const double u          = static_cast<float>(command);
+        const double settled    = compliance_ * u;
+        const double d          = blower_ - u;
+        volume_ = settled + (volume_ - settled) * lung_ + d * coupling_;
+        blower_ = u + d * decay_;
+        time_   += period;
+    }
+
+    Phase
+    phase(float time, const model::Settings& settings) {
+        const float t = elapsed(time, settings);
+        if (t < settings.inspiration)                   { return Phase::inspiration; }
+        if (t < settings.inspiration + settings.pause)  { return Phase::pause; }
+        return Phase::expiration;
+    }
+
+    float
+    elapsed(float time, const model::Settings& settings) {
+        const float t = std::fmod(time, cycle(settings));
+        return t < 0.0f ? t + cycle(settings) : t;
+    }
+
+    Pid::Pid(const Gains& gains, float low, float high) : gains_(gains), low_(low), high_(high) {
+        if (    not (gains.proportional >= 0.0f) or not (gains.integral >= 0.0f)
+            or  not (gains.derivative >= 0.0f))
+        {
+            throw std::invalid_argument("gains must not be negative");
+        }
+        if (not (low <= high)) {
+            throw std::invalid_argument("low limit above the high limit");
+        }
+    }
+
+    float
+    Pid::update(float error, float period) {
+        const float derivative  = started_ ? (error - previous_) / period : 0.0f;
+        const float integral    = integral_ + error * period;
+        const float output      = gains_.proportional * error
+                                + gains_.integral * integral
+                                + gains_.derivative * derivative;
+        const bool saturated    = (output > high_ and error > 0.0f) or (output < low_ and error < 0.0f);
+        if (not saturated) { integral_ = integral; }
+        previous_   = error;
+        started_    = true;
+
+        const float held = gains_.proportional * error
+                         + gains_.integral * integral_
+                         + gains_.derivative * derivative;
+        return std::clamp(held, low_, high_);
+    }
+
+    void
+    Pid::reset() {
+        integral_   = 0.0f;
+        previous_   = 0.0f;
+        started_    = false;
+    }
+
+    PressureControl::PressureControl(
+              const model::Settings& settings
+            , const Pressure& inspiratory
+            , const Pressure& peep
+            , const Pid::Gains& gains
+            )
+        : settings_(settings)
+        , inspiratory_(inspiratory)
+        , peep_(peep)
+        , pid_(gains, -LIMIT, LIMIT)
+    {
+        if (not (cycle(settings) > 0.0f)) {
+            throw std::invalid_argument("breath timing must be positive");
+        }
+    }
+
+    Pressure
+    PressureControl::target(float time) const {
+        return phase(time, settings_) == Phase::expiration ? peep_ : peep_ + inspiratory_;
+    }
+
+    Pressure
+    PressureControl::step(const Sample& sample, float period) {
+        const float goal        = static_cast<float>(target(sample.time));
+        const float correction  = pid_.update(goal - static_cast<float>(sample.pressure), period);
+        return Pressure(std::clamp(goal + correction, 0.0f, LIMIT));
+    }
+
+    VolumeControl::VolumeControl(
+              const model::Settings& settings
+            , const Volume& tidal
+            , const Pressure& peep
+            , const Pid::Gains& gains
+            )
+        : settings_(settings)
+        , tidal_(tidal)
+        , peep_(peep)
+        , pid_(gains, -static_cast<float>(peep), LIMIT - static_cast<float>(peep))
+    {
+        if (not (settings.inspiration > 0.0f) or not (cycle(settings) > 0.0f)) {
+            throw std::invalid_argument("breath timing must be positive");
+        }
+    }
+
+    Flow
+    VolumeControl::target(float time) const {
+        if (phase(time, settings_) != Phase::inspiration) { return Flow(); }
+        return Flow(static_cast<float>(tidal_) / settings_.inspiration);
+    }
+
+    Pressure
+    VolumeControl::step(const Sample& sample, float period) {
+        if (phase(sample.time, settings_) == Phase::expiration) {
+            pid_.reset();
+            return peep_;
+        }
+        const float error = static_cast<float>(target(sample.time)) - static_cast<float>(sample.flow);
+        return Pressure(std::clamp(static_cast<float>(peep_) + pid_.update(error, period), 0.0f, LIMIT));
+    }
+
+    Adaptive::Adaptive(
+              const model::Settings& settings
+            , const Volume& tidal
+            , const Pressure& peep
+            , const Pressure& initial
+            , const Pressure& slew
+            )
+        : settings_(settings)
+        , tidal_(tidal)
+        , peep_(peep)
+        , slew_(slew)
+        , inner_(settings, initial, peep)
+    {
+        if (not (static_cast<float>(slew) > 0.0f)) {
+            throw std::invalid_argument("slew must be positive");
+        }
+    }
+
+    Pressure
+    Adaptive::step(const Sample& sample, float period) {
+        const Phase current = phase(sample.time, settings_);
+        const float volume  = static_cast<float>(sample.volume);
+        if (current == Phase::inspiration and previous_ == Phase::expiration) {
+            const float delivered = highest_ - start_;
+            if (started_) {
+                // Pressure the breath just delivered scaled to the tidal volume
+                const float pressure    = static_cast<float>(inner_.inspiratory());
+                const float goal        = delivered > 0.0f and pressure > 0.0f
+                                        ? pressure * static_cast<float>(tidal_) / delivered
+                                        : pressure + static_cast<float>(slew_);
+                const float step        = std::clamp(goal - pressure, -static_cast<float>(slew_), static_cast<float>(slew_));
+                const float highest     = LIMIT - static_cast<float>(peep_);
+                inner_.inspiratory(Pressure(std::clamp(pressure + step, 0.0f, highest)));
+            }
+            start_      = volume;
+            highest_    = volume;
+            started_    = true;
+        }
+        highest_    = std::max(highest_, volume);
+        previous_   = current;
+        return inner_.step(sample, period);
+    }
+
+    void
+    Timing::merge(const Timing& other) {
+        steps   += other.steps;
+        misses  += other.misses;
+        latency.merge(other.latency);
+        response.merge(other.response);
+    }
+
+namespace detail {
+    std::chrono::nanoseconds
+    validate(const Options& options) {
+        if (not (options.period > 0.0f) or not std::isfinite(options.period)) {
+            throw std::domain_error("period must be finite and positive");
+        }
+        if (options.deadline < std::chrono::nanoseconds(0)) {
+            throw std::invalid_argument("deadline must not be negative");
+        }
+        if (options.deadline == std::chrono::nanoseconds(0)) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(options.period));
+        }
+        return options.deadline;
+    }
+
+    void
+    observe(Delivery& delivery, const Sample& sample) {
+        delivery.peak       = std::max(delivery.peak, sample.pressure);
+        delivery.highest    = std::max(delivery.highest, sample.volume);
+        delivery.lowest     = std::min(delivery.lowest, sample.volume);
+        delivery.last       = sample;
+    }
+} // namespace detail
+} // namespace control
+} // namespace ventilation
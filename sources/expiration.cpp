@@ -0,0 +1,170 @@
+#include "ventilation/expiration.hpp"
+#include "ventilation/instrumentation.hpp"
+#include "ventilation/mechanics.hpp"
+#include "ventilation/tracing.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ventilation {
+namespace expiration {
+namespace {
+    // Settings in raw units, validated once
+    struct Settings {
+        double          period;
+        float           compliance;
+        std::uint64_t   delay;
+        std::int64_t    floor;
+    };
+
+    Settings
+    settings(float period, const Compliance& compliance, const Window& window) {
+        if (not std::isfinite(period) or not (period > 0.0f)) {
+            instrumentation::increment(instrumentation::Counter::domain);
+            throw std::domain_error("sampling period must be finite and positive");
+        }
+        if (not (compliance > Compliance(0.0f))) {
+            throw std::invalid_argument("compliance must be positive");
+        }
+        if (not (window.delay >= 0.0f) or not std::isfinite(window.delay) or window.floor < Flow(0.0f)) {
+            throw std::invalid_argument("window must be finite and non-negative");
+        }
+        return Settings{
+              period
+            , static_cast<float>(compliance)
+            , static_cast<std::uint64_t>(std::llround(window.delay / period))
+            , fixed::Access::raw(window.floor)
+        };
+    }
+
+    Estimate
+    breath(const std::int64_t* flow, const std::int64_t* volume, std::size_t size, const Settings& settings) {
+        VENTILATION_TRACE("expiration::breath");
+        std::size_t i = 0;
+        while (i < size and fixed::positive(flow[i])) {
+            i++;
+        }
+        detail::Sums sums;
+        for (; i < size; i++) {
+            sums.push(flow[i], volume[i], settings.delay, settings.floor);
+        }
+        return sums.finish(settings.period, settings.compliance);
+    }
+} // namespace
+namespace detail {
+    void
+    Sums::push(std::int64_t f, std::int64_t v, std::uint64_t delay, std::int64_t floor) {
+        const std::uint64_t k = index++;
+        last    = v;
+        end     = f;
+        if (k < delay or f >= 0 or f > -floor) { return; }
+
+        const double y = std::log(static_cast<double>(-f));
+        count++;
+        time    += k;
+        squares += static_cast<__int128>(k) * k;
+        log     += y;
+        product += static_cast<double>(k) * y;
+        volume  += v;
+        flow    += f;
+    }
+
+    Estimate
+    Sums::finish(double period, float compliance) const {
+        Estimate estimate{};
+        estimate.end        = fixed::Access::make<Flow>(end);
+        estimate.samples    = static_cast<std::uint32_t>(count);
+        if (count < 3) { return estimate; }
+
+        const double n          = static_cast<double>(count);
+        const double t          = static_cast<double>(time);
+        const double spread     = static_cast<double>(static_cast<__int128>(count) * squares - static_cast<__int128>(time) * time);
+        const double slope      = (n * product - t * log) / spread;
+        if (not (slope < 0.0)) { return estimate; }
+
+        const double tau        = -period / slope;
+        const double relaxation = (static_cast<double>(volume) + tau * static_cast<double>(flow)) / n;
+        const double trapped    = static_cast<double>(last) - relaxation;
+
+        estimate.tau            = static_cast<float>(tau);
+        estimate.resistance     = Resistance(static_cast<float>(tau) / compliance);
+        estimate.trapped        = fixed::Access::make<Volume>(std::llround(trapped));
+        estimate.intrinsic      = fixed::Access::make<Pressure>(std::llround(trapped / compliance));
+        return estimate;
+    }
+} // namespace detail
+    Estimator::Estimator(float period, const Compliance& compliance, const Window& window) {
+        const Settings s    = settings(period, compliance, window);
+        period_             = s.period;
+        compliance_         = s.compliance;
+        delay_              = s.delay;
+        floor_              = s.floor;
+    }
+
+    std::optional<Estimate>
+    Estimator::push(const Flow& flow, const Volume& volume) {
+        const std::int64_t f    = fixed::Access::raw(flow);
+        const bool now          = fixed::positive(f);
+
+        std::optional<Estimate> result;
+        if (now and not positive_) {
+            if (expiration_) { result = current(); }
+            expiration_ = false;
+        } else if (not now and positive_) {
+            expiration_ = true;
+            sums_       = detail::Sums();
+        }
+        positive_ = now;
+        if (expiration_) {
+            sums_.push(f, fixed::Access::raw(volume), delay_, floor_);
+        }
+        return result;
+    }
+
+    Estimate
+    Estimator::current() const {
+        return sums_.finish(period_, compliance_);
+    }
+
+    Estimate
+    fit(
+          std::span<const Flow> flow
+        , std::span<const Volume> volume
+        , float period
+        , const Compliance& compliance
+        , const Window& window
+        )
+    {
+        if (flow.size() != volume.size()) {
+            throw std::invalid_argument("flow and volume must have the same size");
+        }
+        const Settings s = settings(period, compliance, window);
+        return breath(fixed::Access::raw(flow).data(), fixed::Access::raw(volume).data(), flow.size(), s);
+    }
+
+    void
+    fit(
+          std::span<const Flow> flow
+        , std::span<const Volume> volume
+        , std::span<const std::size_t> boundaries
+        , float period
+        , const Compliance& compliance
+        , std::span<Estimate> output
+        , const Window& window
+        , parallel::Pool& pool
+        )
+    {
+        if (flow.size() != volume.size()) {
+            throw std::invalid_argument("flow and volume must have the same size");
+        }
+        const Settings s = settings(period, compliance, window);
+
+        const std::int64_t* fs = fixed::Access::raw(flow).data();
+        const std::int64_t* vs = fixed::Access::raw(volume).data();
+
+        mechanics::detail::breaths(boundaries, output.size(), flow.size(), pool, [&](std::size_t i, std::size_t offset, std::size_t size) {
+            output[i] = breath(fs + offset, vs + offset, size, s);
+        });
+    }
+} // namespace expiration
+} // namespace ventilation
@@ -0,0 +1,142 @@
+#include "ventilation/fft.hpp"
+#include <numbers>
+#include <stdexcept>
+
+namespace ventilation {
+namespace fft {
+    Plan::Plan(std::size_t size) : size_(size) {
+        if (size == 0) {
+            throw std::invalid_argument("transform size must be positive");
+        }
+        std::size_t n = size;
+        while (n % 4 == 0) {
+            factors_.push_back(4);
+            n /= 4;
+        }
+        while (n % 2 == 0) {
+            factors_.push_back(2);
+            n /= 2;
+        }
+        for (std::size_t p = 3; p * p <= n; p += 2) {
+            while (n % p == 0) {
+                factors_.push_back(p);
+                n /= p;
+            }
+        }
+        if (n > 1) { factors_.push_back(n); }
+
+        twiddles_.resize(size);
+        for (std::size_t k = 0; k < size; k++) {
+            const double angle = -2.0 * std::numbers::pi * static_cast<double>(k) / static_cast<double>(size);
+            twiddles_[k] = std::polar(1.0, angle);
+        }
+    }
+
+    void
+    Plan::forward(std::span<const Complex> input, std::span<Complex> output) const {
+        if (input.size() != size_ or output.size() != size_) {
+            throw std::invalid_argument("input and output must have the plan size");
+        }
+        if (factors_.empty()) {
+            output[0] = input[0];
+            return;
+        }
+        transform(input.data(), output.data(), 1, 0);
+    }
+
+    void
+    Plan::inverse(std::span<const Complex> input, std::span<Complex> output) const {
+        if (input.size() != size_ or output.size() != size_) {
+            throw std::invalid_argument("input and output must have the plan size");
+        }
+        // conj(F(conj(x))) / N, with the conjugates folded into the copies
+        std::vector<Complex> conjugated(input.size());
+        for (std::size_t i = 0; i < input.size(); i++) {
+            conjugated[i] = std::conj(input[i]);
+        }
+        forward(conjugated, output);
+        const double scale = 1.0 / static_cast<double>(size_);
+        for (Complex& value : output) {
+            value = std::conj(value) * scale;
+        }
+    }
+
+    // Transforms the N / (radix product so far) samples at input, input +
+    // stride, ... into output. Each of the `radix` interleaved subsequences
+    // is transformed in place into its own contiguous block, which the
+    // butterflies then combine.
+    void
+    Plan::transform(const Complex* input, Complex* output, std::size_t stride, std::size_t factor) const {
+        const std::size_t radix = factors_[factor];
+        std::size_t m = 1;
+        for (std::size_t f = factor + 1; f < factors_.size(); f++) {
+            m *= factors_[f];
+        }
+
+        if (m == 1) {
+            for (std::size_t k = 0; k < radix; k++) {
+                output[k] = input[k * stride];
+            }
+        } else {
+            for (std::size_t k = 0; k < radix; k++) {
+                transform(input + k * stride, output + k * m, stride * radix, factor + 1);
+            }
+        }
+        butterfly(output, stride, radix, m);
+    }
+
+    void
+    Plan::butterfly(Complex* output, std::size_t stride, std::size_t radix, std::size_t m) const {
+        const Complex* twiddle = twiddles_.data();
+        switch (radix) {
+            case 2:
+                for (std::size_t k = 0; k < m; k++) {
+                    const Complex t = output[k + m] * twiddle[k * stride];
+                    output[k + m]   = output[k] - t;
+                    output[k]      += t;
+                }
+                return;
+            case 4:
+                for (std::size_t k = 0; k < m; k++) {
+                    const Complex a = output[k];
+                    const Complex b = output[k + m] * twiddle[k * stride];
+                    const Complex c = output[k + 2 * m] * twiddle[2 * k * stride];
+                    const Complex d = output[k + 3 * m] * twiddle[3 * k * stride];
+
+                    const Complex sum       = a + c;
+                    const Complex difference = a - c;
+                    const Complex outer     = b + d;
+                    // -i (b - d)
+                    const Complex rotated   = Complex((b - d).imag(), -(b - d).real());
+
+                    output[k]           = sum + outer;
+                    output[k + m]       = difference + rotated;
+                    output[k + 2 * m]   = sum - outer;
+                    output[k + 3 * m]   = difference - rotated;
+                }
+                return;
+            default: {
+                // Direct DFT of each group of `radix` values
+                std::vector<Complex> scratch(radix);
+                for (std::size_t u = 0; u < m; u++) {
+                    for (std::size_t q = 0; q < radix; q++) {
+                        scratch[q] = output[u + q * m];
+                    }
+                    for (std::size_t q = 0; q < radix; q++) {
+                        const std::size_t k = u + q * m;
+                        Complex value       = scratch[0];
+                        std::size_t index   = 0;
+                        for (std::size_t r = 1; r < radix; r++) {
+                            index += stride * k;
+                            index %= size_;
+                            value += scratch[r] * twiddle[index];
+                        }
+                        output[k] = value;
+                    }
+                }
+                return;
+            }
+        }
+    }
+} // namespace fft
+} // namespace ventilation
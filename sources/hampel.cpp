@@ -0,0 +1,194 @@
+#include "ventilation/hampel.hpp"
+#include <bit>
+#include <limits>
+
+namespace ventilation {
+namespace hampel {
+    Window::Window(std::size_t capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("window capacity must be positive");
+        }
+        if (capacity > std::numeric_limits<std::uint32_t>::max() - 2) {
+            throw std::invalid_argument("window capacity too large");
+        }
+        // Enough levels for a list of `capacity` values at p = 1/2
+        levels_ = static_cast<std::size_t>(std::bit_width(capacity)) + 1;
+
+        const std::size_t nodes = capacity + 2;
+        values_.resize(nodes, 0);
+        sequence_.resize(nodes, 0);
+        next_.resize(nodes * levels_, TAIL);
+        width_.resize(nodes * levels_, 1);
+        ring_.resize(capacity);
+        for (std::size_t slot = 0; slot < capacity; slot++) {
+            ring_[slot] = static_cast<std::uint32_t>(slot + 2);
+        }
+        values_[TAIL]   = std::numeric_limits<std::int64_t>::max();
+        sequence_[TAIL] = std::numeric_limits<std::uint64_t>::max();
+    }
+
+    bool
+    Window::before(std::uint32_t lhs, std::uint32_t rhs) const {
+        if (values_[lhs] != values_[rhs]) { return values_[lhs] < values_[rhs]; }
+        return sequence_[lhs] < sequence_[rhs];
+    }
+
+    void
+    Window::insert(std::uint32_t node) {
+        std::uint32_t chain[64];
+        std::size_t steps[64];
+
+        std::uint32_t current   = HEAD;
+        std::size_t position    = 0;
+        for (std::size_t level = levels_; level-- > 0;) {
+            while (before(next(current, level), node)) {
+                position    += width(current, level);
+                current     = next(current, level);
+            }
+            chain[level] = current;
+            steps[level] = position;
+        }
+
+        // Geometric height at p = 1/2 from a xorshift stream
+        random_ ^= random_ << 13;
+        random_ ^= random_ >> 7;
+        random_ ^= random_ << 17;
+        const std::size_t height = std::min<std::size_t>(levels_, static_cast<std::size_t>(std::countr_one(random_)) + 1);
+
+        for (std::size_t level = 0; level < levels_; level++) {
+            const std::uint32_t previous = chain[level];
+            if (level < height) {
+                const std::uint32_t skipped = static_cast<std::uint32_t>(position - steps[level]);
+                next(node, level)       = next(previous, level);
+                next(previous, level)   = node;
+                width(node, level)      = width(previous, level) - skipped;
+                width(previous, level)  = skipped + 1;
+            } else {
+                width(previous, level)++;
+            }
+        }
+    }
+
+    void
+    Window::erase(std::uint32_t node) {
+        std::uint32_t current = HEAD;
+        for (std::size_t level = levels_; level-- > 0;) {
+            while (before(next(current, level), node)) {
+                current = next(current, level);
+            }
+            if (next(current, level) == node) {
+                width(current, level)   += width(node, level) - 1;
+                next(current, level)    = next(node, level);
+            } else {
+                width(current, level)--;
+            }
+        }
+    }
+
+    void
+    Window::push(std::int64_t value) {
+        const std::uint32_t node = ring_[position_];
+        if (size_ == ring_.size()) {
+            erase(node);
+        } else {
+            size_++;
+        }
+        values_[node]   = value;
+        sequence_[node] = pushed_++;
+        insert(node);
+        position_ = position_ + 1 == ring_.size() ? 0 : position_ + 1;
+    }
+
+    void
+    Window::clear() {
+        std::fill(next_.begin(), next_.end(), TAIL);
+        std::fill(width_.begin(), width_.end(), 1);
+        position_   = 0;
+        size_       = 0;
+    }
+
+    std::int64_t
+    Window::select(std::size_t rank) const {
+        if (rank >= size_) {
+            throw std::out_of_range("rank beyond the window");
+        }
+        std::uint32_t current   = HEAD;
+        std::size_t remaining   = rank + 1;
+        for (std::size_t level = levels_; level-- > 0;) {
+            while (width(current, level) <= remaining) {
+                remaining   -= width(current, level);
+                current     = next(current, level);
+            }
+        }
+        return values_[current];
+    }
+
+    std::size_t
+    Window::rank(std::int64_t value) const {
+        std::uint32_t current   = HEAD;
+        std::size_t position    = 0;
+        for (std::size_t level = levels_; level-- > 0;) {
+            while (next(current, level) != TAIL and values_[next(current, level)] < value) {
+                position    += width(current, level);
+                current     = next(current, level);
+            }
+        }
+        return position;
+    }
+
+    std::size_t
+    Window::count(std::int64_t lower, std::int64_t upper) const {
+        if (lower > upper) { return 0; }
+        const std::size_t below = rank(lower);
+        if (upper == std::numeric_limits<std::int64_t>::max()) { return size_ - below; }
+        return rank(upper + 1) - below;
+    }
+
+    std::int64_t
+    Window::back(std::size_t age) const {
+        if (age >= size_) {
+            throw std::out_of_range("age beyond the window");
+        }
+        const std::size_t slot = (position_ + ring_.size() - 1 - age) % ring_.size();
+        return values_[ring_[slot]];
+    }
+
+    std::int64_t
+    Window::median() const {
+        return select((size_ - 1) / 2);
+    }
+
+    std::int64_t
+    Window::deviation() const {
+        if (size_ == 0) {
+            throw std::out_of_range("empty window");
+        }
+        // below[j] = m - x(mid - j) for j <= mid and above[j] = x(mid + 1 + j) - m
+        // both increase with j; the answer is entry `mid` of their merge
+        const std::size_t mid       = (size_ - 1) / 2;
+        const std::int64_t m        = select(mid);
+        const std::size_t lower     = mid + 1;
+        const std::size_t upper     = size_ - lower;
+        auto below = [&](std::size_t j) { return m - select(mid - j); };
+        auto above = [&](std::size_t j) { return select(mid + 1 + j) - m; };
+
+        // Take a entries from below and mid + 1 - a from above
+        const std::size_t count = mid + 1;
+        std::size_t lo = count > upper ? count - upper : 0;
+        std::size_t hi = std::min(count, lower);
+        while (true) {
+            const std::size_t a = lo + (hi - lo) / 2;
+            const std::size_t b = count - a;
+            if (a < lower and b > 0 and above(b - 1) > below(a)) {
+                lo = a + 1;
+            } else if (a > 0 and b < upper and below(a - 1) > above(b)) {
+                hi = a - 1;
+            } else {
+                const std::int64_t left     = a > 0 ? below(a - 1) : std::numeric_limits<std::int64_t>::min();
+                const std::int64_t right    = b > 0 ? above(b - 1) : std::numeric_limits<std::int64_t>::min();
+                return std::max(left, right);
+            }
+        }
+    }
+} // namespace hampel
+} // namespace ventilation
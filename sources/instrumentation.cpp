@@ -0,0 +1,192 @@
+#include "ventilation/instrumentation.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace ventilation {
+namespace instrumentation {
+namespace {
+    const char* NAMES[COUNTERS] = {
+          "domain_errors"
+        , "multiplication_overflows"
+        , "range_errors"
+        , "saturations"
+    };
+
+    const char* HELP[COUNTERS] = {
+          "Non-finite values rejected by constructors and scaling"
+        , "Scaling products that overflowed the int64 intermediate"
+        , "Values rejected by checked policy conversions"
+        , "Results clamped by saturating arithmetic"
+    };
+
+    // One cache line per counter, so a thread never shares a line with
+    // another thread's counters or with its own other counters.
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> value{0};
+    };
+
+    struct Block {
+        std::array<Slot, COUNTERS> slots;
+    };
+
+    struct Registry {
+        std::mutex                          mutex;
+        std::vector<const Block*>           live;
+        std::array<std::uint64_t, COUNTERS> retired     = {};
+        std::array<std::uint64_t, COUNTERS> baseline    = {};
+    };
+
+    // Never destroyed, threads may exit after static destruction has begun
+    Registry&
+    registry() {
+        static Registry* instance = new Registry();
+        return *instance;
+    }
+
+    std::array<std::uint64_t, COUNTERS>
+    totals(Registry& registry) {
+        std::array<std::uint64_t, COUNTERS> values = registry.retired;
+        for (const Block* block : registry.live) {
+            for (std::size_t i = 0; i < COUNTERS; i++) {
+                values[i] += block->slots[i].value.load(std::memory_order_relaxed);
+            }
+        }
+        return values;
+    }
+
+#if defined(VENTILATION_INSTRUMENTATION)
+    struct Local {
+        Block block;
+
+        Local() {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.live.push_back(&block);
+        }
+
+        ~Local() {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            for (std::size_t i = 0; i < COUNTERS; i++) {
+                r.retired[i] += block.slots[i].value.load(std::memory_order_relaxed);
+            }
+            r.live.erase(std::find(r.live.begin(), r.live.end(), &block));
+        }
+    };
+
+    thread_local Local local;
+#endif
+} // namespace
+#if defined(VENTILATION_INSTRUMENTATION)
+    void
+    increment(Counter counter, std::uint64_t count) {
+        // Single writer per slot, a relaxed load and store avoids a locked add
+        Slot& slot = local.block.slots[static_cast<std::size_t>(counter)];
+        slot.value.store(slot.value.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    }
+#endif
+
+    Snapshot
+    snapshot() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+
+        Snapshot result;
+        std::array<std::uint64_t, COUNTERS> values = totals(r);
+        for (std::size_t i = 0; i < COUNTERS; i++) {
+            result.values[i] = values[i] - r.baseline[i];
+        }
+        return result;
+    }
+
+    void
+    reset() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.baseline = totals(r);
+    }
+
+    const char*
+    name(Counter counter) {
+        return NAMES[static_cast<std::size_t>(counter)];
+    }
+
+    void
+    prometheus(std::ostream& os, const Snapshot& snapshot) {
+        for (std::size_t i = 0; i < COUNTERS; i++) {
+            os << "# HELP ventilation_" << NAMES[i] << "_total " << HELP[i] << "\n";
+            os << "# TYPE ventilation_" << NAMES[i] << "_total counter\n";
+            os << "ventilation_" << NAMES[i] << "_total " << snapshot.values[i] << "\n";
+        }
+    }
+
+    void
+    json(std::ostream& os, const Snapshot& snapshot) {
+        os << "{";
+        for (std::size_t i = 0; i < COUNTERS; i++) {
+            os << (i == 0 ? "" : ", ") << "\"" << NAMES[i] << "\": " << snapshot.values[i];
+        }
+        os << "}";
+    }
+
+    void
+    Latency::merge(const Latency& other) {
+        for (std::size_t i = 0; i < BUCKETS; i++) {
+            counts_[i] += other.counts_[i];
+        }
+        count_      += other.count_;
+        sum_        += other.sum_;
+        minimum_    = std::min(minimum_, other.minimum_);
+        maximum_    = std::max(maximum_, other.maximum_);
+    }
+
+    void
+    Latency::reset() {
+        std::fill(counts_.begin(), counts_.end(), 0);
+        count_      = 0;
+        sum_        = 0;
+        minimum_    = UINT64_MAX;
+        maximum_    = 0;
+    }
+
+    double
+    Latency::mean() const {
+        return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_);
+    }
+
+    std::uint64_t
+    Latency::quantile(double q) const {
+        if (not (q >= 0.0 and q <= 1.0)) {
+            throw std::invalid_argument("quantile must be within [0, 1]");
+        }
+        if (count_ == 0) { return 0; }
+
+        const double scaled = std::ceil(q * static_cast<double>(count_));
+        const std::uint64_t rank = std::max<std::uint64_t>(1, std::min(count_, static_cast<std::uint64_t>(scaled)));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < BUCKETS; i++) {
+            seen += counts_[i];
+            if (seen >= rank) { return std::min(upper(i), maximum_); }
+        }
+        return maximum_;
+    }
+
+    std::uint64_t
+    Latency::lower(std::size_t index) {
+        if (index < 2 * HALF) { return index; }
+        const std::size_t shift = index / HALF - 1;
+        return static_cast<std::uint64_t>(index - shift * HALF) << shift;
+    }
+
+    std::uint64_t
+    Latency::upper(std::size_t index) {
+        if (index < 2 * HALF) { return index; }
+        const std::size_t shift = index / HALF - 1;
+        return lower(index) + ((std::uint64_t{1} << shift) - 1);
+    }
+} // namespace instrumentation
+} // namespace ventilation
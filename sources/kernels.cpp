@@ -0,0 +1,852 @@
+#include "ventilation/kernels.hpp"
+#include "ventilation/ventilation.hpp"
+#include <bit>
+#include <limits>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace ventilation {
+namespace kernels {
+namespace {
+    constexpr std::int64_t FORWARD = static_cast<std::int64_t>(fixed::FORWARD);
+    constexpr std::int64_t MAXIMUM = std::numeric_limits<std::int64_t>::max();
+    constexpr std::int64_t MINIMUM = std::numeric_limits<std::int64_t>::min();
+
+    // Two's complement wrap-around, as the scalar operators do in practice,
+    // without the undefined behaviour of signed overflow.
+    inline std::int64_t
+    wrapping_add(std::int64_t lhs, std::int64_t rhs) {
+        return static_cast<std::int64_t>(static_cast<std::uint64_t>(lhs) + static_cast<std::uint64_t>(rhs));
+    }
+
+    inline std::int64_t
+    wrapping_mul(std::int64_t lhs, std::int64_t rhs) {
+        return static_cast<std::int64_t>(static_cast<std::uint64_t>(lhs) * static_cast<std::uint64_t>(rhs));
+    }
+
+namespace scalar {
+#define VENTILATION_SCALAR __attribute__((optimize("no-tree-vectorize")))
+    VENTILATION_SCALAR bool
+    finite(const float* input, std::size_t size) {
+        for (std::size_t i = 0; i < size; i++) {
+            if (not std::isfinite(input[i])) { return false; }
+        }
+        return true;
+    }
+
+    VENTILATION_SCALAR void
+    forward(const float* input, std::int64_t* output, std::size_t size) {
+        for (std::size_t i = 0; i < size; i++) {
+            output[i] = static_cast<std::int64_t>(input[i] * fixed::FORWARD);
+        }
+    }
+
+    VENTILATION_SCALAR void
+    inverse(const std::int64_t* input, float* output, std::size_t size) {
+        for (std::size_t i = 0; i < size; i++) {
+            output[i] = static_cast<float>(input[i]) * fixed::INVERSE;
+        }
+    }
+
+    VENTILATION_SCALAR void
+    scale(const std::int64_t* input, std::int64_t factor, std::int64_t* output, std::size_t size) {
+        for (std::size_t i = 0; i < size; i++) {
+            output[i] = wrapping_mul(input[i], factor) / FORWARD;
+        }
+    }
+
+    VENTILATION_SCALAR void
+    compare(const std::int64_t* lhs, const std::int64_t* rhs, std::int8_t* output, std::size_t size) {
+        for (std::size_t i = 0; i < size; i++) {
+            std::int64_t xs = lhs[i] / fixed::PRECISION;
+            std::int64_t ys = rhs[i] / fixed::PRECISION;
+
+            if (xs < ys)        { output[i] = -1; }
+            else if (xs > ys)   { output[i] =  1; }
+            else                { output[i] =  0; }
+        }
+    }
+
+    VENTILATION_SCALAR std::int64_t
+    sum(const std::int64_t* input, std::size_t size) {
+        std::int64_t accumulator = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            accumulator = wrapping_add(accumulator, input[i]);
+        }
+        return accumulator;
+    }
+
+    VENTILATION_SCALAR void
+    motion(
+          const std::int64_t* flow
+        , const std::int64_t* volume
+        , std::int64_t resistance
+        , std::int64_t elastance
+        , std::int64_t peep
+        , std::int64_t* output
+        , std::size_t size
+        )
+    {
+        for (std::size_t i = 0; i < size; i++) {
+            std::int64_t resistive  = wrapping_mul(resistance, flow[i]) / FORWARD;
+            std::int64_t elastic    = wrapping_mul(elastance, volume[i]) / FORWARD;
+
+            output[i] = wrapping_add(wrapping_add(resistive, elastic), peep);
+        }
+    }
+
+    VENTILATION_SCALAR std::size_t
+    saturating_add(const std::int64_t* lhs, const std::int64_t* rhs, std::int64_t* output, std::size_t size) {
+        std::size_t saturated = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            std::int64_t result;
+            if (__builtin_add_overflow(lhs[i], rhs[i], &result)) {
+                result = lhs[i] < 0 ? MINIMUM : MAXIMUM;
+                saturated++;
+            }
+            output[i] = result;
+        }
+        return saturated;
+    }
+
+    VENTILATION_SCALAR std::size_t
+    saturating_subtract(const std::int64_t* lhs, const std::int64_t* rhs, std::int64_t* output, std::size_t size) {
+        std::size_t saturated = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            std::int64_t result;
+            if (__builtin_sub_overflow(lhs[i], rhs[i], &result)) {
+                result = lhs[i] < 0 ? MINIMUM : MAXIMUM;
+                saturated++;
+            }
+            output[i] = result;
+        }
+        return saturated;
+    }
+
+    VENTILATION_SCALAR std::size_t
+    saturating_scale(const std::int64_t* input, std::int64_t factor, std::int64_t* output, std::size_t size) {
+        std::size_t saturated = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            __int128 quotient = static_cast<__int128>(input[i]) * factor / FORWARD;
+            if (quotient > MAXIMUM) {
+                output[i] = MAXIMUM;
+                saturated++;
+            } else if (quotient < MINIMUM) {
+                output[i] = MINIMUM;
+                saturated++;
+            } else {
+                output[i] = static_cast<std::int64_t>(quotient);
+            }
+        }
+        return saturated;
+    }
+
+    VENTILATION_SCALAR void
+    total(const std::int64_t* input, std::size_t size, std::int64_t* high, std::uint64_t* low) {
+        std::int64_t upper  = 0;
+        std::uint64_t lower = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            upper += input[i] >> 32;
+            lower += static_cast<std::uint64_t>(input[i]) & 0xffffffffu;
+        }
+        *high   = upper;
+        *low    = lower;
+    }
+
+    VENTILATION_SCALAR void
+    extrema(const std::int64_t* input, std::size_t size, std::int64_t* minimum, std::int64_t* maximum) {
+        std::int64_t smallest   = input[0];
+        std::int64_t largest    = input[0];
+        for (std::size_t i = 1; i < size; i++) {
+            if (input[i] < smallest)    { smallest = input[i]; }
+            if (input[i] > largest)     { largest = input[i]; }
+        }
+        *minimum = smallest;
+        *maximum = largest;
+    }
+
+    VENTILATION_SCALAR __int128
+    dot(const std::int64_t* lhs, const std::int64_t* rhs, std::size_t size) {
+        __int128 accumulator = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            accumulator += static_cast<__int128>(lhs[i]) * rhs[i];
+        }
+        return accumulator;
+    }
+
+    VENTILATION_SCALAR std::size_t
+    debounce(
+          const std::int64_t* value
+        , const std::int64_t* low
+        , const std::int64_t* high
+        , std::uint32_t debounce
+        , bool latching
+        , std::uint32_t* count
+        , std::uint8_t* state
+        , std::size_t size
+        )
+    {
+        std::size_t changed = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            if (low[i] <= value[i] and value[i] <= high[i]) {
+                if (count[i] < debounce) { count[i]++; }
+            } else {
+                count[i] = 0;
+            }
+            bool previous   = state[i] & 1;
+            bool current    = count[i] >= debounce or (latching and previous);
+
+            state[i] = static_cast<std::uint8_t>(current);
+            if (current != previous) {
+                state[i] |= 2;
+                changed++;
+            }
+        }
+        return changed;
+    }
+
+    VENTILATION_SCALAR void
+    interpolate(
+          const std::int32_t* counts
+        , std::int32_t base
+        , std::uint32_t shift
+        , std::uint32_t segments
+        , const std::int64_t* knots
+        , std::int64_t* output
+        , std::size_t size
+        )
+    {
+        const std::int64_t limit = static_cast<std::int64_t>(segments) << shift;
+        for (std::size_t i = 0; i < size; i++) {
+            std::int64_t offset = static_cast<std::int64_t>(counts[i]) - base;
+            if (offset < 0)     { offset = 0; }
+            if (offset > limit) { offset = limit; }
+
+            std::int64_t index = offset >> shift;
+            if (index == segments) { index--; }
+            std::int64_t fraction = offset - (index << shift);
+            output[i] = knots[index] + (((knots[index + 1] - knots[index]) * fraction) >> shift);
+        }
+    }
+
+    VENTILATION_SCALAR std::size_t
+    deviation(
+          const std::int64_t* lhs
+        , const std::int64_t* rhs
+        , std::uint64_t threshold
+        , std::uint64_t* maximum
+        , std::size_t size
+        )
+    {
+        std::size_t count       = 0;
+        std::uint64_t largest   = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            std::uint64_t magnitude = lhs[i] >= rhs[i]
+                ? static_cast<std::uint64_t>(lhs[i]) - static_cast<std::uint64_t>(rhs[i])
+                : static_cast<std::uint64_t>(rhs[i]) - static_cast<std::uint64_t>(lhs[i]);
+            if (magnitude > threshold)  { count++; }
+            if (magnitude > largest)    { largest = magnitude; }
+        }
+        *maximum = largest;
+        return count;
+    }
+#undef VENTILATION_SCALAR
+} // namespace scalar
+
+    // Branch-free bodies, written so the auto-vectorizer can widen them. Each
+    // is inlined into per-target wrappers below, one set per instruction set.
+namespace body {
+    [[gnu::always_inline]] inline bool
+    finite(const float* input, std::size_t size) {
+        std::uint32_t invalid = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            std::uint32_t exponent = std::bit_cast<std::uint32_t>(input[i]) & 0x7f800000u;
+            invalid |= static_cast<std::uint32_t>(exponent == 0x7f800000u);
+        }
+        return invalid == 0;
+    }
+
+    [[gnu::always_inline]] inline void
+    forward(const float* input, std::int64_t* output, std::size_t size) {
+        for (std::size_t i = 0; i < size; i++) {
+            output[i] = static_cast<std::int64_t>(input[i] * fixed::FORWARD);
+        }
+    }
+
+    [[gnu::always_inline]] inline void
+    inverse(const std::int64_t* input, float* output, std::size_t size) {
+        for (std::size_t i = 0; i < size; i++) {
+            output[i] = static_cast<float>(input[i]) * fixed::INVERSE;
+        }
+    }
+
+    [[gnu::always_inline]] inline void
+    scale(const std::int64_t* input, std::int64_t factor, std::int64_t* output, std::size_t size) {
+        for (std::size_t i = 0; i < size; i++) {
+            output[i] = wrapping_mul(input[i], factor) / FORWARD;
+        }
+    }
+
+    [[gnu::always_inline]] inline void
+    compare(const std::int64_t* lhs, const std::int64_t* rhs, std::int8_t* output, std::size_t size) {
+        for (std::size_t i = 0; i < size; i++) {
+            std::int64_t xs = lhs[i] / fixed::PRECISION;
+            std::int64_t ys = rhs[i] / fixed::PRECISION;
+
+            output[i] = static_cast<std::int8_t>((xs > ys) - (xs < ys));
+        }
+    }
+
+    [[gnu::always_inline]] inline std::int64_t
+    sum(const std::int64_t* input, std::size_t size) {
+        std::uint64_t accumulator = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            accumulator += static_cast<std::uint64_t>(input[i]);
+        }
+        return static_cast<std::int64_t>(accumulator);
+    }
+
+    [[gnu::always_inline]] inline void
+    motion(
+          const std::int64_t* flow
+        , const std::int64_t* volume
+        , std::int64_t resistance
+        , std::int64_t elastance
+        , std::int64_t peep
+        , std::int64_t* output
+        , std::size_t size
+        )
+    {
+        for (std::size_t i = 0; i < size; i++) {
+            std::int64_t resistive  = wrapping_mul(resistance, flow[i]) / FORWARD;
+            std::int64_t elastic    = wrapping_mul(elastance, volume[i]) / FORWARD;
+
+            output[i] = wrapping_add(wrapping_add(resistive, elastic), peep);
+        }
+    }
+
+    // Overflow of a + b shows up as a result whose sign differs from both
+    // operands, and of a - b as one that differs from a and from -b. The
+    // clamped value follows the sign of a in both cases.
+    [[gnu::always_inline]] inline std::size_t
+    saturating_add(const std::int64_t* lhs, const std::int64_t* rhs, std::int64_t* output, std::size_t size) {
+        std::size_t saturated = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            std::int64_t result     = wrapping_add(lhs[i], rhs[i]);
+            bool overflow           = ((lhs[i] ^ result) & (rhs[i] ^ result)) < 0;
+            std::int64_t limit      = (lhs[i] >> 63) ^ MAXIMUM;
+
+            output[i]   = overflow ? limit : result;
+            saturated  += overflow;
+        }
+        return saturated;
+    }
+
+    [[gnu::always_inline]] inline std::size_t
+    saturating_subtract(const std::int64_t* lhs, const std::int64_t* rhs, std::int64_t* output, std::size_t size) {
+        std::size_t saturated = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            std::int64_t result     = static_cast<std::int64_t>(
+                    static_cast<std::uint64_t>(lhs[i]) - static_cast<std::uint64_t>(rhs[i])
+                    );
+            bool overflow           = ((lhs[i] ^ rhs[i]) & (lhs[i] ^ result)) < 0;
+            std::int64_t limit      = (lhs[i] >> 63) ^ MAXIMUM;
+
+            output[i]   = overflow ? limit : result;
+            saturated  += overflow;
+        }
+        return saturated;
+    }
+
+    // Wide enough to vectorize, small enough to stay in L1 for a second read
+    constexpr std::size_t SPAN = 64;
+
+    // The factor is shared by every element, so the range of inputs whose
+    // product fits in int64 is computed once. Spans entirely inside it take
+    // the vector loop; the rare spans outside are redone in 128 bits, where
+    // only a quotient that does not fit clamps. Inputs are read before any
+    // output of their span is written, so input may alias output.
+    [[gnu::always_inline]] inline std::size_t
+    saturating_scale(const std::int64_t* input, std::int64_t factor, std::int64_t* output, std::size_t size) {
+        std::int64_t lower = MINIMUM;
+        std::int64_t upper = MAXIMUM;
+        if (factor > 0) {
+            lower = MINIMUM / factor;
+            upper = MAXIMUM / factor;
+        } else if (factor == -1) {
+            lower = -MAXIMUM;
+        } else if (factor < 0) {
+            lower = MAXIMUM / factor;
+            upper = MINIMUM / factor;
+        }
+
+        std::size_t saturated = 0;
+        for (std::size_t offset = 0; offset < size; offset += SPAN) {
+            const std::size_t last = std::min(size, offset + SPAN);
+
+            std::size_t outside = 0;
+            for (std::size_t i = offset; i < last; i++) {
+                outside += (input[i] > upper) | (input[i] < lower);
+            }
+            if (outside == 0) {
+                for (std::size_t i = offset; i < last; i++) {
+                    output[i] = wrapping_mul(input[i], factor) / FORWARD;
+                }
+                continue;
+            }
+            for (std::size_t i = offset; i < last; i++) {
+                __int128 quotient   = static_cast<__int128>(input[i]) * factor / FORWARD;
+                bool above          = quotient > MAXIMUM;
+                bool below          = quotient < MINIMUM;
+
+                output[i]   = above ? MAXIMUM : below ? MINIMUM : static_cast<std::int64_t>(quotient);
+                saturated  += above | below;
+            }
+        }
+        return saturated;
+    }
+
+    // The low halves are unsigned 32-bit values, so 2^32 of them fit in the
+    // unsigned accumulator; the arithmetic shift keeps the sign in the high
+    // half. Neither step needs 128-bit lanes.
+    [[gnu::always_inline]] inline void
+    total(const std::int64_t* input, std::size_t size, std::int64_t* high, std::uint64_t* low) {
+        std::int64_t upper  = 0;
+        std::uint64_t lower = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            upper += input[i] >> 32;
+            lower += static_cast<std::uint64_t>(input[i]) & 0xffffffffu;
+        }
+        *high   = upper;
+        *low    = lower;
+    }
+
+    [[gnu::always_inline]] inline void
+    extrema(const std::int64_t* input, std::size_t size, std::int64_t* minimum, std::int64_t* maximum) {
+        std::int64_t smallest   = MAXIMUM;
+        std::int64_t largest    = MINIMUM;
+        for (std::size_t i = 0; i < size; i++) {
+            smallest    = input[i] < smallest ? input[i] : smallest;
+            largest     = input[i] > largest ? input[i] : largest;
+        }
+        *minimum = smallest;
+        *maximum = largest;
+    }
+
+    // No instruction set here has a 64 x 64 -> 128 bit vector multiply, so
+    // this stays a scalar loop in every variant.
+    [[gnu::always_inline]] inline __int128
+    dot(const std::int64_t* lhs, const std::int64_t* rhs, std::size_t size) {
+        __int128 accumulator = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            accumulator += static_cast<__int128>(lhs[i]) * rhs[i];
+        }
+        return accumulator;
+    }
+
+    [[gnu::always_inline]] inline std::size_t
+    debounce(
+          const std::int64_t* value
+        , const std::int64_t* low
+        , const std::int64_t* high
+        , std::uint32_t debounce
+        , bool latching
+        , std::uint32_t* count
+        , std::uint8_t* state
+        , std::size_t size
+        )
+    {
+        const std::uint8_t latch = latching;
+
+        std::size_t changed = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            bool inside         = (low[i] <= value[i]) & (value[i] <= high[i]);
+            std::uint32_t next  = count[i] + (count[i] < debounce);
+            std::uint32_t c     = inside ? next : 0;
+
+            std::uint8_t previous   = state[i] & 1;
+            std::uint8_t current    = static_cast<std::uint8_t>(c >= debounce) | (latch & previous);
+            std::uint8_t edge       = current ^ previous;
+
+            count[i]    = c;
+            state[i]    = static_cast<std::uint8_t>(current | (edge << 1));
+            changed    += edge;
+        }
+        return changed;
+    }
+
+    // Clamped with min/max, so the loop has no branch; the table loads are by
+    // index, which only the hand-written gathers below widen
+    [[gnu::always_inline]] inline void
+    interpolate(
+          const std::int32_t* counts
+        , std::int32_t base
+        , std::uint32_t shift
+        , std::uint32_t segments
+        , const std::int64_t* knots
+        , std::int64_t* output
+        , std::size_t size
+        )
+    {
+        const std::int64_t limit    = static_cast<std::int64_t>(segments) << shift;
+        const std::int64_t last     = static_cast<std::int64_t>(segments) - 1;
+        for (std::size_t i = 0; i < size; i++) {
+            std::int64_t offset     = std::min(std::max(static_cast<std::int64_t>(counts[i]) - base, std::int64_t(0)), limit);
+            std::int64_t index      = std::min(offset >> shift, last);
+            std::int64_t fraction   = offset - (index << shift);
+            std::int64_t lower      = knots[index];
+            std::int64_t upper      = knots[index + 1];
+            output[i] = lower + (((upper - lower) * fraction) >> shift);
+        }
+    }
+
+    // Both differences are formed and one selected, so the loop is a
+    // compare, a blend and the unsigned compares of count and maximum
+    [[gnu::always_inline]] inline std::size_t
+    deviation(
+          const std::int64_t* lhs
+        , const std::int64_t* rhs
+        , std::uint64_t threshold
+        , std::uint64_t* maximum
+        , std::size_t size
+        )
+    {
+        std::size_t count       = 0;
+        std::uint64_t largest   = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            std::uint64_t forward   = static_cast<std::uint64_t>(lhs[i]) - static_cast<std::uint64_t>(rhs[i]);
+            std::uint64_t magnitude = lhs[i] >= rhs[i] ? forward : 0 - forward;
+            count   += magnitude > threshold;
+            largest = std::max(largest, magnitude);
+        }
+        *maximum = largest;
+        return count;
+    }
+} // namespace body
+
+    // Stamps out one full set of kernels compiled for a given target.
+#define VENTILATION_VARIANT(NAMESPACE, TARGET)                                                          \
+namespace NAMESPACE {                                                                                   \
+    TARGET bool                                                                                         \
+    finite(const float* input, std::size_t size) {                                                      \
+        return body::finite(input, size);                                                               \
+    }                                                                                                   \
+    TARGET void                                                                                         \
+    forward(const float* input, std::int64_t* output, std::size_t size) {                               \
+        body::forward(input, output, size);                                                             \
+    }                                                                                                   \
+    TARGET void                                                                                         \
+    inverse(const std::int64_t* input, float* output, std::size_t size) {                               \
+        body::inverse(input, output, size);                                                             \
+    }                                                                                                   \
+    TARGET void                                                                                         \
+    scale(const std::int64_t* input, std::int64_t factor, std::int64_t* output, std::size_t size) {     \
+        body::scale(input, factor, output, size);                                                       \
+    }                                                                                                   \
+    TARGET void                                                                                         \
+    compare(const std::int64_t* lhs, const std::int64_t* rhs, std::int8_t* output, std::size_t size) {  \
+        body::compare(lhs, rhs, output, size);                                                          \
+    }                                                                                                   \
+    TARGET std::int64_t                                                                                 \
+    sum(const std::int64_t* input, std::size_t size) {                                                  \
+        return body::sum(input, size);                                                                  \
+    }                                                                                                   \
+    TARGET void                                                                                         \
+    motion(                                                                                             \
+          const std::int64_t* flow                                                                      \
+        , const std::int64_t* volume                                                                    \
+        , std::int64_t resistance                                                                       \
+        , std::int64_t elastance                                                                        \
+        , std::int64_t peep                                                                             \
+        , std::int64_t* output                                                                          \
+        , std::size_t size                                                                              \
+        )                                                                                               \
+    {                                                                                                   \
+        body::motion(flow, volume, resistance, elastance, peep, output, size);                          \
+    }                                                                                                   \
+    TARGET std::size_t                                                                                  \
+    saturating_add(                                                                                     \
+          const std::int64_t* lhs                                                                       \
+        , const std::int64_t* rhs                                                                       \
+        , std::int64_t* output                                                                          \
+        , std::size_t size                                                                              \
+        )                                                                                               \
+    {                                                                                                   \
+        return body::saturating_add(lhs, rhs, output, size);                                            \
+    }                                                                                                   \
+    TARGET std::size_t                                                                                  \
+    saturating_subtract(                                                                                \
+          const std::int64_t* lhs                                                                       \
+        , const std::int64_t* rhs                                                                       \
+        , std::int64_t* output                                                                          \
+        , std::size_t size                                                                              \
+        )                                                                                               \
+    {                                                                                                   \
+        return body::saturating_subtract(lhs, rhs, output, size);                                       \
+    }                                                                                                   \
+    TARGET std::size_t                                                                                  \
+    saturating_scale(                                                                                   \
+          const std::int64_t* input                                                                     \
+        , std::int64_t factor                                                                           \
+        , std::int64_t* output                                                                          \
+        , std::size_t size                                                                              \
+        )                                                                                               \
+    {                                                                                                   \
+        return body::saturating_scale(input, factor, output, size);                                     \
+    }                                                                                                   \
+    TARGET void                                                                                         \
+    total(const std::int64_t* input, std::size_t size, std::int64_t* high, std::uint64_t* low) {        \
+        body::total(input, size, high, low);                                                            \
+    }                                                                                                   \
+    TARGET void                                                                                         \
+    extrema(                                                                                            \
+          const std::int64_t* input                                                                     \
+        , std::size_t size                                                                              \
+        , std::int64_t* minimum                                                                         \
+        , std::int64_t* maximum                                                                         \
+        )                                                                                               \
+    {                                                                                                   \
+        body::extrema(input, size, minimum, maximum);                                                   \
+    }                                                                                                   \
+    TARGET __int128                                                                                     \
+    dot(const std::int64_t* lhs, const std::int64_t* rhs, std::size_t size) {                           \
+        return body::dot(lhs, rhs, size);                                                               \
+    }                                                                                                   \
+    TARGET std::size_t                                                                                  \
+    debounce(                                                                                           \
+          const std::int64_t* value                                                                     \
+        , const std::int64_t* low                                                                       \
+        , const std::int64_t* high                                                                      \
+        , std::uint32_t debounce                                                                        \
+        , bool latching                                                                                 \
+        , std::uint32_t* count                                                                          \
+        , std::uint8_t* state                                                                           \
+        , std::size_t size                                                                              \
+        )                                                                                               \
+    {                                                                                                   \
+        return body::debounce(value, low, high, debounce, latching, count, state, size);                \
+    }                                                                                                   \
+    TARGET std::size_t                                                                                  \
+    deviation(                                                                                          \
+          const std::int64_t* lhs                                                                       \
+        , const std::int64_t* rhs                                                                       \
+        , std::uint64_t threshold                                                                       \
+        , std::uint64_t* maximum                                                                        \
+        , std::size_t size                                                                              \
+        )                                                                                               \
+    {                                                                                                   \
+        return body::deviation(lhs, rhs, threshold, maximum, size);                                     \
+    }                                                                                                   \
+} // namespace NAMESPACE
+
+    VENTILATION_VARIANT(baseline, )
+#if defined(__x86_64__) || defined(__i386__)
+    VENTILATION_VARIANT(sse42,  __attribute__((target("sse4.2"))))
+    VENTILATION_VARIANT(avx2,   __attribute__((target("avx2"))))
+    VENTILATION_VARIANT(avx512, __attribute__((target("avx512f,avx512dq,avx512vl,avx512bw"))))
+#endif
+#undef VENTILATION_VARIANT
+
+    // GCC does not vectorize gathers on its own, so interpolate is written out
+    // per instruction set; the targets without a gather run the body.
+namespace baseline {
+    void
+    interpolate(
+          const std::int32_t* counts
+        , std::int32_t base
+        , std::uint32_t shift
+        , std::uint32_t segments
+        , const std::int64_t* knots
+        , std::int64_t* output
+        , std::size_t size
+        )
+    {
+        body::interpolate(counts, base, shift, segments, knots, output, size);
+    }
+} // namespace baseline
+#if defined(__x86_64__) || defined(__i386__)
+namespace sse42 {
+    __attribute__((target("sse4.2"))) void
+    interpolate(
+          const std::int32_t* counts
+        , std::int32_t base
+        , std::uint32_t shift
+        , std::uint32_t segments
+        , const std::int64_t* knots
+        , std::int64_t* output
+        , std::size_t size
+        )
+    {
+        body::interpolate(counts, base, shift, segments, knots, output, size);
+    }
+} // namespace sse42
+
+namespace avx2 {
+    // AVX2 has no 64-bit min, max, multiply or arithmetic shift: the clamps
+    // are compare and blend, the product of a difference by a fraction below
+    // 2^32 is two 32 x 32 bit multiplies, and the shift flips negative lanes
+    // around a logical one.
+    __attribute__((target("avx2"))) void
+    interpolate(
+          const std::int32_t* counts
+        , std::int32_t base
+        , std::uint32_t shift
+        , std::uint32_t segments
+        , const std::int64_t* knots
+        , std::int64_t* output
+        , std::size_t size
+        )
+    {
+        const __m256i zero      = _mm256_setzero_si256();
+        const __m256i origin    = _mm256_set1_epi64x(base);
+        const __m256i limit     = _mm256_set1_epi64x(static_cast<std::int64_t>(segments) << shift);
+        const __m256i last      = _mm256_set1_epi64x(static_cast<std::int64_t>(segments) - 1);
+        const __m128i count     = _mm_cvtsi32_si128(static_cast<int>(shift));
+        const long long* table  = reinterpret_cast<const long long*>(knots);
+
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            __m256i offset  = _mm256_sub_epi64(
+                    _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(counts + i)))
+                    , origin
+                    );
+            offset          = _mm256_andnot_si256(_mm256_cmpgt_epi64(zero, offset), offset);
+            offset          = _mm256_blendv_epi8(offset, limit, _mm256_cmpgt_epi64(offset, limit));
+
+            __m256i index       = _mm256_srl_epi64(offset, count);
+            index               = _mm256_blendv_epi8(index, last, _mm256_cmpgt_epi64(index, last));
+            __m256i fraction    = _mm256_sub_epi64(offset, _mm256_sll_epi64(index, count));
+
+            __m256i lower       = _mm256_i64gather_epi64(table, index, 8);
+            __m256i upper       = _mm256_i64gather_epi64(table + 1, index, 8);
+            __m256i difference  = _mm256_sub_epi64(upper, lower);
+            __m256i product     = _mm256_add_epi64(
+                      _mm256_mul_epu32(difference, fraction)
+                    , _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(difference, 32), fraction), 32)
+                    );
+            __m256i sign        = _mm256_cmpgt_epi64(zero, product);
+            __m256i shifted     = _mm256_xor_si256(_mm256_srl_epi64(_mm256_xor_si256(product, sign), count), sign);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_add_epi64(lower, shifted));
+        }
+        body::interpolate(counts + i, base, shift, segments, knots, output + i, size - i);
+    }
+} // namespace avx2
+
+    // GCC 12 flags the undefined pass-through operand of its own AVX-512
+    // intrinsics as uninitialized
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+namespace avx512 {
+    __attribute__((target("avx512f,avx512dq,avx512vl,avx512bw"))) void
+    interpolate(
+          const std::int32_t* counts
+        , std::int32_t base
+        , std::uint32_t shift
+        , std::uint32_t segments
+        , const std::int64_t* knots
+        , std::int64_t* output
+        , std::size_t size
+        )
+    {
+        const __m512i zero      = _mm512_setzero_si512();
+        const __m512i origin    = _mm512_set1_epi64(base);
+        const __m512i limit     = _mm512_set1_epi64(static_cast<std::int64_t>(segments) << shift);
+        const __m512i last      = _mm512_set1_epi64(static_cast<std::int64_t>(segments) - 1);
+        const __m128i count     = _mm_cvtsi32_si128(static_cast<int>(shift));
+        const long long* table  = reinterpret_cast<const long long*>(knots);
+
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            __m512i offset  = _mm512_sub_epi64(
+                    _mm512_cvtepi32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(counts + i)))
+                    , origin
+                    );
+            offset          = _mm512_min_epi64(_mm512_max_epi64(offset, zero), limit);
+
+            __m512i index       = _mm512_min_epi64(_mm512_srl_epi64(offset, count), last);
+            __m512i fraction    = _mm512_sub_epi64(offset, _mm512_sll_epi64(index, count));
+
+            __m512i lower       = _mm512_i64gather_epi64(index, table, 8);
+            __m512i upper       = _mm512_i64gather_epi64(index, table + 1, 8);
+            __m512i product     = _mm512_mullo_epi64(_mm512_sub_epi64(upper, lower), fraction);
+
+            _mm512_storeu_si512(output + i, _mm512_add_epi64(lower, _mm512_sra_epi64(product, count)));
+        }
+        body::interpolate(counts + i, base, shift, segments, knots, output + i, size - i);
+    }
+} // namespace avx512
+#pragma GCC diagnostic pop
+#endif
+
+#define VENTILATION_TABLE(NAME, NAMESPACE) \
+    Table{ NAME                            \
+         , NAMESPACE::finite               \
+         , NAMESPACE::forward              \
+         , NAMESPACE::inverse              \
+         , NAMESPACE::scale                \
+         , NAMESPACE::compare              \
+         , NAMESPACE::sum                  \
+         , NAMESPACE::motion               \
+         , NAMESPACE::saturating_add       \
+         , NAMESPACE::saturating_subtract  \
+         , NAMESPACE::saturating_scale     \
+         , NAMESPACE::total                \
+         , NAMESPACE::extrema              \
+         , NAMESPACE::dot                  \
+         , NAMESPACE::debounce             \
+         , NAMESPACE::interpolate          \
+         , NAMESPACE::deviation            \
+         }
+
+    const Table REFERENCE   = VENTILATION_TABLE("scalar", scalar);
+    const Table BASELINE    = VENTILATION_TABLE("baseline", baseline);
+#if defined(__x86_64__) || defined(__i386__)
+    const Table SSE42       = VENTILATION_TABLE("sse4.2", sse42);
+    const Table AVX2        = VENTILATION_TABLE("avx2", avx2);
+    const Table AVX512      = VENTILATION_TABLE("avx512", avx512);
+#endif
+#undef VENTILATION_TABLE
+
+    std::vector<Table>
+    supported() {
+        std::vector<Table> tables = {REFERENCE, BASELINE};
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse4.2")) {
+            tables.push_back(SSE42);
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            tables.push_back(AVX2);
+        }
+        if (    __builtin_cpu_supports("avx512f")
+            and __builtin_cpu_supports("avx512dq")
+            and __builtin_cpu_supports("avx512vl")
+            and __builtin_cpu_supports("avx512bw"))
+        {
+            tables.push_back(AVX512);
+        }
+#endif
+        return tables;
+    }
+} // namespace
+    const Table&
+    reference() {
+        return REFERENCE;
+    }
+
+    const Table&
+    active() {
+        static const Table& table = available().back();
+        return table;
+    }
+
+    std::span<const Table>
+    available() {
+        static const std::vector<Table> tables = supported();
+        return tables;
+    }
+} // namespace kernels
+} // namespace ventilation
@@ -0,0 +1,179 @@
+#include "ventilation/loop.hpp"
+#include "ventilation/mechanics.hpp"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+namespace ventilation {
+namespace loop {
+namespace {
+    // Samples binned per step: indices are computed for a whole block first,
+    // in a loop free of memory dependencies, then scattered into the tile
+    constexpr std::size_t BLOCK     = 4096;
+    // Samples claimed by a thread at a time
+    constexpr std::size_t CHUNK     = 64 * BLOCK;
+
+    __int128
+    shoelace(const std::int64_t* volume, const std::int64_t* pressure, std::size_t size) {
+        __int128 doubled = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            std::size_t j = (i + 1 == size) ? 0 : i + 1;
+            doubled += static_cast<__int128>(volume[i]) * pressure[j];
+            doubled -= static_cast<__int128>(volume[j]) * pressure[i];
+        }
+        return doubled < 0 ? -doubled : doubled;
+    }
+} // namespace
+    Work
+    area(std::span<const Volume> volume, std::span<const Pressure> pressure) {
+        if (volume.size() != pressure.size()) {
+            throw std::invalid_argument("volume and pressure must have the same size");
+        }
+        return mechanics::energy(shoelace(
+                fixed::Access::raw(volume).data()
+                , fixed::Access::raw(pressure).data()
+                , volume.size()
+                ));
+    }
+
+    void
+    area(
+          std::span<const Volume> volume
+        , std::span<const Pressure> pressure
+        , std::span<const std::size_t> boundaries
+        , std::span<Work> output
+        , parallel::Pool& pool
+        )
+    {
+        if (volume.size() != pressure.size()) {
+            throw std::invalid_argument("volume and pressure must have the same size");
+        }
+        const std::int64_t* vs = fixed::Access::raw(volume).data();
+        const std::int64_t* ps = fixed::Access::raw(pressure).data();
+
+        mechanics::detail::breaths(boundaries, output.size(), volume.size(), pool, [&](std::size_t i, std::size_t offset, std::size_t size) {
+            output[i] = mechanics::energy(shoelace(vs + offset, ps + offset, size));
+        });
+    }
+
+    template <Quantity T>
+    Histogram::Scale
+    Histogram::scale(const Axis<T>& axis) {
+        std::int64_t lower = fixed::Access::raw(axis.lower);
+        std::int64_t upper = fixed::Access::raw(axis.upper);
+        if (axis.bins == 0) {
+            throw std::invalid_argument("axis must have at least one bin");
+        }
+        if (lower >= upper) {
+            throw std::invalid_argument("axis lower bound must be below the upper bound");
+        }
+        std::uint64_t range     = static_cast<std::uint64_t>(upper) - static_cast<std::uint64_t>(lower);
+        std::uint64_t width     = range / axis.bins;
+        std::uint64_t remainder = range % axis.bins;
+        // Without a remainder no offset is below the split, and width + 1
+        // may not even fit
+        std::uint64_t narrow    = std::max<std::uint64_t>(width, 1);
+        std::uint64_t wide      = remainder == 0 ? narrow : width + 1;
+        return {lower, range, wide, narrow, remainder * wide, remainder, axis.bins};
+    }
+
+    Histogram::Histogram(const Axis<Volume>& volume, const Axis<Pressure>& pressure)
+        : volume_(volume)
+        , pressure_(pressure)
+        , rows_(scale(volume))
+        , columns_(scale(pressure))
+        , counts_(rows_.bins * columns_.bins, 0)
+    {}
+
+    void
+    Histogram::accumulate(std::span<const Volume> volume, std::span<const Pressure> pressure, parallel::Pool& pool) {
+        if (volume.size() != pressure.size()) {
+            throw std::invalid_argument("volume and pressure must have the same size");
+        }
+        const std::int64_t* vs = fixed::Access::raw(volume).data();
+        const std::int64_t* ps = fixed::Access::raw(pressure).data();
+        const std::size_t cells = counts_.size();
+        const Scale rows        = rows_;
+        const Scale columns     = columns_;
+
+        // One tile per pool thread, the last cell of each counting outliers.
+        // Threads pull chunks off a shared counter and only ever touch their
+        // own tile.
+        std::size_t threads = std::min(pool.size(), (volume.size() + CHUNK - 1) / CHUNK);
+        std::vector<std::vector<std::uint64_t>> tiles(threads);
+        std::atomic<std::size_t> next = 0;
+
+        pool.run(threads, [&](std::size_t t) {
+            std::vector<std::uint64_t>& tile = tiles[t];
+            tile.assign(cells + 1, 0);
+
+            std::size_t indices[BLOCK];
+            for (std::size_t chunk = next++; chunk * CHUNK < volume.size(); chunk = next++) {
+                std::size_t end = std::min(volume.size(), (chunk + 1) * CHUNK);
+                for (std::size_t offset = chunk * CHUNK; offset < end; offset += BLOCK) {
+                    std::size_t count = std::min(BLOCK, end - offset);
+                    for (std::size_t i = 0; i < count; i++) {
+                        std::uint64_t v = static_cast<std::uint64_t>(vs[offset + i]) - static_cast<std::uint64_t>(rows.lower);
+                        std::uint64_t p = static_cast<std::uint64_t>(ps[offset + i]) - static_cast<std::uint64_t>(columns.lower);
+                        // Below the lower bound wraps around past the range
+                        bool inside = (v < rows.range) & (p < columns.range);
+                        indices[i]  = inside ? rows.bin(v) * columns.bins + columns.bin(p) : cells;
+                    }
+                    for (std::size_t i = 0; i < count; i++) {
+                        tile[indices[i]]++;
+                    }
+                }
+            }
+        });
+
+        // Tiles are folded in by bands of rows, so the merge is parallel too
+        // and each band stays in cache across tiles
+        std::size_t bands = std::min(pool.size(), rows.bins);
+        if (threads > 0) {
+            pool.run(bands, [&](std::size_t band) {
+                std::size_t first   = (rows.bins * band / bands) * columns.bins;
+                std::size_t last    = (rows.bins * (band + 1) / bands) * columns.bins;
+                for (const std::vector<std::uint64_t>& tile : tiles) {
+                    for (std::size_t i = first; i < last; i++) {
+                        counts_[i] += tile[i];
+                    }
+                }
+            });
+        }
+        for (const std::vector<std::uint64_t>& tile : tiles) {
+            outside_ += tile[cells];
+        }
+    }
+
+    void
+    Histogram::merge(const Histogram& other) {
+        if (    rows_.lower != other.rows_.lower or rows_.range != other.rows_.range or rows_.bins != other.rows_.bins
+            or  columns_.lower != other.columns_.lower or columns_.range != other.columns_.range
+            or  columns_.bins != other.columns_.bins)
+        {
+            throw std::invalid_argument("histograms must have the same axes");
+        }
+        for (std::size_t i = 0; i < counts_.size(); i++) {
+            counts_[i] += other.counts_[i];
+        }
+        outside_ += other.outside_;
+    }
+
+    std::uint64_t
+    Histogram::at(std::size_t v, std::size_t p) const {
+        if (v >= rows_.bins or p >= columns_.bins) {
+            throw std::out_of_range("bin out of range");
+        }
+        return counts_[v * columns_.bins + p];
+    }
+
+    std::uint64_t
+    Histogram::total() const {
+        std::uint64_t accumulator = outside_;
+        for (std::uint64_t count : counts_) {
+            accumulator += count;
+        }
+        return accumulator;
+    }
+} // namespace loop
+} // namespace ventilation
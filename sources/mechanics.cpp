@@ -0,0 +1,138 @@
+#include "ventilation/mechanics.hpp"
+#include "ventilation/instrumentation.hpp"
+#include "ventilation/tracing.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace ventilation {
+namespace mechanics {
+namespace {
+    // One cmH2O.L is 98.0665 mJ
+    constexpr __int128 JOULE_NUMERATOR      = 980665;
+    constexpr __int128 JOULE_DENOMINATOR    = 10000000;
+
+    void
+    validate(float period) {
+        if (not std::isfinite(period) or not (period > 0.0f)) {
+            instrumentation::increment(instrumentation::Counter::domain);
+            throw std::domain_error("sampling period must be finite and positive");
+        }
+    }
+
+    // Single pass over raw samples. The work integral uses the trapezoidal
+    // rule on volume increments, accumulated exactly in 128 bits.
+    Breath
+    breath(const std::int64_t* pressure, const std::int64_t* flow, const std::int64_t* volume, std::size_t size, float period) {
+        VENTILATION_TRACE("mechanics::breath");
+        __int128 integral       = 0;
+        std::int64_t peak       = pressure[0];
+        std::int64_t plateau    = pressure[0];
+        bool inspiration        = flow[0] >= 0;
+
+        for (std::size_t i = 1; i < size; i++) {
+            peak = std::max(peak, pressure[i]);
+
+            inspiration = inspiration and flow[i] >= 0;
+            if (inspiration) {
+                __int128 height     = static_cast<__int128>(pressure[i - 1]) + pressure[i];
+                __int128 increment  = static_cast<__int128>(volume[i]) - volume[i - 1];
+
+                integral   += height * increment;
+                plateau     = pressure[i];
+            }
+        }
+        Work work = energy(integral);
+
+        Breath result;
+        result.work     = work;
+        result.power    = fixed::Access::make<Power>(fixed::Access::raw(work)) * (60.0f / (static_cast<float>(size) * period));
+        result.peak     = fixed::Access::make<Pressure>(peak);
+        result.plateau  = fixed::Access::make<Pressure>(plateau);
+        result.driving  = fixed::Access::make<Pressure>(plateau - pressure[size - 1]);
+        return result;
+    }
+} // namespace
+    Work
+    energy(__int128 doubled) {
+        // pressure * volume carries the scale twice
+        const __int128 forward = static_cast<std::int64_t>(fixed::FORWARD);
+        __int128 joules = (doubled * JOULE_NUMERATOR) / (2 * forward * JOULE_DENOMINATOR);
+        if (    joules < std::numeric_limits<std::int64_t>::min()
+            or  joules > std::numeric_limits<std::int64_t>::max())
+        {
+            instrumentation::increment(instrumentation::Counter::range);
+            throw std::out_of_range("work does not fit the representation");
+        }
+        return fixed::Access::make<Work>(static_cast<std::int64_t>(joules));
+    }
+
+    Breath
+    analyze(
+          std::span<const Pressure> pressure
+        , std::span<const Flow> flow
+        , std::span<const Volume> volume
+        , float period
+        )
+    {
+        if (pressure.size() != flow.size() or pressure.size() != volume.size()) {
+            throw std::invalid_argument("pressure, flow and volume must have the same size");
+        }
+        if (pressure.empty()) {
+            throw std::invalid_argument("breath must have at least one sample");
+        }
+        validate(period);
+
+        return breath(
+                fixed::Access::raw(pressure).data()
+                , fixed::Access::raw(flow).data()
+                , fixed::Access::raw(volume).data()
+                , pressure.size()
+                , period
+                );
+    }
+
+    void
+    analyze(
+          std::span<const Pressure> pressure
+        , std::span<const Flow> flow
+        , std::span<const Volume> volume
+        , std::span<const std::size_t> boundaries
+        , float period
+        , std::span<Breath> output
+        , parallel::Pool& pool
+        )
+    {
+        if (pressure.size() != flow.size() or pressure.size() != volume.size()) {
+            throw std::invalid_argument("pressure, flow and volume must have the same size");
+        }
+        validate(period);
+
+        const std::int64_t* ps = fixed::Access::raw(pressure).data();
+        const std::int64_t* fs = fixed::Access::raw(flow).data();
+        const std::int64_t* vs = fixed::Access::raw(volume).data();
+
+        detail::breaths(boundaries, output.size(), pressure.size(), pool, [&](std::size_t i, std::size_t offset, std::size_t size) {
+            output[i] = breath(ps + offset, fs + offset, vs + offset, size, period);
+        });
+    }
+
+namespace detail {
+    void
+    validate(std::span<const std::size_t> boundaries, std::size_t breaths, std::size_t samples) {
+        if (boundaries.size() != breaths + 1) {
+            throw std::invalid_argument("boundaries must have one more entry than output");
+        }
+        for (std::size_t i = 0; i < breaths; i++) {
+            if (boundaries[i] >= boundaries[i + 1]) {
+                throw std::invalid_argument("breaths must be non-empty and in order");
+            }
+        }
+        if (boundaries.back() > samples) {
+            throw std::out_of_range("breath boundary past the end of the waveforms");
+        }
+    }
+} // namespace detail
+} // namespace mechanics
+} // namespace ventilation
@@ -0,0 +1,75 @@
+#include "ventilation/model.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace ventilation {
+namespace model {
+namespace {
+    void
+    validate(const Parameters& parameters, const Settings& settings) {
+        if (    not (static_cast<float>(parameters.resistance) > 0.0f)
+            or  not (static_cast<float>(parameters.compliance) > 0.0f))
+        {
+            throw std::invalid_argument("resistance and compliance must be positive");
+        }
+        if (    not (settings.inspiration > 0.0f) or not (settings.expiration > 0.0f)
+            or  not (settings.pause >= 0.0f) or not (settings.period > 0.0f))
+        {
+            throw std::invalid_argument("breath timing must be positive");
+        }
+    }
+} // namespace
+    Pressure
+    peak(const Parameters& parameters, const Settings& settings) {
+        validate(parameters, settings);
+
+        float tidal     = static_cast<float>(parameters.tidal);
+        float flow      = tidal / settings.inspiration;
+        float resistive = static_cast<float>(parameters.resistance) * flow;
+        float elastic   = tidal / static_cast<float>(parameters.compliance);
+
+        return Pressure(resistive + elastic) + parameters.peep;
+    }
+
+    Waveforms
+    simulate(const Parameters& parameters, const Settings& settings) {
+        validate(parameters, settings);
+
+        const float resistance  = static_cast<float>(parameters.resistance);
+        const float compliance  = static_cast<float>(parameters.compliance);
+        const float tidal       = static_cast<float>(parameters.tidal);
+        const float inspiratory = tidal / settings.inspiration;
+        const float constant    = resistance * compliance;
+
+        const std::size_t inspiration   = static_cast<std::size_t>(std::lround(settings.inspiration / settings.period));
+        const std::size_t pause         = static_cast<std::size_t>(std::lround(settings.pause / settings.period));
+        const std::size_t expiration    = static_cast<std::size_t>(std::lround(settings.expiration / settings.period));
+
+        Waveforms waveforms;
+        auto push = [&](float flow, float volume, float pressure) {
+            waveforms.flow.push_back(Flow(flow));
+            waveforms.volume.push_back(Volume(volume));
+            waveforms.pressure.push_back(Pressure(pressure) + parameters.peep);
+        };
+        for (std::size_t i = 0; i <= inspiration; i++) {
+            float volume = tidal * static_cast<float>(i) / static_cast<float>(inspiration);
+            push(inspiratory, volume, resistance * inspiratory + volume / compliance);
+        }
+        for (std::size_t i = 0; i < pause; i++) {
+            push(0.0f, tidal, tidal / compliance);
+        }
+        // The valve opens to PEEP and the lung empties with time constant R * C
+        for (std::size_t i = 1; i <= expiration; i++) {
+            float volume = tidal * std::exp(-static_cast<float>(i) * settings.period / constant);
+            push(-volume / constant, volume, 0.0f);
+        }
+        return waveforms;
+    }
+
+    mechanics::Breath
+    breath(const Parameters& parameters, const Settings& settings) {
+        Waveforms waveforms = simulate(parameters, settings);
+        return mechanics::analyze(waveforms.pressure, waveforms.flow, waveforms.volume, settings.period);
+    }
+} // namespace model
+} // namespace ventilation
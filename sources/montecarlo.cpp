@@ -0,0 +1,180 @@
+#include "ventilation/montecarlo.hpp"
+#include "ventilation/random.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace ventilation {
+namespace montecarlo {
+namespace {
+    // Patients evaluated together, one array per variable
+    constexpr std::size_t BATCH     = 256;
+    // Patients per pool task; fixed, so merges happen in the same order
+    // whatever the number of threads
+    constexpr std::uint64_t BLOCK   = 16 * BATCH;
+    // Blocks in flight at once, which bounds memory for any patient count
+    constexpr std::uint64_t WINDOW  = 1024;
+
+    constexpr float JOULES = 0.0980665f;
+
+    void
+    validate(const Population& population, const model::Settings& settings) {
+        for (const Lognormal& distribution : {population.resistance, population.compliance}) {
+            if (not (distribution.median > 0.0f) or not (distribution.sigma >= 0.0f) or not std::isfinite(distribution.sigma)) {
+                throw std::invalid_argument("log-normal median must be positive and sigma non-negative");
+            }
+        }
+        if (not (settings.inspiration > 0.0f)) {
+            throw std::invalid_argument("inspiratory time must be positive");
+        }
+    }
+
+    // Log-normal value for a standard normal z
+    float
+    draw(const Lognormal& distribution, float z) {
+        return std::exp(std::log(distribution.median) + distribution.sigma * z);
+    }
+
+    Summary
+    block(
+          const Population& population
+        , const model::Settings& settings
+        , std::uint64_t first
+        , std::uint64_t count
+        , std::uint64_t seed
+        , const Pressure& limit
+        )
+    {
+        const random::Philox generator(seed);
+        const float tidal   = static_cast<float>(population.tidal);
+        const float peep    = static_cast<float>(population.peep);
+        const float flow    = tidal / settings.inspiration;
+        const float ceiling = static_cast<float>(limit);
+
+        std::array<std::array<std::uint32_t, 4>, BATCH> bits;
+        std::array<float, BATCH> resistance, compliance;
+        std::array<float, BATCH> peak, plateau, driving, work;
+
+        Summary summary;
+        for (std::uint64_t offset = 0; offset < count; offset += BATCH) {
+            const std::size_t size = static_cast<std::size_t>(std::min<std::uint64_t>(BATCH, count - offset));
+
+            for (std::size_t i = 0; i < size; i++) {
+                bits[i] = generator(0, first + offset + i);
+            }
+            for (std::size_t i = 0; i < size; i++) {
+                // Through the quantity constructors, quantized as patient()
+                // does, so run() and patient() agree
+                auto [zr, zc]   = random::normal(bits[i][0], bits[i][1]);
+                resistance[i]   = static_cast<float>(Resistance(draw(population.resistance, zr)));
+                compliance[i]   = static_cast<float>(Compliance(draw(population.compliance, zc)));
+            }
+            // Closed forms of the model breath, branch-free across the batch
+            for (std::size_t i = 0; i < size; i++) {
+                float elastic   = tidal / compliance[i];
+                float resistive = resistance[i] * flow;
+
+                driving[i]  = elastic;
+                plateau[i]  = elastic + peep;
+                peak[i]     = resistive + elastic + peep;
+                work[i]     = (tidal * (resistive + peep) + 0.5f * tidal * elastic) * JOULES;
+            }
+            for (std::size_t i = 0; i < size; i++) {
+                summary.resistance.push(resistance[i]);
+                summary.compliance.push(compliance[i]);
+                summary.peak.push(peak[i]);
+                summary.plateau.push(plateau[i]);
+                summary.driving.push(driving[i]);
+                summary.work.push(work[i]);
+                summary.exceeding += peak[i] > ceiling;
+            }
+        }
+        return summary;
+    }
+
+    void
+    merge(Summary& summary, const Summary& other) {
+        summary.resistance.merge(other.resistance);
+        summary.compliance.merge(other.compliance);
+        summary.peak.merge(other.peak);
+        summary.plateau.merge(other.plateau);
+        summary.driving.merge(other.driving);
+        summary.work.merge(other.work);
+        summary.exceeding += other.exceeding;
+    }
+} // namespace
+    void
+    Statistics::push(double value) {
+        count++;
+        double delta = value - mean;
+        mean    += delta / static_cast<double>(count);
+        squares += delta * (value - mean);
+        minimum = std::min(minimum, value);
+        maximum = std::max(maximum, value);
+    }
+
+    void
+    Statistics::merge(const Statistics& other) {
+        if (other.count == 0) { return; }
+        if (count == 0) {
+            *this = other;
+            return;
+        }
+        double total    = static_cast<double>(count + other.count);
+        double delta    = other.mean - mean;
+        mean    += delta * static_cast<double>(other.count) / total;
+        squares += other.squares + delta * delta * static_cast<double>(count) * static_cast<double>(other.count) / total;
+        count   += other.count;
+        minimum = std::min(minimum, other.minimum);
+        maximum = std::max(maximum, other.maximum);
+    }
+
+    double
+    Statistics::variance() const {
+        return count < 2 ? 0.0 : squares / static_cast<double>(count - 1);
+    }
+
+    model::Parameters
+    patient(const Population& population, std::uint64_t seed, std::uint64_t index) {
+        random::Philox::Block bits = random::Philox(seed)(0, index);
+        auto [zr, zc] = random::normal(bits[0], bits[1]);
+        return {
+              Resistance(draw(population.resistance, zr))
+            , Compliance(draw(population.compliance, zc))
+            , population.peep
+            , population.tidal
+        };
+    }
+
+    Summary
+    run(
+          const Population& population
+        , const model::Settings& settings
+        , std::uint64_t count
+        , std::uint64_t seed
+        , const Pressure& limit
+        , parallel::Pool& pool
+        )
+    {
+        validate(population, settings);
+
+        Summary summary;
+        const std::uint64_t blocks = (count + BLOCK - 1) / BLOCK;
+        std::vector<Summary> partials;
+        for (std::uint64_t window = 0; window < blocks; window += WINDOW) {
+            std::size_t size = static_cast<std::size_t>(std::min(WINDOW, blocks - window));
+            partials.assign(size, Summary());
+            pool.run(size, [&](std::size_t i) {
+                std::uint64_t first = (window + i) * BLOCK;
+                partials[i] = block(population, settings, first, std::min(BLOCK, count - first), seed, limit);
+            });
+            for (const Summary& partial : partials) {
+                merge(summary, partial);
+            }
+        }
+        return summary;
+    }
+} // namespace montecarlo
+} // namespace ventilation
@@ -0,0 +1,218 @@
+#include "ventilation/oscillation.hpp"
+#include "ventilation/instrumentation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+namespace ventilation {
+namespace oscillation {
+namespace {
+    void
+    validate(float period) {
+        if (not std::isfinite(period) or not (period > 0.0f)) {
+            instrumentation::increment(instrumentation::Counter::domain);
+            throw std::domain_error("sampling period must be finite and positive");
+        }
+    }
+
+    // Segments transformed by one pool task
+    constexpr std::size_t SEGMENTS = 16;
+
+    // Spectra summed over segments, for bins 0 ... segment / 2
+    struct Spectra {
+        std::vector<double>         flow;
+        std::vector<double>         pressure;
+        std::vector<fft::Complex>   cross;
+
+        explicit Spectra(std::size_t bins) : flow(bins, 0.0), pressure(bins, 0.0), cross(bins) {}
+
+        void
+        merge(const Spectra& other) {
+            for (std::size_t k = 0; k < flow.size(); k++) {
+                flow[k]     += other.flow[k];
+                pressure[k] += other.pressure[k];
+                cross[k]    += other.cross[k];
+            }
+        }
+    };
+
+    Point
+    point(double frequency, const fft::Complex& impedance, double coherence) {
+        const double omega = 2.0 * std::numbers::pi * frequency;
+        return Point{
+              static_cast<float>(frequency)
+            , Resistance(static_cast<float>(impedance.real()))
+            , Elastance(static_cast<float>(-omega * impedance.imag()))
+            , static_cast<float>(coherence)
+        };
+    }
+} // namespace
+    std::vector<Point>
+    impedance(
+          std::span<const Pressure> pressure
+        , std::span<const Flow> flow
+        , float period
+        , const Welch& welch
+        , parallel::Pool& pool
+        )
+    {
+        if (pressure.size() != flow.size()) {
+            throw std::invalid_argument("pressure and flow must have the same size");
+        }
+        if (welch.segment < 2 or welch.overlap >= welch.segment) {
+            throw std::invalid_argument("segments must hold two samples and overlap less than one segment");
+        }
+        if (flow.size() < welch.segment) {
+            throw std::invalid_argument("recording is shorter than one segment");
+        }
+        validate(period);
+
+        const std::size_t segment   = welch.segment;
+        const std::size_t step      = segment - welch.overlap;
+        const std::size_t segments  = (flow.size() - segment) / step + 1;
+        const std::size_t bins      = segment / 2 + 1;
+        const fft::Plan plan(segment);
+
+        // Periodic Hann window
+        std::vector<double> window(segment);
+        for (std::size_t n = 0; n < segment; n++) {
+            window[n] = 0.5 - 0.5 * std::cos(2.0 * std::numbers::pi * static_cast<double>(n) / static_cast<double>(segment));
+        }
+
+        std::span<const std::int64_t> ps = fixed::Access::raw(pressure);
+        std::span<const std::int64_t> fs = fixed::Access::raw(flow);
+
+        const std::size_t blocks = (segments + SEGMENTS - 1) / SEGMENTS;
+        std::vector<Spectra> partial(blocks, Spectra(bins));
+        pool.run(blocks, [&](std::size_t block) {
+            std::vector<fft::Complex> input(segment);
+            std::vector<fft::Complex> q(segment);
+            std::vector<fft::Complex> p(segment);
+            Spectra& sums = partial[block];
+
+            // Mean removed, so breathing offsets do not leak into the bins
+            auto transform = [&](std::span<const std::int64_t> raw, std::vector<fft::Complex>& output) {
+                std::int64_t total = 0;
+                for (std::int64_t value : raw) {
+                    total += value;
+                }
+                const double mean = static_cast<double>(total) / static_cast<double>(segment);
+                for (std::size_t n = 0; n < segment; n++) {
+                    input[n] = (static_cast<double>(raw[n]) - mean) * window[n];
+                }
+                plan.forward(input, output);
+            };
+
+            const std::size_t last = std::min(segments, (block + 1) * SEGMENTS);
+            for (std::size_t s = block * SEGMENTS; s < last; s++) {
+                const std::size_t offset = s * step;
+                transform(fs.subspan(offset, segment), q);
+                transform(ps.subspan(offset, segment), p);
+                for (std::size_t k = 0; k < bins; k++) {
+                    sums.flow[k]        += std::norm(q[k]);
+                    sums.pressure[k]    += std::norm(p[k]);
+                    sums.cross[k]       += std::conj(q[k]) * p[k];
+                }
+            }
+        });
+        for (std::size_t block = 1; block < blocks; block++) {
+            partial[0].merge(partial[block]);
+        }
+
+        const Spectra& total = partial[0];
+        const double resolution = 1.0 / (static_cast<double>(segment) * period);
+        std::vector<Point> result;
+        result.reserve(bins - 1);
+        for (std::size_t k = 1; k < bins; k++) {
+            const double frequency = static_cast<double>(k) * resolution;
+            if (not (total.flow[k] > 0.0)) {
+                result.push_back(Point{static_cast<float>(frequency), Resistance(0.0f), Elastance(0.0f), 0.0f});
+                continue;
+            }
+            const double power = total.flow[k] * total.pressure[k];
+            const double coherence = power > 0.0 ? std::norm(total.cross[k]) / power : 0.0;
+            result.push_back(point(frequency, total.cross[k] / total.flow[k], coherence));
+        }
+        return result;
+    }
+
+    Tracker::Tracker(std::span<const float> frequencies, std::size_t window, float period)
+        : window_(window)
+        , period_(period)
+    {
+        validate(period);
+        if (window < 2) {
+            throw std::invalid_argument("window must hold two samples");
+        }
+        for (float frequency : frequencies) {
+            const double k = std::round(static_cast<double>(frequency) * static_cast<double>(window) * period);
+            if (not (k >= 1.0) or k > static_cast<double>(window / 2)) {
+                throw std::invalid_argument("frequency outside the bins of the window");
+            }
+            bins_.push_back(static_cast<std::size_t>(k));
+            rotations_.push_back(std::polar(1.0, 2.0 * std::numbers::pi * k / static_cast<double>(window)));
+        }
+        twiddles_.resize(window);
+        for (std::size_t n = 0; n < window; n++) {
+            twiddles_[n] = std::polar(1.0, -2.0 * std::numbers::pi * static_cast<double>(n) / static_cast<double>(window));
+        }
+        pressures_.resize(bins_.size());
+        flows_.resize(bins_.size());
+        pressure_.resize(window, 0);
+        flow_.resize(window, 0);
+    }
+
+    void
+    Tracker::push(const Pressure& pressure, const Flow& flow) {
+        const std::int64_t p = fixed::Access::raw(pressure);
+        const std::int64_t f = fixed::Access::raw(flow);
+
+        // The window starts out as zeros, so the first samples need no care
+        const double dp = static_cast<double>(p - pressure_[position_]);
+        const double df = static_cast<double>(f - flow_[position_]);
+        pressure_[position_]    = p;
+        flow_[position_]        = f;
+        position_               = position_ + 1 == window_ ? 0 : position_ + 1;
+        count_++;
+
+        if (position_ == 0) {
+            refresh();
+            return;
+        }
+        for (std::size_t i = 0; i < bins_.size(); i++) {
+            pressures_[i]   = (pressures_[i] + dp) * rotations_[i];
+            flows_[i]       = (flows_[i] + df) * rotations_[i];
+        }
+    }
+
+    void
+    Tracker::refresh() {
+        for (std::size_t i = 0; i < bins_.size(); i++) {
+            fft::Complex p = 0.0;
+            fft::Complex f = 0.0;
+            std::size_t index = 0;
+            for (std::size_t n = 0; n < window_; n++) {
+                p       += static_cast<double>(pressure_[n]) * twiddles_[index];
+                f       += static_cast<double>(flow_[n]) * twiddles_[index];
+                index   += bins_[i];
+                if (index >= window_) { index -= window_; }
+            }
+            pressures_[i]   = p;
+            flows_[i]       = f;
+        }
+    }
+
+    Point
+    Tracker::operator[](std::size_t i) const {
+        if (i >= bins_.size()) {
+            throw std::out_of_range("no such tracked frequency");
+        }
+        const double frequency = static_cast<double>(bins_[i]) / (static_cast<double>(window_) * period_);
+        if (flows_[i] == fft::Complex(0.0)) {
+            return Point{static_cast<float>(frequency), Resistance(0.0f), Elastance(0.0f), 0.0f};
+        }
+        return point(frequency, pressures_[i] / flows_[i], 1.0);
+    }
+} // namespace oscillation
+} // namespace ventilation
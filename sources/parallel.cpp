@@ -0,0 +1,323 @@
+#include "ventilation/parallel.hpp"
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <pthread.h>
+#include <sched.h>
+
+namespace ventilation {
+namespace parallel {
+namespace {
+    // Largest number of indices a Range can hold
+    constexpr std::uint64_t ROUND = 0xffffffffu;
+
+    // Pool the current thread is running indices for, as a worker or as the
+    // caller of run(); nullptr outside any task
+    thread_local const Pool* working = nullptr;
+
+    // Marks the calling thread as working for a pool until destroyed
+    class Working {
+        public:
+            explicit Working(const Pool* pool) : previous_(working) { working = pool; }
+
+            ~Working() { working = previous_; }
+
+            Working(const Working&)             = delete;
+            Working& operator=(const Working&)  = delete;
+        private:
+            const Pool* previous_;
+    };
+
+    Topology
+    detect() {
+        std::vector<unsigned> allowed;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (unsigned cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+                if (CPU_ISSET(cpu, &set)) { allowed.push_back(cpu); }
+            }
+        }
+        if (allowed.empty()) {
+            for (unsigned cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); cpu++) {
+                allowed.push_back(cpu);
+            }
+        }
+
+        Topology topology;
+        std::map<unsigned, std::vector<unsigned>> nodes;
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", error)) {
+            const std::string name = entry.path().filename().string();
+            unsigned node = 0;
+            if (name.rfind("node", 0) != 0) { continue; }
+            auto [end, failure] = std::from_chars(name.data() + 4, name.data() + name.size(), node);
+            if (failure != std::errc() or end != name.data() + name.size()) { continue; }
+
+            std::ifstream file(entry.path() / "cpulist");
+            std::string list;
+            std::getline(file, list);
+            try {
+                for (unsigned cpu : cpus(list)) {
+                    if (std::binary_search(allowed.begin(), allowed.end(), cpu)) { nodes[node].push_back(cpu); }
+                }
+            } catch (const std::invalid_argument&) {
+                continue;
+            }
+        }
+        for (auto& [node, members] : nodes) {
+            if (not members.empty()) { topology.nodes.push_back(std::move(members)); }
+        }
+        if (topology.nodes.empty()) {
+            topology.nodes.push_back(std::move(allowed));
+        }
+        return topology;
+    }
+} // namespace
+    const Topology&
+    Topology::system() {
+        static const Topology topology = detect();
+        return topology;
+    }
+
+    std::size_t
+    Topology::cpus() const {
+        std::size_t count = 0;
+        for (const std::vector<unsigned>& node : nodes) { count += node.size(); }
+        return count;
+    }
+
+    std::vector<Placement>
+    Topology::place(std::size_t threads) const {
+        if (cpus() == 0) { throw std::invalid_argument("topology has no CPU"); }
+
+        std::vector<Placement> placement;
+        std::vector<std::size_t> used(nodes.size(), 0);
+        placement.reserve(threads);
+        for (std::size_t i = 0, node = 0; placement.size() < threads; i++, node = i % nodes.size()) {
+            if (nodes[node].empty()) { continue; }
+            placement.push_back({nodes[node][used[node]++ % nodes[node].size()], node});
+        }
+        return placement;
+    }
+
+    std::vector<unsigned>
+    cpus(std::string_view list) {
+        std::vector<unsigned> output;
+        while (not list.empty() and (list.back() == '\n' or list.back() == ' ')) { list.remove_suffix(1); }
+        if (not list.empty() and list.back() == ',') { throw std::invalid_argument("malformed cpu list"); }
+        while (not list.empty()) {
+            std::size_t comma = list.find(',');
+            std::string_view item = list.substr(0, comma);
+            list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+
+            unsigned first = 0, last = 0;
+            const char* end = item.data() + item.size();
+            auto [middle, error] = std::from_chars(item.data(), end, first);
+            last = first;
+            if (error == std::errc() and middle != end and *middle == '-') {
+                auto [tail, failure] = std::from_chars(middle + 1, end, last);
+                middle  = tail;
+                error   = failure;
+            }
+            if (error != std::errc() or middle != end or last < first) {
+                throw std::invalid_argument("malformed cpu list");
+            }
+            for (unsigned cpu = first; cpu <= last; cpu++) { output.push_back(cpu); }
+        }
+        return output;
+    }
+
+    std::vector<std::size_t>
+    victims(std::span<const Placement> placement, std::size_t self) {
+        if (self >= placement.size()) { throw std::out_of_range("thread out of range"); }
+
+        std::vector<std::size_t> local, remote;
+        for (std::size_t k = 1; k < placement.size(); k++) {
+            std::size_t other = (self + k) % placement.size();
+            (placement[other].node == placement[self].node ? local : remote).push_back(other);
+        }
+        local.insert(local.end(), remote.begin(), remote.end());
+        return local;
+    }
+
+    bool
+    pin(std::thread& thread, unsigned cpu) {
+        if (cpu >= CPU_SETSIZE) { return false; }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+    }
+
+    bool
+    Pool::Range::pop(std::size_t& index) {
+        std::uint64_t current = bounds.load();
+        for (;;) {
+            std::uint64_t begin = current >> 32;
+            std::uint64_t end   = current & 0xffffffffu;
+            if (begin >= end) { return false; }
+            if (bounds.compare_exchange_weak(current, pack(begin + 1, end))) {
+                index = begin;
+                return true;
+            }
+        }
+    }
+
+    bool
+    Pool::Range::steal(std::uint64_t& begin, std::uint64_t& end) {
+        std::uint64_t current = bounds.load();
+        for (;;) {
+            std::uint64_t first = current >> 32;
+            std::uint64_t last  = current & 0xffffffffu;
+            if (first >= last) { return false; }
+            std::uint64_t middle = first + (last - first) / 2;
+            if (bounds.compare_exchange_weak(current, pack(first, middle))) {
+                begin   = middle;
+                end     = last;
+                return true;
+            }
+        }
+    }
+
+    Pool::Pool(std::size_t threads) : Pool(threads, Topology::system()) {}
+
+    Pool::Pool(std::size_t threads, const Topology& topology) {
+        const std::size_t count = std::max<std::size_t>(threads, 1);
+        const std::vector<Placement> placement = topology.place(count);
+
+        ranges_ = std::make_unique<Range[]>(count);
+        order_.reserve(count * (count - 1));
+        for (std::size_t t = 0; t < count; t++) {
+            std::vector<std::size_t> others = victims(placement, t);
+            order_.insert(order_.end(), others.begin(), others.end());
+        }
+        // Participant 0 is the caller of run()
+        workers_.reserve(count - 1);
+        for (std::size_t t = 1; t < count; t++) {
+            workers_.emplace_back([this, t] { loop(t); });
+            if (topology.nodes.size() > 1) { pin(workers_.back(), placement[t].cpu); }
+        }
+    }
+
+    Pool::~Pool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    void
+    Pool::dispatch(std::size_t count, Invoke invoke, const void* context) {
+        if (count == 0) { return; }
+
+        // A task calling run() on its own pool would wait for itself; the
+        // nested indices run inline on the calling thread instead
+        if (working == this) {
+            for (std::size_t i = 0; i < count; i++) {
+                invoke(context, i);
+            }
+            return;
+        }
+
+        // One job at a time; concurrent callers queue up here
+        std::lock_guard<std::mutex> serial(submit_);
+        const Working marker(this);
+
+        Job job;
+        job.invoke  = invoke;
+        job.context = context;
+
+        const std::size_t participants = size();
+        for (std::size_t offset = 0; offset < count and not job.failed; offset += ROUND) {
+            const std::uint64_t round = std::min<std::uint64_t>(ROUND, count - offset);
+            job.offset = offset;
+            for (std::size_t t = 0; t < participants; t++) {
+                ranges_[t].bounds.store(Range::pack(round * t / participants, round * (t + 1) / participants));
+            }
+            if (not workers_.empty() and round > 1) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                job_ = &job;
+                generation_++;
+                wake_.notify_all();
+            }
+            work(job, 0);
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            finished_.wait(lock, [&] { return active_ == 0; });
+            job_ = nullptr;
+        }
+        if (job.error) { std::rethrow_exception(job.error); }
+    }
+
+    void
+    Pool::work(Job& job, std::size_t self) {
+        const std::size_t others    = size() - 1;
+        const std::size_t* order    = order_.data() + self * others;
+        Range& own                  = ranges_[self];
+
+        for (;;) {
+            std::size_t index;
+            while (own.pop(index)) {
+                if (job.failed.load(std::memory_order_relaxed)) { return; }
+                try {
+                    job.invoke(job.context, job.offset + index);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (not job.error) { job.error = std::current_exception(); }
+                    // Every participant stops before its next index
+                    job.failed = true;
+                    return;
+                }
+            }
+            // Own range is empty; take half of the first non-empty victim's
+            bool stolen = false;
+            for (std::size_t k = 0; k < others and not stolen; k++) {
+                std::uint64_t begin, end;
+                if (ranges_[order[k]].steal(begin, end)) {
+                    own.bounds.store(Range::pack(begin, end));
+                    stolen = true;
+                }
+            }
+            if (not stolen) { return; }
+        }
+    }
+
+    void
+    Pool::loop(std::size_t self) {
+        const Working marker(this);
+        std::uint64_t seen = 0;
+        for (;;) {
+            Job* job = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stop_ or (job_ != nullptr and generation_ != seen); });
+                if (stop_) { return; }
+                seen = generation_;
+                job  = job_;
+                active_++;
+            }
+            work(*job, self);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                active_--;
+            }
+            finished_.notify_all();
+        }
+    }
+
+    Pool&
+    shared() {
+        static Pool pool;
+        return pool;
+    }
+} // namespace parallel
+} // namespace ventilation
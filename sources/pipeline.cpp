@@ -0,0 +1,217 @@
+#include "ventilation/pipeline.hpp"
+#include "ventilation/tracing.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ventilation {
+namespace pipeline {
+namespace {
+    // Executor whose thread is running, and which of its threads
+    thread_local const Executor*    current     = nullptr;
+    thread_local std::size_t        worker      = 0;
+} // namespace
+    void
+    Task::Final::await_suspend(handle h) noexcept {
+        Executor*           executor    = h.promise().executor;
+        std::exception_ptr  error       = std::move(h.promise().error);
+        // Locals of the task, its streams included, go before wait() returns
+        h.destroy();
+        executor->finished(std::move(error));
+    }
+
+    Executor::Executor(std::size_t threads) : Executor(threads, parallel::Topology::system()) {}
+
+    Executor::Executor(std::size_t threads, const parallel::Topology& topology) {
+        const std::size_t count = std::max<std::size_t>(threads, 1);
+        const std::vector<parallel::Placement> placement = topology.place(count);
+
+        workers_.reserve(count);
+        for (std::size_t t = 0; t < count; t++) {
+            workers_.push_back(std::make_unique<Worker>());
+            workers_.back()->victims = parallel::victims(placement, t);
+        }
+        threads_.reserve(count);
+        for (std::size_t t = 0; t < count; t++) {
+            threads_.emplace_back([this, t] { loop(t); });
+            if (topology.nodes.size() > 1) { parallel::pin(threads_.back(), placement[t].cpu); }
+        }
+    }
+
+    Executor::~Executor() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        ready_.notify_all();
+        for (std::thread& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    void
+    Executor::spawn(Task task) {
+        Task::handle coroutine = std::exchange(task.handle_, nullptr);
+        coroutine.promise().executor = this;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_++;
+        }
+        schedule(coroutine);
+    }
+
+    void
+    Executor::schedule(std::coroutine_handle<> coroutine) {
+        // Counted first, so a thread that sees nothing pending cannot miss it
+        pending_.fetch_add(1);
+        if (current == this) {
+            workers_[worker]->deque.push(coroutine.address());
+        } else {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(coroutine);
+            injected_++;
+        }
+        // Pairs with loop(): either the sleeper sees pending_, or this sees it
+        // asleep and wakes it through the mutex
+        if (sleeping_.load() > 0) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+            }
+            ready_.notify_one();
+        }
+    }
+
+    void
+    Executor::wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [&] { return tasks_ == 0; });
+        if (error_) { std::rethrow_exception(std::exchange(error_, nullptr)); }
+    }
+
+    void
+    Executor::finished(std::exception_ptr error) {
+        // Notified under the lock, the executor may be gone once it is released
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error and not error_) { error_ = error; }
+        if (--tasks_ == 0) { idle_.notify_all(); }
+    }
+
+    std::coroutine_handle<>
+    Executor::take(std::size_t self) {
+        Worker& own = *workers_[self];
+        if (std::optional<void*> address = own.deque.pop()) {
+            return std::coroutine_handle<>::from_address(*address);
+        }
+        if (injected_.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (not queue_.empty()) {
+                std::coroutine_handle<> coroutine = queue_.front();
+                queue_.pop_front();
+                injected_--;
+                return coroutine;
+            }
+        }
+        for (std::size_t victim : own.victims) {
+            if (std::optional<void*> address = workers_[victim]->deque.steal()) {
+                return std::coroutine_handle<>::from_address(*address);
+            }
+        }
+        return nullptr;
+    }
+
+    void
+    Executor::loop(std::size_t self) {
+        current     = this;
+        worker      = self;
+        for (;;) {
+            if (std::coroutine_handle<> coroutine = take(self)) {
+                pending_.fetch_sub(1);
+                coroutine.resume();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            sleeping_.fetch_add(1);
+            ready_.wait(lock, [&] { return stop_ or pending_.load() > 0; });
+            sleeping_.fetch_sub(1);
+            if (stop_) { return; }
+            if (pending_.load() > 0) {
+                // Queued but not visible yet, or just taken by another thread
+                lock.unlock();
+                std::this_thread::yield();
+            }
+        }
+    }
+
+namespace {
+    Stream<Batch<Volume>>
+    accumulate(Stream<Batch<Flow>> flow, double step, Volume initial) {
+        std::vector<Volume> buffer;
+        const std::int64_t start = fixed::Access::raw(initial);
+        // Exact raw flow so far, rounded once per sample so errors do not add up
+        std::int64_t sum = 0;
+        while (const Batch<Flow>* batch = co_await flow.next()) {
+            {
+                VENTILATION_TRACE("pipeline::integrate");
+                buffer.resize(batch->size());
+                std::span<const std::int64_t> input  = fixed::Access::raw(*batch);
+                std::span<std::int64_t>       output = fixed::Access::raw(std::span<Volume>(buffer));
+                for (std::size_t i = 0; i < input.size(); i++) {
+                    sum         += input[i];
+                    output[i]   = start + static_cast<std::int64_t>(std::llround(static_cast<double>(sum) * step));
+                }
+            }
+            co_yield Batch<Volume>(buffer);
+        }
+    }
+} // namespace
+    Stream<Batch<Volume>>
+    integrate(Stream<Batch<Flow>> flow, float period, Volume initial) {
+        if (not (period > 0.0f) or not std::isfinite(period)) {
+            throw std::invalid_argument("sampling period must be positive");
+        }
+        return accumulate(std::move(flow), period, initial);
+    }
+
+    Stream<Batch<Flow>>
+    segment(Stream<Batch<Flow>> flow) {
+        const Flow zero(0.0f);
+
+        std::vector<Flow> breath;
+        std::vector<Flow> complete;
+        bool started    = false;
+        bool positive   = true;     // no onset on the very first sample
+
+        while (const Batch<Flow>* batch = co_await flow.next()) {
+            std::size_t from    = 0;
+            std::size_t i       = 0;
+            // Traced up to each breath handed downstream, never across it
+            for (bool done = false; not done;) {
+                bool ready = false;
+                {
+                    VENTILATION_TRACE("pipeline::segment");
+                    for (; i < batch->size() and not ready; i++) {
+                        bool now = (*batch)[i] > zero;
+                        if (now and not positive) {
+                            if (started) {
+                                breath.insert(breath.end(), batch->begin() + from, batch->begin() + i);
+                                complete.swap(breath);
+                                breath.clear();
+                                ready = true;
+                            }
+                            started = true;
+                            from    = i;
+                        }
+                        positive = now;
+                    }
+                    if (not ready) {
+                        if (started) {
+                            breath.insert(breath.end(), batch->begin() + from, batch->end());
+                        }
+                        done = true;
+                    }
+                }
+                if (ready) { co_yield Batch<Flow>(complete); }
+            }
+        }
+    }
+} // namespace pipeline
+} // namespace ventilation
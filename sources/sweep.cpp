@@ -0,0 +1,110 @@
+#include "ventilation/sweep.hpp"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+
+namespace ventilation {
+namespace sweep {
+    std::size_t
+    Grid::size() const {
+        return resistance.size() * compliance.size() * peep.size() * tidal.size();
+    }
+
+    model::Parameters
+    Grid::operator[](std::size_t i) const {
+        if (i >= size()) { throw std::out_of_range("grid point out of range"); }
+
+        std::size_t v = i % tidal.size();       i /= tidal.size();
+        std::size_t p = i % peep.size();        i /= peep.size();
+        std::size_t c = i % compliance.size();  i /= compliance.size();
+        return {resistance[i], compliance[c], peep[p], tidal[v]};
+    }
+
+    Cache::Cache(const model::Settings& settings) : settings_(settings) {}
+
+    Cache::Shard&
+    Cache::shard(const model::Parameters& parameters) const {
+        return shards_[std::hash<model::Parameters>()(parameters) % SHARDS];
+    }
+
+    std::optional<mechanics::Breath>
+    Cache::find(const model::Parameters& parameters) const {
+        Shard& s = shard(parameters);
+        std::lock_guard<std::mutex> lock(s.mutex);
+
+        auto found = s.entries.find(parameters);
+        if (found == s.entries.end()) { return std::nullopt; }
+        return found->second;
+    }
+
+    void
+    Cache::insert(const model::Parameters& parameters, const mechanics::Breath& breath) {
+        Shard& s = shard(parameters);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.entries.insert_or_assign(parameters, breath);
+    }
+
+    std::size_t
+    Cache::size() const {
+        std::size_t total = 0;
+        for (const Shard& s : shards_) {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            total += s.entries.size();
+        }
+        return total;
+    }
+
+    void
+    Cache::clear() {
+        for (Shard& s : shards_) {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.entries.clear();
+        }
+    }
+
+    std::vector<Result>
+    run(const Grid& grid, const Pressure& limit, Cache& cache, parallel::Pool& pool) {
+        std::vector<Result> results(grid.size());
+        if (results.empty()) { return results; }
+
+        const std::size_t width = grid.tidal.size();
+        const std::size_t lines = grid.size() / width;
+        if (lines > 0xffffffffu) { throw std::length_error("grid has too many lines"); }
+
+        // Each line is walked in increasing tidal volume, so the first point
+        // over the limit prunes the rest of it
+        std::vector<std::size_t> order(width);
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+            return fixed::Access::raw(grid.tidal[lhs]) < fixed::Access::raw(grid.tidal[rhs]);
+        });
+
+        auto line = [&](std::size_t index) {
+            bool pruned = false;
+            for (std::size_t v : order) {
+                std::size_t point   = index * width + v;
+                Result& result      = results[point];
+                result.parameters   = grid[point];
+
+                pruned = pruned or model::peak(result.parameters, cache.settings()) > limit;
+                if (pruned) {
+                    result.status = Status::pruned;
+                } else if (std::optional<mechanics::Breath> found = cache.find(result.parameters)) {
+                    result.status   = Status::cached;
+                    result.breath   = *found;
+                } else {
+                    result.status   = Status::computed;
+                    result.breath   = model::breath(result.parameters, cache.settings());
+                    cache.insert(result.parameters, result.breath);
+                }
+            }
+        };
+
+        // Lines differ in cost as pruning cuts them short; the pool's work
+        // stealing evens that out
+        pool.run(lines, line);
+        return results;
+    }
+} // namespace sweep
+} // namespace ventilation
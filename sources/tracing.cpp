@@ -0,0 +1,217 @@
+#include "ventilation/tracing.hpp"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace ventilation {
+namespace tracing {
+namespace {
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "capacity must be a power of two");
+
+    // One span of a ring, written under a sequence lock: odd while its
+    // thread writes it, 2n + 2 once it holds span n
+    struct Slot {
+        std::atomic<std::uint64_t>  sequence{0};
+        std::atomic<const char*>    name{nullptr};
+        std::atomic<std::uint64_t>  begin{0};
+        std::atomic<std::uint64_t>  duration{0};
+    };
+
+    // Spans of one thread; only that thread writes, collections read
+    struct Ring {
+        explicit Ring(std::uint32_t thread) : thread(thread), slots(new Slot[CAPACITY]) {}
+
+        const std::uint32_t             thread;
+        const std::unique_ptr<Slot[]>   slots;
+        alignas(64) std::atomic<std::uint64_t>  head{0};        // spans written
+        std::uint64_t                   tail        = 0;        // spans collected, under the registry lock
+    };
+
+    struct Registry {
+        std::mutex          mutex;
+        std::vector<Ring*>  rings;
+        std::deque<Event>   orphans;            // spans of exited threads, at most CAPACITY
+        std::uint64_t       dropped     = 0;    // orphans discarded to make room
+        std::uint32_t       threads     = 0;
+    };
+
+    // Never destroyed, threads may exit after static destruction has begun
+    Registry&
+    registry() {
+        static Registry* instance = new Registry();
+        return *instance;
+    }
+
+    // Passes the spans of a ring not yet collected to `sink`, counting those
+    // overwritten or torn while being read as dropped. Under the registry
+    // lock.
+    template <typename Sink>
+    void
+    drain(Ring& ring, std::uint64_t& dropped, Sink&& sink) {
+        const std::uint64_t head = ring.head.load(std::memory_order_acquire);
+        std::uint64_t first = ring.tail;
+        if (head - first > CAPACITY) {
+            dropped += head - CAPACITY - first;
+            first   = head - CAPACITY;
+        }
+        for (std::uint64_t n = first; n < head; n++) {
+            const Slot& slot = ring.slots[n & (CAPACITY - 1)];
+            const std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != 2 * n + 2) {
+                dropped++;
+                continue;
+            }
+            const Event event{
+                  slot.name.load(std::memory_order_relaxed)
+                , slot.begin.load(std::memory_order_relaxed)
+                , slot.duration.load(std::memory_order_relaxed)
+                , ring.thread
+            };
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+                dropped++;
+                continue;
+            }
+            sink(event);
+        }
+        ring.tail = head;
+    }
+
+#if defined(VENTILATION_TRACING)
+    struct Local {
+        Ring*   ring    = nullptr;
+        bool    exited  = false;
+
+        // Nullptr once the thread is exiting, for spans of later destructors
+        Ring*
+        attach() {
+            if (ring == nullptr and not exited) {
+                Registry& r = registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                ring = new Ring(++r.threads);
+                r.rings.push_back(ring);
+            }
+            return ring;
+        }
+
+        // The ring goes with its thread. Its spans not yet collected wait
+        // in the registry, the oldest making room for newer ones, so exited
+        // threads hold at most CAPACITY spans between them.
+        ~Local() {
+            exited = true;
+            if (ring == nullptr) { return; }
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            drain(*ring, r.dropped, [&](const Event& event) { r.orphans.push_back(event); });
+            while (r.orphans.size() > CAPACITY) {
+                r.orphans.pop_front();
+                r.dropped++;
+            }
+            std::erase(r.rings, ring);
+            delete ring;
+            ring = nullptr;
+        }
+    };
+
+    thread_local Local local;
+#endif
+
+    void
+    escape(std::ostream& os, std::string_view text) {
+        constexpr char HEX[] = "0123456789abcdef";
+        for (char c : text) {
+            const unsigned char u = static_cast<unsigned char>(c);
+            if (c == '"' or c == '\\') {
+                os << '\\' << c;
+            } else if (u < 0x20) {
+                os << "\\u00" << HEX[u >> 4] << HEX[u & 0xf];
+            } else {
+                os << c;
+            }
+        }
+    }
+
+    // Microseconds with three decimals, exactly
+    void
+    microseconds(std::ostream& os, std::uint64_t nanoseconds) {
+        const std::uint64_t fraction = nanoseconds % 1000;
+        os << nanoseconds / 1000 << '.'
+           << static_cast<char>('0' + fraction / 100)
+           << static_cast<char>('0' + fraction / 10 % 10)
+           << static_cast<char>('0' + fraction % 10);
+    }
+} // namespace
+#if defined(VENTILATION_TRACING)
+    void
+    prepare() {
+        local.attach();
+    }
+
+    void
+    record(const char* name, std::uint64_t begin, std::uint64_t end) noexcept {
+        Ring* attached = local.ring != nullptr ? local.ring : local.attach();
+        if (attached == nullptr) { return; }
+        Ring& ring = *attached;
+        const std::uint64_t n = ring.head.load(std::memory_order_relaxed);
+        Slot& slot = ring.slots[n & (CAPACITY - 1)];
+        slot.sequence.store(2 * n + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.begin.store(begin, std::memory_order_relaxed);
+        slot.duration.store(end > begin ? end - begin : 0, std::memory_order_relaxed);
+        slot.sequence.store(2 * n + 2, std::memory_order_release);
+        ring.head.store(n + 1, std::memory_order_release);
+    }
+#endif
+
+    void
+    Trace::collect() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+
+        auto add = [&](const Event& event) {
+            events_.push_back(event);
+            auto [entry, inserted] = index_.try_emplace(std::string_view(event.name), summaries_.size());
+            if (inserted) {
+                summaries_.push_back(Summary{event.name, instrumentation::Latency()});
+            }
+            summaries_[entry->second].latency.record(event.duration);
+        };
+        for (const Event& event : r.orphans) {
+            add(event);
+        }
+        r.orphans.clear();
+        dropped_    += r.dropped;
+        r.dropped   = 0;
+
+        for (Ring* ring : r.rings) {
+            drain(*ring, dropped_, add);
+        }
+    }
+
+    const instrumentation::Latency*
+    Trace::latency(std::string_view name) const {
+        auto entry = index_.find(name);
+        return entry == index_.end() ? nullptr : &summaries_[entry->second].latency;
+    }
+
+    void
+    chrome(std::ostream& os, const Trace& trace) {
+        os << "{\"traceEvents\":[";
+        bool first = true;
+        for (const Event& event : trace.events()) {
+            os << (first ? "\n" : ",\n") << "{\"name\":\"";
+            escape(os, event.name);
+            os << "\",\"cat\":\"ventilation\",\"ph\":\"X\",\"ts\":";
+            microseconds(os, event.begin);
+            os << ",\"dur\":";
+            microseconds(os, event.duration);
+            os << ",\"pid\":1,\"tid\":" << event.thread << "}";
+            first = false;
+        }
+        os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    }
+} // namespace tracing
+} // namespace ventilation
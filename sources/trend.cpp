@@ -0,0 +1,209 @@
+#include "ventilation/trend.hpp"
+#include <algorithm>
+
+namespace ventilation {
+namespace trend {
+namespace detail {
+    Predicate
+    predicate(Column column, __int128 low, __int128 high) {
+        constexpr std::int64_t minimum = std::numeric_limits<std::int64_t>::min();
+        constexpr std::int64_t maximum = std::numeric_limits<std::int64_t>::max();
+
+        if (low > maximum or high < minimum or low > high) {
+            return {column, maximum, minimum};
+        }
+        return {
+              column
+            , static_cast<std::int64_t>(low < minimum ? minimum : low)
+            , static_cast<std::int64_t>(high > maximum ? maximum : high)
+        };
+    }
+} // namespace detail
+namespace {
+    // Floor of time over period, times a period
+    std::int64_t
+    start(std::int64_t time, std::int64_t period) {
+        std::int64_t quotient = time / period;
+        if (time % period < 0) { quotient--; }
+        return quotient * period;
+    }
+
+    template <Quantity T>
+    void
+    accumulate(Aggregate<T>& aggregate, const T& value, bool first) {
+        if (first or value < aggregate.minimum) { aggregate.minimum = value; }
+        if (first or value > aggregate.maximum) { aggregate.maximum = value; }
+        aggregate.sum += fixed::Access::raw(value);
+    }
+
+    void
+    roll(std::vector<Rollup>& rollups, std::int64_t period, const Record& record) {
+        const std::int64_t begin = start(record.time, period);
+        if (rollups.empty() or rollups.back().start != begin) {
+            Rollup rollup;
+            rollup.start = begin;
+            rollups.push_back(rollup);
+        }
+        Rollup& rollup = rollups.back();
+        const bool first = rollup.count == 0;
+        rollup.count++;
+        accumulate(rollup.tidal,        record.tidal,       first);
+        accumulate(rollup.peak,         record.peak,        first);
+        accumulate(rollup.plateau,      record.plateau,     first);
+        accumulate(rollup.resistance,   record.resistance,  first);
+        accumulate(rollup.compliance,   record.compliance,  first);
+    }
+
+    std::span<const Rollup>
+    between(std::span<const Rollup> rollups, std::int64_t from, std::int64_t to) {
+        auto earlier = [](const Rollup& rollup, std::int64_t time) { return rollup.start < time; };
+        auto first  = std::lower_bound(rollups.begin(), rollups.end(), from, earlier);
+        auto last   = std::lower_bound(first, rollups.end(), std::max(from, to), earlier);
+        return {first, last};
+    }
+
+    // True when value - low <= high - low, unsigned, that is low <= value <= high
+    inline std::uint8_t
+    inside(std::int64_t value, std::int64_t low, std::int64_t high) {
+        return static_cast<std::uint64_t>(value) - static_cast<std::uint64_t>(low)
+            <= static_cast<std::uint64_t>(high) - static_cast<std::uint64_t>(low);
+    }
+} // namespace
+
+    void
+    Store::append(const Record& record) {
+        if (not time_.empty() and record.time < time_.back()) {
+            throw std::invalid_argument("records must be appended in time order");
+        }
+        const std::array<std::int64_t, COLUMNS> values = {
+              fixed::Access::raw(record.tidal)
+            , fixed::Access::raw(record.peak)
+            , fixed::Access::raw(record.plateau)
+            , fixed::Access::raw(record.resistance)
+            , fixed::Access::raw(record.compliance)
+        };
+        if (time_.size() % BLOCK == 0) {
+            blocks_.push_back(Block{values, values});
+            index_.push_back(record.time);
+        } else {
+            Block& block = blocks_.back();
+            for (std::size_t c = 0; c < COLUMNS; c++) {
+                block.minimum[c] = std::min(block.minimum[c], values[c]);
+                block.maximum[c] = std::max(block.maximum[c], values[c]);
+            }
+        }
+        time_.push_back(record.time);
+        tidal_.push_back(record.tidal);
+        peak_.push_back(record.peak);
+        plateau_.push_back(record.plateau);
+        resistance_.push_back(record.resistance);
+        compliance_.push_back(record.compliance);
+
+        roll(hours_, HOUR, record);
+        roll(days_, DAY, record);
+    }
+
+    Record
+    Store::operator[](std::size_t row) const {
+        if (row >= time_.size()) {
+            throw std::out_of_range("row out of range");
+        }
+        return Record{time_[row], tidal_[row], peak_[row], plateau_[row], resistance_[row], compliance_[row]};
+    }
+
+    std::span<const std::int64_t>
+    Store::raw(Column column) const {
+        switch (column) {
+            case Column::tidal:         return fixed::Access::raw(std::span<const Volume>(tidal_));
+            case Column::peak:          return fixed::Access::raw(std::span<const Pressure>(peak_));
+            case Column::plateau:       return fixed::Access::raw(std::span<const Pressure>(plateau_));
+            case Column::resistance:    return fixed::Access::raw(std::span<const Resistance>(resistance_));
+            case Column::compliance:    return fixed::Access::raw(std::span<const Compliance>(compliance_));
+        }
+        throw std::invalid_argument("no such column");
+    }
+
+    Rows
+    Store::rows(std::int64_t from, std::int64_t to) const {
+        // First row with time >= t: the block index narrows the search to the
+        // block before the first block starting at or after t
+        auto find = [&](std::int64_t t) -> std::size_t {
+            const std::size_t block = static_cast<std::size_t>(std::lower_bound(index_.begin(), index_.end(), t) - index_.begin());
+            if (block == 0) { return 0; }
+            const auto first    = time_.begin() + static_cast<std::ptrdiff_t>((block - 1) * BLOCK);
+            const auto last     = time_.begin() + static_cast<std::ptrdiff_t>(std::min(block * BLOCK, time_.size()));
+            return static_cast<std::size_t>(std::lower_bound(first, last, t) - time_.begin());
+        };
+        const std::size_t begin = find(from);
+        return Rows{begin, std::max(begin, find(to))};
+    }
+
+    std::size_t
+    Store::select(std::span<const Predicate> predicates, Rows rows, std::vector<std::size_t>& output) const {
+        if (rows.begin > rows.end or rows.end > time_.size()) {
+            throw std::out_of_range("rows out of range");
+        }
+        const std::size_t blocks = rows.begin == rows.end ? 0 : (rows.end - 1) / BLOCK - rows.begin / BLOCK + 1;
+        for (const Predicate& predicate : predicates) {
+            if (predicate.low > predicate.high) { return blocks; }
+        }
+
+        std::array<std::span<const std::int64_t>, COLUMNS> columns;
+        for (std::size_t c = 0; c < COLUMNS; c++) {
+            columns[c] = raw(static_cast<Column>(c));
+        }
+
+        std::array<std::uint8_t, BLOCK> mask;
+        std::size_t skipped = 0;
+        for (std::size_t begin = rows.begin; begin < rows.end;) {
+            const std::size_t b     = begin / BLOCK;
+            const std::size_t end   = std::min((b + 1) * BLOCK, rows.end);
+            const Block& block      = blocks_[b];
+
+            bool disjoint   = false;
+            bool contained  = true;
+            for (const Predicate& predicate : predicates) {
+                const std::size_t c = static_cast<std::size_t>(predicate.column);
+                if (block.maximum[c] < predicate.low or block.minimum[c] > predicate.high) {
+                    disjoint = true;
+                    break;
+                }
+                if (block.minimum[c] < predicate.low or block.maximum[c] > predicate.high) {
+                    contained = false;
+                }
+            }
+            if (disjoint) {
+                skipped++;
+            } else if (contained) {
+                for (std::size_t row = begin; row < end; row++) {
+                    output.push_back(row);
+                }
+            } else {
+                const std::size_t count = end - begin;
+                std::fill_n(mask.begin(), count, std::uint8_t{1});
+                for (const Predicate& predicate : predicates) {
+                    const std::int64_t* values = columns[static_cast<std::size_t>(predicate.column)].data() + begin;
+                    for (std::size_t i = 0; i < count; i++) {
+                        mask[i] &= inside(values[i], predicate.low, predicate.high);
+                    }
+                }
+                for (std::size_t i = 0; i < count; i++) {
+                    if (mask[i]) { output.push_back(begin + i); }
+                }
+            }
+            begin = end;
+        }
+        return skipped;
+    }
+
+    std::span<const Rollup>
+    Store::hourly(std::int64_t from, std::int64_t to) const {
+        return between(hours_, from, to);
+    }
+
+    std::span<const Rollup>
+    Store::daily(std::int64_t from, std::int64_t to) const {
+        return between(days_, from, to);
+    }
+} // namespace trend
+} // namespace ventilation
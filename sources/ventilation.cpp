@@ -1,16 +1,30 @@
 #include "ventilation/ventilation.hpp"
+#include "ventilation/instrumentation.hpp"
 #include <iostream>
 
 namespace ventilation {
-namespace fixed {
-    const float FORWARD             = 1e+6f;
-    const float INVERSE             = 1e-6f;
-    const std::int64_t PRECISION    = 1000;
-} // namespace fixed
+namespace {
+    [[noreturn]] void
+    reject(const char* message) {
+        instrumentation::increment(instrumentation::Counter::domain);
+        throw std::domain_error(message);
+    }
+
+    // Counts scaling products that wrap, when instrumentation is compiled in
+    inline void
+    observe(std::int64_t value, std::int64_t converted) {
+        if constexpr (instrumentation::ENABLED) {
+            std::int64_t product;
+            if (__builtin_mul_overflow(value, converted, &product)) {
+                instrumentation::increment(instrumentation::Counter::overflow);
+            }
+        }
+    }
+} // namespace
     Compliance::Compliance() : value_(0) {}
     Compliance::Compliance(float v) {
         if (not std::isfinite(v)) {
-            throw std::domain_error("compliance value must be finite");
+            reject("compliance value must be finite");
         } else {
             value_ = static_cast<std::int64_t>(v * fixed::FORWARD);
         }
@@ -63,19 +77,21 @@ namespace fixed {
 
     Compliance
     operator*(const Compliance& compliance, float scalar) {
-        if (not std::isfinite(scalar)) { throw std::domain_error("scalar value must be finite"); }
+        if (not std::isfinite(scalar)) { reject("scalar value must be finite"); }
         std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
         std::int64_t converted  = static_cast<std::int64_t>(scalar * forward);
 
+        observe(compliance.value_, converted);
         return Compliance((compliance.value_ * converted) / forward);
     }
 
     Compliance
     operator*(float scalar, const Compliance& compliance) {
-        if (not std::isfinite(scalar)) { throw std::domain_error("scalar value must be finite"); }
+        if (not std::isfinite(scalar)) { reject("scalar value must be finite"); }
         std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
         std::int64_t converted  = static_cast<std::int64_t>(scalar * forward);
 
+        observe(compliance.value_, converted);
         return Compliance((compliance.value_ * converted) / forward);
     }
 
@@ -87,7 +103,7 @@ namespace fixed {
     Elastance::Elastance() : value_(0) {}
     Elastance::Elastance(float v) {
         if (not std::isfinite(v)) {
-            throw std::domain_error("elastance value must be finite");
+            reject("elastance value must be finite");
         } else {
             value_ = static_cast<std::int64_t>(v * fixed::FORWARD);
         }
@@ -140,19 +156,21 @@ namespace fixed {
 
     Elastance
     operator*(const Elastance& elastance, float scalar) {
-        if (not std::isfinite(scalar)) { throw std::domain_error("scalar value must be finite"); }
+        if (not std::isfinite(scalar)) { reject("scalar value must be finite"); }
         std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
         std::int64_t converted  = static_cast<std::int64_t>(scalar * forward);
 
+        observe(elastance.value_, converted);
         return Elastance((elastance.value_ * converted) / forward);
     }
 
     Elastance
     operator*(float scalar, const Elastance& elastance) {
-        if (not std::isfinite(scalar)) { throw std::domain_error("scalar value must be finite"); }
+        if (not std::isfinite(scalar)) { reject("scalar value must be finite"); }
         std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
         std::int64_t converted  = static_cast<std::int64_t>(scalar * forward);
 
+        observe(elastance.value_, converted);
         return Elastance((elastance.value_ * converted) / forward);
     }
 
@@ -164,7 +182,7 @@ namespace fixed {
     Flow::Flow() : value_(0) {}
     Flow::Flow(float v) {
         if (not std::isfinite(v)) {
-            throw std::domain_error("flow value must be finite");
+            reject("flow value must be finite");
         } else {
             value_ = static_cast<std::int64_t>(v * fixed::FORWARD);
         }
@@ -232,19 +250,21 @@ namespace fixed {
 
     Flow
     operator*(const Flow& flow, float scalar) {
-        if (not std::isfinite(scalar)) { throw std::domain_error("scalar value must be finite"); }
+        if (not std::isfinite(scalar)) { reject("scalar value must be finite"); }
         std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
         std::int64_t converted  = static_cast<std::int64_t>(scalar * forward);
 
+        observe(flow.value_, converted);
         return Flow((flow.value_ * converted) / forward);
     }
 
     Flow
     operator*(float scalar, const Flow& flow) {
-        if (not std::isfinite(scalar)) { throw std::domain_error("scalar value must be finite"); }
+        if (not std::isfinite(scalar)) { reject("scalar value must be finite"); }
         std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
         std::int64_t converted  = static_cast<std::int64_t>(scalar * forward);
 
+        observe(flow.value_, converted);
         return Flow((flow.value_ * converted) / forward);
     }
 
@@ -253,10 +273,104 @@ namespace fixed {
         return os << std::format("{:.1f}L/s", static_cast<float>(flow));
     }
 
+    Power::Power() : value_(0) {}
+    Power::Power(float v) {
+        if (not std::isfinite(v)) {
+            reject("power value must be finite");
+        } else {
+            value_ = static_cast<std::int64_t>(v * fixed::FORWARD);
+        }
+    }
+
+    Power::Power(std::int64_t v) : value_(v) {}
+
+    Power::operator
+    float() const {
+        return static_cast<float>(value_) * fixed::INVERSE;
+    }
+
+    std::strong_ordering
+    operator<=>(const Power& lhs, const Power& rhs) {
+        std::int64_t xs = lhs.value_ / fixed::PRECISION;
+        std::int64_t ys = rhs.value_ / fixed::PRECISION;
+
+        return (xs <=> ys);
+    }
+
+    bool
+    operator==(const Power& lhs, const Power& rhs) {
+        return (lhs <=> rhs) == std::strong_ordering::equal;
+    }
+
+    bool
+    operator!=(const Power& lhs, const Power& rhs) {
+        return (lhs <=> rhs) != std::strong_ordering::equal;
+    }
+
+    bool
+    operator<(const Power& lhs, const Power& rhs) {
+        return (lhs <=> rhs) == std::strong_ordering::less;
+    }
+
+    bool
+    operator<=(const Power& lhs, const Power& rhs) {
+        return (lhs <=> rhs) != std::strong_ordering::greater;
+    }
+
+    bool
+    operator>(const Power& lhs, const Power& rhs) {
+        return (lhs <=> rhs) == std::strong_ordering::greater;
+    }
+
+    bool
+    operator>=(const Power& lhs, const Power& rhs) {
+        return (lhs <=> rhs) != std::strong_ordering::less;
+    }
+
+    Power
+    operator+(const Power& lhs, const Power& rhs) {
+        return Power(lhs.value_ + rhs.value_);
+    }
+
+    Power
+    operator-(const Power& lhs) {
+        return Power(-lhs.value_);
+    }
+
+    Power
+    operator-(const Power& lhs, const Power& rhs) {
+        return Power(lhs.value_ - rhs.value_);
+    }
+
+    Power
+    operator*(const Power& power, float scalar) {
+        if (not std::isfinite(scalar)) { reject("scalar value must be finite"); }
+        std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
+        std::int64_t converted  = static_cast<std::int64_t>(scalar * forward);
+
+        observe(power.value_, converted);
+        return Power((power.value_ * converted) / forward);
+    }
+
+    Power
+    operator*(float scalar, const Power& power) {
+        if (not std::isfinite(scalar)) { reject("scalar value must be finite"); }
+        std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
+        std::int64_t converted  = static_cast<std::int64_t>(scalar * forward);
+
+        observe(power.value_, converted);
+        return Power((power.value_ * converted) / forward);
+    }
+
+    std::ostream&
+    operator<<(std::ostream& os, const Power& power) {
+        return os << std::format("{:.1f}J/min", static_cast<float>(power));
+    }
+
     Pressure::Pressure() : value_(0) {}
     Pressure::Pressure(float v) {
         if (not std::isfinite(v)) {
-            throw std::domain_error("pressure value must be finite");
+            reject("pressure value must be finite");
         } else {
             value_ = static_cast<std::int64_t>(v * fixed::FORWARD);
         }
@@ -324,19 +438,21 @@ namespace fixed {
 
     Pressure
     operator*(const Pressure& pressure, float scalar) {
-        if (not std::isfinite(scalar)) { throw std::domain_error("scalar value must be finite"); }
+        if (not std::isfinite(scalar)) { reject("scalar value must be finite"); }
         std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
         std::int64_t converted  = static_cast<std::int64_t>(scalar * forward);
 
+        observe(pressure.value_, converted);
         return Pressure((pressure.value_ * converted) / forward);
     }
 
     Pressure
     operator*(float scalar, const Pressure& pressure) {
-        if (not std::isfinite(scalar)) { throw std::domain_error("scalar value must be finite"); }
+        if (not std::isfinite(scalar)) { reject("scalar value must be finite"); }
         std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
         std::int64_t converted  = static_cast<std::int64_t>(scalar * forward);
 
+        observe(pressure.value_, converted);
         return Pressure((pressure.value_ * converted) / forward);
     }
 
@@ -348,7 +464,7 @@ namespace fixed {
     Resistance::Resistance() : value_(0) {}
     Resistance::Resistance(float v) {
         if (not std::isfinite(v)) {
-            throw std::domain_error("resistance value must be finite");
+            reject("resistance value must be finite");
         } else {
             value_ = static_cast<std::int64_t>(v * fixed::FORWARD);
         }
@@ -401,19 +517,21 @@ namespace fixed {
 
     Resistance
     operator*(const Resistance& resistance, float scalar) {
-        if (not std::isfinite(scalar)) { throw std::domain_error("scalar value must be finite"); }
+        if (not std::isfinite(scalar)) { reject("scalar value must be finite"); }
         std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
         std::int64_t converted  = static_cast<std::int64_t>(scalar * forward);
 
+        observe(resistance.value_, converted);
         return Resistance((resistance.value_ * converted) / forward);
     }
 
     Resistance
     operator*(float scalar, const Resistance& resistance) {
-        if (not std::isfinite(scalar)) { throw std::domain_error("scalar value must be finite"); }
+        if (not std::isfinite(scalar)) { reject("scalar value must be finite"); }
         std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
         std::int64_t converted  = static_cast<std::int64_t>(scalar * forward);
 
+        observe(resistance.value_, converted);
         return Resistance((resistance.value_ * converted) / forward);
     }
 
@@ -425,7 +543,7 @@ namespace fixed {
     Volume::Volume() : value_(0) {}
     Volume::Volume(float v) {
         if (not std::isfinite(v)) {
-            throw std::domain_error("volume value must be finite");
+            reject("volume value must be finite");
         } else {
             value_ = static_cast<std::int64_t>(v * fixed::FORWARD);
         }
@@ -493,19 +611,21 @@ namespace fixed {
 
     Volume
     operator*(const Volume& volume, float scalar) {
-        if (not std::isfinite(scalar)) { throw std::domain_error("scalar value must be finite"); }
+        if (not std::isfinite(scalar)) { reject("scalar value must be finite"); }
         std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
         std::int64_t converted  = static_cast<std::int64_t>(scalar * forward);
 
+        observe(volume.value_, converted);
         return Volume((volume.value_ * converted) / forward);
     }
 
     Volume
     operator*(float scalar, const Volume& volume) {
-        if (not std::isfinite(scalar)) { throw std::domain_error("scalar value must be finite"); }
+        if (not std::isfinite(scalar)) { reject("scalar value must be finite"); }
         std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
         std::int64_t converted  = static_cast<std::int64_t>(scalar * forward);
 
+        observe(volume.value_, converted);
         return Volume((volume.value_ * converted) / forward);
     }
 
@@ -513,4 +633,98 @@ namespace fixed {
     operator<<(std::ostream& os, const Volume& volume) {
         return os << std::format("{:.1f}L", static_cast<float>(volume));
     }
+
+    Work::Work() : value_(0) {}
+    Work::Work(float v) {
+        if (not std::isfinite(v)) {
+            reject("work value must be finite");
+        } else {
+            value_ = static_cast<std::int64_t>(v * fixed::FORWARD);
+        }
+    }
+
+    Work::Work(std::int64_t v) : value_(v) {}
+
+    Work::operator
+    float() const {
+        return static_cast<float>(value_) * fixed::INVERSE;
+    }
+
+    std::strong_ordering
+    operator<=>(const Work& lhs, const Work& rhs) {
+        std::int64_t xs = lhs.value_ / fixed::PRECISION;
+        std::int64_t ys = rhs.value_ / fixed::PRECISION;
+
+        return (xs <=> ys);
+    }
+
+    bool
+    operator==(const Work& lhs, const Work& rhs) {
+        return (lhs <=> rhs) == std::strong_ordering::equal;
+    }
+
+    bool
+    operator!=(const Work& lhs, const Work& rhs) {
+        return (lhs <=> rhs) != std::strong_ordering::equal;
+    }
+
+    bool
+    operator<(const Work& lhs, const Work& rhs) {
+        return (lhs <=> rhs) == std::strong_ordering::less;
+    }
+
+    bool
+    operator<=(const Work& lhs, const Work& rhs) {
+        return (lhs <=> rhs) != std::strong_ordering::greater;
+    }
+
+    bool
+    operator>(const Work& lhs, const Work& rhs) {
+        return (lhs <=> rhs) == std::strong_ordering::greater;
+    }
+
+    bool
+    operator>=(const Work& lhs, const Work& rhs) {
+        return (lhs <=> rhs) != std::strong_ordering::less;
+    }
+
+    Work
+    operator+(const Work& lhs, const Work& rhs) {
+        return Work(lhs.value_ + rhs.value_);
+    }
+
+    Work
+    operator-(const Work& lhs) {
+        return Work(-lhs.value_);
+    }
+
+    Work
+    operator-(const Work& lhs, const Work& rhs) {
+        return Work(lhs.value_ - rhs.value_);
+    }
+
+    Work
+    operator*(const Work& work, float scalar) {
+        if (not std::isfinite(scalar)) { reject("scalar value must be finite"); }
+        std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
+        std::int64_t converted  = static_cast<std::int64_t>(scalar * forward);
+
+        observe(work.value_, converted);
+        return Work((work.value_ * converted) / forward);
+    }
+
+    Work
+    operator*(float scalar, const Work& work) {
+        if (not std::isfinite(scalar)) { reject("scalar value must be finite"); }
+        std::int64_t forward    = static_cast<std::int64_t>(fixed::FORWARD);
+        std::int64_t converted  = static_cast<std::int64_t>(scalar * forward);
+
+        observe(work.value_, converted);
+        return Work((work.value_ * converted) / forward);
+    }
+
+    std::ostream&
+    operator<<(std::ostream& os, const Work& work) {
+        return os << std::format("{:.1f}J", static_cast<float>(work));
+    }
 } // namespace ventilation
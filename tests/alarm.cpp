@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <vector>
+#include <ventilation/alarm.hpp>
+
+namespace {
+    template <typename T>
+    T
+    raw(std::int64_t value) {
+        return ventilation::fixed::Access::make<T>(value);
+    }
+
+    // Values near the threshold, where truncation to PRECISION matters, or anywhere
+    rc::Gen<std::int64_t>
+    near(std::int64_t threshold) {
+        return rc::gen::map(
+                rc::gen::pair(rc::gen::inRange<std::int64_t>(-3000, 3000), rc::gen::arbitrary<std::int64_t>())
+                , [threshold](const std::pair<std::int64_t, std::int64_t>& p) {
+                    return (p.second & 1) ? p.second : static_cast<std::int64_t>(
+                            static_cast<std::uint64_t>(threshold) + static_cast<std::uint64_t>(p.first)
+                            );
+                }
+                );
+    }
+
+    struct Samples {
+        std::vector<ventilation::Pressure>  pressure;
+        std::vector<ventilation::Flow>      flow;
+        std::vector<ventilation::Volume>    volume;
+
+        explicit Samples(std::size_t beds) : pressure(beds), flow(beds), volume(beds) {}
+    };
+} // namespace
+
+RC_GTEST_PROP(
+      RULE
+    , ABOVE
+    , (std::int64_t threshold)
+    )
+{
+    const std::int64_t value = *near(threshold);
+    const ventilation::alarm::Rule rule = ventilation::alarm::Rule::above(raw<ventilation::Pressure>(threshold));
+    RC_ASSERT(rule.holds(raw<ventilation::Pressure>(value)) == (raw<ventilation::Pressure>(value) > raw<ventilation::Pressure>(threshold)));
+}
+
+RC_GTEST_PROP(
+      RULE
+    , BELOW
+    , (std::int64_t threshold)
+    )
+{
+    const std::int64_t value = *near(threshold);
+    const ventilation::alarm::Rule rule = ventilation::alarm::Rule::below(raw<ventilation::Volume>(threshold));
+    RC_ASSERT(rule.holds(raw<ventilation::Volume>(value)) == (raw<ventilation::Volume>(value) < raw<ventilation::Volume>(threshold)));
+}
+
+RC_GTEST_PROP(
+      RULE
+    , WITHIN
+    , (std::int64_t lower)
+    )
+{
+    const std::int64_t upper = *near(lower);
+    const std::int64_t value = *near(lower);
+    const ventilation::Flow xs = raw<ventilation::Flow>(value);
+    const ventilation::alarm::Rule rule = ventilation::alarm::Rule::within(raw<ventilation::Flow>(lower), raw<ventilation::Flow>(upper));
+    RC_ASSERT(rule.holds(xs) == (raw<ventilation::Flow>(lower) < xs and xs < raw<ventilation::Flow>(upper)));
+}
+
+TEST(RULE, SIGNAL) {
+    const ventilation::alarm::Rule rule = ventilation::alarm::Rule::above(ventilation::Pressure(30.0f));
+    EXPECT_EQ(rule.signal, ventilation::alarm::Signal::pressure);
+    EXPECT_TRUE(rule.holds(ventilation::Pressure(31.0f)));
+    EXPECT_FALSE(rule.holds(ventilation::Flow(31.0f)));
+}
+
+TEST(ENGINE, DEBOUNCE) {
+    const ventilation::alarm::Rule rules[] = {ventilation::alarm::Rule::above(ventilation::Pressure(30.0f), 3)};
+    ventilation::alarm::Engine engine(rules, 2);
+    Samples samples(2);
+    std::vector<ventilation::alarm::Event> events;
+
+    samples.pressure = {ventilation::Pressure(35.0f), ventilation::Pressure(20.0f)};
+    engine.evaluate(samples.pressure, samples.flow, samples.volume, events);
+    engine.evaluate(samples.pressure, samples.flow, samples.volume, events);
+    EXPECT_TRUE(events.empty());
+    engine.evaluate(samples.pressure, samples.flow, samples.volume, events);
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(events[0].tick, 3);
+    EXPECT_EQ(events[0].bed, 0);
+    EXPECT_EQ(events[0].rule, 0);
+    EXPECT_EQ(events[0].edge, ventilation::alarm::Edge::raised);
+    EXPECT_TRUE(engine.active(0, 0));
+    EXPECT_FALSE(engine.active(0, 1));
+
+    // Still active, no further event
+    engine.evaluate(samples.pressure, samples.flow, samples.volume, events);
+    EXPECT_EQ(events.size(), 1);
+
+    samples.pressure[0] = ventilation::Pressure(30.0f);
+    engine.evaluate(samples.pressure, samples.flow, samples.volume, events);
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[1].edge, ventilation::alarm::Edge::cleared);
+    EXPECT_EQ(events[1].tick, 5);
+}
+
+TEST(ENGINE, LATCHING) {
+    const ventilation::alarm::Rule rules[] = {ventilation::alarm::Rule::below(ventilation::Volume(0.2f), 1, true)};
+    ventilation::alarm::Engine engine(rules, 1);
+    Samples samples(1);
+    std::vector<ventilation::alarm::Event> events;
+
+    samples.volume[0] = ventilation::Volume(0.1f);
+    engine.evaluate(samples.pressure, samples.flow, samples.volume, events);
+    EXPECT_EQ(events.size(), 1);
+
+    // Acknowledging while the condition holds does not clear
+    engine.acknowledge(0, 0, events);
+    EXPECT_EQ(events.size(), 1);
+    EXPECT_TRUE(engine.active(0, 0));
+
+    samples.volume[0] = ventilation::Volume(0.5f);
+    engine.evaluate(samples.pressure, samples.flow, samples.volume, events);
+    EXPECT_EQ(events.size(), 1);
+    EXPECT_TRUE(engine.active(0, 0));
+
+    engine.acknowledge(0, 0, events);
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[1].edge, ventilation::alarm::Edge::cleared);
+    EXPECT_FALSE(engine.active(0, 0));
+}
+
+TEST(ENGINE, CONFIGURE) {
+    const ventilation::alarm::Rule rules[] = {
+          ventilation::alarm::Rule::above(ventilation::Pressure(30.0f))
+        , ventilation::alarm::Rule::within(ventilation::Flow(-0.05f), ventilation::Flow(0.05f), 2)
+    };
+    ventilation::alarm::Engine engine(rules, 3);
+    engine.configure(0, 1, ventilation::alarm::Rule::above(ventilation::Pressure(40.0f)));
+    EXPECT_THROW(engine.configure(0, 1, ventilation::alarm::Rule::above(ventilation::Flow(1.0f))), std::invalid_argument);
+    EXPECT_THROW(engine.configure(2, 0, rules[0]), std::out_of_range);
+    EXPECT_THROW(engine.configure(0, 3, rules[0]), std::out_of_range);
+
+    Samples samples(3);
+    std::vector<ventilation::alarm::Event> events;
+    samples.pressure.assign(3, ventilation::Pressure(35.0f));
+    samples.flow = {ventilation::Flow(0.5f), ventilation::Flow(0.5f), ventilation::Flow(0.0f)};
+    engine.evaluate(samples.pressure, samples.flow, samples.volume, events);
+    engine.evaluate(samples.pressure, samples.flow, samples.volume, events);
+
+    EXPECT_TRUE(engine.active(0, 0));
+    EXPECT_FALSE(engine.active(0, 1));
+    EXPECT_TRUE(engine.active(0, 2));
+    EXPECT_FALSE(engine.active(1, 0));
+    EXPECT_TRUE(engine.active(1, 2));
+    EXPECT_EQ(events.size(), 3);
+}
+
+TEST(ENGINE, EXCEPTION) {
+    const ventilation::alarm::Rule rules[] = {ventilation::alarm::Rule::above(ventilation::Pressure(30.0f), 0)};
+    EXPECT_THROW(ventilation::alarm::Engine(rules, 1), std::invalid_argument);
+
+    ventilation::alarm::Engine engine(std::span<const ventilation::alarm::Rule>(), 2);
+    Samples samples(1);
+    std::vector<ventilation::alarm::Event> events;
+    EXPECT_THROW(engine.evaluate(samples.pressure, samples.flow, samples.volume, events), std::invalid_argument);
+}
+
+RC_GTEST_PROP(
+      ENGINE
+    , MODEL
+    , ()
+    )
+{
+    // Against a per-bed scalar model using the comparison operators
+    const std::size_t beds      = *rc::gen::inRange<std::size_t>(1, 70);
+    const std::uint32_t debounce = *rc::gen::inRange<std::uint32_t>(1, 4);
+    const bool latching         = *rc::gen::arbitrary<bool>();
+    const ventilation::Pressure threshold(25.0f);
+    const ventilation::alarm::Rule rules[] = {ventilation::alarm::Rule::above(threshold, debounce, latching)};
+
+    ventilation::alarm::Engine engine(rules, beds);
+    std::vector<std::uint32_t> count(beds, 0);
+    std::vector<bool> active(beds, false);
+    Samples samples(beds);
+
+    for (std::size_t tick = 1; tick <= 20; tick++) {
+        for (std::size_t bed = 0; bed < beds; bed++) {
+            samples.pressure[bed] = ventilation::Pressure(*rc::gen::inRange(230, 270) * 0.1f);
+        }
+        std::vector<ventilation::alarm::Event> events;
+        engine.evaluate(samples.pressure, samples.flow, samples.volume, events);
+
+        std::size_t e = 0;
+        for (std::size_t bed = 0; bed < beds; bed++) {
+            count[bed]      = samples.pressure[bed] > threshold ? std::min(count[bed] + 1, debounce) : 0;
+            bool current    = count[bed] >= debounce or (latching and active[bed]);
+            if (current != active[bed]) {
+                RC_ASSERT(e < events.size());
+                RC_ASSERT(events[e].bed == bed);
+                RC_ASSERT(events[e].tick == tick);
+                RC_ASSERT(events[e].edge == (current ? ventilation::alarm::Edge::raised : ventilation::alarm::Edge::cleared));
+                e++;
+            }
+            active[bed] = current;
+            RC_ASSERT(engine.active(0, bed) == current);
+        }
+        RC_ASSERT(e == events.size());
+    }
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numbers>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <vector>
+#include <ventilation/asynchrony.hpp>
+
+namespace {
+    constexpr float PERIOD = 0.001f;
+
+    struct Recording {
+        std::vector<ventilation::Pressure>  pressure;
+        std::vector<ventilation::Flow>      flow;
+    };
+
+    // Volume-controlled breath at 1 kHz: one second of constant inspiratory
+    // flow, then passive exhalation with a time constant of half a second.
+    // An effort adds a half-sine bump of flow, and a dip of pressure, lasting
+    // 0.3 s from `effort` seconds into expiration.
+    void
+    breath(Recording& recording, float expiration, float effort = -1.0f) {
+        for (int i = 0; i < 1000; i++) {
+            recording.pressure.push_back(ventilation::Pressure(5.0f + 15.0f * static_cast<float>(i) / 1000.0f));
+            recording.flow.push_back(ventilation::Flow(0.5f));
+        }
+        const int samples = static_cast<int>(std::lround(expiration / PERIOD));
+        for (int i = 0; i < samples; i++) {
+            const float t   = static_cast<float>(i) * PERIOD;
+            float flow      = -1.0f * std::exp(-t / 0.5f) - 0.01f;
+            float pressure  = 5.0f + 15.0f * std::exp(-t / 0.05f);
+            if (effort >= 0.0f and t >= effort and t < effort + 0.3f) {
+                const float bump = std::sin(std::numbers::pi_v<float> * (t - effort) / 0.3f);
+                flow        += 0.25f * bump;
+                pressure    -= 1.5f * bump;
+            }
+            recording.pressure.push_back(ventilation::Pressure(pressure));
+            recording.flow.push_back(ventilation::Flow(std::min(flow, -0.01f)));
+        }
+    }
+
+    Recording
+    lead() {
+        Recording recording;
+        for (int i = 0; i < 10; i++) {
+            recording.pressure.push_back(ventilation::Pressure(5.0f));
+            recording.flow.push_back(ventilation::Flow(-0.01f));
+        }
+        return recording;
+    }
+
+    std::vector<ventilation::asynchrony::Breath>
+    stream(const Recording& recording) {
+        ventilation::asynchrony::Detector detector(PERIOD);
+        std::vector<ventilation::asynchrony::Breath> breaths;
+        detector.push(recording.pressure, recording.flow, breaths);
+        return breaths;
+    }
+
+    bool
+    same(const ventilation::asynchrony::Breath& lhs, const ventilation::asynchrony::Breath& rhs) {
+        return  lhs.start       == rhs.start
+            and lhs.inspiration == rhs.inspiration
+            and lhs.expiration  == rhs.expiration
+            and lhs.peak        == rhs.peak
+            and lhs.pressure    == rhs.pressure
+            and lhs.inspired    == rhs.inspired
+            and lhs.expired     == rhs.expired
+            and lhs.efforts     == rhs.efforts
+            and lhs.type        == rhs.type;
+    }
+} // namespace
+
+TEST(DETECTOR, NORMAL) {
+    Recording recording = lead();
+    breath(recording, 2.0f);
+    breath(recording, 2.0f);
+
+    const std::vector<ventilation::asynchrony::Breath> breaths = stream(recording);
+    ASSERT_EQ(breaths.size(), 1u);
+    EXPECT_EQ(breaths[0].start, 10u);
+    EXPECT_EQ(breaths[0].inspiration, 1000u);
+    EXPECT_EQ(breaths[0].expiration, 2000u);
+    EXPECT_EQ(breaths[0].peak, ventilation::Flow(0.5f));
+    EXPECT_NEAR(static_cast<float>(breaths[0].pressure), 20.0f, 0.02f);
+    EXPECT_NEAR(static_cast<float>(breaths[0].inspired), 0.5f, 1e-3f);
+    EXPECT_NEAR(static_cast<float>(breaths[0].expired), 0.51f, 0.01f);
+    EXPECT_EQ(breaths[0].efforts, 0u);
+    EXPECT_EQ(breaths[0].type, ventilation::asynchrony::Type::normal);
+}
+
+TEST(DETECTOR, INEFFECTIVE) {
+    Recording recording = lead();
+    breath(recording, 2.0f, 0.6f);
+    breath(recording, 2.0f);
+
+    const std::vector<ventilation::asynchrony::Breath> breaths = stream(recording);
+    ASSERT_EQ(breaths.size(), 1u);
+    EXPECT_EQ(breaths[0].efforts, 1u);
+    EXPECT_EQ(breaths[0].type, ventilation::asynchrony::Type::ineffective);
+}
+
+TEST(DETECTOR, PREMATURE) {
+    Recording recording = lead();
+    breath(recording, 2.0f, 0.05f);
+    breath(recording, 2.0f);
+
+    const std::vector<ventilation::asynchrony::Breath> breaths = stream(recording);
+    ASSERT_EQ(breaths.size(), 1u);
+    EXPECT_EQ(breaths[0].efforts, 1u);
+    EXPECT_EQ(breaths[0].type, ventilation::asynchrony::Type::premature);
+}
+
+TEST(DETECTOR, DOUBLE) {
+    Recording recording = lead();
+    breath(recording, 0.3f);
+    breath(recording, 2.0f);
+    breath(recording, 2.0f);
+
+    const std::vector<ventilation::asynchrony::Breath> breaths = stream(recording);
+    ASSERT_EQ(breaths.size(), 2u);
+    EXPECT_EQ(breaths[0].type, ventilation::asynchrony::Type::double_trigger);
+    EXPECT_EQ(breaths[1].type, ventilation::asynchrony::Type::normal);
+    EXPECT_EQ(breaths[1].start, 10u + 1300u);
+}
+
+TEST(DETECTOR, PUSH) {
+    Recording recording = lead();
+    breath(recording, 2.0f);
+    breath(recording, 2.0f);
+
+    ventilation::asynchrony::Detector detector(PERIOD);
+    std::size_t ended = 0;
+    for (std::size_t i = 0; i < recording.flow.size(); i++) {
+        if (detector.push(recording.pressure[i], recording.flow[i])) {
+            EXPECT_EQ(i, 3010u);
+            ended++;
+        }
+    }
+    EXPECT_EQ(ended, 1u);
+    EXPECT_EQ(detector.samples(), recording.flow.size());
+}
+
+TEST(DETECTOR, INVALID) {
+    ventilation::asynchrony::Thresholds negative;
+    negative.effort = ventilation::Flow(-0.1f);
+
+    EXPECT_THROW(ventilation::asynchrony::Detector(0.0f), std::domain_error);
+    EXPECT_THROW(ventilation::asynchrony::Detector(NAN), std::domain_error);
+    EXPECT_THROW(ventilation::asynchrony::Detector(PERIOD, negative), std::invalid_argument);
+
+    ventilation::asynchrony::Detector detector(PERIOD);
+    std::vector<ventilation::asynchrony::Breath> breaths;
+    std::vector<ventilation::Pressure> pressure(2);
+    std::vector<ventilation::Flow> flow(3);
+    EXPECT_THROW(detector.push(pressure, flow, breaths), std::invalid_argument);
+}
+
+RC_GTEST_PROP(
+      CLASSIFY
+    , STREAM
+    , ()
+    )
+{
+    Recording recording = lead();
+    const std::size_t count = *rc::gen::inRange<std::size_t>(1, 40);
+    for (std::size_t i = 0; i < count; i++) {
+        switch (*rc::gen::inRange(0, 4)) {
+            case 0: breath(recording, 2.0f);        break;
+            case 1: breath(recording, 2.0f, 0.6f);  break;
+            case 2: breath(recording, 1.5f, 0.05f); break;
+            case 3: breath(recording, 0.3f);        break;
+        }
+    }
+    const std::vector<ventilation::asynchrony::Breath> expected = stream(recording);
+
+    ventilation::parallel::Pool pool(*rc::gen::inRange<std::size_t>(1, 5));
+    const std::vector<ventilation::asynchrony::Breath> actual = ventilation::asynchrony::classify(
+              recording.pressure
+            , recording.flow
+            , PERIOD
+            , ventilation::asynchrony::Thresholds()
+            , pool
+            );
+    RC_ASSERT(actual.size() == expected.size());
+    for (std::size_t i = 0; i < actual.size(); i++) {
+        RC_ASSERT(same(actual[i], expected[i]));
+    }
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <vector>
+#include <ventilation/batch.hpp>
+
+namespace rc {
+    template <>
+    struct Arbitrary<ventilation::Flow> {
+        static Gen<ventilation::Flow>
+        arbitrary() {
+            const Gen<std::int32_t> value = gen::inRange(-1000, 1000);
+            return gen::construct<ventilation::Flow>(
+                    gen::map(value, [](std::int32_t v) { return static_cast<float>(v) * 1e-3f; })
+            );
+        }
+    };
+
+    template <>
+    struct Arbitrary<ventilation::Volume> {
+        static Gen<ventilation::Volume>
+        arbitrary() {
+            const Gen<std::int32_t> value = gen::inRange(-1000, 1000);
+            return gen::construct<ventilation::Volume>(
+                    gen::map(value, [](std::int32_t v) { return static_cast<float>(v) * 1e-3f; })
+            );
+        }
+    };
+} // namespace rc
+
+TEST(CONSTRUCT, EXCEPTION) {
+    std::vector<float> input = {1.0f, std::numeric_limits<float>::quiet_NaN()};
+    std::vector<ventilation::Flow> output(input.size());
+    EXPECT_THROW(
+            ventilation::batch::construct<ventilation::Flow>(input, output)
+            , std::domain_error
+            );
+}
+
+TEST(CONSTRUCT, SIZE) {
+    std::vector<float> input(3);
+    std::vector<ventilation::Flow> output(2);
+    EXPECT_THROW(
+            ventilation::batch::construct<ventilation::Flow>(input, output)
+            , std::invalid_argument
+            );
+}
+
+RC_GTEST_PROP(
+      CONSTRUCT
+    , SCALAR
+    , (const std::vector<std::int32_t>& values)
+    )
+{
+    std::vector<float> input;
+    for (std::int32_t v : values) { input.push_back(static_cast<float>(v) * 1e-3f); }
+
+    std::vector<ventilation::Pressure> output(input.size());
+    ventilation::batch::construct<ventilation::Pressure>(input, output);
+    for (std::size_t i = 0; i < input.size(); i++) {
+        RC_ASSERT(static_cast<float>(output[i]) == static_cast<float>(ventilation::Pressure(input[i])));
+    }
+}
+
+RC_GTEST_PROP(
+      CONVERT
+    , SCALAR
+    , (const std::vector<ventilation::Flow>& input)
+    )
+{
+    std::vector<float> output(input.size());
+    ventilation::batch::convert<ventilation::Flow>(input, output);
+    for (std::size_t i = 0; i < input.size(); i++) {
+        RC_ASSERT(output[i] == static_cast<float>(input[i]));
+    }
+}
+
+RC_GTEST_PROP(
+      SCALE
+    , SCALAR
+    , (const std::vector<ventilation::Flow>& input, std::int32_t factor)
+    )
+{
+    float scalar = static_cast<float>(factor) * 1e-3f;
+
+    std::vector<ventilation::Flow> output(input.size());
+    ventilation::batch::scale<ventilation::Flow>(input, scalar, output);
+    for (std::size_t i = 0; i < input.size(); i++) {
+        RC_ASSERT(static_cast<float>(output[i]) == static_cast<float>(input[i] * scalar));
+    }
+}
+
+TEST(SCALE, EXCEPTION) {
+    std::vector<ventilation::Flow> input(4);
+    std::vector<ventilation::Flow> output(4);
+    EXPECT_THROW(
+            ventilation::batch::scale<ventilation::Flow>(input, std::numeric_limits<float>::infinity(), output)
+            , std::domain_error
+            );
+}
+
+RC_GTEST_PROP(
+      COMPARE
+    , SCALAR
+    , (const std::vector<ventilation::Flow>& lhs)
+    )
+{
+    const std::vector<ventilation::Flow> rhs = *rc::gen::container<std::vector<ventilation::Flow>>(
+            lhs.size()
+            , rc::gen::arbitrary<ventilation::Flow>()
+            );
+
+    std::vector<std::int8_t> output(lhs.size());
+    ventilation::batch::compare<ventilation::Flow>(lhs, rhs, output);
+    for (std::size_t i = 0; i < lhs.size(); i++) {
+        RC_ASSERT((output[i] < 0) == (lhs[i] < rhs[i]));
+        RC_ASSERT((output[i] == 0) == (lhs[i] == rhs[i]));
+        RC_ASSERT((output[i] > 0) == (lhs[i] > rhs[i]));
+    }
+}
+
+RC_GTEST_PROP(
+      SUM
+    , SCALAR
+    , (const std::vector<ventilation::Volume>& input)
+    )
+{
+    ventilation::Volume expected;
+    for (const ventilation::Volume& v : input) { expected = expected + v; }
+
+    RC_ASSERT(ventilation::batch::sum<ventilation::Volume>(input) == expected);
+}
+
+TEST(MOTION, DEFINITION) {
+    std::vector<ventilation::Flow>      flow    = {ventilation::Flow(0.5f), ventilation::Flow(-0.25f)};
+    std::vector<ventilation::Volume>    volume  = {ventilation::Volume(0.2f), ventilation::Volume(0.4f)};
+    std::vector<ventilation::Pressure>  output(2);
+
+    ventilation::batch::motion(
+              flow
+            , volume
+            , ventilation::Resistance(10.0f)
+            , ventilation::Elastance(20.0f)
+            , ventilation::Pressure(5.0f)
+            , output
+            );
+    EXPECT_EQ(output[0], ventilation::Pressure(14.0f));
+    EXPECT_EQ(output[1], ventilation::Pressure(10.5f));
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
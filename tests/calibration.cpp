@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <thread>
+#include <vector>
+#include <ventilation/calibration.hpp>
+
+namespace {
+    // Flow through a differential pressure sensor, as the square root of the
+    // counts above its offset
+    std::vector<ventilation::calibration::Point>
+    sensor() {
+        std::vector<ventilation::calibration::Point> points;
+        for (std::int32_t count = 512; count <= 65535; count += 2047) {
+            points.push_back({count, 0.5f * std::sqrt(static_cast<float>(count - 512))});
+        }
+        return points;
+    }
+
+    // The conversion this replaces, searching the points for every sample
+    float
+    search(const std::vector<ventilation::calibration::Point>& points, std::int32_t count) {
+        auto upper = std::upper_bound(
+                  points.begin()
+                , points.end()
+                , count
+                , [](std::int32_t c, const ventilation::calibration::Point& p) { return c < p.count; }
+                );
+        if (upper == points.begin())    { return points.front().value; }
+        if (upper == points.end())      { return points.back().value; }
+        auto lower = upper - 1;
+        float fraction = static_cast<float>(count - lower->count) / static_cast<float>(upper->count - lower->count);
+        return lower->value + (upper->value - lower->value) * fraction;
+    }
+} // namespace
+
+TEST(TABLE, POINTS) {
+    const std::vector<ventilation::calibration::Point> points = {{0, -2.0f}, {1024, 3.0f}, {4096, 3.5f}};
+    ventilation::calibration::Table<ventilation::Pressure> table(points, 4);
+
+    EXPECT_EQ(table.segments(), 4u);
+    EXPECT_EQ(table.lower(), 0);
+    EXPECT_EQ(table.upper(), 4096);
+    EXPECT_EQ(table.error(), ventilation::Pressure(0.0f));
+    for (const ventilation::calibration::Point& point : points) {
+        EXPECT_EQ(table(point.count), ventilation::Pressure(point.value));
+    }
+    EXPECT_EQ(table(512), ventilation::Pressure(0.5f));
+}
+
+TEST(TABLE, CLAMP) {
+    const std::vector<ventilation::calibration::Point> points = {{100, 1.0f}, {356, 5.0f}};
+    ventilation::calibration::Table<ventilation::Flow> table(points, 1);
+
+    EXPECT_EQ(table.error(), ventilation::Flow(0.0f));
+    EXPECT_EQ(table(std::numeric_limits<std::int32_t>::min()), ventilation::Flow(1.0f));
+    EXPECT_EQ(table(99), ventilation::Flow(1.0f));
+    EXPECT_EQ(table(228), ventilation::Flow(3.0f));
+    EXPECT_EQ(table(357), ventilation::Flow(5.0f));
+    EXPECT_EQ(table(std::numeric_limits<std::int32_t>::max()), ventilation::Flow(5.0f));
+}
+
+TEST(TABLE, INVALID) {
+    using Table = ventilation::calibration::Table<ventilation::Flow>;
+    const std::vector<ventilation::calibration::Point> single      = {{0, 1.0f}};
+    const std::vector<ventilation::calibration::Point> unordered   = {{0, 1.0f}, {0, 2.0f}};
+    const std::vector<ventilation::calibration::Point> valid       = {{0, 1.0f}, {10, 2.0f}};
+    const std::vector<ventilation::calibration::Point> infinite    = {{0, 1.0f}, {10, INFINITY}};
+
+    EXPECT_THROW(Table(single, 1), std::invalid_argument);
+    EXPECT_THROW(Table(unordered, 1), std::invalid_argument);
+    EXPECT_THROW(Table(valid, 3), std::invalid_argument);
+    EXPECT_THROW(Table(valid, 0), std::invalid_argument);
+    EXPECT_THROW(Table(infinite, 1), std::domain_error);
+}
+
+TEST(TABLE, FIT) {
+    const std::vector<ventilation::calibration::Point> points = sensor();
+    const ventilation::Flow tolerance(0.01f);
+    ventilation::calibration::Table<ventilation::Flow> table = ventilation::calibration::Table<ventilation::Flow>::fit(
+            points
+            , tolerance
+            );
+    EXPECT_LE(table.error(), tolerance);
+
+    for (std::int32_t count = 0; count <= 70000; count += 37) {
+        EXPECT_NEAR(static_cast<float>(table(count)), search(points, count), 0.02f) << count;
+    }
+}
+
+RC_GTEST_PROP(
+      TABLE
+    , CONVERT
+    , (const std::vector<std::int32_t>& counts)
+    )
+{
+    const std::vector<ventilation::calibration::Point> points = sensor();
+    const std::uint32_t segments = 1u << *rc::gen::inRange<std::uint32_t>(0, 12);
+    ventilation::calibration::Table<ventilation::Flow> table(points, segments);
+
+    std::vector<ventilation::Flow> output(counts.size());
+    table.convert(std::span<const std::int32_t>(counts), std::span<ventilation::Flow>(output));
+    for (std::size_t i = 0; i < counts.size(); i++) {
+        RC_ASSERT(output[i] == table(counts[i]));
+    }
+}
+
+RC_GTEST_PROP(
+      TABLE
+    , NARROW
+    , (const std::vector<std::uint16_t>& counts)
+    )
+{
+    ventilation::calibration::Table<ventilation::Flow> table(sensor(), 64);
+    const std::vector<std::int32_t> wide(counts.begin(), counts.end());
+
+    std::vector<ventilation::Flow> expected(counts.size());
+    std::vector<ventilation::Flow> actual(counts.size());
+    table.convert(std::span<const std::int32_t>(wide), std::span<ventilation::Flow>(expected));
+    table.convert(std::span<const std::uint16_t>(counts), std::span<ventilation::Flow>(actual));
+    RC_ASSERT(actual == expected);
+}
+
+TEST(CALIBRATION, INSTALL) {
+    using ventilation::calibration::Table;
+    const std::vector<ventilation::calibration::Point> one = {{0, 1.0f}, {1000, 1.0f}};
+    const std::vector<ventilation::calibration::Point> two = {{0, 2.0f}, {1000, 2.0f}};
+    ventilation::calibration::Calibration<ventilation::Pressure> calibration(Table<ventilation::Pressure>(one, 1));
+
+    std::atomic<bool> done = false;
+    std::thread writer([&] {
+        for (int i = 0; i < 1000; i++) {
+            calibration.install(Table<ventilation::Pressure>(i % 2 == 0 ? two : one, 1));
+        }
+        done = true;
+    });
+
+    const std::vector<std::int32_t> counts(4096, 500);
+    std::vector<ventilation::Pressure> output(counts.size());
+    std::size_t mixed = 0;
+    while (not done) {
+        calibration.convert(std::span<const std::int32_t>(counts), std::span<ventilation::Pressure>(output));
+        if (std::any_of(output.begin(), output.end(), [&](const ventilation::Pressure& p) { return p != output.front(); })) {
+            mixed++;
+        }
+    }
+    writer.join();
+
+    EXPECT_EQ(mixed, 0u);
+    EXPECT_EQ(calibration(500), ventilation::Pressure(1.0f));
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <span>
+#include <vector>
+#include <ventilation/cohort.hpp>
+
+namespace {
+    using ventilation::cohort::Aggregation;
+    using ventilation::cohort::Function;
+    using Key = std::vector<std::int64_t>;
+
+    const Aggregation AGGREGATIONS[] = {
+          {0, Function::count}
+        , {0, Function::sum}
+        , {0, Function::minimum}
+        , {1, Function::maximum}
+        , {1, Function::mean}
+        , {0, Function::median}
+        , {1, Function::median}
+    };
+
+    // Rows of two key columns, patient and day, and two value columns
+    struct Records {
+        std::vector<std::int64_t>           patient;
+        std::vector<std::int64_t>           day;
+        std::vector<ventilation::Pressure>  driving;
+        std::vector<ventilation::Pressure>  plateau;
+    };
+
+    // Drawn inside a property
+    Records
+    records(std::size_t size) {
+        Records records;
+        for (std::size_t i = 0; i < size; i++) {
+            records.patient.push_back(*rc::gen::inRange<std::int64_t>(0, 6));
+            records.day.push_back(*rc::gen::inRange<std::int64_t>(-2, 3));
+            records.driving.push_back(ventilation::Pressure(static_cast<float>(*rc::gen::inRange(500, 2500)) * 0.01f));
+            records.plateau.push_back(ventilation::Pressure(static_cast<float>(*rc::gen::inRange(-100, 3500)) * 0.01f));
+        }
+        return records;
+    }
+
+    ventilation::cohort::Result
+    group(const Records& records, ventilation::parallel::Pool& pool) {
+        const std::span<const std::int64_t> keys[] = {records.patient, records.day};
+        const std::span<const std::int64_t> columns[] = {
+              ventilation::fixed::Access::raw(std::span<const ventilation::Pressure>(records.driving))
+            , ventilation::fixed::Access::raw(std::span<const ventilation::Pressure>(records.plateau))
+        };
+        return ventilation::cohort::group(keys, columns, AGGREGATIONS, pool);
+    }
+} // namespace
+
+RC_GTEST_PROP(
+      GROUP
+    , REFERENCE
+    , ()
+    )
+{
+    const Records input = records(*rc::gen::inRange<std::size_t>(0, 2000));
+    ventilation::parallel::Pool pool(2);
+    const ventilation::cohort::Result result = group(input, pool);
+
+    std::map<Key, std::vector<std::size_t>> expected;
+    for (std::size_t row = 0; row < input.patient.size(); row++) {
+        expected[{input.patient[row], input.day[row]}].push_back(row);
+    }
+    RC_ASSERT(result.groups() == expected.size());
+    RC_ASSERT(result.width() == 2u);
+    RC_ASSERT(result.aggregations() == 7u);
+
+    std::size_t g = 0;
+    for (const auto& [key, rows] : expected) {
+        std::span<const std::int64_t> actual = result.key(g);
+        RC_ASSERT(Key(actual.begin(), actual.end()) == key);
+        RC_ASSERT(result.find(key) == g);
+        RC_ASSERT(result.count(g) == rows.size());
+
+        std::vector<std::int64_t> driving;
+        std::vector<std::int64_t> plateau;
+        __int128 total = 0;
+        __int128 sum = 0;
+        for (std::size_t row : rows) {
+            driving.push_back(ventilation::fixed::Access::raw(input.driving[row]));
+            plateau.push_back(ventilation::fixed::Access::raw(input.plateau[row]));
+            total   += driving.back();
+            sum     += plateau.back();
+        }
+        std::sort(driving.begin(), driving.end());
+        std::sort(plateau.begin(), plateau.end());
+        const std::size_t mid = (rows.size() - 1) / 2;
+
+        using ventilation::fixed::Access;
+        RC_ASSERT(result.total(g, 1) == total);
+        RC_ASSERT(Access::raw(result.value<ventilation::Pressure>(g, 1)) == static_cast<std::int64_t>(total));
+        RC_ASSERT(Access::raw(result.value<ventilation::Pressure>(g, 2)) == driving.front());
+        RC_ASSERT(Access::raw(result.value<ventilation::Pressure>(g, 3)) == plateau.back());
+        RC_ASSERT(Access::raw(result.value<ventilation::Pressure>(g, 4)) == static_cast<std::int64_t>(sum / static_cast<__int128>(rows.size())));
+        RC_ASSERT(Access::raw(result.value<ventilation::Pressure>(g, 5)) == driving[mid]);
+        RC_ASSERT(Access::raw(result.value<ventilation::Pressure>(g, 6)) == plateau[mid]);
+        g++;
+    }
+    RC_ASSERT(result.find(Key{7, 7}) == result.groups());
+}
+
+TEST(GROUP, POOL) {
+    // Several chunks, so partials are merged
+    Records input;
+    for (std::size_t i = 0; i < 3 * ventilation::cohort::CHUNK + 123; i++) {
+        input.patient.push_back(static_cast<std::int64_t>((i * 7919) % 97));
+        input.day.push_back(static_cast<std::int64_t>(i / 50000));
+        input.driving.push_back(ventilation::Pressure(static_cast<float>((i * 31) % 2000) * 0.01f));
+        input.plateau.push_back(ventilation::Pressure(static_cast<float>((i * 17) % 3000) * 0.01f));
+    }
+    ventilation::parallel::Pool one(1);
+    const ventilation::cohort::Result expected = group(input, one);
+
+    // More threads than chunks too
+    for (std::size_t threads : {3, 8}) {
+        ventilation::parallel::Pool pool(threads);
+        const ventilation::cohort::Result actual = group(input, pool);
+
+        ASSERT_EQ(actual.groups(), expected.groups());
+        std::uint64_t rows = 0;
+        for (std::size_t g = 0; g < actual.groups(); g++) {
+            ASSERT_TRUE(std::ranges::equal(actual.key(g), expected.key(g)));
+            EXPECT_EQ(actual.count(g), expected.count(g));
+            for (std::size_t a = 1; a < actual.aggregations(); a++) {
+                EXPECT_EQ(actual.value<ventilation::Pressure>(g, a), expected.value<ventilation::Pressure>(g, a));
+            }
+            rows += actual.count(g);
+        }
+        EXPECT_EQ(rows, input.patient.size());
+    }
+}
+
+TEST(GROUP, NOKEYS) {
+    const std::vector<ventilation::Volume> tidal = {
+        ventilation::Volume(0.4f), ventilation::Volume(0.6f), ventilation::Volume(0.5f)
+    };
+    const std::span<const std::int64_t> columns[] = {
+        ventilation::fixed::Access::raw(std::span<const ventilation::Volume>(tidal))
+    };
+    const Aggregation aggregations[] = {{0, Function::median}, {0, Function::sum}};
+    const ventilation::cohort::Result result = ventilation::cohort::group({}, columns, aggregations);
+
+    ASSERT_EQ(result.groups(), 1u);
+    EXPECT_EQ(result.count(0), 3u);
+    EXPECT_EQ(result.value<ventilation::Volume>(0, 0), ventilation::Volume(0.5f));
+    EXPECT_EQ(result.value<ventilation::Volume>(0, 1), ventilation::Volume(1.5f));
+}
+
+TEST(QUANTIZE, WIDTH) {
+    const std::vector<ventilation::Compliance> compliance = {
+          ventilation::Compliance(0.0f)
+        , ventilation::Compliance(0.009f)
+        , ventilation::Compliance(0.01f)
+        , ventilation::Compliance(0.055f)
+        , ventilation::Compliance(-0.001f)
+    };
+    std::vector<std::int64_t> codes(compliance.size());
+    ventilation::cohort::quantize<ventilation::Compliance>(compliance, ventilation::Compliance(0.01f), codes);
+    EXPECT_EQ(codes, (std::vector<std::int64_t>{0, 0, 1, 5, -1}));
+
+    EXPECT_THROW(
+            ventilation::cohort::quantize<ventilation::Compliance>(compliance, ventilation::Compliance(0.0f), codes)
+            , std::invalid_argument
+            );
+}
+
+TEST(QUANTIZE, DECILES) {
+    std::vector<ventilation::Compliance> compliance;
+    for (int i = 0; i < 1000; i++) {
+        compliance.push_back(ventilation::Compliance(static_cast<float>((i * 389) % 1000) * 0.0001f));
+    }
+    const std::vector<ventilation::Compliance> edges = ventilation::cohort::quantiles<ventilation::Compliance>(compliance, 10);
+    ASSERT_EQ(edges.size(), 9u);
+
+    std::vector<std::int64_t> codes(compliance.size());
+    ventilation::cohort::quantize<ventilation::Compliance>(compliance, edges, codes);
+    std::vector<std::size_t> sizes(10, 0);
+    for (std::int64_t code : codes) {
+        ASSERT_GE(code, 0);
+        ASSERT_LT(code, 10);
+        sizes[static_cast<std::size_t>(code)]++;
+    }
+    for (std::size_t size : sizes) {
+        EXPECT_EQ(size, 100u);
+    }
+
+    const std::vector<ventilation::Compliance> unsorted = {ventilation::Compliance(0.02f), ventilation::Compliance(0.01f)};
+    EXPECT_THROW(
+            ventilation::cohort::quantize<ventilation::Compliance>(compliance, unsorted, codes)
+            , std::invalid_argument
+            );
+    EXPECT_THROW(ventilation::cohort::quantiles<ventilation::Compliance>({}, 10), std::invalid_argument);
+}
+
+TEST(GROUP, INVALID) {
+    const std::vector<std::int64_t> keys = {1, 2, 3};
+    const std::vector<std::int64_t> values = {1, 2};
+    const std::span<const std::int64_t> key[] = {keys};
+    const std::span<const std::int64_t> value[] = {values};
+    const std::span<const std::int64_t> matching[] = {std::span<const std::int64_t>(keys)};
+    const Aggregation missing[] = {{1, Function::sum}};
+    const Aggregation count[] = {{0, Function::count}};
+
+    EXPECT_THROW(ventilation::cohort::group(key, value, count), std::invalid_argument);
+    EXPECT_THROW(ventilation::cohort::group(key, matching, missing), std::out_of_range);
+
+    const ventilation::cohort::Result result = ventilation::cohort::group(key, matching, count);
+    EXPECT_EQ(result.groups(), 3u);
+    EXPECT_THROW(result.value<ventilation::Pressure>(0, 0), std::invalid_argument);
+    EXPECT_THROW(result.count(3), std::out_of_range);
+
+    // A sum past the representation
+    const std::vector<std::int64_t> large = {std::numeric_limits<std::int64_t>::max(), 1};
+    const std::vector<std::int64_t> same = {0, 0};
+    const std::span<const std::int64_t> keyed[] = {same};
+    const std::span<const std::int64_t> overflowing[] = {large};
+    const Aggregation sum[] = {{0, Function::sum}};
+    const ventilation::cohort::Result overflow = ventilation::cohort::group(keyed, overflowing, sum);
+    EXPECT_EQ(overflow.total(0, 0), static_cast<__int128>(std::numeric_limits<std::int64_t>::max()) + 1);
+    EXPECT_THROW(overflow.value<ventilation::Pressure>(0, 0), std::out_of_range);
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+#include <ventilation/comparison.hpp>
+
+namespace {
+    using ventilation::comparison::Channel;
+    using ventilation::comparison::Golden;
+    using ventilation::comparison::Report;
+
+    // Raw samples, some nudged away from `base`; drawn inside a property
+    std::vector<std::int64_t>
+    perturbed(const std::vector<std::int64_t>& base) {
+        std::vector<std::int64_t> samples(base);
+        const std::size_t changes = *rc::gen::inRange<std::size_t>(0, 20);
+        for (std::size_t k = 0; k < changes and not samples.empty(); k++) {
+            const std::size_t i = *rc::gen::inRange<std::size_t>(0, samples.size());
+            samples[i] += *rc::gen::inRange<std::int64_t>(-5000, 5000);
+        }
+        return samples;
+    }
+
+    Report
+    reference(std::span<const std::int64_t> actual, std::span<const std::int64_t> expected, std::uint64_t tolerance) {
+        Report report;
+        report.actual   = actual.size();
+        report.expected = expected.size();
+        const std::size_t common = std::min(actual.size(), expected.size());
+        for (std::size_t i = 0; i < std::max(actual.size(), expected.size()); i++) {
+            bool mismatch = true;
+            if (i < common) {
+                const std::int64_t lhs = actual[i] / ventilation::fixed::PRECISION;
+                const std::int64_t rhs = expected[i] / ventilation::fixed::PRECISION;
+                mismatch = static_cast<std::uint64_t>(lhs > rhs ? lhs - rhs : rhs - lhs) > tolerance;
+                const std::int64_t difference = actual[i] > expected[i] ? actual[i] - expected[i] : expected[i] - actual[i];
+                report.deviation = std::max(report.deviation, static_cast<std::uint64_t>(difference));
+            }
+            if (mismatch) {
+                if (not report.first) { report.first = i; }
+                report.mismatches++;
+            }
+        }
+        return report;
+    }
+
+    std::filesystem::path
+    temporary(const char* name) {
+        return std::filesystem::temp_directory_path()
+            / (std::string(name) + "-" + std::to_string(::getpid()) + ".golden");
+    }
+} // namespace
+
+RC_GTEST_PROP(
+      COMPARISON
+    , REFERENCE
+    , ()
+    )
+{
+    const std::size_t size = *rc::gen::inRange<std::size_t>(0, 3 * ventilation::comparison::CHUNK);
+    std::vector<std::int64_t> expected(size);
+    for (std::int64_t& value : expected) {
+        value = *rc::gen::inRange<std::int64_t>(-1000000000, 1000000000);
+    }
+    std::vector<std::int64_t> actual = perturbed(expected);
+    actual.resize(actual.size() - *rc::gen::inRange<std::size_t>(0, std::min<std::size_t>(3, actual.size() + 1)));
+    const std::uint64_t tolerance = *rc::gen::inRange<std::uint64_t>(0, 4);
+
+    ventilation::parallel::Pool pool(3);
+    const Report report     = ventilation::comparison::compare(actual, expected, tolerance, pool);
+    const Report expect     = reference(actual, expected, tolerance);
+    RC_ASSERT(report.actual == expect.actual);
+    RC_ASSERT(report.expected == expect.expected);
+    RC_ASSERT(report.mismatches == expect.mismatches);
+    RC_ASSERT(report.first == expect.first);
+    RC_ASSERT(report.deviation == expect.deviation);
+}
+
+RC_GTEST_PROP(
+      COMPARISON
+    , EQUALITY
+    , ()
+    )
+{
+    // A zero tolerance is operator==
+    const std::int64_t raw = *rc::gen::inRange<std::int64_t>(-100000000, 100000000);
+    const ventilation::Pressure actual[]    = {
+        ventilation::fixed::Access::make<ventilation::Pressure>(raw)
+    };
+    const ventilation::Pressure expected[]  = {
+        ventilation::fixed::Access::make<ventilation::Pressure>(raw + *rc::gen::inRange<std::int64_t>(-3000, 3000))
+    };
+    const Report report = ventilation::comparison::compare<ventilation::Pressure>(actual, expected);
+    RC_ASSERT(report.matches() == (actual[0] == expected[0]));
+}
+
+TEST(COMPARISON, TOLERANCE) {
+    const std::int64_t expected[]   = {0, 1000, 5999, -1999, std::numeric_limits<std::int64_t>::max()};
+    const std::int64_t actual[]     = {999, 2999, 3000, 1999, std::numeric_limits<std::int64_t>::min()};
+
+    const Report exact = ventilation::comparison::compare(actual, expected);
+    EXPECT_EQ(exact.mismatches, 4u);
+    EXPECT_EQ(exact.first, 1u);
+    EXPECT_EQ(exact.deviation, std::numeric_limits<std::uint64_t>::max());
+
+    // Steps of 0, 1, 2 and 2; the extremes are far beyond any tolerance
+    const Report close = ventilation::comparison::compare(actual, expected, 1);
+    EXPECT_EQ(close.mismatches, 3u);
+    EXPECT_EQ(close.first, 2u);
+    const Report loose = ventilation::comparison::compare(actual, expected, 2);
+    EXPECT_EQ(loose.mismatches, 1u);
+    EXPECT_EQ(loose.first, 4u);
+    EXPECT_EQ(ventilation::comparison::compare(actual, expected, 1000).mismatches, 1u);
+
+    const std::int64_t shorter[] = {0, 1000};
+    const Report missing = ventilation::comparison::compare(shorter, {expected, 2});
+    EXPECT_TRUE(missing.matches());
+    const Report truncated = ventilation::comparison::compare(shorter, expected);
+    EXPECT_EQ(truncated.mismatches, 3u);
+    EXPECT_EQ(truncated.first, 2u);
+}
+
+TEST(GOLDEN, ROUNDTRIP) {
+    std::vector<ventilation::Pressure> pressure;
+    std::vector<ventilation::Flow> flow;
+    for (std::size_t i = 0; i < 200000; i++) {
+        pressure.push_back(ventilation::Pressure(static_cast<float>(i % 500) * 0.05f));
+        flow.push_back(ventilation::Flow(static_cast<float>(i % 300) * 0.002f - 0.3f));
+    }
+    const Channel recorded[] = {
+          Channel::of<ventilation::Pressure>(pressure)
+        , Channel::of<ventilation::Flow>(flow)
+        , Channel::of<ventilation::Volume>({})
+    };
+    const std::filesystem::path path = temporary("roundtrip");
+    Golden::write(path, recorded);
+
+    const Golden golden(path);
+    ASSERT_EQ(golden.channels().size(), 3u);
+    EXPECT_EQ(golden.channel<ventilation::Flow>(1).size(), flow.size());
+    EXPECT_EQ(golden.channel<ventilation::Pressure>(0)[1234], pressure[1234]);
+    EXPECT_TRUE(golden.channel<ventilation::Volume>(2).empty());
+    EXPECT_THROW(golden.channel<ventilation::Volume>(0), std::invalid_argument);
+    EXPECT_THROW(golden.channel<ventilation::Volume>(3), std::out_of_range);
+
+    for (const Report& report : ventilation::comparison::compare(recorded, golden.channels())) {
+        EXPECT_TRUE(report.matches());
+    }
+
+    // One pressure sample replaced, flow drifting by 0.5 mL/s
+    pressure[150000] = ventilation::Pressure(100.0f);
+    for (ventilation::Flow& sample : flow) {
+        sample = sample + ventilation::Flow(0.0005f);
+    }
+    const Channel drifted[] = {recorded[0], Channel::of<ventilation::Flow>(flow), recorded[2]};
+    const std::vector<Report> reports = ventilation::comparison::compare(drifted, golden.channels());
+    EXPECT_EQ(reports[0].mismatches, 1u);
+    EXPECT_EQ(reports[0].first, 150000u);
+    EXPECT_GT(reports[1].mismatches, 0u);
+    EXPECT_LE(reports[1].deviation, 501u);
+    EXPECT_TRUE(ventilation::comparison::compare(drifted, golden.channels(), 1)[1].matches());
+    EXPECT_TRUE(reports[2].matches());
+
+    const Channel swapped[] = {recorded[1], recorded[0], recorded[2]};
+    EXPECT_THROW(ventilation::comparison::compare(swapped, golden.channels()), std::invalid_argument);
+    EXPECT_THROW(ventilation::comparison::compare({recorded, 2}, golden.channels()), std::invalid_argument);
+    std::filesystem::remove(path);
+}
+
+TEST(GOLDEN, INVALID) {
+    EXPECT_THROW(Golden(temporary("missing")), std::system_error);
+
+    const std::filesystem::path path = temporary("invalid");
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "NOTGOLD, definitely not a golden recording";
+    }
+    EXPECT_THROW(Golden{path}, std::invalid_argument);
+
+    const std::int64_t samples[] = {1, 2, 3};
+    const Channel channels[] = {{ventilation::alarm::Signal::flow, samples}};
+    Golden::write(path, channels);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+    EXPECT_THROW(Golden{path}, std::invalid_argument);
+    std::filesystem::remove(path);
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -102,6 +102,14 @@ TEST(MULTIPLICATION, EXCEPTION) {
             );
 }
 
+TEST(HASH, CONSISTENT) {
+    // Equal at comparison granularity, though stored differently
+    const ventilation::Compliance xs(0.0001f);
+    const ventilation::Compliance ys(0.0002f);
+    ASSERT_EQ(xs, ys);
+    EXPECT_EQ(std::hash<ventilation::Compliance>()(xs), std::hash<ventilation::Compliance>()(ys));
+}
+
 int
 main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
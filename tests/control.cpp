@@ -0,0 +1,276 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <thread>
+#include <vector>
+#include <ventilation/control.hpp>
+
+namespace {
+    using ventilation::control::Plant;
+
+    // Plant within clinical ranges; drawn inside a property
+    Plant
+    plant() {
+        return Plant{
+              ventilation::Resistance(static_cast<float>(*rc::gen::inRange(50, 250)) * 0.1f)
+            , ventilation::Compliance(static_cast<float>(*rc::gen::inRange(200, 1000)) * 0.0001f)
+            , static_cast<float>(*rc::gen::inRange(0, 50)) * 0.001f
+        };
+    }
+
+    // Tidal volume of each whole breath of a record sampled every millisecond
+    std::vector<float>
+    tidals(const ventilation::model::Waveforms& record, const ventilation::model::Settings& settings) {
+        const std::size_t length = static_cast<std::size_t>(
+                std::lround((settings.inspiration + settings.pause + settings.expiration) * 1000.0f)
+                );
+        std::vector<float> volumes;
+        for (std::size_t start = 0; start + length <= record.volume.size(); start += length) {
+            auto [lowest, highest] = std::minmax_element(
+                      record.volume.begin() + static_cast<std::ptrdiff_t>(start)
+                    , record.volume.begin() + static_cast<std::ptrdiff_t>(start + length)
+                    );
+            volumes.push_back(static_cast<float>(*highest) - static_cast<float>(*lowest));
+        }
+        return volumes;
+    }
+
+    // Controller holding a constant command, stalling at one step
+    struct Stalling {
+        std::uint64_t   steps = 0;
+        std::uint64_t   stall;
+
+        ventilation::Pressure
+        step(const ventilation::control::Sample&, float) {
+            if (steps++ == stall) { std::this_thread::sleep_for(std::chrono::milliseconds(5)); }
+            return ventilation::Pressure(10.0f);
+        }
+    };
+} // namespace
+
+RC_GTEST_PROP(
+      LUNG
+    , EXACT
+    , ()
+    )
+{
+    // Steps hold the command exactly, so their length does not matter
+    const Plant p = plant();
+    const ventilation::Pressure command(static_cast<float>(*rc::gen::inRange(0, 400)) * 0.1f);
+    ventilation::control::Lung fine(p);
+    ventilation::control::Lung coarse(p);
+    for (int i = 0; i < 100; i++) {
+        fine.step(command, 0.001f);
+    }
+    coarse.step(command, 0.1f);
+    RC_ASSERT(std::abs(static_cast<float>(fine.sample().volume) - static_cast<float>(coarse.sample().volume)) < 1e-4f);
+    RC_ASSERT(std::abs(static_cast<float>(fine.sample().pressure) - static_cast<float>(coarse.sample().pressure)) < 1e-3f);
+
+    // and the lung settles at compliance * command with no flow
+    coarse.step(command, 100.0f);
+    const float settled = static_cast<float>(p.compliance) * static_cast<float>(command);
+    RC_ASSERT(std::abs(static_cast<float>(coarse.sample().volume) - settled) < 1e-4f);
+    RC_ASSERT(std::abs(static_cast<float>(coarse.sample().flow)) < 1e-3f);
+}
+
+TEST(LUNG, MATCHED) {
+    // A blower as slow as the lung takes the limit of the general solution
+    const Plant matched{ventilation::Resistance(10.0f), ventilation::Compliance(0.05f), 0.5f};
+    const Plant near{ventilation::Resistance(10.0f), ventilation::Compliance(0.05f), 0.5001f};
+    ventilation::control::Lung lhs(matched);
+    ventilation::control::Lung rhs(near);
+    lhs.step(ventilation::Pressure(20.0f), 0.4f);
+    rhs.step(ventilation::Pressure(20.0f), 0.4f);
+    EXPECT_NEAR(static_cast<float>(lhs.sample().volume), static_cast<float>(rhs.sample().volume), 1e-4f);
+    EXPECT_GT(static_cast<float>(lhs.sample().volume), 0.0f);
+}
+
+TEST(PID, WINDUP) {
+    ventilation::control::Pid pid({1.0f, 10.0f, 0.0f}, -5.0f, 5.0f);
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(pid.update(100.0f, 0.01f), 5.0f);
+    }
+    // The integral stopped at the limit, so a reversed error leaves it at once
+    EXPECT_LT(pid.update(-1.0f, 0.01f), 5.0f);
+    pid.reset();
+    EXPECT_FLOAT_EQ(pid.update(1.0f, 0.01f), 1.1f);
+}
+
+TEST(CONTROLLER, PRESSURE) {
+    const ventilation::model::Settings settings;
+    ventilation::control::Lung lung(Plant{ventilation::Resistance(10.0f), ventilation::Compliance(0.05f)});
+    ventilation::control::PressureControl controller(settings, ventilation::Pressure(15.0f), ventilation::Pressure(5.0f));
+
+    ventilation::control::Options options;
+    options.steps = 3 * 3200;
+    ventilation::control::Timing timing;
+    ventilation::model::Waveforms record;
+    const ventilation::control::Delivery delivery = ventilation::control::run(controller, lung, options, timing, &record);
+    EXPECT_LT(static_cast<float>(delivery.peak), 21.5f);
+    // Overshoot of the last breath, end of its inspiration and expiration
+    EXPECT_LT(*std::max_element(record.pressure.begin() + 2 * 3200, record.pressure.end()), ventilation::Pressure(21.0f));
+    EXPECT_NEAR(static_cast<float>(record.pressure[2 * 3200 + 1198]), 20.0f, 0.05f);
+    EXPECT_NEAR(static_cast<float>(record.pressure[3 * 3200 - 1]), 5.0f, 0.05f);
+    EXPECT_EQ(timing.steps, options.steps);
+    EXPECT_EQ(timing.latency.count(), options.steps);
+    EXPECT_EQ(timing.response.count(), 0u);
+    EXPECT_EQ(timing.misses, 0u);
+}
+
+RC_GTEST_PROP(
+      CONTROLLER
+    , VOLUME
+    , ()
+    )
+{
+    const ventilation::model::Settings settings;
+    // The default gains are tuned for a blower that lags
+    Plant p = plant();
+    p.lag = std::max(p.lag, 0.01f);
+    const ventilation::Volume tidal(static_cast<float>(*rc::gen::inRange(300, 600)) * 0.001f);
+    ventilation::control::Lung lung(p);
+    ventilation::control::VolumeControl controller(settings, tidal, ventilation::Pressure(5.0f));
+
+    ventilation::control::Options options;
+    options.steps = 3 * 3200;
+    ventilation::control::Timing timing;
+    ventilation::model::Waveforms record;
+    ventilation::control::run(controller, lung, options, timing, &record);
+    // The first breath also fills the lung up to PEEP
+    const std::vector<float> volumes = tidals(record, settings);
+    for (std::size_t breath = 1; breath < volumes.size(); breath++) {
+        const float delivered = volumes[breath];
+        RC_ASSERT(std::abs(delivered - static_cast<float>(tidal)) < 0.02f * static_cast<float>(tidal));
+    }
+}
+
+RC_GTEST_PROP(
+      CONTROLLER
+    , ADAPTIVE
+    , ()
+    )
+{
+    const ventilation::model::Settings settings;
+    const Plant p = plant();
+    ventilation::control::Lung lung(p);
+    ventilation::control::Adaptive controller(
+              settings
+            , ventilation::Volume(0.4f)
+            , ventilation::Pressure(5.0f)
+            , ventilation::Pressure(10.0f)
+            );
+
+    ventilation::control::Options options;
+    options.steps = 3200;
+    ventilation::control::Timing timing;
+    ventilation::model::Waveforms record;
+    float previous = static_cast<float>(controller.inspiratory());
+    for (int breath = 0; breath < 25; breath++) {
+        ventilation::control::run(controller, lung, options, timing, &record);
+        const float current = static_cast<float>(controller.inspiratory());
+        RC_ASSERT(std::abs(current - previous) <= 3.0f + 1e-4f);
+        previous = current;
+    }
+    const std::vector<float> volumes = tidals(record, settings);
+    RC_ASSERT(std::abs(volumes.back() - 0.4f) < 0.01f);
+}
+
+TEST(RUNNER, REALTIME) {
+    ventilation::control::Lung lung(Plant{ventilation::Resistance(10.0f), ventilation::Compliance(0.05f)});
+    Stalling controller{0, 10};
+
+    ventilation::control::Options options;
+    options.period  = 0.002f;
+    options.steps   = 40;
+    options.mode    = ventilation::control::Mode::realtime;
+    ventilation::control::Timing timing;
+
+    const auto start = std::chrono::steady_clock::now();
+    ventilation::control::run(controller, lung, options, timing);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(78));
+    EXPECT_EQ(timing.steps, 40u);
+    EXPECT_EQ(timing.response.count(), 40u);
+    // The stalled step misses, and so does the next one released meanwhile
+    EXPECT_GE(timing.misses, 2u);
+    EXPECT_GE(timing.latency.maximum(), 5000000u);
+    EXPECT_GE(timing.response.quantile(1.0), timing.latency.quantile(1.0));
+}
+
+TEST(RUNNER, VALIDATE) {
+    const ventilation::model::Settings settings;
+    std::vector<Plant> plants;
+    for (int r = 5; r <= 25; r += 5) {
+        for (int c = 2; c <= 10; c++) {
+            plants.push_back(Plant{ventilation::Resistance(static_cast<float>(r)), ventilation::Compliance(0.01f * static_cast<float>(c))});
+        }
+    }
+    auto make = [&](const Plant&) {
+        return ventilation::control::Adaptive(settings, ventilation::Volume(0.5f), ventilation::Pressure(5.0f), ventilation::Pressure(10.0f));
+    };
+    ventilation::control::Options options;
+    options.steps   = 10 * 3200;
+    options.mode    = ventilation::control::Mode::realtime;
+
+    ventilation::parallel::Pool pool(3);
+    ventilation::control::Timing timing;
+    const std::vector<ventilation::control::Delivery> deliveries = ventilation::control::validate(
+              std::span<const Plant>(plants)
+            , make
+            , options
+            , timing
+            , pool
+            );
+    ASSERT_EQ(deliveries.size(), plants.size());
+    EXPECT_EQ(timing.steps, plants.size() * options.steps);
+    EXPECT_EQ(timing.latency.count(), timing.steps);
+    EXPECT_EQ(timing.response.count(), 0u);
+
+    // Each delivery is that of the same run alone
+    for (std::size_t i : {std::size_t{0}, plants.size() / 2, plants.size() - 1}) {
+        ventilation::control::Lung lung(plants[i]);
+        auto controller = make(plants[i]);
+        ventilation::control::Options fast = options;
+        fast.mode = ventilation::control::Mode::fast;
+        ventilation::control::Timing alone;
+        const ventilation::control::Delivery delivery = ventilation::control::run(controller, lung, fast, alone);
+        EXPECT_EQ(deliveries[i].peak, delivery.peak);
+        EXPECT_EQ(deliveries[i].highest, delivery.highest);
+        EXPECT_EQ(deliveries[i].last.volume, delivery.last.volume);
+    }
+}
+
+TEST(RUNNER, INVALID) {
+    EXPECT_THROW(
+              ventilation::control::Lung(Plant{ventilation::Resistance(0.0f), ventilation::Compliance(0.05f)})
+            , std::invalid_argument
+            );
+    EXPECT_THROW(
+              ventilation::control::Lung(Plant{ventilation::Resistance(10.0f), ventilation::Compliance(0.05f), -0.01f})
+            , std::invalid_argument
+            );
+    EXPECT_THROW(ventilation::control::Pid({1.0f, -1.0f, 0.0f}, -1.0f, 1.0f), std::invalid_argument);
+    EXPECT_THROW(ventilation::control::Pid({1.0f, 1.0f, 0.0f}, 1.0f, -1.0f), std::invalid_argument);
+
+    ventilation::control::Lung lung(Plant{ventilation::Resistance(10.0f), ventilation::Compliance(0.05f)});
+    EXPECT_THROW(lung.step(ventilation::Pressure(10.0f), 0.0f), std::domain_error);
+
+    Stalling controller{0, 1000};
+    ventilation::control::Timing timing;
+    ventilation::control::Options options;
+    options.steps   = 1;
+    options.period  = -0.001f;
+    EXPECT_THROW(ventilation::control::run(controller, lung, options, timing), std::domain_error);
+    options.period      = 0.001f;
+    options.deadline    = std::chrono::nanoseconds(-1);
+    EXPECT_THROW(ventilation::control::run(controller, lung, options, timing), std::invalid_argument);
+    EXPECT_EQ(timing.steps, 0u);
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
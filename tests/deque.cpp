@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <ventilation/deque.hpp>
+
+TEST(DEQUE, ORDER) {
+    ventilation::parallel::Deque<int> deque(2);
+    EXPECT_FALSE(deque.pop());
+    EXPECT_FALSE(deque.steal());
+
+    // Grows past the initial capacity
+    for (int i = 0; i < 10; i++) { deque.push(i); }
+    EXPECT_EQ(deque.size(), 10);
+    EXPECT_EQ(deque.pop(), 9);
+    EXPECT_EQ(deque.steal(), 0);
+    EXPECT_EQ(deque.pop(), 8);
+    EXPECT_EQ(deque.steal(), 1);
+    EXPECT_EQ(deque.size(), 6);
+
+    for (int i = 7; i >= 2; i--) { EXPECT_EQ(deque.pop(), i); }
+    EXPECT_TRUE(deque.empty());
+    EXPECT_FALSE(deque.pop());
+}
+
+TEST(DEQUE, CAPACITY) {
+    EXPECT_THROW(ventilation::parallel::Deque<int>(0), std::invalid_argument);
+    EXPECT_THROW(ventilation::parallel::Deque<int>(3), std::invalid_argument);
+}
+
+TEST(DEQUE, CONCURRENT) {
+    // The owner pushes and pops while thieves steal; every item is taken once
+    constexpr int items     = 200000;
+    constexpr int thieves   = 3;
+
+    ventilation::parallel::Deque<int> deque(4);
+    std::vector<std::atomic<int>> taken(items);
+    std::atomic<bool> done = false;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thieves; t++) {
+        threads.emplace_back([&] {
+            while (not done.load() or not deque.empty()) {
+                if (std::optional<int> item = deque.steal()) { taken[*item]++; }
+            }
+        });
+    }
+    for (int i = 0; i < items; i++) {
+        deque.push(i);
+        if (i % 3 == 0) {
+            if (std::optional<int> item = deque.pop()) { taken[*item]++; }
+        }
+    }
+    while (std::optional<int> item = deque.pop()) { taken[*item]++; }
+    done = true;
+    for (std::thread& thread : threads) { thread.join(); }
+
+    for (int i = 0; i < items; i++) {
+        ASSERT_EQ(taken[i].load(), 1) << "item " << i;
+    }
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -103,6 +103,14 @@ TEST(MULTIPLICATION, EXCEPTION) {
 }
 
 
+TEST(HASH, CONSISTENT) {
+    // Equal at comparison granularity, though stored differently
+    const ventilation::Elastance xs(0.0001f);
+    const ventilation::Elastance ys(0.0002f);
+    ASSERT_EQ(xs, ys);
+    EXPECT_EQ(std::hash<ventilation::Elastance>()(xs), std::hash<ventilation::Elastance>()(ys));
+}
+
 int
 main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
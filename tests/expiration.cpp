@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <vector>
+#include <ventilation/expiration.hpp>
+
+namespace {
+    constexpr float PERIOD = 0.001f;
+
+    struct Recording {
+        std::vector<ventilation::Flow>      flow;
+        std::vector<ventilation::Volume>    volume;
+        std::vector<std::size_t>            boundaries;
+    };
+
+    // Half a second of inspiration at 1 L/s, then passive exhalation for
+    // `expiration` seconds with time constant tau towards `relaxation`
+    void
+    breath(Recording& recording, float tau, float expiration, float relaxation = 1.0f) {
+        recording.boundaries.push_back(recording.flow.size());
+        float volume = recording.volume.empty() ? relaxation : static_cast<float>(recording.volume.back());
+        for (int i = 0; i < 500; i++) {
+            volume += 1.0f * PERIOD;
+            recording.flow.push_back(ventilation::Flow(1.0f));
+            recording.volume.push_back(ventilation::Volume(volume));
+        }
+        const double start = volume - relaxation;
+        const int samples = static_cast<int>(std::lround(expiration / PERIOD));
+        for (int i = 1; i <= samples; i++) {
+            const double above = start * std::exp(-static_cast<double>(i) * PERIOD / tau);
+            recording.flow.push_back(ventilation::Flow(static_cast<float>(-above / tau)));
+            recording.volume.push_back(ventilation::Volume(static_cast<float>(relaxation + above)));
+        }
+    }
+} // namespace
+
+TEST(FIT, TRAPPED) {
+    // R = 10 cmH2O.s/L, C = 0.05 L/cmH2O
+    Recording recording;
+    breath(recording, 0.5f, 1.0f);
+
+    const ventilation::Compliance compliance(0.05f);
+    const ventilation::expiration::Estimate estimate = ventilation::expiration::fit(
+            recording.flow
+            , recording.volume
+            , PERIOD
+            , compliance
+            );
+    const float trapped = 0.5f * std::exp(-2.0f);
+    EXPECT_NEAR(estimate.tau, 0.5f, 0.005f);
+    EXPECT_NEAR(static_cast<float>(estimate.resistance), 10.0f, 0.1f);
+    EXPECT_NEAR(static_cast<float>(estimate.trapped), trapped, 1e-3f);
+    EXPECT_NEAR(static_cast<float>(estimate.intrinsic), trapped / 0.05f, 0.02f);
+    EXPECT_NEAR(static_cast<float>(estimate.end), -trapped / 0.5f, 1e-3f);
+    EXPECT_EQ(estimate.samples, 900u);
+}
+
+TEST(FIT, EXHALED) {
+    Recording recording;
+    breath(recording, 0.3f, 3.0f);
+
+    const ventilation::expiration::Estimate estimate = ventilation::expiration::fit(
+            recording.flow
+            , recording.volume
+            , PERIOD
+            , ventilation::Compliance(0.03f)
+            );
+    EXPECT_NEAR(estimate.tau, 0.3f, 0.003f);
+    EXPECT_NEAR(static_cast<float>(estimate.trapped), 0.0f, 1e-3f);
+    EXPECT_NEAR(static_cast<float>(estimate.intrinsic), 0.0f, 0.05f);
+}
+
+TEST(FIT, SHORT) {
+    Recording recording;
+    breath(recording, 0.5f, 0.102f);
+
+    const ventilation::expiration::Estimate estimate = ventilation::expiration::fit(
+            recording.flow
+            , recording.volume
+            , PERIOD
+            , ventilation::Compliance(0.05f)
+            );
+    EXPECT_EQ(estimate.samples, 2u);
+    EXPECT_EQ(estimate.tau, 0.0f);
+    EXPECT_EQ(estimate.trapped, ventilation::Volume(0.0f));
+    EXPECT_EQ(estimate.intrinsic, ventilation::Pressure(0.0f));
+}
+
+TEST(FIT, INVALID) {
+    const std::vector<ventilation::Flow> flow(4);
+    const std::vector<ventilation::Volume> volume(3);
+    const std::vector<ventilation::Volume> matching(4);
+    const ventilation::Compliance compliance(0.05f);
+    ventilation::expiration::Window negative;
+    negative.delay = -1.0f;
+
+    EXPECT_THROW(ventilation::expiration::fit(flow, volume, PERIOD, compliance), std::invalid_argument);
+    EXPECT_THROW(ventilation::expiration::fit(flow, matching, 0.0f, compliance), std::domain_error);
+    EXPECT_THROW(ventilation::expiration::fit(flow, matching, PERIOD, ventilation::Compliance(0.0f)), std::invalid_argument);
+    EXPECT_THROW(ventilation::expiration::fit(flow, matching, PERIOD, compliance, negative), std::invalid_argument);
+
+    std::vector<ventilation::expiration::Estimate> output(1);
+    const std::vector<std::size_t> past = {0, 5};
+    EXPECT_THROW(
+            ventilation::expiration::fit(flow, matching, past, PERIOD, compliance, output)
+            , std::out_of_range
+            );
+}
+
+RC_GTEST_PROP(
+      ESTIMATOR
+    , BATCH
+    , ()
+    )
+{
+    Recording recording;
+    const std::size_t count = *rc::gen::inRange<std::size_t>(1, 20);
+    for (std::size_t i = 0; i < count; i++) {
+        const float tau         = static_cast<float>(*rc::gen::inRange(100, 1000)) * 1e-3f;
+        const float expiration  = static_cast<float>(*rc::gen::inRange(50, 3000)) * 1e-3f;
+        breath(recording, tau, expiration);
+    }
+    recording.boundaries.push_back(recording.flow.size());
+
+    const ventilation::Compliance compliance(0.04f);
+    std::vector<ventilation::expiration::Estimate> batch(count);
+    ventilation::parallel::Pool pool(*rc::gen::inRange<std::size_t>(1, 4));
+    ventilation::expiration::fit(
+              recording.flow
+            , recording.volume
+            , recording.boundaries
+            , PERIOD
+            , compliance
+            , batch
+            , ventilation::expiration::Window()
+            , pool
+            );
+
+    ventilation::expiration::Estimator estimator(PERIOD, compliance);
+    std::vector<ventilation::expiration::Estimate> streamed;
+    for (std::size_t i = 0; i < recording.flow.size(); i++) {
+        if (std::optional<ventilation::expiration::Estimate> estimate = estimator.push(recording.flow[i], recording.volume[i])) {
+            streamed.push_back(*estimate);
+        }
+    }
+    streamed.push_back(estimator.current());
+
+    RC_ASSERT(streamed.size() == batch.size());
+    for (std::size_t i = 0; i < batch.size(); i++) {
+        RC_ASSERT(streamed[i].tau == batch[i].tau);
+        RC_ASSERT(streamed[i].resistance == batch[i].resistance);
+        RC_ASSERT(streamed[i].trapped == batch[i].trapped);
+        RC_ASSERT(streamed[i].intrinsic == batch[i].intrinsic);
+        RC_ASSERT(streamed[i].end == batch[i].end);
+        RC_ASSERT(streamed[i].samples == batch[i].samples);
+    }
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
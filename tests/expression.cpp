@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <vector>
+#include <ventilation/expression.hpp>
+
+namespace rc {
+    template <>
+    struct Arbitrary<ventilation::Pressure> {
+        static Gen<ventilation::Pressure>
+        arbitrary() {
+            const Gen<std::int32_t> value = gen::inRange(-1000, 1000);
+            return gen::construct<ventilation::Pressure>(
+                    gen::map(value, [](std::int32_t v) { return static_cast<float>(v) * 1e-3f; })
+            );
+        }
+    };
+} // namespace rc
+
+namespace {
+    std::vector<ventilation::Pressure>
+    pressures(std::size_t size) {
+        return *rc::gen::container<std::vector<ventilation::Pressure>>(
+                size
+                , rc::gen::arbitrary<ventilation::Pressure>()
+                );
+    }
+
+    template <typename E>
+    concept Additive = requires(const E& x) { x + x; x - x; -x; };
+
+    template <typename E>
+    concept Scalable = requires(const E& x) { x * 2.0f; 2.0f * x; };
+
+    // Same bits, not merely equal at comparison precision
+    bool
+    identical(const ventilation::Pressure& lhs, const ventilation::Pressure& rhs) {
+        return ventilation::fixed::Access::raw(lhs) == ventilation::fixed::Access::raw(rhs);
+    }
+} // namespace
+
+RC_GTEST_PROP(
+      ASSIGN
+    , SCALAR
+    , (const std::vector<ventilation::Pressure>& airway, const ventilation::Pressure& peep, std::int32_t factor)
+    )
+{
+    const std::vector<ventilation::Pressure> flow = pressures(airway.size());
+    float scalar = static_cast<float>(factor) * 1e-3f;
+
+    std::vector<ventilation::Pressure> output(airway.size());
+    ventilation::assign(output, ventilation::lazy(airway) - peep - scalar * ventilation::lazy(flow));
+    for (std::size_t i = 0; i < airway.size(); i++) {
+        RC_ASSERT(identical(output[i], airway[i] - peep - scalar * flow[i]));
+    }
+}
+
+RC_GTEST_PROP(
+      ASSIGN
+    , NESTED
+    , (const std::vector<ventilation::Pressure>& xs, std::int32_t factor)
+    )
+{
+    const std::vector<ventilation::Pressure> ys = pressures(xs.size());
+    const std::vector<ventilation::Pressure> zs = pressures(xs.size());
+    float scalar = static_cast<float>(factor) * 1e-3f;
+
+    std::vector<ventilation::Pressure> output(xs.size());
+    ventilation::assign(
+            output
+            , -((ventilation::lazy(xs) + ventilation::lazy(ys)) * scalar - ventilation::lazy(zs) * 0.5f)
+            );
+    for (std::size_t i = 0; i < xs.size(); i++) {
+        RC_ASSERT(identical(output[i], -((xs[i] + ys[i]) * scalar - zs[i] * 0.5f)));
+    }
+}
+
+RC_GTEST_PROP(
+      ASSIGN
+    , INPLACE
+    , (const std::vector<ventilation::Pressure>& xs, const ventilation::Pressure& offset)
+    )
+{
+    std::vector<ventilation::Pressure> values = xs;
+    ventilation::assign(values, offset + ventilation::lazy(values));
+    for (std::size_t i = 0; i < xs.size(); i++) {
+        RC_ASSERT(identical(values[i], offset + xs[i]));
+    }
+}
+
+TEST(ASSIGN, SIZE) {
+    std::vector<ventilation::Pressure> xs(3);
+    std::vector<ventilation::Pressure> ys(2);
+    std::vector<ventilation::Pressure> output(3);
+
+    EXPECT_THROW(ventilation::lazy(xs) + ventilation::lazy(ys), std::invalid_argument);
+    EXPECT_THROW(ventilation::assign(ys, ventilation::lazy(xs) * 2.0f), std::invalid_argument);
+}
+
+TEST(MULTIPLICATION, EXCEPTION) {
+    std::vector<ventilation::Pressure> xs(3);
+    EXPECT_THROW(ventilation::lazy(xs) * std::numeric_limits<float>::quiet_NaN(), std::domain_error);
+    EXPECT_THROW(std::numeric_limits<float>::infinity() * ventilation::lazy(xs), std::domain_error);
+}
+
+TEST(OPERATORS, AVAILABILITY) {
+    using Compliances = ventilation::expression::Terminal<ventilation::Compliance>;
+    using Pressures   = ventilation::expression::Terminal<ventilation::Pressure>;
+
+    EXPECT_TRUE(Additive<Pressures>);
+    EXPECT_TRUE(Scalable<Pressures>);
+    EXPECT_FALSE(Additive<Compliances>);
+    EXPECT_TRUE(Scalable<Compliances>);
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numbers>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <vector>
+#include <ventilation/fft.hpp>
+
+namespace {
+    using ventilation::fft::Complex;
+
+    std::vector<Complex>
+    direct(const std::vector<Complex>& input) {
+        const std::size_t n = input.size();
+        std::vector<Complex> output(n);
+        for (std::size_t k = 0; k < n; k++) {
+            for (std::size_t j = 0; j < n; j++) {
+                const double angle = -2.0 * std::numbers::pi * static_cast<double>((k * j) % n) / static_cast<double>(n);
+                output[k] += input[j] * std::polar(1.0, angle);
+            }
+        }
+        return output;
+    }
+
+    rc::Gen<std::vector<Complex>>
+    signal(std::size_t size) {
+        return rc::gen::container<std::vector<Complex>>(
+                size
+                , rc::gen::map(
+                    rc::gen::pair(rc::gen::inRange(-1000000, 1000000), rc::gen::inRange(-1000000, 1000000))
+                    , [](const std::pair<int, int>& v) { return Complex(v.first * 1e-3, v.second * 1e-3); }
+                    )
+                );
+    }
+} // namespace
+
+RC_GTEST_PROP(
+      PLAN
+    , DIRECT
+    , ()
+    )
+{
+    const std::size_t size = *rc::gen::inRange<std::size_t>(1, 200);
+    const std::vector<Complex> input = *signal(size);
+    const std::vector<Complex> expected = direct(input);
+
+    ventilation::fft::Plan plan(size);
+    std::vector<Complex> actual(size);
+    plan.forward(input, actual);
+    for (std::size_t k = 0; k < size; k++) {
+        RC_ASSERT(std::abs(actual[k] - expected[k]) <= 1e-6 * static_cast<double>(size) * 1000.0);
+    }
+}
+
+RC_GTEST_PROP(
+      PLAN
+    , INVERSE
+    , ()
+    )
+{
+    const std::vector<std::size_t> sizes = {1, 2, 8, 12, 60, 97, 256, 1000, 1024};
+    const std::size_t size = sizes[*rc::gen::inRange<std::size_t>(0, sizes.size())];
+    const std::vector<Complex> input = *signal(size);
+
+    ventilation::fft::Plan plan(size);
+    std::vector<Complex> spectrum(size);
+    std::vector<Complex> output(size);
+    plan.forward(input, spectrum);
+    plan.inverse(spectrum, output);
+    for (std::size_t k = 0; k < size; k++) {
+        RC_ASSERT(std::abs(output[k] - input[k]) <= 1e-9);
+    }
+}
+
+TEST(PLAN, TONE) {
+    // A cosine on bin 5 of 64 lands on bins 5 and 59, half the amplitude each
+    ventilation::fft::Plan plan(64);
+    std::vector<Complex> input(64);
+    for (std::size_t n = 0; n < 64; n++) {
+        input[n] = 2.0 * std::cos(2.0 * std::numbers::pi * 5.0 * static_cast<double>(n) / 64.0);
+    }
+    std::vector<Complex> output(64);
+    plan.forward(input, output);
+    for (std::size_t k = 0; k < 64; k++) {
+        const double expected = k == 5 or k == 59 ? 64.0 : 0.0;
+        EXPECT_NEAR(output[k].real(), expected, 1e-9) << k;
+        EXPECT_NEAR(output[k].imag(), 0.0, 1e-9) << k;
+    }
+}
+
+TEST(PLAN, INVALID) {
+    EXPECT_THROW(ventilation::fft::Plan(0), std::invalid_argument);
+
+    ventilation::fft::Plan plan(8);
+    std::vector<Complex> input(8);
+    std::vector<Complex> output(4);
+    EXPECT_THROW(plan.forward(input, output), std::invalid_argument);
+    EXPECT_THROW(plan.inverse(output, input), std::invalid_argument);
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
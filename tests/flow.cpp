@@ -56,6 +56,18 @@ TEST(COMPARISON, GE) {
     EXPECT_GE(ventilation::Flow(2.0f), ventilation::Flow(1.0f));
 }
 
+TEST(COMPARISON, POSITIVE) {
+    // Raw values below the comparison granularity compare equal to zero
+    const std::int64_t values[] = {
+          -ventilation::fixed::PRECISION, -1, 0, 1
+        , ventilation::fixed::PRECISION - 1, ventilation::fixed::PRECISION, 1000000
+    };
+    for (std::int64_t value : values) {
+        const ventilation::Flow flow = ventilation::fixed::Access::make<ventilation::Flow>(value);
+        EXPECT_EQ(ventilation::fixed::positive(value), flow > ventilation::Flow()) << value;
+    }
+}
+
 RC_GTEST_PROP(
       ADDITION
     , IDENTITY
@@ -166,6 +178,15 @@ TEST(MULTIPLICATION, EXCEPTION) {
             );
 }
 
+TEST(HASH, CONSISTENT) {
+    // Equal at comparison granularity, though stored differently
+    const ventilation::Flow xs(0.0001f);
+    const ventilation::Flow ys(0.0002f);
+    ASSERT_EQ(xs, ys);
+    EXPECT_EQ(std::hash<ventilation::Flow>()(xs), std::hash<ventilation::Flow>()(ys));
+    EXPECT_EQ(std::hash<ventilation::Flow>()(-xs), std::hash<ventilation::Flow>()(ventilation::Flow()));
+}
+
 int
 main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <span>
+#include <vector>
+#include <ventilation/hampel.hpp>
+
+namespace {
+    using ventilation::fixed::Access;
+
+    // Reference: re-sorts the window for every sample
+    std::int64_t
+    median(std::vector<std::int64_t> values) {
+        std::sort(values.begin(), values.end());
+        return values[(values.size() - 1) / 2];
+    }
+
+    std::int64_t
+    deviation(const std::vector<std::int64_t>& values) {
+        const std::int64_t m = median(values);
+        std::vector<std::int64_t> distances;
+        for (std::int64_t value : values) {
+            distances.push_back(value > m ? value - m : m - value);
+        }
+        return median(distances);
+    }
+
+    std::vector<ventilation::Pressure>
+    reference(const std::vector<ventilation::Pressure>& input, std::size_t half, float threshold) {
+        std::vector<ventilation::Pressure> output(input);
+        for (std::size_t i = half; i + half < input.size(); i++) {
+            std::vector<std::int64_t> window;
+            for (std::size_t j = i - half; j <= i + half; j++) {
+                window.push_back(Access::raw(input[j]));
+            }
+            const std::int64_t m = median(window);
+            const double distance = std::abs(static_cast<double>(Access::raw(input[i])) - static_cast<double>(m));
+            if (distance > static_cast<double>(threshold) * 1.4826 * static_cast<double>(deviation(window))) {
+                output[i] = Access::make<ventilation::Pressure>(m);
+            }
+        }
+        return output;
+    }
+
+    std::vector<ventilation::Pressure>
+    breathing(std::size_t samples) {
+        std::vector<ventilation::Pressure> pressure;
+        for (std::size_t n = 0; n < samples; n++) {
+            const double t = static_cast<double>(n) * 0.005;
+            pressure.push_back(ventilation::Pressure(static_cast<float>(10.0 + 5.0 * std::sin(0.5 * std::numbers::pi * t))));
+        }
+        return pressure;
+    }
+} // namespace
+
+RC_GTEST_PROP(
+      WINDOW
+    , REFERENCE
+    , ()
+    )
+{
+    const std::size_t capacity  = *rc::gen::inRange<std::size_t>(1, 40);
+    const std::size_t pushes    = *rc::gen::inRange<std::size_t>(1, 200);
+    // Narrow range, so ties are common
+    const std::vector<int> values = *rc::gen::container<std::vector<int>>(pushes, rc::gen::inRange(-20, 20));
+
+    ventilation::hampel::Window window(capacity);
+    std::vector<std::int64_t> history;
+    for (int value : values) {
+        window.push(value);
+        history.push_back(value);
+
+        const std::size_t size = std::min(history.size(), capacity);
+        RC_ASSERT(window.size() == size);
+        std::vector<std::int64_t> latest(history.end() - static_cast<std::ptrdiff_t>(size), history.end());
+        std::vector<std::int64_t> sorted(latest);
+        std::sort(sorted.begin(), sorted.end());
+        for (std::size_t rank = 0; rank < size; rank++) {
+            RC_ASSERT(window.select(rank) == sorted[rank]);
+        }
+        for (std::size_t age = 0; age < size; age++) {
+            RC_ASSERT(window.back(age) == latest[size - 1 - age]);
+        }
+        for (int lower = -21; lower <= 21; lower += 3) {
+            for (int upper = lower - 1; upper <= 21; upper += 4) {
+                const auto inside = std::count_if(latest.begin(), latest.end(), [&](std::int64_t v) {
+                    return v >= lower and v <= upper;
+                });
+                RC_ASSERT(window.count(lower, upper) == static_cast<std::size_t>(inside));
+            }
+        }
+        RC_ASSERT(window.median() == median(latest));
+        RC_ASSERT(window.deviation() == deviation(latest));
+    }
+}
+
+RC_GTEST_PROP(
+      FILTER
+    , REFERENCE
+    , ()
+    )
+{
+    const std::size_t half      = *rc::gen::inRange<std::size_t>(1, 8);
+    const std::size_t samples   = *rc::gen::inRange<std::size_t>(0, 300);
+    const std::vector<int> raw  = *rc::gen::container<std::vector<int>>(samples, rc::gen::inRange(-5000, 5000));
+    const float threshold       = static_cast<float>(*rc::gen::inRange(0, 40)) * 0.1f;
+
+    std::vector<ventilation::Pressure> input;
+    for (int value : raw) {
+        input.push_back(Access::make<ventilation::Pressure>(static_cast<std::int64_t>(value) * 1000));
+    }
+    const std::vector<ventilation::Pressure> expected = reference(input, half, threshold);
+
+    std::vector<ventilation::Pressure> output(samples);
+    ventilation::hampel::filter<ventilation::Pressure>(input, output, half, threshold);
+    RC_ASSERT(output == expected);
+}
+
+TEST(FILTER, SPIKES) {
+    std::vector<ventilation::Pressure> input = breathing(2000);
+    const std::vector<ventilation::Pressure> clean = input;
+    for (std::size_t n : {100u, 101u, 700u, 1500u}) {
+        input[n] = ventilation::Pressure(60.0f);
+    }
+
+    ventilation::hampel::Filter<ventilation::Pressure> filter(5);
+    std::vector<ventilation::Pressure> output;
+    for (const ventilation::Pressure& value : input) {
+        if (std::optional<ventilation::Pressure> result = filter.push(value)) {
+            output.push_back(*result);
+        }
+    }
+    EXPECT_EQ(output.size(), input.size() - 5);
+    filter.flush(output);
+    ASSERT_EQ(output.size(), input.size());
+
+    EXPECT_EQ(filter.replaced(), 4u);
+    for (std::size_t n = 0; n < output.size(); n++) {
+        if (n == 100 or n == 101 or n == 700 or n == 1500) {
+            EXPECT_NEAR(static_cast<float>(output[n]), static_cast<float>(clean[n]), 0.1f) << n;
+        } else {
+            EXPECT_EQ(output[n], clean[n]) << n;
+        }
+    }
+}
+
+TEST(FILTER, SHORT) {
+    // Fewer samples than a window: everything passes unchanged
+    const std::vector<ventilation::Pressure> input = {
+        ventilation::Pressure(1.0f), ventilation::Pressure(90.0f), ventilation::Pressure(1.0f)
+    };
+    ventilation::hampel::Filter<ventilation::Pressure> filter(3);
+    std::vector<ventilation::Pressure> output;
+    for (const ventilation::Pressure& value : input) {
+        EXPECT_FALSE(filter.push(value).has_value());
+    }
+    filter.flush(output);
+    EXPECT_EQ(output, input);
+    EXPECT_EQ(filter.replaced(), 0u);
+}
+
+TEST(FILTER, CHANNELS) {
+    std::vector<std::vector<ventilation::Pressure>> channels;
+    for (std::size_t c = 0; c < 13; c++) {
+        std::vector<ventilation::Pressure> channel = breathing(1000 + 37 * c);
+        for (std::size_t n = c; n < channel.size(); n += 97) {
+            channel[n] = ventilation::Pressure(-40.0f);
+        }
+        channels.push_back(std::move(channel));
+    }
+
+    std::vector<std::vector<ventilation::Pressure>> expected;
+    std::uint64_t replaced = 0;
+    for (const std::vector<ventilation::Pressure>& channel : channels) {
+        std::vector<ventilation::Pressure> output(channel.size());
+        replaced += ventilation::hampel::filter<ventilation::Pressure>(channel, output, 4);
+        expected.push_back(std::move(output));
+    }
+    EXPECT_GT(replaced, 0u);
+
+    std::vector<std::vector<ventilation::Pressure>> actual;
+    std::vector<std::span<const ventilation::Pressure>> inputs;
+    std::vector<std::span<ventilation::Pressure>> outputs;
+    for (const std::vector<ventilation::Pressure>& channel : channels) {
+        actual.emplace_back(channel.size());
+        inputs.push_back(channel);
+    }
+    for (std::vector<ventilation::Pressure>& output : actual) {
+        outputs.push_back(output);
+    }
+
+    ventilation::parallel::Pool pool(3);
+    EXPECT_EQ(
+            ventilation::hampel::filter<ventilation::Pressure>(inputs, outputs, 4, 3.0f, pool)
+            , replaced
+            );
+    EXPECT_EQ(actual, expected);
+}
+
+TEST(FILTER, INVALID) {
+    EXPECT_THROW(ventilation::hampel::Window(0), std::invalid_argument);
+    EXPECT_THROW(ventilation::hampel::Filter<ventilation::Flow>(0), std::invalid_argument);
+    EXPECT_THROW(ventilation::hampel::Filter<ventilation::Flow>(2, -1.0f), std::invalid_argument);
+    EXPECT_THROW(ventilation::hampel::Filter<ventilation::Flow>(2, NAN), std::invalid_argument);
+
+    ventilation::hampel::Window window(4);
+    EXPECT_THROW(window.select(0), std::out_of_range);
+    window.push(1);
+    EXPECT_THROW(window.select(1), std::out_of_range);
+    EXPECT_THROW(window.back(1), std::out_of_range);
+
+    std::vector<ventilation::Flow> input(10);
+    std::vector<ventilation::Flow> output(9);
+    EXPECT_THROW(
+            ventilation::hampel::filter<ventilation::Flow>(input, output, 2)
+            , std::invalid_argument
+            );
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <ventilation/instrumentation.hpp>
+#include <ventilation/ventilation.hpp>
+
+using ventilation::instrumentation::Counter;
+
+TEST(SNAPSHOT, DOMAIN) {
+    ventilation::instrumentation::reset();
+    EXPECT_ANY_THROW(ventilation::Flow(std::numeric_limits<float>::quiet_NaN()));
+    EXPECT_ANY_THROW(ventilation::Pressure() * std::numeric_limits<float>::infinity());
+
+    std::uint64_t expected = ventilation::instrumentation::ENABLED ? 2 : 0;
+    EXPECT_EQ(ventilation::instrumentation::snapshot()[Counter::domain], expected);
+}
+
+TEST(SNAPSHOT, OVERFLOW) {
+    ventilation::instrumentation::reset();
+    ventilation::Volume volume = ventilation::Volume(1e6f) * 1e6f;
+    (void)volume;
+
+    std::uint64_t expected = ventilation::instrumentation::ENABLED ? 1 : 0;
+    EXPECT_EQ(ventilation::instrumentation::snapshot()[Counter::overflow], expected);
+}
+
+TEST(SNAPSHOT, THREADS) {
+    ventilation::instrumentation::reset();
+    std::thread worker([]() {
+        for (int i = 0; i < 100; i++) {
+            EXPECT_ANY_THROW(ventilation::Flow(std::numeric_limits<float>::infinity()));
+        }
+    });
+    worker.join();
+
+    std::uint64_t expected = ventilation::instrumentation::ENABLED ? 100 : 0;
+    EXPECT_EQ(ventilation::instrumentation::snapshot()[Counter::domain], expected);
+}
+
+TEST(SNAPSHOT, RESET) {
+    EXPECT_ANY_THROW(ventilation::Flow(std::numeric_limits<float>::infinity()));
+    ventilation::instrumentation::reset();
+    EXPECT_EQ(ventilation::instrumentation::snapshot()[Counter::domain], 0);
+}
+
+TEST(EXPORT, PROMETHEUS) {
+    ventilation::instrumentation::Snapshot snapshot;
+    snapshot.values = {1, 2, 3, 4};
+
+    std::ostringstream os;
+    ventilation::instrumentation::prometheus(os, snapshot);
+    EXPECT_NE(os.str().find("# TYPE ventilation_domain_errors_total counter\n"), std::string::npos);
+    EXPECT_NE(os.str().find("ventilation_multiplication_overflows_total 2\n"), std::string::npos);
+    EXPECT_NE(os.str().find("ventilation_saturations_total 4\n"), std::string::npos);
+}
+
+TEST(EXPORT, JSON) {
+    ventilation::instrumentation::Snapshot snapshot;
+    snapshot.values = {1, 2, 3, 4};
+
+    std::ostringstream os;
+    ventilation::instrumentation::json(os, snapshot);
+    EXPECT_EQ(
+            os.str()
+            , "{\"domain_errors\": 1, \"multiplication_overflows\": 2, \"range_errors\": 3, \"saturations\": 4}"
+            );
+}
+
+TEST(LATENCY, BUCKETS) {
+    using ventilation::instrumentation::Latency;
+    // Buckets tile the range without gaps, each within 1/64 of its values
+    for (std::size_t i = 1; i < Latency::BUCKETS; i++) {
+        EXPECT_EQ(Latency::lower(i), Latency::upper(i - 1) + 1);
+        EXPECT_LE(Latency::upper(i) - Latency::lower(i), Latency::lower(i) / 64);
+    }
+    EXPECT_EQ(Latency::upper(Latency::BUCKETS - 1), std::numeric_limits<std::uint64_t>::max());
+    for (std::uint64_t value : {0ull, 127ull, 128ull, 1000ull, 123456789ull, ~0ull}) {
+        const std::size_t i = Latency::index(value);
+        EXPECT_LE(Latency::lower(i), value);
+        EXPECT_GE(Latency::upper(i), value);
+    }
+}
+
+TEST(LATENCY, QUANTILES) {
+    ventilation::instrumentation::Latency latency;
+    EXPECT_EQ(latency.quantile(0.5), 0u);
+    for (std::uint64_t value = 1; value <= 10000; value++) {
+        latency.record(value * 100);
+    }
+    EXPECT_EQ(latency.count(), 10000u);
+    EXPECT_EQ(latency.minimum(), 100u);
+    EXPECT_EQ(latency.maximum(), 1000000u);
+    EXPECT_DOUBLE_EQ(latency.mean(), 500050.0);
+    EXPECT_EQ(latency.quantile(1.0), 1000000u);
+    EXPECT_NEAR(static_cast<double>(latency.quantile(0.5)), 500000.0, 500000.0 / 64);
+    EXPECT_NEAR(static_cast<double>(latency.quantile(0.99)), 990000.0, 990000.0 / 64);
+    EXPECT_THROW(latency.quantile(1.5), std::invalid_argument);
+
+    ventilation::instrumentation::Latency other;
+    other.record(std::chrono::microseconds(5000));
+    latency.merge(other);
+    EXPECT_EQ(latency.count(), 10001u);
+    EXPECT_EQ(latency.maximum(), 5000000u);
+    latency.reset();
+    EXPECT_EQ(latency.count(), 0u);
+    EXPECT_EQ(latency.minimum(), 0u);
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
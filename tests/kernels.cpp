@@ -0,0 +1,443 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <vector>
+#include <ventilation/kernels.hpp>
+
+namespace {
+    rc::Gen<std::vector<float>>
+    samples() {
+        return rc::gen::container<std::vector<float>>(
+                rc::gen::map(
+                    rc::gen::inRange(-1000000, 1000000)
+                    , [](std::int32_t v) { return static_cast<float>(v) * 1e-3f; }
+                    )
+                );
+    }
+} // namespace
+
+TEST(DISPATCH, REFERENCE) {
+    EXPECT_STREQ(ventilation::kernels::reference().name, "scalar");
+    EXPECT_STREQ(ventilation::kernels::available().front().name, "scalar");
+}
+
+TEST(DISPATCH, ACTIVE) {
+    const ventilation::kernels::Table& active = ventilation::kernels::active();
+    bool found = false;
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        found = found or (std::strcmp(table.name, active.name) == 0);
+    }
+    EXPECT_TRUE(found);
+}
+
+RC_GTEST_PROP(
+      FINITE
+    , REFERENCE
+    , (const std::vector<float>& xs)
+    )
+{
+    const ventilation::kernels::Table& reference = ventilation::kernels::reference();
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        RC_ASSERT(table.finite(xs.data(), xs.size()) == reference.finite(xs.data(), xs.size()));
+    }
+}
+
+RC_GTEST_PROP(
+      FORWARD
+    , REFERENCE
+    , ()
+    )
+{
+    const std::vector<float> xs = *samples();
+    const ventilation::kernels::Table& reference = ventilation::kernels::reference();
+
+    std::vector<std::int64_t> expected(xs.size());
+    reference.forward(xs.data(), expected.data(), xs.size());
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        std::vector<std::int64_t> actual(xs.size());
+        table.forward(xs.data(), actual.data(), xs.size());
+        RC_ASSERT(actual == expected);
+    }
+}
+
+RC_GTEST_PROP(
+      INVERSE
+    , REFERENCE
+    , (const std::vector<std::int64_t>& xs)
+    )
+{
+    const ventilation::kernels::Table& reference = ventilation::kernels::reference();
+
+    std::vector<float> expected(xs.size());
+    reference.inverse(xs.data(), expected.data(), xs.size());
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        std::vector<float> actual(xs.size());
+        table.inverse(xs.data(), actual.data(), xs.size());
+        RC_ASSERT(std::memcmp(actual.data(), expected.data(), xs.size() * sizeof(float)) == 0);
+    }
+}
+
+RC_GTEST_PROP(
+      SCALE
+    , REFERENCE
+    , (const std::vector<std::int64_t>& xs, std::int64_t factor)
+    )
+{
+    const ventilation::kernels::Table& reference = ventilation::kernels::reference();
+
+    std::vector<std::int64_t> expected(xs.size());
+    reference.scale(xs.data(), factor, expected.data(), xs.size());
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        std::vector<std::int64_t> actual(xs.size());
+        table.scale(xs.data(), factor, actual.data(), xs.size());
+        RC_ASSERT(actual == expected);
+    }
+}
+
+RC_GTEST_PROP(
+      COMPARE
+    , REFERENCE
+    , (const std::vector<std::int64_t>& xs)
+    )
+{
+    const std::vector<std::int64_t> ys = *rc::gen::container<std::vector<std::int64_t>>(
+            xs.size()
+            , rc::gen::arbitrary<std::int64_t>()
+            );
+    const ventilation::kernels::Table& reference = ventilation::kernels::reference();
+
+    std::vector<std::int8_t> expected(xs.size());
+    reference.compare(xs.data(), ys.data(), expected.data(), xs.size());
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        std::vector<std::int8_t> actual(xs.size());
+        table.compare(xs.data(), ys.data(), actual.data(), xs.size());
+        RC_ASSERT(actual == expected);
+    }
+}
+
+RC_GTEST_PROP(
+      SUM
+    , REFERENCE
+    , (const std::vector<std::int64_t>& xs)
+    )
+{
+    const ventilation::kernels::Table& reference = ventilation::kernels::reference();
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        RC_ASSERT(table.sum(xs.data(), xs.size()) == reference.sum(xs.data(), xs.size()));
+    }
+}
+
+RC_GTEST_PROP(
+      MOTION
+    , REFERENCE
+    , (const std::vector<std::int64_t>& flow, std::int64_t resistance, std::int64_t elastance, std::int64_t peep)
+    )
+{
+    const std::vector<std::int64_t> volume = *rc::gen::container<std::vector<std::int64_t>>(
+            flow.size()
+            , rc::gen::arbitrary<std::int64_t>()
+            );
+    const ventilation::kernels::Table& reference = ventilation::kernels::reference();
+
+    std::vector<std::int64_t> expected(flow.size());
+    reference.motion(flow.data(), volume.data(), resistance, elastance, peep, expected.data(), flow.size());
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        std::vector<std::int64_t> actual(flow.size());
+        table.motion(flow.data(), volume.data(), resistance, elastance, peep, actual.data(), flow.size());
+        RC_ASSERT(actual == expected);
+    }
+}
+
+RC_GTEST_PROP(
+      SATURATING
+    , ADD
+    , (const std::vector<std::int64_t>& xs)
+    )
+{
+    const std::vector<std::int64_t> ys = *rc::gen::container<std::vector<std::int64_t>>(
+            xs.size()
+            , rc::gen::arbitrary<std::int64_t>()
+            );
+    const ventilation::kernels::Table& reference = ventilation::kernels::reference();
+
+    std::vector<std::int64_t> expected(xs.size());
+    std::size_t saturated = reference.saturating_add(xs.data(), ys.data(), expected.data(), xs.size());
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        std::vector<std::int64_t> actual(xs.size());
+        RC_ASSERT(table.saturating_add(xs.data(), ys.data(), actual.data(), xs.size()) == saturated);
+        RC_ASSERT(actual == expected);
+    }
+}
+
+RC_GTEST_PROP(
+      SATURATING
+    , SUBTRACT
+    , (const std::vector<std::int64_t>& xs)
+    )
+{
+    const std::vector<std::int64_t> ys = *rc::gen::container<std::vector<std::int64_t>>(
+            xs.size()
+            , rc::gen::arbitrary<std::int64_t>()
+            );
+    const ventilation::kernels::Table& reference = ventilation::kernels::reference();
+
+    std::vector<std::int64_t> expected(xs.size());
+    std::size_t saturated = reference.saturating_subtract(xs.data(), ys.data(), expected.data(), xs.size());
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        std::vector<std::int64_t> actual(xs.size());
+        RC_ASSERT(table.saturating_subtract(xs.data(), ys.data(), actual.data(), xs.size()) == saturated);
+        RC_ASSERT(actual == expected);
+    }
+}
+
+RC_GTEST_PROP(
+      SATURATING
+    , SCALE
+    , (const std::vector<std::int64_t>& xs, std::int64_t factor)
+    )
+{
+    const ventilation::kernels::Table& reference = ventilation::kernels::reference();
+
+    std::vector<std::int64_t> expected(xs.size());
+    std::size_t saturated = reference.saturating_scale(xs.data(), factor, expected.data(), xs.size());
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        std::vector<std::int64_t> actual(xs.size());
+        RC_ASSERT(table.saturating_scale(xs.data(), factor, actual.data(), xs.size()) == saturated);
+        RC_ASSERT(actual == expected);
+    }
+}
+
+TEST(SATURATING, LIMITS) {
+    const std::int64_t maximum = std::numeric_limits<std::int64_t>::max();
+    const std::int64_t minimum = std::numeric_limits<std::int64_t>::min();
+    const std::vector<std::int64_t> xs = {maximum, minimum, minimum, maximum / 2 + 1, -(maximum / 2) - 2};
+    const std::int64_t factors[] = {-1, 2, -2, 0};
+
+    for (std::int64_t factor : factors) {
+        std::vector<std::int64_t> expected(xs.size());
+        ventilation::kernels::reference().saturating_scale(xs.data(), factor, expected.data(), xs.size());
+        for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+            std::vector<std::int64_t> actual(xs.size());
+            table.saturating_scale(xs.data(), factor, actual.data(), xs.size());
+            EXPECT_EQ(actual, expected) << table.name << " factor " << factor;
+        }
+    }
+}
+
+TEST(SATURATING, QUOTIENT) {
+    // Products overflowing int64 whose quotient fits are not clamped, in
+    // place as well
+    const std::int64_t maximum = std::numeric_limits<std::int64_t>::max();
+    const std::int64_t minimum = std::numeric_limits<std::int64_t>::min();
+    std::vector<std::int64_t> xs(200, 1000000);
+    xs[130] = 10000000000;
+    xs[131] = maximum;
+    xs[132] = minimum;
+    std::vector<std::int64_t> expected(xs.size(), 1000000000);
+    expected[130] = 10000000000000;
+    expected[131] = maximum;
+    expected[132] = minimum;
+
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        std::vector<std::int64_t> actual(xs.size());
+        EXPECT_EQ(table.saturating_scale(xs.data(), 1000000000, actual.data(), xs.size()), 2u) << table.name;
+        EXPECT_EQ(actual, expected) << table.name;
+
+        actual = xs;
+        table.saturating_scale(actual.data(), 1000000000, actual.data(), actual.size());
+        EXPECT_EQ(actual, expected) << table.name;
+    }
+}
+
+RC_GTEST_PROP(
+      TOTAL
+    , REFERENCE
+    , (const std::vector<std::int64_t>& xs)
+    )
+{
+    const ventilation::kernels::Table& reference = ventilation::kernels::reference();
+
+    std::int64_t high   = 0;
+    std::uint64_t low   = 0;
+    reference.total(xs.data(), xs.size(), &high, &low);
+
+    __int128 exact = 0;
+    for (std::int64_t x : xs) { exact += x; }
+    RC_ASSERT(static_cast<__int128>(high) * (__int128(1) << 32) + low == exact);
+
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        std::int64_t upper  = 0;
+        std::uint64_t lower = 0;
+        table.total(xs.data(), xs.size(), &upper, &lower);
+        RC_ASSERT(upper == high);
+        RC_ASSERT(lower == low);
+    }
+}
+
+RC_GTEST_PROP(
+      EXTREMA
+    , REFERENCE
+    , (const std::vector<std::int64_t>& xs)
+    )
+{
+    RC_PRE(not xs.empty());
+    const ventilation::kernels::Table& reference = ventilation::kernels::reference();
+
+    std::int64_t minimum = 0;
+    std::int64_t maximum = 0;
+    reference.extrema(xs.data(), xs.size(), &minimum, &maximum);
+    RC_ASSERT(minimum == *std::min_element(xs.begin(), xs.end()));
+    RC_ASSERT(maximum == *std::max_element(xs.begin(), xs.end()));
+
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        std::int64_t smallest   = 0;
+        std::int64_t largest    = 0;
+        table.extrema(xs.data(), xs.size(), &smallest, &largest);
+        RC_ASSERT(smallest == minimum);
+        RC_ASSERT(largest == maximum);
+    }
+}
+
+RC_GTEST_PROP(
+      DOT
+    , REFERENCE
+    , (const std::vector<std::int64_t>& xs)
+    )
+{
+    const std::vector<std::int64_t> ys = *rc::gen::container<std::vector<std::int64_t>>(
+            xs.size()
+            , rc::gen::inRange<std::int64_t>(-1000000000, 1000000000)
+            );
+    const ventilation::kernels::Table& reference = ventilation::kernels::reference();
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        RC_ASSERT(table.dot(xs.data(), ys.data(), xs.size()) == reference.dot(xs.data(), ys.data(), xs.size()));
+    }
+}
+
+RC_GTEST_PROP(
+      DEBOUNCE
+    , REFERENCE
+    , (const std::vector<std::int64_t>& value, bool latching)
+    )
+{
+    const std::size_t size = value.size();
+    const std::vector<std::int64_t> low = *rc::gen::container<std::vector<std::int64_t>>(
+            size
+            , rc::gen::arbitrary<std::int64_t>()
+            );
+    const std::vector<std::int64_t> high = *rc::gen::container<std::vector<std::int64_t>>(
+            size
+            , rc::gen::arbitrary<std::int64_t>()
+            );
+    const std::uint32_t debounce = *rc::gen::inRange<std::uint32_t>(1, 4);
+    const std::vector<std::uint32_t> count = *rc::gen::container<std::vector<std::uint32_t>>(
+            size
+            , rc::gen::inRange<std::uint32_t>(0, debounce + 1)
+            );
+    const std::vector<std::uint8_t> state = *rc::gen::container<std::vector<std::uint8_t>>(
+            size
+            , rc::gen::inRange<std::uint8_t>(0, 2)
+            );
+    const ventilation::kernels::Table& reference = ventilation::kernels::reference();
+
+    std::vector<std::uint32_t> expected_count = count;
+    std::vector<std::uint8_t> expected_state = state;
+    std::size_t changed = reference.debounce(
+            value.data(), low.data(), high.data(), debounce, latching, expected_count.data(), expected_state.data(), size
+            );
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        std::vector<std::uint32_t> actual_count = count;
+        std::vector<std::uint8_t> actual_state = state;
+        RC_ASSERT(table.debounce(
+                    value.data(), low.data(), high.data(), debounce, latching, actual_count.data(), actual_state.data(), size
+                    ) == changed);
+        RC_ASSERT(actual_count == expected_count);
+        RC_ASSERT(actual_state == expected_state);
+    }
+}
+
+RC_GTEST_PROP(
+      INTERPOLATE
+    , REFERENCE
+    , (const std::vector<std::int32_t>& counts)
+    )
+{
+    const std::int32_t base         = *rc::gen::inRange<std::int32_t>(-100000, 100000);
+    const std::uint32_t shift       = *rc::gen::inRange<std::uint32_t>(0, 17);
+    const std::uint32_t segments    = *rc::gen::inRange<std::uint32_t>(1, 64);
+    const std::vector<std::int64_t> knots = *rc::gen::container<std::vector<std::int64_t>>(
+            segments + 1
+            , rc::gen::inRange<std::int64_t>(-(std::int64_t(1) << 40), std::int64_t(1) << 40)
+            );
+    const ventilation::kernels::Table& reference = ventilation::kernels::reference();
+
+    std::vector<std::int64_t> expected(counts.size());
+    reference.interpolate(counts.data(), base, shift, segments, knots.data(), expected.data(), counts.size());
+    for (std::size_t i = 0; i < counts.size(); i++) {
+        RC_ASSERT(expected[i] >= *std::min_element(knots.begin(), knots.end()));
+        RC_ASSERT(expected[i] <= *std::max_element(knots.begin(), knots.end()));
+    }
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        std::vector<std::int64_t> actual(counts.size());
+        table.interpolate(counts.data(), base, shift, segments, knots.data(), actual.data(), counts.size());
+        RC_ASSERT(actual == expected);
+    }
+}
+
+TEST(INTERPOLATE, KNOTS) {
+    const std::vector<std::int64_t> knots = {-7, 5, 5, 100};
+    const std::vector<std::int32_t> counts = {-50, 10, 14, 18, 22, 26, 30, 34, 1000};
+    const std::vector<std::int64_t> expected = {-7, -7, -1, 5, 5, 5, 52, 100, 100};
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        std::vector<std::int64_t> actual(counts.size());
+        table.interpolate(counts.data(), 10, 3, 3, knots.data(), actual.data(), counts.size());
+        EXPECT_EQ(actual, expected) << table.name;
+    }
+}
+
+RC_GTEST_PROP(
+      DEVIATION
+    , REFERENCE
+    , (const std::vector<std::int64_t>& xs)
+    )
+{
+    // Near copies of xs as well as arbitrary values, so both counts occur
+    std::vector<std::int64_t> ys = *rc::gen::container<std::vector<std::int64_t>>(
+            xs.size()
+            , rc::gen::arbitrary<std::int64_t>()
+            );
+    for (std::size_t i = 0; i < xs.size(); i += 2) {
+        ys[i] = xs[i] / 2 + (ys[i] % 2000) / 2;
+    }
+    const std::uint64_t threshold = *rc::gen::inRange<std::uint64_t>(0, 3000);
+    const ventilation::kernels::Table& reference = ventilation::kernels::reference();
+
+    std::uint64_t expected  = 0;
+    const std::size_t count = reference.deviation(xs.data(), ys.data(), threshold, &expected, xs.size());
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        std::uint64_t actual = 1;
+        RC_ASSERT(table.deviation(xs.data(), ys.data(), threshold, &actual, xs.size()) == count);
+        RC_ASSERT(actual == expected);
+    }
+}
+
+TEST(DEVIATION, EXTREMES) {
+    const std::int64_t minimum = std::numeric_limits<std::int64_t>::min();
+    const std::int64_t maximum = std::numeric_limits<std::int64_t>::max();
+    const std::vector<std::int64_t> xs = {maximum, 5, -5, 1000, 0};
+    const std::vector<std::int64_t> ys = {minimum, 5, 5, 999, 0};
+    for (const ventilation::kernels::Table& table : ventilation::kernels::available()) {
+        std::uint64_t largest = 0;
+        EXPECT_EQ(table.deviation(xs.data(), ys.data(), 1, &largest, xs.size()), 2u) << table.name;
+        EXPECT_EQ(largest, std::numeric_limits<std::uint64_t>::max()) << table.name;
+    }
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <vector>
+#include <ventilation/loop.hpp>
+
+namespace {
+    std::vector<ventilation::Volume>
+    volumes(const std::vector<float>& values) {
+        std::vector<ventilation::Volume> result;
+        for (float value : values) { result.push_back(ventilation::Volume(value)); }
+        return result;
+    }
+
+    std::vector<ventilation::Pressure>
+    pressures(const std::vector<float>& values) {
+        std::vector<ventilation::Pressure> result;
+        for (float value : values) { result.push_back(ventilation::Pressure(value)); }
+        return result;
+    }
+
+    ventilation::loop::Histogram
+    grid() {
+        return ventilation::loop::Histogram(
+                {ventilation::Volume(0.0f), ventilation::Volume(1.0f), 4}
+                , {ventilation::Pressure(0.0f), ventilation::Pressure(40.0f), 8}
+                );
+    }
+} // namespace
+
+TEST(AREA, RECTANGLE) {
+    // 1 L by 10 cmH2O, 10 cmH2O.L = 0.980665 J in either direction
+    std::vector<ventilation::Volume> volume = volumes({0.0f, 1.0f, 1.0f, 0.0f});
+    std::vector<ventilation::Pressure> pressure = pressures({0.0f, 0.0f, 10.0f, 10.0f});
+    EXPECT_NEAR(static_cast<float>(ventilation::loop::area(volume, pressure)), 0.980665f, 1e-5f);
+
+    std::reverse(volume.begin(), volume.end());
+    std::reverse(pressure.begin(), pressure.end());
+    EXPECT_NEAR(static_cast<float>(ventilation::loop::area(volume, pressure)), 0.980665f, 1e-5f);
+}
+
+TEST(AREA, DEGENERATE) {
+    std::vector<ventilation::Volume> volume = volumes({0.0f, 0.5f, 1.0f});
+    std::vector<ventilation::Pressure> pressure = pressures({5.0f, 10.0f, 15.0f});
+    EXPECT_EQ(ventilation::loop::area(volume, pressure), ventilation::Work());
+    EXPECT_EQ(ventilation::loop::area({}, std::span<const ventilation::Pressure>()), ventilation::Work());
+
+    pressure.pop_back();
+    EXPECT_THROW(ventilation::loop::area(volume, pressure), std::invalid_argument);
+}
+
+TEST(AREA, BOUNDARIES) {
+    // Breaths are validated as by mechanics::analyze(), empty ones rejected
+    std::vector<ventilation::Volume> volume = volumes({0.0f, 0.5f, 1.0f, 0.5f});
+    std::vector<ventilation::Pressure> pressure = pressures({5.0f, 10.0f, 15.0f, 10.0f});
+    std::vector<ventilation::Work> output(2);
+    const std::vector<std::size_t> empty = {0, 2, 2};
+    const std::vector<std::size_t> reversed = {0, 3, 2};
+    const std::vector<std::size_t> beyond = {0, 2, 5};
+    const std::vector<std::size_t> missing = {0, 2};
+    EXPECT_THROW(ventilation::loop::area(volume, pressure, empty, output), std::invalid_argument);
+    EXPECT_THROW(ventilation::loop::area(volume, pressure, reversed, output), std::invalid_argument);
+    EXPECT_THROW(ventilation::loop::area(volume, pressure, missing, output), std::invalid_argument);
+    EXPECT_THROW(ventilation::loop::area(volume, pressure, beyond, output), std::out_of_range);
+}
+
+RC_GTEST_PROP(
+      AREA
+    , BATCH
+    , ()
+    )
+{
+    const std::size_t count = *rc::gen::inRange<std::size_t>(1, 150);
+    std::vector<ventilation::Volume> volume;
+    std::vector<ventilation::Pressure> pressure;
+    std::vector<std::size_t> boundaries = {0};
+    for (std::size_t i = 0; i < count; i++) {
+        const std::size_t size = *rc::gen::inRange<std::size_t>(1, 40);
+        for (std::size_t j = 0; j < size; j++) {
+            volume.push_back(ventilation::Volume(*rc::gen::inRange(0, 800) * 1e-3f));
+            pressure.push_back(ventilation::Pressure(*rc::gen::inRange(0, 400) * 1e-1f));
+        }
+        boundaries.push_back(volume.size());
+    }
+
+    ventilation::parallel::Pool pool(3);
+    std::vector<ventilation::Work> output(count);
+    ventilation::loop::area(volume, pressure, boundaries, output, pool);
+    for (std::size_t i = 0; i < count; i++) {
+        std::size_t offset  = boundaries[i];
+        std::size_t size    = boundaries[i + 1] - offset;
+        ventilation::Work expected = ventilation::loop::area(
+                std::span<const ventilation::Volume>(volume).subspan(offset, size)
+                , std::span<const ventilation::Pressure>(pressure).subspan(offset, size)
+                );
+        RC_ASSERT(output[i] == expected);
+    }
+}
+
+TEST(HISTOGRAM, BINS) {
+    ventilation::loop::Histogram histogram = grid();
+    std::vector<ventilation::Volume> volume = volumes({0.0f, 0.3f, 0.999f, 1.0f, -0.1f, 0.5f});
+    std::vector<ventilation::Pressure> pressure = pressures({0.0f, 12.0f, 39.0f, 10.0f, 10.0f, 40.0f});
+    histogram.accumulate(volume, pressure);
+
+    EXPECT_EQ(histogram.at(0, 0), 1);
+    EXPECT_EQ(histogram.at(1, 2), 1);
+    EXPECT_EQ(histogram.at(3, 7), 1);
+    EXPECT_EQ(histogram.outside(), 3);
+    EXPECT_EQ(histogram.total(), 6);
+    EXPECT_THROW(histogram.at(4, 0), std::out_of_range);
+    EXPECT_THROW(histogram.at(0, 8), std::out_of_range);
+}
+
+TEST(HISTOGRAM, REMAINDER) {
+    // 10 raw units over 6 bins are 2, 2, 2, 2, 1 and 1 units wide
+    ventilation::loop::Histogram histogram(
+            {ventilation::fixed::Access::make<ventilation::Volume>(0), ventilation::fixed::Access::make<ventilation::Volume>(10), 6}
+            , {ventilation::fixed::Access::make<ventilation::Pressure>(0), ventilation::fixed::Access::make<ventilation::Pressure>(3), 5}
+            );
+    std::vector<ventilation::Volume> volume;
+    std::vector<ventilation::Pressure> pressure;
+    for (std::int64_t i = 0; i < 10; i++) {
+        volume.push_back(ventilation::fixed::Access::make<ventilation::Volume>(i));
+        pressure.push_back(ventilation::fixed::Access::make<ventilation::Pressure>(i % 3));
+    }
+    histogram.accumulate(volume, pressure);
+
+    const std::uint64_t rows[] = {2, 2, 2, 2, 1, 1};
+    for (std::size_t v = 0; v < 6; v++) {
+        std::uint64_t count = 0;
+        for (std::size_t p = 0; p < 5; p++) { count += histogram.at(v, p); }
+        EXPECT_EQ(count, rows[v]) << v;
+    }
+    // Bins beyond a range narrower than the bin count stay empty
+    EXPECT_EQ(histogram.at(0, 0) + histogram.at(0, 1) + histogram.at(0, 2), 2);
+    for (std::size_t v = 0; v < 6; v++) {
+        EXPECT_EQ(histogram.at(v, 3), 0);
+        EXPECT_EQ(histogram.at(v, 4), 0);
+    }
+    EXPECT_EQ(histogram.outside(), 0);
+}
+
+TEST(HISTOGRAM, EXCEPTION) {
+    EXPECT_THROW(
+            ventilation::loop::Histogram(
+                {ventilation::Volume(0.0f), ventilation::Volume(1.0f), 0}
+                , {ventilation::Pressure(0.0f), ventilation::Pressure(40.0f), 8}
+                )
+            , std::invalid_argument
+            );
+    EXPECT_THROW(
+            ventilation::loop::Histogram(
+                {ventilation::Volume(0.0f), ventilation::Volume(1.0f), 4}
+                , {ventilation::Pressure(40.0f), ventilation::Pressure(40.0f), 8}
+                )
+            , std::invalid_argument
+            );
+
+    ventilation::loop::Histogram histogram = grid();
+    ventilation::loop::Histogram other(
+            {ventilation::Volume(0.0f), ventilation::Volume(2.0f), 4}
+            , {ventilation::Pressure(0.0f), ventilation::Pressure(40.0f), 8}
+            );
+    EXPECT_THROW(histogram.merge(other), std::invalid_argument);
+
+    std::vector<ventilation::Volume> volume(3);
+    std::vector<ventilation::Pressure> pressure(2);
+    EXPECT_THROW(histogram.accumulate(volume, pressure), std::invalid_argument);
+}
+
+TEST(HISTOGRAM, THREADS) {
+    // Several chunks, so every pool below splits the input
+    const std::size_t size = 700000;
+    std::vector<ventilation::Volume> volume;
+    std::vector<ventilation::Pressure> pressure;
+    std::uint64_t state = 1;
+    for (std::size_t i = 0; i < size; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        volume.push_back(ventilation::Volume(static_cast<float>((state >> 40) % 1200) * 1e-3f - 0.1f));
+        pressure.push_back(ventilation::Pressure(static_cast<float>((state >> 20) % 4500) * 1e-2f));
+    }
+
+    // Reference: the same samples fed sequentially, in several calls
+    ventilation::parallel::Pool sequential(1);
+    ventilation::loop::Histogram expected = grid();
+    for (std::size_t offset = 0; offset < size; offset += 100000) {
+        std::size_t count = std::min<std::size_t>(100000, size - offset);
+        expected.accumulate(
+                std::span<const ventilation::Volume>(volume).subspan(offset, count)
+                , std::span<const ventilation::Pressure>(pressure).subspan(offset, count)
+                , sequential
+                );
+    }
+    EXPECT_EQ(expected.total(), size);
+
+    for (std::size_t threads : {1, 2, 5}) {
+        ventilation::parallel::Pool pool(threads);
+        ventilation::loop::Histogram actual = grid();
+        actual.accumulate(volume, pressure, pool);
+        EXPECT_TRUE(std::ranges::equal(actual.counts(), expected.counts())) << threads << " threads";
+        EXPECT_EQ(actual.outside(), expected.outside());
+    }
+}
+
+TEST(HISTOGRAM, MERGE) {
+    std::vector<ventilation::Volume> volume = volumes({0.1f, 0.6f, 2.0f});
+    std::vector<ventilation::Pressure> pressure = pressures({1.0f, 21.0f, 5.0f});
+
+    ventilation::loop::Histogram lhs = grid();
+    ventilation::loop::Histogram rhs = grid();
+    lhs.accumulate(volume, pressure);
+    rhs.accumulate(volume, pressure);
+    lhs.merge(rhs);
+
+    EXPECT_EQ(lhs.at(0, 0), 2);
+    EXPECT_EQ(lhs.at(2, 4), 2);
+    EXPECT_EQ(lhs.outside(), 2);
+    EXPECT_EQ(lhs.total(), 6);
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
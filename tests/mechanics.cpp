@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <limits>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <vector>
+#include <ventilation/mechanics.hpp>
+
+namespace {
+    struct Recording {
+        std::vector<ventilation::Pressure>  pressure;
+        std::vector<ventilation::Flow>      flow;
+        std::vector<ventilation::Volume>    volume;
+
+        void
+        push(float f, float v, float resistance, float elastance, float peep) {
+            flow.push_back(ventilation::Flow(f));
+            volume.push_back(ventilation::Volume(v));
+            pressure.push_back(ventilation::Pressure(resistance * f + elastance * v + peep));
+        }
+
+        // Volume-controlled breath: constant inspiratory flow, an end-inspiratory
+        // pause, a linear expiration and an end-expiratory pause
+        void
+        breath(float tidal, float resistance, float elastance, float peep) {
+            const float period  = 0.02f;
+            const float flow    = tidal / (50 * period);
+            for (int i = 0; i <= 50; i++)   { push(flow, tidal * i / 50.0f, resistance, elastance, peep); }
+            for (int i = 0; i < 15; i++)    { push(0.0f, tidal, resistance, elastance, peep); }
+            for (int i = 49; i >= 0; i--)   { push(-flow, tidal * i / 50.0f, resistance, elastance, peep); }
+            for (int i = 0; i < 34; i++)    { push(0.0f, 0.0f, resistance, elastance, peep); }
+        }
+    };
+
+    bool
+    identical(const ventilation::mechanics::Breath& lhs, const ventilation::mechanics::Breath& rhs) {
+        return  std::memcmp(&lhs.work, &rhs.work, sizeof(lhs.work)) == 0
+            and std::memcmp(&lhs.power, &rhs.power, sizeof(lhs.power)) == 0
+            and std::memcmp(&lhs.peak, &rhs.peak, sizeof(lhs.peak)) == 0
+            and std::memcmp(&lhs.plateau, &rhs.plateau, sizeof(lhs.plateau)) == 0
+            and std::memcmp(&lhs.driving, &rhs.driving, sizeof(lhs.driving)) == 0;
+    }
+} // namespace
+
+TEST(ANALYZE, VOLUME_CONTROL) {
+    Recording recording;
+    recording.breath(0.5f, 10.0f, 20.0f, 5.0f);
+
+    ventilation::mechanics::Breath breath = ventilation::mechanics::analyze(
+            recording.pressure
+            , recording.flow
+            , recording.volume
+            , 0.02f
+            );
+    // Work = integral of (5 + 10 * 0.5 + 20 * V) dV over [0, 0.5] = 7.5 cmH2O.L
+    const float joules = 7.5f * 0.0980665f;
+    EXPECT_NEAR(static_cast<float>(breath.work), joules, 1e-3f);
+    EXPECT_NEAR(static_cast<float>(breath.power), joules * 60.0f / 3.0f, 1e-2f);
+    EXPECT_EQ(breath.peak, ventilation::Pressure(20.0f));
+    EXPECT_EQ(breath.plateau, ventilation::Pressure(15.0f));
+    EXPECT_EQ(breath.driving, ventilation::Pressure(10.0f));
+}
+
+TEST(ANALYZE, SINGLE) {
+    std::vector<ventilation::Pressure> pressure = {ventilation::Pressure(7.0f)};
+    std::vector<ventilation::Flow> flow = {ventilation::Flow(0.0f)};
+    std::vector<ventilation::Volume> volume = {ventilation::Volume(0.0f)};
+
+    ventilation::mechanics::Breath breath = ventilation::mechanics::analyze(pressure, flow, volume, 0.01f);
+    EXPECT_EQ(breath.work, ventilation::Work());
+    EXPECT_EQ(breath.peak, ventilation::Pressure(7.0f));
+    EXPECT_EQ(breath.driving, ventilation::Pressure());
+}
+
+TEST(ANALYZE, EXCEPTION) {
+    std::vector<ventilation::Pressure> pressure(4);
+    std::vector<ventilation::Flow> flow(4);
+    std::vector<ventilation::Volume> volume(3);
+    std::vector<ventilation::Volume> empty;
+
+    EXPECT_THROW(ventilation::mechanics::analyze(pressure, flow, volume, 0.01f), std::invalid_argument);
+    volume.resize(4);
+    EXPECT_THROW(
+            ventilation::mechanics::analyze({}, std::span<const ventilation::Flow>(), empty, 0.01f)
+            , std::invalid_argument
+            );
+    EXPECT_THROW(ventilation::mechanics::analyze(pressure, flow, volume, 0.0f), std::domain_error);
+    EXPECT_THROW(
+            ventilation::mechanics::analyze(pressure, flow, volume, std::numeric_limits<float>::quiet_NaN())
+            , std::domain_error
+            );
+
+    std::vector<ventilation::mechanics::Breath> output(2);
+    std::vector<std::size_t> unordered = {0, 3, 3};
+    std::vector<std::size_t> past = {0, 3, 5};
+    std::vector<std::size_t> missing = {0, 4};
+    EXPECT_THROW(ventilation::mechanics::analyze(pressure, flow, volume, unordered, 0.01f, output), std::invalid_argument);
+    EXPECT_THROW(ventilation::mechanics::analyze(pressure, flow, volume, past, 0.01f, output), std::out_of_range);
+    EXPECT_THROW(ventilation::mechanics::analyze(pressure, flow, volume, missing, 0.01f, output), std::invalid_argument);
+}
+
+RC_GTEST_PROP(
+      BATCH
+    , SEQUENTIAL
+    , ()
+    )
+{
+    const std::size_t count = *rc::gen::inRange<std::size_t>(1, 200);
+
+    Recording recording;
+    std::vector<std::size_t> boundaries = {0};
+    for (std::size_t i = 0; i < count; i++) {
+        float tidal         = *rc::gen::inRange(200, 800) * 1e-3f;
+        float resistance    = *rc::gen::inRange(5, 30);
+        float elastance     = *rc::gen::inRange(10, 50);
+        float peep          = *rc::gen::inRange(0, 15);
+        recording.breath(tidal, resistance, elastance, peep);
+        boundaries.push_back(recording.pressure.size());
+    }
+
+    for (std::size_t threads : {1, 3}) {
+        ventilation::parallel::Pool pool(threads);
+        std::vector<ventilation::mechanics::Breath> output(count);
+        ventilation::mechanics::analyze(
+                recording.pressure
+                , recording.flow
+                , recording.volume
+                , boundaries
+                , 0.02f
+                , output
+                , pool
+                );
+        for (std::size_t i = 0; i < count; i++) {
+            std::size_t offset  = boundaries[i];
+            std::size_t size    = boundaries[i + 1] - offset;
+            ventilation::mechanics::Breath expected = ventilation::mechanics::analyze(
+                    std::span<const ventilation::Pressure>(recording.pressure).subspan(offset, size)
+                    , std::span<const ventilation::Flow>(recording.flow).subspan(offset, size)
+                    , std::span<const ventilation::Volume>(recording.volume).subspan(offset, size)
+                    , 0.02f
+                    );
+            RC_ASSERT(identical(output[i], expected));
+            RC_ASSERT(output[i].peak >= output[i].plateau);
+        }
+    }
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
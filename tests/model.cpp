@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <unordered_set>
+#include <ventilation/model.hpp>
+
+namespace {
+    ventilation::model::Parameters
+    parameters(float resistance, float compliance, float peep, float tidal) {
+        return {
+              ventilation::Resistance(resistance)
+            , ventilation::Compliance(compliance)
+            , ventilation::Pressure(peep)
+            , ventilation::Volume(tidal)
+        };
+    }
+} // namespace
+
+TEST(MODEL, BREATH) {
+    const ventilation::model::Settings settings;
+    const ventilation::model::Parameters p = parameters(10.0f, 0.05f, 5.0f, 0.5f);
+
+    ventilation::mechanics::Breath breath = ventilation::model::breath(p, settings);
+    // Plateau = 0.5 / 0.05 + 5, peak adds 10 * 0.5 L/s of resistive pressure
+    EXPECT_EQ(breath.plateau, ventilation::Pressure(15.0f));
+    EXPECT_EQ(breath.driving, ventilation::Pressure(10.0f));
+    EXPECT_NEAR(static_cast<float>(breath.peak), 20.0f, 0.01f);
+    EXPECT_NEAR(static_cast<float>(ventilation::model::peak(p, settings)), 20.0f, 0.01f);
+    EXPECT_GT(breath.work, ventilation::Work());
+}
+
+TEST(MODEL, WAVEFORMS) {
+    ventilation::model::Settings settings;
+    settings.inspiration    = 0.5f;
+    settings.pause          = 0.1f;
+    settings.expiration     = 1.0f;
+    settings.period         = 0.1f;
+
+    ventilation::model::Waveforms waveforms = ventilation::model::simulate(parameters(10.0f, 0.05f, 5.0f, 0.5f), settings);
+    EXPECT_EQ(waveforms.pressure.size(), 6 + 1 + 10);
+    EXPECT_EQ(waveforms.flow.size(), waveforms.pressure.size());
+    EXPECT_EQ(waveforms.volume.size(), waveforms.pressure.size());
+    EXPECT_EQ(waveforms.volume[5], ventilation::Volume(0.5f));
+    EXPECT_EQ(waveforms.flow[6], ventilation::Flow(0.0f));
+    EXPECT_LT(waveforms.flow[7], ventilation::Flow(0.0f));
+    EXPECT_EQ(waveforms.pressure.back(), ventilation::Pressure(5.0f));
+}
+
+TEST(MODEL, EXCEPTION) {
+    const ventilation::model::Settings settings;
+    EXPECT_THROW(ventilation::model::simulate(parameters(10.0f, 0.0f, 5.0f, 0.5f), settings), std::invalid_argument);
+    EXPECT_THROW(ventilation::model::simulate(parameters(0.0f, 0.05f, 5.0f, 0.5f), settings), std::invalid_argument);
+
+    ventilation::model::Settings broken;
+    broken.period = 0.0f;
+    EXPECT_THROW(ventilation::model::peak(parameters(10.0f, 0.05f, 5.0f, 0.5f), broken), std::invalid_argument);
+}
+
+RC_GTEST_PROP(
+      PEAK
+    , MONOTONIC
+    , ()
+    )
+{
+    const ventilation::model::Settings settings;
+    const float resistance  = *rc::gen::inRange(1, 50);
+    const float compliance  = *rc::gen::inRange(10, 100) * 1e-3f;
+    const float peep        = *rc::gen::inRange(0, 20);
+    const float tidal       = *rc::gen::inRange(100, 900) * 1e-3f;
+
+    const ventilation::Pressure base = ventilation::model::peak(parameters(resistance, compliance, peep, tidal), settings);
+    RC_ASSERT(ventilation::model::peak(parameters(resistance + 1.0f, compliance, peep, tidal), settings) >= base);
+    RC_ASSERT(ventilation::model::peak(parameters(resistance, compliance * 0.5f, peep, tidal), settings) >= base);
+    RC_ASSERT(ventilation::model::peak(parameters(resistance, compliance, peep + 1.0f, tidal), settings) >= base);
+    RC_ASSERT(ventilation::model::peak(parameters(resistance, compliance, peep, tidal + 0.05f), settings) >= base);
+}
+
+TEST(HASH, CONSISTENT) {
+    const ventilation::model::Parameters lhs = parameters(10.0f, 0.05f, 5.0f, 0.5f);
+    ventilation::model::Parameters rhs = lhs;
+    rhs.tidal = rhs.tidal + ventilation::Volume(0.0001f);
+
+    ASSERT_EQ(lhs, rhs);
+    EXPECT_EQ(std::hash<ventilation::model::Parameters>()(lhs), std::hash<ventilation::model::Parameters>()(rhs));
+
+    std::unordered_set<ventilation::model::Parameters> set = {lhs, rhs, parameters(10.0f, 0.05f, 5.0f, 0.6f)};
+    EXPECT_EQ(set.size(), 2);
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
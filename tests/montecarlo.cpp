@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <ventilation/montecarlo.hpp>
+
+namespace {
+    ventilation::montecarlo::Population
+    population() {
+        return {
+              {10.0f, 0.3f}
+            , {0.05f, 0.25f}
+            , ventilation::Pressure(5.0f)
+            , ventilation::Volume(0.5f)
+        };
+    }
+
+    void
+    same(const ventilation::montecarlo::Statistics& lhs, const ventilation::montecarlo::Statistics& rhs) {
+        EXPECT_EQ(lhs.count, rhs.count);
+        EXPECT_EQ(lhs.mean, rhs.mean);
+        EXPECT_EQ(lhs.squares, rhs.squares);
+        EXPECT_EQ(lhs.minimum, rhs.minimum);
+        EXPECT_EQ(lhs.maximum, rhs.maximum);
+    }
+} // namespace
+
+TEST(STATISTICS, MERGE) {
+    std::vector<double> values;
+    for (int i = 0; i < 1000; i++) { values.push_back(std::sin(i) * 10.0 + i * 0.01); }
+
+    ventilation::montecarlo::Statistics whole, first, second;
+    for (std::size_t i = 0; i < values.size(); i++) {
+        whole.push(values[i]);
+        (i < 300 ? first : second).push(values[i]);
+    }
+    first.merge(second);
+    EXPECT_EQ(first.count, whole.count);
+    EXPECT_NEAR(first.mean, whole.mean, 1e-9);
+    EXPECT_NEAR(first.variance(), whole.variance(), 1e-9);
+    EXPECT_EQ(first.minimum, whole.minimum);
+    EXPECT_EQ(first.maximum, whole.maximum);
+
+    ventilation::montecarlo::Statistics empty;
+    empty.merge(whole);
+    EXPECT_EQ(empty.mean, whole.mean);
+    EXPECT_EQ(ventilation::montecarlo::Statistics().variance(), 0.0);
+}
+
+TEST(MONTECARLO, THREADS) {
+    const ventilation::model::Settings settings;
+    const ventilation::Pressure limit(25.0f);
+    // Not a multiple of the block size, so the last block is partial
+    constexpr std::uint64_t count = 50000;
+
+    ventilation::parallel::Pool single(1);
+    ventilation::montecarlo::Summary expected = ventilation::montecarlo::run(population(), settings, count, 11, limit, single);
+    for (std::size_t threads : {2, 5}) {
+        ventilation::parallel::Pool pool(threads);
+        ventilation::montecarlo::Summary summary = ventilation::montecarlo::run(population(), settings, count, 11, limit, pool);
+        same(summary.resistance, expected.resistance);
+        same(summary.compliance, expected.compliance);
+        same(summary.peak, expected.peak);
+        same(summary.plateau, expected.plateau);
+        same(summary.driving, expected.driving);
+        same(summary.work, expected.work);
+        EXPECT_EQ(summary.exceeding, expected.exceeding);
+    }
+    EXPECT_EQ(expected.peak.count, count);
+}
+
+TEST(MONTECARLO, PATIENTS) {
+    const ventilation::model::Settings settings;
+    const ventilation::Pressure limit(25.0f);
+    constexpr std::uint64_t count = 2000;
+
+    ventilation::montecarlo::Summary summary = ventilation::montecarlo::run(population(), settings, count, 3, limit);
+
+    ventilation::montecarlo::Statistics peak, work;
+    std::uint64_t exceeding = 0;
+    for (std::uint64_t i = 0; i < count; i++) {
+        ventilation::model::Parameters parameters = ventilation::montecarlo::patient(population(), 3, i);
+        EXPECT_EQ(parameters, ventilation::montecarlo::patient(population(), 3, i));
+
+        ventilation::Pressure pressure = ventilation::model::peak(parameters, settings);
+        peak.push(static_cast<float>(pressure));
+        exceeding += pressure > limit;
+
+        ventilation::mechanics::Breath breath = ventilation::model::breath(parameters, settings);
+        work.push(static_cast<float>(breath.work));
+    }
+    EXPECT_NEAR(summary.peak.mean, peak.mean, 1e-3 * peak.mean);
+    EXPECT_NEAR(summary.peak.variance(), peak.variance(), 1e-2 * peak.variance());
+    EXPECT_NEAR(static_cast<double>(summary.exceeding), static_cast<double>(exceeding), 0.01 * count);
+    // The simulated breath integrates a sampled waveform
+    EXPECT_NEAR(summary.work.mean, work.mean, 0.02 * work.mean);
+}
+
+TEST(MONTECARLO, DISTRIBUTION) {
+    ventilation::montecarlo::Summary summary = ventilation::montecarlo::run(
+              population()
+            , ventilation::model::Settings()
+            , 100000
+            , 5
+            , ventilation::Pressure(25.0f)
+            );
+    // Mean of a log-normal is median * exp(sigma^2 / 2)
+    EXPECT_NEAR(summary.resistance.mean, 10.0 * std::exp(0.3 * 0.3 / 2), 0.05);
+    EXPECT_NEAR(summary.compliance.mean, 0.05 * std::exp(0.25 * 0.25 / 2), 0.0005);
+    EXPECT_GT(summary.resistance.minimum, 0.0);
+    EXPECT_NEAR(summary.driving.mean, summary.plateau.mean - 5.0, 1e-3);
+}
+
+TEST(MONTECARLO, INVALID) {
+    ventilation::montecarlo::Population invalid = population();
+    invalid.compliance.median = 0.0f;
+    EXPECT_THROW(
+              ventilation::montecarlo::run(invalid, ventilation::model::Settings(), 10, 0, ventilation::Pressure(25.0f))
+            , std::invalid_argument
+            );
+    EXPECT_EQ(
+              ventilation::montecarlo::run(population(), ventilation::model::Settings(), 0, 0, ventilation::Pressure(25.0f)).peak.count
+            , 0
+            );
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
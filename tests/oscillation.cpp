@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numbers>
+#include <vector>
+#include <ventilation/oscillation.hpp>
+
+namespace {
+    constexpr float PERIOD = 0.005f;
+
+    struct Recording {
+        std::vector<ventilation::Pressure>  pressure;
+        std::vector<ventilation::Flow>      flow;
+    };
+
+    // Single compartment with R = 3 cmH2O.s/L and E = 20 cmH2O/L, breathing
+    // at 0.25 Hz under oscillations at 5, 10 and 20 Hz, all given in closed
+    // form, plus a constant PEEP
+    Recording
+    forced(std::size_t samples) {
+        constexpr double R = 3.0;
+        constexpr double E = 20.0;
+        const double components[][2] = {{0.25, 0.5}, {5.0, 0.1}, {10.0, 0.1}, {20.0, 0.1}};
+
+        Recording recording;
+        for (std::size_t n = 0; n < samples; n++) {
+            const double t = static_cast<double>(n) * PERIOD;
+            double flow     = 0.0;
+            double volume   = 0.0;
+            for (const auto& [frequency, amplitude] : components) {
+                const double omega = 2.0 * std::numbers::pi * frequency;
+                flow    += amplitude * std::sin(omega * t);
+                volume  += amplitude * (1.0 - std::cos(omega * t)) / omega;
+            }
+            recording.flow.push_back(ventilation::Flow(static_cast<float>(flow)));
+            recording.pressure.push_back(ventilation::Pressure(static_cast<float>(5.0 + R * flow + E * volume)));
+        }
+        return recording;
+    }
+} // namespace
+
+TEST(WELCH, IMPEDANCE) {
+    const Recording recording = forced(20000);
+    ventilation::oscillation::Welch welch;
+    welch.segment = 400;    // 0.5 Hz bins
+    welch.overlap = 200;
+
+    const std::vector<ventilation::oscillation::Point> points = ventilation::oscillation::impedance(
+              recording.pressure
+            , recording.flow
+            , PERIOD
+            , welch
+            );
+    ASSERT_EQ(points.size(), 200u);
+    for (std::size_t k : {10u, 20u, 40u}) {
+        const ventilation::oscillation::Point& point = points[k - 1];
+        EXPECT_FLOAT_EQ(point.frequency, 0.5f * static_cast<float>(k));
+        EXPECT_NEAR(static_cast<float>(point.resistance), 3.0f, 0.01f) << k;
+        EXPECT_NEAR(static_cast<float>(point.elastance), 20.0f, 0.1f) << k;
+        EXPECT_GT(point.coherence, 0.999f) << k;
+    }
+}
+
+TEST(WELCH, POOL) {
+    const Recording recording = forced(30000);
+    ventilation::oscillation::Welch welch;
+    welch.segment = 256;
+    welch.overlap = 128;
+
+    ventilation::parallel::Pool one(1);
+    ventilation::parallel::Pool three(3);
+    const std::vector<ventilation::oscillation::Point> expected = ventilation::oscillation::impedance(
+            recording.pressure, recording.flow, PERIOD, welch, one
+            );
+    const std::vector<ventilation::oscillation::Point> actual = ventilation::oscillation::impedance(
+            recording.pressure, recording.flow, PERIOD, welch, three
+            );
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t i = 0; i < actual.size(); i++) {
+        EXPECT_EQ(actual[i].resistance, expected[i].resistance);
+        EXPECT_EQ(actual[i].elastance, expected[i].elastance);
+        EXPECT_EQ(actual[i].coherence, expected[i].coherence);
+    }
+}
+
+TEST(WELCH, INVALID) {
+    const Recording recording = forced(100);
+    ventilation::oscillation::Welch overlapping;
+    overlapping.segment = 64;
+    overlapping.overlap = 64;
+    ventilation::oscillation::Welch fitting;
+    fitting.segment = 64;
+    fitting.overlap = 32;
+
+    EXPECT_THROW(
+            ventilation::oscillation::impedance(recording.pressure, recording.flow, PERIOD)
+            , std::invalid_argument
+            );
+    EXPECT_THROW(
+            ventilation::oscillation::impedance(recording.pressure, recording.flow, PERIOD, overlapping)
+            , std::invalid_argument
+            );
+    EXPECT_THROW(
+            ventilation::oscillation::impedance(recording.pressure, recording.flow, 0.0f, fitting)
+            , std::domain_error
+            );
+    EXPECT_THROW(
+            ventilation::oscillation::impedance(
+                std::span<const ventilation::Pressure>(recording.pressure).first(99)
+                , recording.flow
+                , PERIOD
+                , fitting
+                )
+            , std::invalid_argument
+            );
+}
+
+TEST(TRACKER, IMPEDANCE) {
+    // Four seconds, whole periods of every component
+    const Recording recording = forced(100000);
+    const float frequencies[] = {5.0f, 10.0f, 20.0f};
+    ventilation::oscillation::Tracker tracker(frequencies, 800, PERIOD);
+    ASSERT_EQ(tracker.size(), 3u);
+
+    for (std::size_t n = 0; n < recording.flow.size(); n++) {
+        tracker.push(recording.pressure[n], recording.flow[n]);
+        EXPECT_EQ(tracker.ready(), n + 1 >= 800);
+        // Off the refresh points too, where only the sliding update ran
+        if (n == 99999 or n == 99799 or n == 55555) {
+            for (std::size_t i = 0; i < tracker.size(); i++) {
+                EXPECT_FLOAT_EQ(tracker[i].frequency, frequencies[i]);
+                EXPECT_NEAR(static_cast<float>(tracker[i].resistance), 3.0f, 0.01f) << n;
+                EXPECT_NEAR(static_cast<float>(tracker[i].elastance), 20.0f, 0.1f) << n;
+            }
+        }
+    }
+    EXPECT_THROW(tracker[3], std::out_of_range);
+}
+
+TEST(TRACKER, INVALID) {
+    const float zero[]      = {0.1f};
+    const float nyquist[]   = {101.0f};
+    const float valid[]     = {5.0f};
+
+    EXPECT_THROW(ventilation::oscillation::Tracker(zero, 400, PERIOD), std::invalid_argument);
+    EXPECT_THROW(ventilation::oscillation::Tracker(nyquist, 400, PERIOD), std::invalid_argument);
+    EXPECT_THROW(ventilation::oscillation::Tracker(valid, 1, PERIOD), std::invalid_argument);
+    EXPECT_THROW(ventilation::oscillation::Tracker(valid, 400, -1.0f), std::domain_error);
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <sstream>
+#include <ventilation/packed.hpp>
+
+using Narrow = ventilation::Packed<ventilation::Flow, ventilation::fixed::Narrow>;
+
+namespace rc {
+    template <>
+    struct Arbitrary<ventilation::Flow> {
+        static Gen<ventilation::Flow>
+        arbitrary() {
+            const Gen<std::int32_t> value = gen::inRange(-1000, 1000);
+            return gen::construct<ventilation::Flow>(
+                    gen::map(value, [](std::int32_t v) { return static_cast<float>(v) * 1e-3f; })
+            );
+        }
+    };
+
+    template <>
+    struct Arbitrary<Narrow> {
+        static Gen<Narrow>
+        arbitrary() {
+            const Gen<std::int32_t> value = gen::inRange(-1000, 1000);
+            return gen::construct<Narrow>(
+                    gen::map(value, [](std::int32_t v) { return static_cast<float>(v) * 1e-3f; })
+            );
+        }
+    };
+} // namespace rc
+
+TEST(STORAGE, WIDTH) {
+    EXPECT_EQ(sizeof(Narrow), sizeof(std::int32_t));
+    EXPECT_EQ(sizeof(ventilation::Packed<ventilation::Flow>), sizeof(ventilation::Flow));
+}
+
+TEST(CONSTRUCTOR, ZERO) {
+    EXPECT_EQ(static_cast<float>(Narrow()), 0.0f);
+}
+
+TEST(CONSTRUCTOR, EXCEPTION) {
+    EXPECT_THROW(Narrow(std::numeric_limits<float>::quiet_NaN()), std::domain_error);
+    EXPECT_THROW(Narrow(std::numeric_limits<float>::infinity()), std::domain_error);
+    EXPECT_THROW(Narrow(1e7f), std::out_of_range);
+    EXPECT_THROW(Narrow(-1e7f), std::out_of_range);
+}
+
+TEST(CONVERSION, EXCEPTION) {
+    EXPECT_THROW(Narrow(ventilation::Flow(1e7f)), std::out_of_range);
+    EXPECT_NO_THROW(Narrow(ventilation::Flow(1e6f)));
+}
+
+RC_GTEST_PROP(
+      CONVERSION
+    , ROUNDTRIP
+    , (const ventilation::Flow& xs)
+    )
+{
+    RC_ASSERT(static_cast<ventilation::Flow>(Narrow(xs)) == xs);
+}
+
+RC_GTEST_PROP(
+      CONVERSION
+    , POLICY
+    , (const Narrow& xs)
+    )
+{
+    using Wide = ventilation::Packed<ventilation::Flow, ventilation::fixed::Default>;
+    RC_ASSERT(Narrow(Wide(xs)) == xs);
+}
+
+RC_GTEST_PROP(
+      COMPARISON
+    , CONSISTENT
+    , (const ventilation::Flow& xs, const ventilation::Flow& ys)
+    )
+{
+    RC_ASSERT((Narrow(xs) <=> Narrow(ys)) == (xs <=> ys));
+}
+
+RC_GTEST_PROP(
+      ADDITION
+    , IDENTITY
+    , (const Narrow& xs)
+    )
+{
+    RC_ASSERT((xs + Narrow()) == xs);
+}
+
+RC_GTEST_PROP(
+      ADDITION
+    , COMMUTATIVE
+    , (const Narrow& xs, const Narrow& ys)
+    )
+{
+    RC_ASSERT((xs + ys) == (ys + xs));
+}
+
+RC_GTEST_PROP(
+      SUBTRACTION
+    , ANTICOMMUTATIVE
+    , (const Narrow& xs, const Narrow& ys)
+    )
+{
+    RC_ASSERT((xs - ys) == -(ys - xs));
+}
+
+RC_GTEST_PROP(
+      MULTIPLICATION
+    , IDENTITY
+    , (const Narrow& xs)
+    )
+{
+    RC_ASSERT((xs * 1.0f) == xs);
+    RC_ASSERT((1.0f * xs) == xs);
+}
+
+RC_GTEST_PROP(
+      MULTIPLICATION
+    , DEFINITION
+    , (const Narrow& xs)
+    )
+{
+    RC_ASSERT((xs * 2.0f) == (xs + xs));
+}
+
+TEST(MULTIPLICATION, EXCEPTION) {
+    Narrow flow;
+    EXPECT_ANY_THROW(flow * std::numeric_limits<float>::quiet_NaN());
+    EXPECT_ANY_THROW(std::numeric_limits<float>::infinity() * flow);
+}
+
+TEST(MULTIPLICATION, RANGE) {
+    // Products beyond the representation throw instead of wrapping
+    using Pressure = ventilation::Packed<ventilation::Pressure, ventilation::fixed::Narrow>;
+    EXPECT_THROW(Pressure(1500.0f) * 2000.0f, std::out_of_range);
+    EXPECT_THROW(-2000.0f * Pressure(1500.0f), std::out_of_range);
+    EXPECT_THROW(Pressure(1.0f) * 1e20f, std::out_of_range);
+    EXPECT_EQ(Pressure(1500.0f) * 1000.0f, Pressure(1.5e6f));
+
+    using Wide = ventilation::Packed<ventilation::Pressure>;
+    EXPECT_THROW(Wide(1e6f) * 1e7f, std::out_of_range);
+}
+
+TEST(FORMAT, QUANTITY) {
+    std::ostringstream packed;
+    std::ostringstream quantity;
+
+    packed      << Narrow(1.5f);
+    quantity    << ventilation::Flow(1.5f);
+    EXPECT_EQ(packed.str(), quantity.str());
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <ventilation/parallel.hpp>
+
+TEST(POOL, SIZE) {
+    EXPECT_EQ(ventilation::parallel::Pool(1).size(), 1);
+    EXPECT_EQ(ventilation::parallel::Pool(4).size(), 4);
+    EXPECT_EQ(ventilation::parallel::Pool(0).size(), 1);
+}
+
+TEST(POOL, EVERY) {
+    for (std::size_t threads : {1, 2, 4, 8}) {
+        ventilation::parallel::Pool pool(threads);
+        for (std::size_t count : {0, 1, 7, 1000}) {
+            std::vector<std::atomic<int>> calls(count);
+            pool.run(count, [&](std::size_t i) { calls[i]++; });
+            for (std::size_t i = 0; i < count; i++) {
+                EXPECT_EQ(calls[i].load(), 1) << threads << " threads, index " << i;
+            }
+        }
+    }
+}
+
+TEST(POOL, REPEATED) {
+    ventilation::parallel::Pool pool(3);
+    std::atomic<std::size_t> total = 0;
+    for (std::size_t round = 0; round < 200; round++) {
+        pool.run(16, [&](std::size_t i) { total += i; });
+    }
+    EXPECT_EQ(total.load(), 200 * 120);
+}
+
+TEST(POOL, EXCEPTION) {
+    ventilation::parallel::Pool pool(4);
+    EXPECT_THROW(
+            pool.run(100, [](std::size_t i) { if (i == 42) { throw std::runtime_error("task"); } })
+            , std::runtime_error
+            );
+
+    // The pool stays usable afterwards
+    std::atomic<std::size_t> calls = 0;
+    pool.run(10, [&](std::size_t) { calls++; });
+    EXPECT_EQ(calls.load(), 10);
+}
+
+TEST(POOL, NESTED) {
+    // A task may run more indices on the pool executing it
+    for (std::size_t threads : {1, 4}) {
+        ventilation::parallel::Pool pool(threads);
+        std::vector<std::atomic<int>> calls(64 * 16);
+        pool.run(64, [&](std::size_t i) {
+            pool.run(16, [&](std::size_t j) { calls[i * 16 + j]++; });
+        });
+        for (std::size_t i = 0; i < calls.size(); i++) {
+            EXPECT_EQ(calls[i].load(), 1) << threads << " threads, index " << i;
+        }
+        EXPECT_THROW(
+                pool.run(8, [&](std::size_t) {
+                    pool.run(8, [](std::size_t j) { if (j == 5) { throw std::runtime_error("nested"); } });
+                })
+                , std::runtime_error
+                );
+    }
+}
+
+TEST(POOL, SKEWED) {
+    // One participant's share is far more expensive; the others steal it
+    ventilation::parallel::Pool pool(4);
+    std::vector<std::atomic<int>> calls(64);
+    std::atomic<std::size_t> total = 0;
+    pool.run(calls.size(), [&](std::size_t i) {
+        if (i < 16) { std::this_thread::sleep_for(std::chrono::milliseconds(2)); }
+        calls[i]++;
+        total += i;
+    });
+    for (std::size_t i = 0; i < calls.size(); i++) {
+        EXPECT_EQ(calls[i].load(), 1) << "index " << i;
+    }
+    EXPECT_EQ(total.load(), 64 * 63 / 2);
+}
+
+TEST(POOL, TOPOLOGY) {
+    // Placement on a two-node topology, pinned if the CPUs exist here
+    const ventilation::parallel::Topology topology{{{0, 1}, {2, 3}}};
+    ventilation::parallel::Pool pool(5, topology);
+    EXPECT_EQ(pool.size(), 5);
+
+    std::vector<std::atomic<int>> calls(1000);
+    pool.run(calls.size(), [&](std::size_t i) { calls[i]++; });
+    for (std::size_t i = 0; i < calls.size(); i++) {
+        EXPECT_EQ(calls[i].load(), 1) << "index " << i;
+    }
+}
+
+TEST(TOPOLOGY, CPUS) {
+    EXPECT_EQ(ventilation::parallel::cpus("0-3,8,10-11\n"), (std::vector<unsigned>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(ventilation::parallel::cpus("5"), (std::vector<unsigned>{5}));
+    EXPECT_TRUE(ventilation::parallel::cpus("").empty());
+    EXPECT_THROW(ventilation::parallel::cpus("3-1"), std::invalid_argument);
+    EXPECT_THROW(ventilation::parallel::cpus("a"), std::invalid_argument);
+    EXPECT_THROW(ventilation::parallel::cpus("1,"), std::invalid_argument);
+}
+
+TEST(TOPOLOGY, PLACE) {
+    const ventilation::parallel::Topology topology{{{0, 1, 2}, {4, 5}}};
+    EXPECT_EQ(topology.cpus(), 5);
+
+    std::vector<ventilation::parallel::Placement> placement = topology.place(6);
+    std::vector<unsigned> cpus;
+    std::vector<std::size_t> nodes;
+    for (const ventilation::parallel::Placement& p : placement) {
+        cpus.push_back(p.cpu);
+        nodes.push_back(p.node);
+    }
+    EXPECT_EQ(cpus, (std::vector<unsigned>{0, 4, 1, 5, 2, 4}));
+    EXPECT_EQ(nodes, (std::vector<std::size_t>{0, 1, 0, 1, 0, 1}));
+
+    EXPECT_THROW(ventilation::parallel::Topology().place(1), std::invalid_argument);
+
+    const ventilation::parallel::Topology& system = ventilation::parallel::Topology::system();
+    EXPECT_GE(system.cpus(), 1);
+    EXPECT_EQ(&system, &ventilation::parallel::Topology::system());
+}
+
+TEST(TOPOLOGY, VICTIMS) {
+    const std::vector<ventilation::parallel::Placement> placement = {{0, 0}, {4, 1}, {1, 0}, {5, 1}, {2, 0}};
+    EXPECT_EQ(ventilation::parallel::victims(placement, 0), (std::vector<std::size_t>{2, 4, 1, 3}));
+    EXPECT_EQ(ventilation::parallel::victims(placement, 3), (std::vector<std::size_t>{1, 4, 0, 2}));
+    EXPECT_THROW(ventilation::parallel::victims(placement, 5), std::out_of_range);
+}
+
+TEST(POOL, SHARED) {
+    EXPECT_EQ(&ventilation::parallel::shared(), &ventilation::parallel::shared());
+    EXPECT_GE(ventilation::parallel::shared().size(), 1);
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <ventilation/pipeline.hpp>
+
+namespace {
+    using ventilation::Flow;
+    using ventilation::Volume;
+    using ventilation::pipeline::Batch;
+    using ventilation::pipeline::Stream;
+    using ventilation::pipeline::Task;
+
+    // Yields each vector in turn, in place
+    Stream<Batch<Flow>>
+    replay(const std::vector<std::vector<Flow>>& batches) {
+        for (const std::vector<Flow>& batch : batches) {
+            co_yield Batch<Flow>(batch);
+        }
+    }
+
+    template <typename T>
+    Task
+    collect(Stream<Batch<T>> stream, std::vector<std::vector<T>>& output) {
+        while (const Batch<T>* batch = co_await stream.next()) {
+            output.emplace_back(batch->begin(), batch->end());
+        }
+    }
+
+    std::vector<Flow>
+    flows(std::initializer_list<float> values) {
+        std::vector<Flow> output;
+        for (float value : values) { output.push_back(Flow(value)); }
+        return output;
+    }
+} // namespace
+
+TEST(STREAM, BY_REFERENCE) {
+    const std::vector<std::vector<Flow>> batches = {flows({1.0f, 2.0f}), flows({3.0f})};
+    std::vector<const Flow*> seen;
+
+    ventilation::pipeline::Executor executor(1);
+    executor.spawn([](Stream<Batch<Flow>> stream, std::vector<const Flow*>& seen) -> Task {
+        while (const Batch<Flow>* batch = co_await stream.next()) {
+            seen.push_back(batch->data());
+        }
+        // Finished streams keep reporting the end
+        EXPECT_EQ(co_await stream.next(), nullptr);
+    }(replay(batches), seen));
+    executor.wait();
+
+    ASSERT_EQ(seen.size(), 2);
+    EXPECT_EQ(seen[0], batches[0].data());
+    EXPECT_EQ(seen[1], batches[1].data());
+}
+
+TEST(STREAM, TRANSFORM) {
+    const std::vector<std::vector<Flow>> batches = {flows({1.0f, -2.0f}), flows({0.5f})};
+    std::vector<std::vector<Flow>> output;
+
+    ventilation::pipeline::Executor executor(1);
+    executor.spawn(collect(
+                ventilation::pipeline::transform<Flow>(replay(batches), [](Batch<Flow> input, std::span<Flow> output) {
+                    for (std::size_t i = 0; i < input.size(); i++) { output[i] = input[i] * 2.0f; }
+                })
+                , output
+                ));
+    executor.wait();
+
+    ASSERT_EQ(output.size(), 2);
+    EXPECT_EQ(output[0], flows({2.0f, -4.0f}));
+    EXPECT_EQ(output[1], flows({1.0f}));
+}
+
+TEST(STREAM, INTEGRATE) {
+    const std::vector<std::vector<Flow>> batches = {flows({1.0f, 1.0f}), flows({-0.5f, 0.0f})};
+    std::vector<std::vector<Volume>> output;
+
+    ventilation::pipeline::Executor executor(1);
+    executor.spawn(collect(ventilation::pipeline::integrate(replay(batches), 0.1f, Volume(0.2f)), output));
+    executor.wait();
+
+    ASSERT_EQ(output.size(), 2);
+    EXPECT_EQ(output[0], (std::vector<Volume>{Volume(0.3f), Volume(0.4f)}));
+    EXPECT_EQ(output[1], (std::vector<Volume>{Volume(0.35f), Volume(0.35f)}));
+
+    EXPECT_THROW(ventilation::pipeline::integrate(replay(batches), 0.0f), std::invalid_argument);
+}
+
+TEST(STREAM, DRIFT) {
+    // Constant flow, whose volume per sample is not a whole raw step, ends
+    // at the exact product instead of accumulating each truncation
+    const std::vector<std::vector<Flow>> batches(100, std::vector<Flow>(100, Flow(0.333333f)));
+    std::vector<std::vector<Volume>> output;
+
+    ventilation::pipeline::Executor executor(1);
+    executor.spawn(collect(ventilation::pipeline::integrate(replay(batches), 0.01f), output));
+    executor.wait();
+
+    ASSERT_EQ(output.size(), 100);
+    const std::int64_t flow = ventilation::fixed::Access::raw(Flow(0.333333f));
+    const std::int64_t volume = ventilation::fixed::Access::raw(output.back().back());
+    EXPECT_EQ(volume, std::llround(static_cast<double>(flow * 10000) * static_cast<double>(0.01f)));
+}
+
+TEST(STREAM, SEGMENT) {
+    // Breaths start where flow turns positive, across batch boundaries
+    const std::vector<std::vector<Flow>> batches = {
+          flows({0.5f, -0.1f, 0.0f, 0.4f, 0.3f})
+        , flows({-0.2f, -0.1f})
+        , flows({0.2f, -0.3f, 0.1f, 0.1f})
+    };
+    std::vector<std::vector<Flow>> output;
+
+    ventilation::pipeline::Executor executor(1);
+    executor.spawn(collect(ventilation::pipeline::segment(replay(batches)), output));
+    executor.wait();
+
+    ASSERT_EQ(output.size(), 2);
+    EXPECT_EQ(output[0], flows({0.4f, 0.3f, -0.2f, -0.1f}));
+    EXPECT_EQ(output[1], flows({0.2f, -0.3f}));
+}
+
+TEST(STREAM, ONSET) {
+    // An onset on the last sample of a batch keeps that sample
+    const std::vector<std::vector<Flow>> batches = {
+          flows({-0.1f, 0.2f, -0.1f, 0.3f})
+        , flows({-0.2f, -0.1f, 0.2f})
+    };
+    std::vector<std::vector<Flow>> output;
+
+    ventilation::pipeline::Executor executor(1);
+    executor.spawn(collect(ventilation::pipeline::segment(replay(batches)), output));
+    executor.wait();
+
+    ASSERT_EQ(output.size(), 2);
+    EXPECT_EQ(output[0], flows({0.2f, -0.1f}));
+    EXPECT_EQ(output[1], flows({0.3f, -0.2f, -0.1f}));
+}
+
+TEST(STREAM, EXCEPTION) {
+    ventilation::pipeline::Executor executor(2);
+    executor.spawn([]() -> Task {
+        Stream<Batch<Flow>> failing = []() -> Stream<Batch<Flow>> {
+            throw std::runtime_error("stage");
+            co_return;
+        }();
+        co_await failing.next();
+    }());
+    EXPECT_THROW(executor.wait(), std::runtime_error);
+
+    // The executor stays usable afterwards
+    std::vector<std::vector<Flow>> output;
+    const std::vector<std::vector<Flow>> batches = {flows({1.0f})};
+    executor.spawn(collect(replay(batches), output));
+    EXPECT_NO_THROW(executor.wait());
+    EXPECT_EQ(output.size(), 1);
+}
+
+TEST(CHANNEL, BACKPRESSURE) {
+    ventilation::pipeline::Executor executor(1);
+    ventilation::pipeline::Channel<std::vector<Flow>> channel(executor, 2);
+
+    std::vector<Flow> batch = flows({1.0f});
+    EXPECT_TRUE(channel.try_push(batch));
+    batch = flows({2.0f});
+    EXPECT_TRUE(channel.try_push(batch));
+    batch = flows({3.0f});
+    EXPECT_FALSE(channel.try_push(batch));
+    EXPECT_EQ(batch, flows({3.0f}));
+
+    std::vector<std::vector<Flow>> output;
+    executor.spawn(collect(ventilation::pipeline::source(channel), output));
+
+    // The consumer drains the channel, so a blocked producer gets through
+    channel.push(batch);
+    channel.close();
+    executor.wait();
+
+    ASSERT_EQ(output.size(), 3);
+    EXPECT_EQ(output[2], flows({3.0f}));
+    EXPECT_THROW(channel.push(batch), std::logic_error);
+    EXPECT_THROW(ventilation::pipeline::Channel<int>(executor, 0), std::invalid_argument);
+}
+
+TEST(EXECUTOR, BEDS) {
+    // Many beds, each fed by its own acquisition thread, on two threads
+    constexpr std::size_t beds      = 32;
+    constexpr std::size_t batches   = 50;
+    constexpr std::size_t samples   = 20;
+
+    ventilation::pipeline::Executor executor(2);
+    std::vector<std::unique_ptr<ventilation::pipeline::Channel<std::vector<Flow>>>> channels;
+    std::vector<Volume> last(beds);
+
+    for (std::size_t bed = 0; bed < beds; bed++) {
+        channels.push_back(std::make_unique<ventilation::pipeline::Channel<std::vector<Flow>>>(executor, 4));
+        executor.spawn([](Stream<Batch<Volume>> volume, Volume& last) -> Task {
+            while (const Batch<Volume>* batch = co_await volume.next()) {
+                last = batch->back();
+            }
+        }(ventilation::pipeline::integrate(ventilation::pipeline::source(*channels.back()), 0.125f), last[bed]));
+    }
+
+    std::vector<std::thread> acquisition;
+    for (std::size_t bed = 0; bed < beds; bed++) {
+        acquisition.emplace_back([&, bed] {
+            for (std::size_t i = 0; i < batches; i++) {
+                channels[bed]->push(std::vector<Flow>(samples, Flow(static_cast<float>(bed))));
+            }
+            channels[bed]->close();
+        });
+    }
+    for (std::thread& thread : acquisition) { thread.join(); }
+    executor.wait();
+
+    for (std::size_t bed = 0; bed < beds; bed++) {
+        EXPECT_FLOAT_EQ(static_cast<float>(last[bed]), static_cast<float>(bed) * 0.125f * batches * samples) << "bed " << bed;
+    }
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
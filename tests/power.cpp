@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <ventilation/ventilation.hpp>
+
+namespace rc {
+    template <>
+    struct Arbitrary<ventilation::Power> {
+        static Gen<ventilation::Power>
+        arbitrary() {
+            const Gen<std::int32_t> value = gen::inRange(-1000, 1000);
+            return gen::construct<ventilation::Power>(
+                    gen::map(value, [](std::int32_t v) { return static_cast<float>(v) * 1e-3f; })
+            );
+        }
+    };
+} // namespace rc
+
+TEST(CONSTRUCTOR, ZERO) {
+    EXPECT_EQ(static_cast<float>(ventilation::Power()), 0.0f);
+}
+
+TEST(CONSTRUCTOR, EXCEPTION) {
+    EXPECT_ANY_THROW(
+            ventilation::Power(std::numeric_limits<float>::quiet_NaN())
+            );
+    EXPECT_ANY_THROW(
+            ventilation::Power(std::numeric_limits<float>::infinity())
+            );
+}
+
+TEST(COMPARISON, EQ) {
+    EXPECT_EQ(ventilation::Power(1.0f), ventilation::Power(1.0f));
+}
+
+TEST(COMPARISON, NE) {
+    EXPECT_NE(ventilation::Power(1.0f), ventilation::Power(2.0f));
+}
+
+TEST(COMPARISON, LT) {
+    EXPECT_LT(ventilation::Power(1.0f), ventilation::Power(2.0f));
+}
+
+TEST(COMPARISON, LE) {
+    EXPECT_LE(ventilation::Power(1.0f), ventilation::Power(1.0f));
+    EXPECT_LE(ventilation::Power(1.0f), ventilation::Power(2.0f));
+}
+
+TEST(COMPARISON, GT) {
+    EXPECT_GT(ventilation::Power(2.0f), ventilation::Power(1.0f));
+}
+
+TEST(COMPARISON, GE) {
+    EXPECT_GE(ventilation::Power(1.0f), ventilation::Power(1.0f));
+    EXPECT_GE(ventilation::Power(2.0f), ventilation::Power(1.0f));
+}
+
+RC_GTEST_PROP(
+      ADDITION
+    , IDENTITY
+    , (const ventilation::Power& xs)
+    )
+{
+    RC_ASSERT((xs + ventilation::Power()) == xs);
+}
+
+RC_GTEST_PROP(
+      ADDITION
+    , COMMUTATIVE
+    , (const ventilation::Power& xs, const ventilation::Power& ys)
+    )
+{
+    RC_ASSERT((xs + ys) == (ys + xs));
+}
+
+RC_GTEST_PROP(
+      ADDITION
+    , ASSOCIATIVE
+    , (const ventilation::Power& xs, const ventilation::Power& ys, const ventilation::Power& zs)
+    )
+{
+    RC_ASSERT((xs + ys) + zs == (xs + ys + zs));
+}
+
+RC_GTEST_PROP(
+      SUBTRACTION
+    , NEUTRAL
+    , (const ventilation::Power& xs)
+    )
+{
+    RC_ASSERT((xs - ventilation::Power()) == xs);
+}
+
+RC_GTEST_PROP(
+      SUBTRACTION
+    , NEGATE
+    , (const ventilation::Power& xs)
+    )
+{
+    RC_ASSERT((ventilation::Power() - xs) == -xs);
+}
+
+RC_GTEST_PROP(
+      SUBTRACTION
+    , ANTICOMMUTATIVE
+    , (const ventilation::Power& xs, const ventilation::Power& ys)
+    )
+{
+    RC_ASSERT((xs - ys) == -(ys - xs));
+}
+
+RC_GTEST_PROP(
+      MULTIPLICATION
+    , IDENTITY
+    , (const ventilation::Power& xs)
+    )
+{
+    RC_ASSERT((xs * 1.0f) == xs);
+    RC_ASSERT((1.0f * xs) == xs);
+}
+
+RC_GTEST_PROP(
+      MULTIPLICATION
+    , DEFINITION
+    , (const ventilation::Power& xs)
+    )
+{
+    RC_ASSERT((xs * 2.0f) == (xs + xs));
+    RC_ASSERT((2.0f * xs) == (xs + xs));
+}
+
+RC_GTEST_PROP(
+      MULTIPLICATION
+    , ZERO
+    , (const ventilation::Power& xs)
+    )
+{
+    RC_ASSERT((xs * 0.0f) == ventilation::Power());
+    RC_ASSERT((0.0f * xs) == ventilation::Power());
+}
+
+RC_GTEST_PROP(
+      MULTIPLICATION
+    , COMMUTATIVE
+    , (const ventilation::Power& xs, float scalar)
+    )
+{
+    RC_PRE(std::isfinite(scalar));
+    RC_ASSERT((xs * scalar) == (scalar * xs));
+}
+
+TEST(MULTIPLICATION, EXCEPTION) {
+    ventilation::Power power;
+    EXPECT_ANY_THROW(
+            power * std::numeric_limits<float>::quiet_NaN()
+            );
+    EXPECT_ANY_THROW(
+            std::numeric_limits<float>::quiet_NaN() * power
+            );
+    EXPECT_ANY_THROW(
+            power * std::numeric_limits<float>::infinity()
+            );
+    EXPECT_ANY_THROW(
+            std::numeric_limits<float>::infinity() * power
+            );
+}
+
+TEST(HASH, CONSISTENT) {
+    // Equal at comparison granularity, though stored differently
+    const ventilation::Power xs(0.0001f);
+    const ventilation::Power ys(0.0002f);
+    ASSERT_EQ(xs, ys);
+    EXPECT_EQ(std::hash<ventilation::Power>()(xs), std::hash<ventilation::Power>()(ys));
+    EXPECT_EQ(std::hash<ventilation::Power>()(-xs), std::hash<ventilation::Power>()(ventilation::Power()));
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
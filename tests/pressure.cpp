@@ -166,6 +166,15 @@ TEST(MULTIPLICATION, EXCEPTION) {
             );
 }
 
+TEST(HASH, CONSISTENT) {
+    // Equal at comparison granularity, though stored differently
+    const ventilation::Pressure xs(0.0001f);
+    const ventilation::Pressure ys(0.0002f);
+    ASSERT_EQ(xs, ys);
+    EXPECT_EQ(std::hash<ventilation::Pressure>()(xs), std::hash<ventilation::Pressure>()(ys));
+    EXPECT_EQ(std::hash<ventilation::Pressure>()(-xs), std::hash<ventilation::Pressure>()(ventilation::Pressure()));
+}
+
 int
 main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
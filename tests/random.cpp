@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <ventilation/random.hpp>
+
+using Block = ventilation::random::Philox::Block;
+
+// Known-answer vectors of the Random123 reference implementation
+TEST(PHILOX, KNOWN_ANSWERS) {
+    EXPECT_EQ(
+              ventilation::random::Philox(0)(Block{0, 0, 0, 0})
+            , (Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8})
+            );
+    EXPECT_EQ(
+              ventilation::random::Philox(0xffffffffffffffff)(Block{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff})
+            , (Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd})
+            );
+    EXPECT_EQ(
+              ventilation::random::Philox(0x299f31d0a4093822)(Block{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344})
+            , (Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1})
+            );
+}
+
+TEST(PHILOX, STREAMS) {
+    constexpr ventilation::random::Philox generator(42);
+    EXPECT_EQ(generator(3, 7), generator(Block{7, 0, 3, 0}));
+    EXPECT_NE(generator(0, 1), generator(1, 0));
+    EXPECT_NE(generator(0, 0), ventilation::random::Philox(43)(0, 0));
+}
+
+RC_GTEST_PROP(UNIFORM, OPEN, (std::uint32_t bits)) {
+    float u = ventilation::random::uniform(bits);
+    RC_ASSERT(u > 0.0f);
+    RC_ASSERT(u < 1.0f);
+}
+
+TEST(NORMAL, MOMENTS) {
+    const ventilation::random::Philox generator(7);
+    constexpr std::uint64_t count = 100000;
+
+    double sum      = 0.0;
+    double squares  = 0.0;
+    for (std::uint64_t i = 0; i < count; i++) {
+        Block bits = generator(0, i);
+        for (std::size_t j = 0; j < 4; j += 2) {
+            auto [x, y] = ventilation::random::normal(bits[j], bits[j + 1]);
+            ASSERT_TRUE(std::isfinite(x) and std::isfinite(y));
+            sum     += x + y;
+            squares += x * x + y * y;
+        }
+    }
+    double mean     = sum / (4 * count);
+    double variance = squares / (4 * count) - mean * mean;
+    EXPECT_NEAR(mean, 0.0, 0.01);
+    EXPECT_NEAR(variance, 1.0, 0.01);
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <vector>
+#include <ventilation/reduction.hpp>
+
+namespace {
+    // Sizes spanning several chunks, so the pools below actually split them
+    rc::Gen<std::vector<ventilation::Volume>>
+    volumes() {
+        return rc::gen::map(
+                rc::gen::inRange<std::size_t>(1, 5 * ventilation::reduction::CHUNK)
+                , [](std::size_t size) {
+                    std::vector<ventilation::Volume> values;
+                    values.reserve(size);
+                    std::int64_t state = static_cast<std::int64_t>(size);
+                    for (std::size_t i = 0; i < size; i++) {
+                        state = (state * 6364136223846793005LL + 1442695040888963407LL);
+                        values.push_back(ventilation::Volume(static_cast<float>((state >> 40) % 10000) * 1e-3f));
+                    }
+                    return values;
+                }
+                );
+    }
+} // namespace
+
+RC_GTEST_PROP(
+      SUM
+    , THREADS
+    , ()
+    )
+{
+    const std::vector<ventilation::Volume> xs = *volumes();
+
+    ventilation::Volume expected(0.0f);
+    for (const ventilation::Volume& x : xs) { expected = expected + x; }
+
+    for (std::size_t threads : {1, 2, 3, 8}) {
+        ventilation::parallel::Pool pool(threads);
+        ventilation::Volume actual = ventilation::reduction::sum<ventilation::Volume>(xs, pool);
+        RC_ASSERT(std::memcmp(&actual, &expected, sizeof(actual)) == 0);
+    }
+}
+
+RC_GTEST_PROP(
+      MEAN
+    , THREADS
+    , ()
+    )
+{
+    const std::vector<ventilation::Volume> xs = *volumes();
+
+    ventilation::parallel::Pool sequential(1);
+    ventilation::Volume expected = ventilation::reduction::mean<ventilation::Volume>(xs, sequential);
+    for (std::size_t threads : {2, 5}) {
+        ventilation::parallel::Pool pool(threads);
+        ventilation::Volume actual = ventilation::reduction::mean<ventilation::Volume>(xs, pool);
+        RC_ASSERT(std::memcmp(&actual, &expected, sizeof(actual)) == 0);
+    }
+    RC_ASSERT(expected >= ventilation::reduction::minimum<ventilation::Volume>(xs, sequential));
+    RC_ASSERT(expected <= ventilation::reduction::maximum<ventilation::Volume>(xs, sequential));
+}
+
+RC_GTEST_PROP(
+      EXTREMA
+    , THREADS
+    , ()
+    )
+{
+    const std::vector<ventilation::Volume> xs = *volumes();
+    const auto [smallest, largest] = std::minmax_element(xs.begin(), xs.end());
+
+    for (std::size_t threads : {1, 4}) {
+        ventilation::parallel::Pool pool(threads);
+        auto [minimum, maximum] = ventilation::reduction::extrema<ventilation::Volume>(xs, pool);
+        RC_ASSERT(minimum == *smallest);
+        RC_ASSERT(maximum == *largest);
+    }
+}
+
+RC_GTEST_PROP(
+      DOT
+    , THREADS
+    , ()
+    )
+{
+    const std::vector<ventilation::Volume> xs = *volumes();
+    std::vector<ventilation::Flow> flow;
+    std::vector<ventilation::Pressure> pressure;
+    for (std::size_t i = 0; i < xs.size(); i++) {
+        float value = static_cast<float>(xs[i]);
+        flow.push_back(ventilation::Flow(value - 5.0f));
+        pressure.push_back(ventilation::Pressure(value * 3.0f));
+    }
+
+    ventilation::parallel::Pool sequential(1);
+    double expected = ventilation::reduction::dot(flow, pressure, sequential);
+    for (std::size_t threads : {2, 7}) {
+        ventilation::parallel::Pool pool(threads);
+        double actual = ventilation::reduction::dot(flow, pressure, pool);
+        RC_ASSERT(std::memcmp(&actual, &expected, sizeof(actual)) == 0);
+    }
+}
+
+RC_GTEST_PROP(
+      VIEW
+    , SPAN
+    , ()
+    )
+{
+    // Strided and narrow views reduce as their decoded copies do
+    const std::vector<ventilation::Volume> xs = *volumes();
+    std::vector<std::int64_t> frames;
+    std::vector<std::int32_t> narrow;
+    for (const ventilation::Volume& x : xs) {
+        const std::int64_t raw = ventilation::fixed::Access::raw(x);
+        frames.push_back(raw);
+        frames.push_back(-raw);
+        narrow.push_back(static_cast<std::int32_t>(raw / 1000));
+    }
+    const auto strided = ventilation::QuantitySpan<ventilation::Volume>::interleaved(frames.data(), xs.size(), 2, 0);
+    const ventilation::QuantitySpan<ventilation::Volume, std::int32_t, ventilation::fixed::Narrow> packed(narrow.data(), narrow.size());
+    const ventilation::QuantitySpan<ventilation::Volume> contiguous(
+            ventilation::fixed::Access::raw(std::span<const ventilation::Volume>(xs)).data(), xs.size()
+            );
+    std::vector<ventilation::Volume> decoded;
+    for (std::size_t i = 0; i < packed.size(); i++) { decoded.push_back(packed[i]); }
+
+    ventilation::parallel::Pool pool(3);
+    RC_ASSERT(ventilation::reduction::total(strided, pool) == ventilation::reduction::total<ventilation::Volume>(xs, pool));
+    RC_ASSERT(ventilation::reduction::sum(strided, pool) == ventilation::reduction::sum<ventilation::Volume>(xs, pool));
+    RC_ASSERT(ventilation::reduction::mean(strided, pool) == ventilation::reduction::mean<ventilation::Volume>(xs, pool));
+    RC_ASSERT(ventilation::reduction::extrema(strided, pool) == ventilation::reduction::extrema<ventilation::Volume>(xs, pool));
+    RC_ASSERT(ventilation::reduction::sum(contiguous, pool) == ventilation::reduction::sum<ventilation::Volume>(xs, pool));
+    RC_ASSERT(ventilation::reduction::sum(packed, pool) == ventilation::reduction::sum<ventilation::Volume>(decoded, pool));
+    RC_ASSERT(ventilation::reduction::minimum(packed, pool) == ventilation::reduction::minimum<ventilation::Volume>(decoded, pool));
+    RC_ASSERT(ventilation::reduction::maximum(packed, pool) == ventilation::reduction::maximum<ventilation::Volume>(decoded, pool));
+
+    std::vector<std::int64_t> channels;
+    std::vector<ventilation::Flow> flow;
+    std::vector<ventilation::Pressure> pressure;
+    for (const ventilation::Volume& x : xs) {
+        flow.push_back(ventilation::Flow(static_cast<float>(x) - 5.0f));
+        pressure.push_back(ventilation::Pressure(static_cast<float>(x) * 3.0f));
+        channels.push_back(ventilation::fixed::Access::raw(flow.back()));
+        channels.push_back(ventilation::fixed::Access::raw(pressure.back()));
+    }
+    const double expected   = ventilation::reduction::dot(flow, pressure, pool);
+    const double actual     = ventilation::reduction::dot(
+              ventilation::QuantitySpan<ventilation::Flow>::interleaved(channels.data(), xs.size(), 2, 0)
+            , ventilation::QuantitySpan<ventilation::Pressure>::interleaved(channels.data(), xs.size(), 2, 1)
+            , pool
+            );
+    RC_ASSERT(std::memcmp(&actual, &expected, sizeof(actual)) == 0);
+}
+
+TEST(VIEW, EMPTY) {
+    const ventilation::QuantitySpan<ventilation::Pressure, std::int32_t, ventilation::fixed::Narrow> empty;
+    EXPECT_EQ(ventilation::reduction::sum(empty), ventilation::Pressure(0.0f));
+    EXPECT_THROW(ventilation::reduction::mean(empty), std::invalid_argument);
+    EXPECT_THROW(ventilation::reduction::extrema(empty), std::invalid_argument);
+}
+
+TEST(SUM, EXACT) {
+    // Partial sums above the int64 range cancel out exactly
+    const float large = 9.0e12f;
+    std::vector<ventilation::Flow> xs = {
+        ventilation::Flow(large), ventilation::Flow(large), ventilation::Flow(-large), ventilation::Flow(-large), ventilation::Flow(1.5f)
+    };
+    EXPECT_EQ(ventilation::reduction::sum<ventilation::Flow>(xs), ventilation::Flow(1.5f));
+    EXPECT_EQ(ventilation::reduction::mean<ventilation::Flow>(xs), ventilation::Flow(0.3f));
+}
+
+TEST(SUM, OVERFLOW) {
+    const float large = 9.0e12f;
+    std::vector<ventilation::Flow> xs = {ventilation::Flow(large), ventilation::Flow(large)};
+    EXPECT_THROW(ventilation::reduction::sum<ventilation::Flow>(xs), std::out_of_range);
+    EXPECT_EQ(ventilation::reduction::mean<ventilation::Flow>(xs), ventilation::Flow(large));
+}
+
+TEST(SUM, EMPTY) {
+    std::vector<ventilation::Pressure> xs;
+    EXPECT_EQ(ventilation::reduction::sum<ventilation::Pressure>(xs), ventilation::Pressure(0.0f));
+    EXPECT_THROW(ventilation::reduction::mean<ventilation::Pressure>(xs), std::invalid_argument);
+    EXPECT_THROW(ventilation::reduction::extrema<ventilation::Pressure>(xs), std::invalid_argument);
+}
+
+TEST(SUM, NESTED) {
+    // Reductions on the shared pool from tasks already running on it
+    std::vector<ventilation::Volume> xs(3 * ventilation::reduction::CHUNK, ventilation::Volume(0.001f));
+    std::vector<ventilation::Volume> sums(64);
+    ventilation::parallel::shared().run(sums.size(), [&](std::size_t i) {
+        sums[i] = ventilation::reduction::sum<ventilation::Volume>(xs);
+    });
+    for (const ventilation::Volume& sum : sums) {
+        EXPECT_EQ(sum, ventilation::reduction::sum<ventilation::Volume>(xs));
+    }
+}
+
+TEST(DOT, VALUE) {
+    std::vector<ventilation::Flow> flow = {ventilation::Flow(0.5f), ventilation::Flow(-1.0f)};
+    std::vector<ventilation::Pressure> pressure = {ventilation::Pressure(20.0f), ventilation::Pressure(4.0f)};
+    EXPECT_DOUBLE_EQ(ventilation::reduction::dot(flow, pressure), 6.0);
+
+    pressure.pop_back();
+    EXPECT_THROW(ventilation::reduction::dot(flow, pressure), std::invalid_argument);
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
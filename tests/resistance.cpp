@@ -102,6 +102,14 @@ TEST(MULTIPLICATION, EXCEPTION) {
             );
 }
 
+TEST(HASH, CONSISTENT) {
+    // Equal at comparison granularity, though stored differently
+    const ventilation::Resistance xs(0.0001f);
+    const ventilation::Resistance ys(0.0002f);
+    ASSERT_EQ(xs, ys);
+    EXPECT_EQ(std::hash<ventilation::Resistance>()(xs), std::hash<ventilation::Resistance>()(ys));
+}
+
 int
 main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <vector>
+#include <ventilation/batch.hpp>
+#include <ventilation/saturating.hpp>
+
+namespace rc {
+    template <>
+    struct Arbitrary<ventilation::Pressure> {
+        static Gen<ventilation::Pressure>
+        arbitrary() {
+            const Gen<std::int32_t> value = gen::inRange(-1000, 1000);
+            return gen::construct<ventilation::Pressure>(
+                    gen::map(value, [](std::int32_t v) { return static_cast<float>(v) * 1e-3f; })
+            );
+        }
+    };
+} // namespace rc
+
+namespace {
+    const std::int64_t MAXIMUM = std::numeric_limits<std::int64_t>::max();
+    const std::int64_t MINIMUM = std::numeric_limits<std::int64_t>::min();
+} // namespace
+
+TEST(RAW, ADD) {
+    EXPECT_EQ(ventilation::saturating::add(MAXIMUM, 1), MAXIMUM);
+    EXPECT_EQ(ventilation::saturating::add(MINIMUM, -1), MINIMUM);
+    EXPECT_EQ(ventilation::saturating::add(MAXIMUM, MINIMUM), -1);
+}
+
+TEST(RAW, SUBTRACT) {
+    EXPECT_EQ(ventilation::saturating::subtract(MINIMUM, 1), MINIMUM);
+    EXPECT_EQ(ventilation::saturating::subtract(MAXIMUM, -1), MAXIMUM);
+    EXPECT_EQ(ventilation::saturating::subtract(0, MINIMUM), MAXIMUM);
+}
+
+TEST(RAW, SCALE) {
+    EXPECT_EQ(ventilation::saturating::scale(MAXIMUM, 2, 1), MAXIMUM);
+    EXPECT_EQ(ventilation::saturating::scale(MAXIMUM, -2, 1), MINIMUM);
+    EXPECT_EQ(ventilation::saturating::scale(MINIMUM, -1, 1), MAXIMUM);
+    EXPECT_EQ(ventilation::saturating::scale(3000000, 2000000, 1000000), 6000000);
+}
+
+TEST(RAW, QUOTIENT) {
+    // The product overflows int64 but the quotient fits
+    EXPECT_EQ(ventilation::saturating::scale(MAXIMUM, 2, 1000000), 18446744073709);
+    EXPECT_EQ(ventilation::saturating::scale(MAXIMUM, -2, 1000000), -18446744073709);
+    EXPECT_EQ(ventilation::saturating::scale(MINIMUM, -1, 1000000), 9223372036854);
+    EXPECT_EQ(ventilation::saturating::scale(MAXIMUM, 2000000, 1000000), MAXIMUM);
+    EXPECT_EQ(ventilation::saturating::scale(MINIMUM, 2000000, 1000000), MINIMUM);
+}
+
+TEST(MULTIPLICATION, SATURATES) {
+    ventilation::Pressure pressure(1e9f);
+    EXPECT_GT(ventilation::saturating::multiply(pressure, 1e9f), ventilation::Pressure(1e12f));
+    EXPECT_LT(ventilation::saturating::multiply(pressure, -1e9f), ventilation::Pressure(-1e12f));
+}
+
+TEST(MULTIPLICATION, QUOTIENT) {
+    // 10^4 L/s times 1000 overflows int64 before the division by FORWARD
+    const ventilation::Flow flow = ventilation::saturating::multiply(ventilation::Flow(10000.0f), 1000.0f);
+    EXPECT_EQ(ventilation::fixed::Access::raw(flow), 10000000000000);
+}
+
+TEST(MULTIPLICATION, WIDE) {
+    // Scalars whose fixed-point factor exceeds int64
+    const ventilation::Pressure smallest = ventilation::fixed::Access::make<ventilation::Pressure>(1);
+    const ventilation::Pressure zero;
+    const std::int64_t raw = ventilation::fixed::Access::raw(ventilation::saturating::multiply(smallest, 1e13f));
+    EXPECT_NEAR(static_cast<double>(raw), 1e13, 1e7);
+    EXPECT_EQ(ventilation::fixed::Access::raw(ventilation::saturating::multiply(smallest, 1e30f)), MAXIMUM);
+    EXPECT_EQ(ventilation::fixed::Access::raw(ventilation::saturating::multiply(smallest, -1e30f)), MINIMUM);
+    EXPECT_EQ(
+          ventilation::fixed::Access::raw(ventilation::saturating::multiply(-smallest, std::numeric_limits<float>::max()))
+        , MINIMUM
+        );
+    EXPECT_EQ(ventilation::saturating::multiply(zero, std::numeric_limits<float>::max()), zero);
+}
+
+TEST(MULTIPLICATION, EXCEPTION) {
+    ventilation::Pressure pressure;
+    EXPECT_ANY_THROW(ventilation::saturating::multiply(pressure, std::numeric_limits<float>::quiet_NaN()));
+    EXPECT_ANY_THROW(ventilation::saturating::multiply(std::numeric_limits<float>::infinity(), pressure));
+}
+
+RC_GTEST_PROP(
+      ADDITION
+    , OPERATOR
+    , (const ventilation::Pressure& xs, const ventilation::Pressure& ys)
+    )
+{
+    RC_ASSERT(ventilation::saturating::add(xs, ys) == (xs + ys));
+}
+
+RC_GTEST_PROP(
+      SUBTRACTION
+    , OPERATOR
+    , (const ventilation::Pressure& xs, const ventilation::Pressure& ys)
+    )
+{
+    RC_ASSERT(ventilation::saturating::subtract(xs, ys) == (xs - ys));
+    RC_ASSERT(ventilation::saturating::negate(xs) == -xs);
+}
+
+RC_GTEST_PROP(
+      MULTIPLICATION
+    , OPERATOR
+    , (const ventilation::Pressure& xs, std::int32_t factor)
+    )
+{
+    float scalar = static_cast<float>(factor) * 1e-3f;
+    RC_ASSERT(ventilation::saturating::multiply(xs, scalar) == (xs * scalar));
+    RC_ASSERT(ventilation::saturating::multiply(scalar, xs) == (scalar * xs));
+}
+
+RC_GTEST_PROP(
+      BATCH
+    , SCALAR
+    , (const std::vector<ventilation::Pressure>& xs, std::int32_t factor)
+    )
+{
+    const std::vector<ventilation::Pressure> ys = *rc::gen::container<std::vector<ventilation::Pressure>>(
+            xs.size()
+            , rc::gen::arbitrary<ventilation::Pressure>()
+            );
+    float scalar = static_cast<float>(factor) * 1e-3f;
+
+    std::vector<ventilation::Pressure> sums(xs.size());
+    std::vector<ventilation::Pressure> differences(xs.size());
+    std::vector<ventilation::Pressure> products(xs.size());
+    ventilation::batch::saturating::add<ventilation::Pressure>(xs, ys, sums);
+    ventilation::batch::saturating::subtract<ventilation::Pressure>(xs, ys, differences);
+    ventilation::batch::saturating::scale<ventilation::Pressure>(xs, scalar, products);
+    for (std::size_t i = 0; i < xs.size(); i++) {
+        RC_ASSERT(sums[i]           == ventilation::saturating::add(xs[i], ys[i]));
+        RC_ASSERT(differences[i]    == ventilation::saturating::subtract(xs[i], ys[i]));
+        RC_ASSERT(products[i]       == ventilation::saturating::multiply(xs[i], scalar));
+    }
+}
+
+TEST(BATCH, SATURATES) {
+    std::vector<ventilation::Pressure> xs = {ventilation::Pressure(1e9f), ventilation::Pressure(-1e9f)};
+    std::vector<ventilation::Pressure> products(xs.size());
+
+    ventilation::batch::saturating::scale<ventilation::Pressure>(xs, 1e9f, products);
+    EXPECT_EQ(products[0], ventilation::saturating::multiply(xs[0], 1e9f));
+    EXPECT_EQ(products[1], ventilation::saturating::multiply(xs[1], 1e9f));
+}
+
+TEST(BATCH, QUOTIENT) {
+    std::vector<ventilation::Flow> xs(100, ventilation::Flow(1.0f));
+    xs[70] = ventilation::Flow(10000.0f);
+    xs[71] = ventilation::Flow(-1e12f);
+    std::vector<ventilation::Flow> products(xs.size());
+
+    ventilation::batch::saturating::scale<ventilation::Flow>(xs, 1000.0f, products);
+    EXPECT_EQ(ventilation::fixed::Access::raw(products[70]), 10000000000000);
+    EXPECT_EQ(ventilation::fixed::Access::raw(products[71]), MINIMUM);
+    for (std::size_t i = 0; i < xs.size(); i++) {
+        EXPECT_EQ(products[i], ventilation::saturating::multiply(xs[i], 1000.0f));
+    }
+}
+
+TEST(BATCH, WIDE) {
+    const std::vector<ventilation::Pressure> xs = {
+          ventilation::fixed::Access::make<ventilation::Pressure>(1)
+        , ventilation::Pressure()
+        , ventilation::Pressure(-1.0f)
+    };
+    const float scalars[] = {1e13f, -1e20f, 1e30f, std::numeric_limits<float>::max()};
+    for (float scalar : scalars) {
+        std::vector<ventilation::Pressure> products(xs.size());
+        ventilation::batch::saturating::scale<ventilation::Pressure>(xs, scalar, products);
+        for (std::size_t i = 0; i < xs.size(); i++) {
+            EXPECT_EQ(products[i], ventilation::saturating::multiply(xs[i], scalar)) << scalar;
+        }
+    }
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
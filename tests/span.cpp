@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <vector>
+#include <ventilation/batch.hpp>
+#include <ventilation/expression.hpp>
+#include <ventilation/span.hpp>
+
+namespace {
+    // Interleaved frames of `channels` raw samples, in the native representation
+    std::vector<std::int64_t>
+    frames(std::size_t count, std::size_t channels) {
+        return *rc::gen::container<std::vector<std::int64_t>>(
+                count * channels
+                , rc::gen::map(rc::gen::inRange(-1000000, 1000000), [](std::int32_t v) {
+                    return static_cast<std::int64_t>(v) * 1000;
+                })
+                );
+    }
+
+    std::vector<ventilation::Flow>
+    channel(const std::vector<std::int64_t>& raw, std::size_t channels, std::size_t index) {
+        std::vector<ventilation::Flow> values;
+        for (std::size_t i = index; i < raw.size(); i += channels) {
+            values.push_back(ventilation::reinterpret<ventilation::Flow>(std::span<const std::int64_t>(&raw[i], 1))[0]);
+        }
+        return values;
+    }
+
+    template <typename Source, typename P>
+    concept Viewable = requires { typename ventilation::QuantitySpan<ventilation::Pressure, Source, P>; };
+} // namespace
+
+TEST(REINTERPRET, ZEROCOPY) {
+    std::vector<std::int64_t> raw = {1000000, -2500000};
+    std::span<const ventilation::Pressure> pressures = ventilation::reinterpret<ventilation::Pressure>(
+            std::span<const std::int64_t>(raw)
+            );
+
+    EXPECT_EQ(static_cast<const void*>(pressures.data()), static_cast<const void*>(raw.data()));
+    EXPECT_EQ(pressures[0], ventilation::Pressure(1.0f));
+    EXPECT_EQ(pressures[1], ventilation::Pressure(-2.5f));
+}
+
+TEST(VIEW, CONTIGUOUS) {
+    std::vector<std::int64_t> raw = {1000000, 2000000};
+    ventilation::QuantitySpan<ventilation::Flow> view(raw.data(), raw.size());
+
+    EXPECT_TRUE(view.contiguous());
+    EXPECT_EQ(static_cast<const void*>(view.span().data()), static_cast<const void*>(raw.data()));
+    EXPECT_FALSE(ventilation::QuantitySpan<ventilation::Flow>(raw.data(), 1, 2).contiguous());
+}
+
+TEST(VIEW, NARROW) {
+    std::vector<std::int32_t> raw = {1500, -250};
+    ventilation::QuantitySpan<ventilation::Volume, std::int32_t, ventilation::fixed::Narrow> view(raw.data(), raw.size());
+
+    EXPECT_EQ(view[0], ventilation::Volume(1.5f));
+    EXPECT_EQ(view[1], ventilation::Volume(-0.25f));
+    EXPECT_THROW(view.span(), std::logic_error);
+}
+
+TEST(VIEW, WIDTH) {
+    // Integer sources wider than the policy's representation would be
+    // truncated on decoding, so they are rejected
+    static_assert(Viewable<std::int16_t, ventilation::fixed::Narrow>);
+    static_assert(Viewable<std::int32_t, ventilation::fixed::Narrow>);
+    static_assert(not Viewable<std::int64_t, ventilation::fixed::Narrow>);
+    static_assert(Viewable<std::int32_t, ventilation::fixed::Default>);
+    static_assert(Viewable<std::int64_t, ventilation::fixed::Default>);
+    static_assert(Viewable<float, ventilation::fixed::Narrow>);
+    SUCCEED();
+}
+
+TEST(VIEW, FLOAT) {
+    std::vector<float> raw = {0.5f, 1.0f, std::numeric_limits<float>::quiet_NaN(), 2.0f};
+    ventilation::QuantitySpan<ventilation::Flow, float> view(raw.data(), raw.size());
+
+    EXPECT_EQ(view[1], ventilation::Flow(1.0f));
+    EXPECT_THROW(view[2], std::domain_error);
+}
+
+TEST(VIEW, INTERLEAVED) {
+    std::vector<std::int64_t> raw = {1, 2, 3, 4, 5, 6};
+    auto view = ventilation::QuantitySpan<ventilation::Flow>::interleaved(raw.data(), 2, 3, 1);
+
+    EXPECT_EQ(view.size(), 2);
+    EXPECT_EQ(view.raw(0), 2);
+    EXPECT_EQ(view.raw(1), 5);
+    EXPECT_THROW(ventilation::QuantitySpan<ventilation::Flow>::interleaved(raw.data(), 2, 3, 3), std::out_of_range);
+}
+
+RC_GTEST_PROP(
+      BATCH
+    , INTERLEAVED
+    , (std::uint8_t frames_)
+    )
+{
+    const std::size_t count = 1 + frames_ * 4;
+    const std::vector<std::int64_t> raw = frames(count, 3);
+    const auto flow = ventilation::QuantitySpan<ventilation::Flow>::interleaved(raw.data(), count, 3, 0);
+    const auto other = ventilation::QuantitySpan<ventilation::Flow>::interleaved(raw.data(), count, 3, 2);
+    const std::vector<ventilation::Flow> xs = channel(raw, 3, 0);
+    const std::vector<ventilation::Flow> ys = channel(raw, 3, 2);
+
+    RC_ASSERT(ventilation::batch::sum(flow) == ventilation::batch::sum<ventilation::Flow>(xs));
+
+    std::vector<float> expected(count);
+    std::vector<float> actual(count);
+    ventilation::batch::convert<ventilation::Flow>(xs, expected);
+    ventilation::batch::convert(flow, actual);
+    RC_ASSERT(actual == expected);
+
+    std::vector<ventilation::Flow> scaled(count);
+    ventilation::batch::scale(flow, 0.5f, scaled);
+    for (std::size_t i = 0; i < count; i++) {
+        RC_ASSERT(scaled[i] == xs[i] * 0.5f);
+    }
+
+    std::vector<std::int8_t> ordering(count);
+    ventilation::batch::compare(flow, other, ordering);
+    for (std::size_t i = 0; i < count; i++) {
+        RC_ASSERT((ordering[i] < 0) == (xs[i] < ys[i]));
+    }
+
+    std::vector<ventilation::Flow> sums(count);
+    ventilation::batch::saturating::add(flow, other, sums);
+    for (std::size_t i = 0; i < count; i++) {
+        RC_ASSERT(sums[i] == xs[i] + ys[i]);
+    }
+}
+
+TEST(BATCH, MOTION) {
+    std::vector<std::int64_t> raw = {500000, 200000, -250000, 400000};
+    auto flow   = ventilation::QuantitySpan<ventilation::Flow>::interleaved(raw.data(), 2, 2, 0);
+    auto volume = ventilation::QuantitySpan<ventilation::Volume>::interleaved(raw.data(), 2, 2, 1);
+
+    std::vector<ventilation::Pressure> output(2);
+    ventilation::batch::motion(
+              flow
+            , volume
+            , ventilation::Resistance(10.0f)
+            , ventilation::Elastance(20.0f)
+            , ventilation::Pressure(5.0f)
+            , output
+            );
+    EXPECT_EQ(output[0], ventilation::Pressure(14.0f));
+    EXPECT_EQ(output[1], ventilation::Pressure(10.5f));
+}
+
+TEST(BATCH, CONSTRUCT) {
+    std::vector<float> raw = {0.5f, 9.0f, 1.5f, 9.0f};
+    ventilation::QuantitySpan<ventilation::Flow, float> contiguous(raw.data(), raw.size());
+    ventilation::QuantitySpan<ventilation::Flow, float> strided(raw.data(), 2, 2);
+
+    std::vector<ventilation::Flow> all(4);
+    std::vector<ventilation::Flow> even(2);
+    ventilation::batch::construct(contiguous, all);
+    ventilation::batch::construct(strided, even);
+    EXPECT_EQ(all[1], ventilation::Flow(9.0f));
+    EXPECT_EQ(even[1], ventilation::Flow(1.5f));
+}
+
+TEST(EXPRESSION, VIEW) {
+    std::vector<std::int32_t> raw = {1000, 2000, 3000};
+    ventilation::QuantitySpan<ventilation::Pressure, std::int32_t, ventilation::fixed::Narrow> view(raw.data(), raw.size());
+
+    std::vector<ventilation::Pressure> output(3);
+    ventilation::assign(output, ventilation::lazy(view) * 2.0f - ventilation::Pressure(1.0f));
+    EXPECT_EQ(output[0], ventilation::Pressure(1.0f));
+    EXPECT_EQ(output[2], ventilation::Pressure(5.0f));
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
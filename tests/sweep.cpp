@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include <ventilation/sweep.hpp>
+
+namespace {
+    ventilation::sweep::Grid
+    grid() {
+        ventilation::sweep::Grid g;
+        for (float r : {5.0f, 10.0f, 20.0f})                { g.resistance.push_back(ventilation::Resistance(r)); }
+        for (float c : {0.02f, 0.05f})                      { g.compliance.push_back(ventilation::Compliance(c)); }
+        for (float p : {5.0f, 10.0f})                       { g.peep.push_back(ventilation::Pressure(p)); }
+        // Out of order on purpose, pruning must still follow volume
+        for (float v : {0.6f, 0.3f, 0.8f, 0.4f})            { g.tidal.push_back(ventilation::Volume(v)); }
+        return g;
+    }
+
+    ventilation::model::Settings
+    settings() {
+        ventilation::model::Settings s;
+        s.period = 0.02f;
+        return s;
+    }
+} // namespace
+
+TEST(GRID, ORDER) {
+    const ventilation::sweep::Grid g = grid();
+    EXPECT_EQ(g.size(), 48);
+    EXPECT_EQ(g[0], (ventilation::model::Parameters{g.resistance[0], g.compliance[0], g.peep[0], g.tidal[0]}));
+    EXPECT_EQ(g[1], (ventilation::model::Parameters{g.resistance[0], g.compliance[0], g.peep[0], g.tidal[1]}));
+    EXPECT_EQ(g[4], (ventilation::model::Parameters{g.resistance[0], g.compliance[0], g.peep[1], g.tidal[0]}));
+    EXPECT_EQ(g[47], (ventilation::model::Parameters{g.resistance[2], g.compliance[1], g.peep[1], g.tidal[3]}));
+    EXPECT_THROW(g[48], std::out_of_range);
+}
+
+TEST(SWEEP, RESULTS) {
+    const ventilation::sweep::Grid g = grid();
+    const ventilation::Pressure limit(35.0f);
+    ventilation::sweep::Cache cache(settings());
+    ventilation::parallel::Pool pool(3);
+
+    std::vector<ventilation::sweep::Result> results = ventilation::sweep::run(g, limit, cache, pool);
+    ASSERT_EQ(results.size(), g.size());
+
+    std::size_t computed = 0;
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const ventilation::sweep::Result& result = results[i];
+        EXPECT_EQ(result.parameters, g[i]);
+
+        bool over = ventilation::model::peak(result.parameters, cache.settings()) > limit;
+        if (result.status == ventilation::sweep::Status::pruned) {
+            // Pruned only at or beyond the first violation of its line
+            bool line = false;
+            for (std::size_t j = i - i % 4; j < i - i % 4 + 4; j++) {
+                line = line or (
+                        g[j].tidal <= result.parameters.tidal
+                        and ventilation::model::peak(g[j], cache.settings()) > limit
+                        );
+            }
+            EXPECT_TRUE(line) << i;
+        } else {
+            EXPECT_FALSE(over) << i;
+            EXPECT_EQ(result.status, ventilation::sweep::Status::computed);
+            ventilation::mechanics::Breath expected = ventilation::model::breath(result.parameters, cache.settings());
+            EXPECT_EQ(result.breath.work, expected.work);
+            EXPECT_EQ(result.breath.peak, expected.peak);
+            computed++;
+        }
+    }
+    EXPECT_GT(computed, 0);
+    EXPECT_LT(computed, results.size());
+    EXPECT_EQ(cache.size(), computed);
+}
+
+TEST(SWEEP, REUSE) {
+    ventilation::sweep::Grid g = grid();
+    const ventilation::Pressure limit(35.0f);
+    ventilation::sweep::Cache cache(settings());
+
+    std::vector<ventilation::sweep::Result> first = ventilation::sweep::run(g, limit, cache);
+
+    // One more resistance: only its lines are simulated again
+    g.resistance.push_back(ventilation::Resistance(7.0f));
+    std::vector<ventilation::sweep::Result> second = ventilation::sweep::run(g, limit, cache);
+    for (std::size_t i = 0; i < second.size(); i++) {
+        if (i < first.size()) {
+            EXPECT_EQ(second[i].parameters, first[i].parameters);
+            EXPECT_NE(second[i].status, ventilation::sweep::Status::computed) << i;
+            if (first[i].status != ventilation::sweep::Status::pruned) {
+                EXPECT_EQ(second[i].status, ventilation::sweep::Status::cached);
+                EXPECT_EQ(std::memcmp(&second[i].breath, &first[i].breath, sizeof(first[i].breath)), 0);
+            }
+        } else {
+            EXPECT_NE(second[i].status, ventilation::sweep::Status::cached) << i;
+        }
+    }
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(SWEEP, THREADS) {
+    // Results do not depend on how lines were scheduled. Points are distinct,
+    // since which of two equal points is computed and which cached does.
+    ventilation::sweep::Grid g = grid();
+    for (int i = 0; i < 20; i++) {
+        g.resistance.push_back(ventilation::Resistance(0.5f + static_cast<float>(i)));
+    }
+    ventilation::sweep::Cache sequential(settings());
+    ventilation::parallel::Pool single(1);
+    std::vector<ventilation::sweep::Result> expected = ventilation::sweep::run(g, ventilation::Pressure(30.0f), sequential, single);
+
+    for (std::size_t threads : {2, 4, 7}) {
+        ventilation::sweep::Cache cache(settings());
+        ventilation::parallel::Pool pool(threads);
+        std::vector<ventilation::sweep::Result> actual = ventilation::sweep::run(g, ventilation::Pressure(30.0f), cache, pool);
+        ASSERT_EQ(actual.size(), expected.size());
+        for (std::size_t i = 0; i < actual.size(); i++) {
+            EXPECT_EQ(actual[i].status, expected[i].status);
+            EXPECT_EQ(std::memcmp(&actual[i].breath, &expected[i].breath, sizeof(expected[i].breath)), 0);
+        }
+    }
+}
+
+TEST(SWEEP, EMPTY) {
+    ventilation::sweep::Grid g = grid();
+    g.peep.clear();
+    ventilation::sweep::Cache cache(settings());
+    EXPECT_TRUE(ventilation::sweep::run(g, ventilation::Pressure(35.0f), cache).empty());
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
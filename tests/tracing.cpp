@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <ventilation/mechanics.hpp>
+#include <ventilation/pipeline.hpp>
+#include <ventilation/tracing.hpp>
+
+namespace {
+    // Spans left over from earlier tests
+    void
+    drain() {
+        ventilation::tracing::Trace trace;
+        trace.collect();
+    }
+
+    void
+    nested() {
+        VENTILATION_TRACE("outer");
+        {
+            VENTILATION_TRACE("inner");
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+} // namespace
+
+TEST(TRACE, NESTED) {
+    drain();
+    nested();
+    nested();
+
+    ventilation::tracing::Trace trace;
+    trace.collect();
+    if (not ventilation::tracing::ENABLED) {
+        EXPECT_TRUE(trace.events().empty());
+        EXPECT_EQ(trace.latency("outer"), nullptr);
+        return;
+    }
+    ASSERT_EQ(trace.events().size(), 4u);
+    // Inner spans end first, and lie within their outer span
+    const ventilation::tracing::Event& inner = trace.events()[0];
+    const ventilation::tracing::Event& outer = trace.events()[1];
+    EXPECT_STREQ(inner.name, "inner");
+    EXPECT_STREQ(outer.name, "outer");
+    EXPECT_LE(outer.begin, inner.begin);
+    EXPECT_GE(outer.begin + outer.duration, inner.begin + inner.duration);
+    EXPECT_GE(inner.duration, 200000u);
+    EXPECT_EQ(inner.thread, outer.thread);
+
+    ASSERT_EQ(trace.summaries().size(), 2u);
+    EXPECT_EQ(trace.summaries()[0].name, "inner");
+    ASSERT_NE(trace.latency("outer"), nullptr);
+    EXPECT_EQ(trace.latency("outer")->count(), 2u);
+    EXPECT_GE(trace.latency("outer")->minimum(), 200000u);
+
+    // Summaries keep accumulating once the events are cleared
+    trace.clear();
+    nested();
+    trace.collect();
+    EXPECT_EQ(trace.events().size(), 2u);
+    EXPECT_EQ(trace.latency("inner")->count(), 3u);
+}
+
+TEST(TRACE, THREADS) {
+    drain();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 1000; i++) {
+                VENTILATION_TRACE("worker");
+            }
+        });
+    }
+    // Collecting while threads record only ever moves whole spans
+    ventilation::tracing::Trace trace;
+    trace.collect();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    trace.collect();
+
+    const std::uint64_t expected = ventilation::tracing::ENABLED ? 4000 : 0;
+    EXPECT_EQ(trace.events().size(), expected);
+    EXPECT_EQ(trace.dropped(), 0u);
+    std::set<std::uint32_t> ids;
+    for (const ventilation::tracing::Event& event : trace.events()) {
+        EXPECT_STREQ(event.name, "worker");
+        ids.insert(event.thread);
+    }
+    EXPECT_EQ(ids.size(), ventilation::tracing::ENABLED ? 4u : 0u);
+
+    // Nothing of exited threads is left to collect
+    ventilation::tracing::Trace again;
+    again.collect();
+    EXPECT_TRUE(again.events().empty());
+}
+
+TEST(TRACE, OVERWRITE) {
+    drain();
+    for (std::size_t i = 0; i < ventilation::tracing::CAPACITY + 10; i++) {
+        VENTILATION_TRACE("span");
+    }
+    ventilation::tracing::Trace trace;
+    trace.collect();
+    EXPECT_EQ(trace.events().size(), ventilation::tracing::ENABLED ? ventilation::tracing::CAPACITY : 0u);
+    EXPECT_EQ(trace.dropped(), ventilation::tracing::ENABLED ? 10u : 0u);
+}
+
+TEST(TRACE, EXITED) {
+    // Spans of exited threads outlive their rings, up to CAPACITY of them
+    drain();
+    const std::size_t spans = ventilation::tracing::CAPACITY * 3 / 4;
+    for (int t = 0; t < 2; t++) {
+        std::thread([spans]() {
+            ventilation::tracing::prepare();
+            for (std::size_t i = 0; i < spans; i++) {
+                VENTILATION_TRACE("exited");
+            }
+        }).join();
+    }
+    ventilation::tracing::Trace trace;
+    trace.collect();
+
+    const std::size_t kept = ventilation::tracing::ENABLED ? ventilation::tracing::CAPACITY : 0;
+    EXPECT_EQ(trace.events().size(), kept);
+    EXPECT_EQ(trace.dropped(), ventilation::tracing::ENABLED ? 2 * spans - kept : 0u);
+    if (ventilation::tracing::ENABLED) {
+        // The oldest spans made room for the newest
+        EXPECT_EQ(trace.events().front().thread + 1, trace.events().back().thread);
+        EXPECT_LE(trace.events().front().begin, trace.events().back().begin);
+    }
+}
+
+TEST(TRACE, LIBRARY) {
+    drain();
+    const std::vector<ventilation::Pressure> pressure = {
+        ventilation::Pressure(5.0f), ventilation::Pressure(20.0f), ventilation::Pressure(5.0f)
+    };
+    const std::vector<ventilation::Flow> flow = {
+        ventilation::Flow(0.5f), ventilation::Flow(0.0f), ventilation::Flow(-0.5f)
+    };
+    const std::vector<ventilation::Volume> volume = {
+        ventilation::Volume(0.0f), ventilation::Volume(0.5f), ventilation::Volume(0.0f)
+    };
+    ventilation::mechanics::analyze(pressure, flow, volume, 1.0f);
+
+    ventilation::tracing::Trace trace;
+    trace.collect();
+    const ventilation::instrumentation::Latency* latency = trace.latency("mechanics::breath");
+    EXPECT_EQ(latency != nullptr, ventilation::tracing::ENABLED);
+}
+
+TEST(TRACE, PIPELINE) {
+    drain();
+    using ventilation::Flow;
+    using ventilation::pipeline::Batch;
+    using ventilation::pipeline::Stream;
+    using ventilation::pipeline::Task;
+
+    const std::vector<Flow> samples = {Flow(0.5f), Flow(-0.5f), Flow(0.5f), Flow(-0.5f), Flow(0.5f)};
+    std::size_t volumes = 0;
+    std::size_t breaths = 0;
+    {
+        ventilation::pipeline::Executor executor(2);
+        auto replay = [](const std::vector<Flow>& samples) -> Stream<Batch<Flow>> {
+            co_yield Batch<Flow>(samples);
+            co_yield Batch<Flow>(samples);
+        };
+        auto count = []<typename T>(Stream<Batch<T>> stream, std::size_t& batches) -> Task {
+            while (co_await stream.next()) { batches++; }
+        };
+        auto doubled = [](Batch<Flow> input, std::span<Flow> output) {
+            for (std::size_t i = 0; i < input.size(); i++) { output[i] = input[i] * 2.0f; }
+        };
+        executor.spawn(count(ventilation::pipeline::integrate(
+                        ventilation::pipeline::transform<Flow>(replay(samples), doubled), 0.1f
+                        ), volumes));
+        executor.spawn(count(ventilation::pipeline::segment(replay(samples)), breaths));
+        executor.wait();
+    }
+    EXPECT_EQ(volumes, 2);
+    EXPECT_EQ(breaths, 3);
+
+    // One span per batch in each stage, collected from the executor threads
+    ventilation::tracing::Trace trace;
+    trace.collect();
+    for (const char* name : {"pipeline::transform", "pipeline::integrate", "pipeline::segment"}) {
+        const ventilation::instrumentation::Latency* latency = trace.latency(name);
+        EXPECT_EQ(latency != nullptr, ventilation::tracing::ENABLED) << name;
+    }
+}
+
+TEST(EXPORT, CHROME) {
+    drain();
+    {
+        VENTILATION_TRACE("quoted \"stage\"\n");
+    }
+    ventilation::tracing::Trace trace;
+    trace.collect();
+
+    std::ostringstream os;
+    ventilation::tracing::chrome(os, trace);
+    const std::string json = os.str();
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("],\"displayTimeUnit\":\"ns\"}"), std::string::npos);
+    if (ventilation::tracing::ENABLED) {
+        EXPECT_NE(json.find("{\"name\":\"quoted \\\"stage\\\"\\u000a\",\"cat\":\"ventilation\",\"ph\":\"X\",\"ts\":"), std::string::npos);
+        const ventilation::tracing::Event& event = trace.events().front();
+        std::ostringstream ts;
+        ts << "\"ts\":" << event.begin / 1000 << "." << (event.begin % 1000) / 100;
+        EXPECT_NE(json.find(ts.str()), std::string::npos);
+    }
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <vector>
+#include <ventilation/trend.hpp>
+
+namespace {
+    using ventilation::trend::Column;
+    using ventilation::trend::Predicate;
+    using ventilation::trend::Record;
+
+    // Breaths up to 6 seconds apart from `start`, a few sharing a start
+    // time; drawn inside a property
+    std::vector<Record>
+    records(std::size_t size, std::int64_t start) {
+        std::vector<Record> records;
+        std::int64_t time = start;
+        for (std::size_t i = 0; i < size; i++) {
+            time += *rc::gen::inRange<std::int64_t>(0, 6000);
+            records.push_back(Record{
+                  time
+                , ventilation::Volume(static_cast<float>(*rc::gen::inRange(200, 800)) * 0.001f)
+                , ventilation::Pressure(static_cast<float>(*rc::gen::inRange(1000, 4000)) * 0.01f)
+                , ventilation::Pressure(static_cast<float>(*rc::gen::inRange(1000, 3500)) * 0.01f)
+                , ventilation::Resistance(static_cast<float>(*rc::gen::inRange(50, 300)) * 0.1f)
+                , ventilation::Compliance(static_cast<float>(*rc::gen::inRange(100, 800)) * 0.0001f)
+            });
+        }
+        return records;
+    }
+
+    ventilation::trend::Store
+    store(const std::vector<Record>& records) {
+        ventilation::trend::Store store;
+        for (const Record& record : records) {
+            store.append(record);
+        }
+        return store;
+    }
+
+    Record
+    breath(std::int64_t time, float plateau) {
+        return Record{
+              time
+            , ventilation::Volume(0.5f)
+            , ventilation::Pressure(plateau + 5.0f)
+            , ventilation::Pressure(plateau)
+            , ventilation::Resistance(10.0f)
+            , ventilation::Compliance(0.05f)
+        };
+    }
+} // namespace
+
+RC_GTEST_PROP(
+      STORE
+    , ROWS
+    , ()
+    )
+{
+    const std::vector<Record> input = records(*rc::gen::inRange<std::size_t>(0, 5000), -1000000);
+    const ventilation::trend::Store trends = store(input);
+    RC_ASSERT(trends.size() == input.size());
+
+    const std::int64_t from = *rc::gen::inRange<std::int64_t>(-1100000, 20000000);
+    const std::int64_t to   = *rc::gen::inRange<std::int64_t>(-1100000, 20000000);
+    const ventilation::trend::Rows rows = trends.rows(from, to);
+
+    std::size_t begin = 0;
+    while (begin < input.size() and input[begin].time < from) { begin++; }
+    std::size_t end = begin;
+    while (end < input.size() and input[end].time < to) { end++; }
+    RC_ASSERT(rows.begin == begin);
+    RC_ASSERT(rows.end == end);
+}
+
+RC_GTEST_PROP(
+      STORE
+    , SELECT
+    , ()
+    )
+{
+    const std::vector<Record> input = records(*rc::gen::inRange<std::size_t>(0, 5000), 0);
+    const ventilation::trend::Store trends = store(input);
+
+    const ventilation::Pressure plateau(static_cast<float>(*rc::gen::inRange(900, 3600)) * 0.01f);
+    const ventilation::Compliance low(static_cast<float>(*rc::gen::inRange(90, 500)) * 0.0001f);
+    const ventilation::Compliance high(static_cast<float>(*rc::gen::inRange(400, 900)) * 0.0001f);
+    const Predicate predicates[] = {
+          Predicate::above(Column::plateau, plateau)
+        , Predicate::within(Column::compliance, low, high)
+    };
+
+    const std::size_t begin = *rc::gen::inRange<std::size_t>(0, input.size() + 1);
+    const std::size_t end   = *rc::gen::inRange<std::size_t>(begin, input.size() + 1);
+    std::vector<std::size_t> actual;
+    trends.select(predicates, ventilation::trend::Rows{begin, end}, actual);
+
+    std::vector<std::size_t> expected;
+    for (std::size_t row = begin; row < end; row++) {
+        if (input[row].plateau > plateau and input[row].compliance > low and input[row].compliance < high) {
+            expected.push_back(row);
+        }
+    }
+    RC_ASSERT(actual == expected);
+}
+
+RC_GTEST_PROP(
+      STORE
+    , ROLLUP
+    , ()
+    )
+{
+    const std::vector<Record> input = records(*rc::gen::inRange<std::size_t>(1, 3000), -10000000);
+    const ventilation::trend::Store trends = store(input);
+
+    for (const auto& [rollups, period] : {
+              std::pair{trends.hourly(), ventilation::trend::HOUR}
+            , std::pair{trends.daily(), ventilation::trend::DAY}
+            })
+    {
+        std::uint64_t total = 0;
+        for (const ventilation::trend::Rollup& rollup : rollups) {
+            RC_ASSERT(rollup.start % period == 0);
+            std::vector<Record> inside;
+            for (const Record& record : input) {
+                if (record.time >= rollup.start and record.time < rollup.start + period) {
+                    inside.push_back(record);
+                }
+            }
+            RC_ASSERT(rollup.count == inside.size());
+            total += rollup.count;
+
+            __int128 sum = 0;
+            ventilation::Pressure peak = inside.front().peak;
+            ventilation::Volume tidal = inside.front().tidal;
+            for (const Record& record : inside) {
+                sum     += ventilation::fixed::Access::raw(record.plateau);
+                peak    = std::max(peak, record.peak);
+                tidal   = std::min(tidal, record.tidal);
+            }
+            RC_ASSERT(rollup.plateau.sum == sum);
+            RC_ASSERT(rollup.peak.maximum == peak);
+            RC_ASSERT(rollup.tidal.minimum == tidal);
+        }
+        RC_ASSERT(total == input.size());
+    }
+}
+
+TEST(STORE, SKIPPING) {
+    // Plateau above 30 cmH2O only during one hour of a day of breaths
+    ventilation::trend::Store trends;
+    for (std::int64_t time = 0; time < ventilation::trend::DAY; time += 4000) {
+        const bool high = time >= 5 * ventilation::trend::HOUR and time < 6 * ventilation::trend::HOUR;
+        trends.append(breath(time, high ? 32.0f : 20.0f));
+    }
+    const Predicate predicates[] = {Predicate::above(Column::plateau, ventilation::Pressure(30.0f))};
+
+    std::vector<std::size_t> rows;
+    const std::size_t skipped = trends.select(predicates, trends.rows(0, ventilation::trend::DAY), rows);
+    EXPECT_EQ(rows.size(), 900u);
+    EXPECT_EQ(trends.time()[rows.front()], 5 * ventilation::trend::HOUR);
+    EXPECT_EQ(trends.time()[rows.back()], 6 * ventilation::trend::HOUR - 4000);
+    // 21600 breaths in 22 blocks, of which only the two covering that hour are read
+    EXPECT_EQ(skipped, 20u);
+
+    ASSERT_EQ(trends.hourly().size(), 24u);
+    ASSERT_EQ(trends.daily().size(), 1u);
+    EXPECT_EQ(trends.hourly()[5].plateau.mean(trends.hourly()[5].count), ventilation::Pressure(32.0f));
+    EXPECT_EQ(trends.hourly(2 * ventilation::trend::HOUR, 4 * ventilation::trend::HOUR).size(), 2u);
+    EXPECT_EQ(trends.daily(1, ventilation::trend::DAY).size(), 0u);
+}
+
+TEST(STORE, INVALID) {
+    ventilation::trend::Store trends;
+    trends.append(breath(1000, 20.0f));
+    EXPECT_THROW(trends.append(breath(999, 20.0f)), std::invalid_argument);
+    EXPECT_NO_THROW(trends.append(breath(1000, 20.0f)));
+    EXPECT_EQ(trends.size(), 2u);
+    EXPECT_EQ(trends[1].plateau, ventilation::Pressure(20.0f));
+    EXPECT_THROW(trends[2], std::out_of_range);
+
+    std::vector<std::size_t> rows;
+    EXPECT_THROW(trends.select({}, ventilation::trend::Rows{0, 3}, rows), std::out_of_range);
+    EXPECT_THROW(Predicate::above(Column::plateau, ventilation::Volume(0.5f)), std::invalid_argument);
+    EXPECT_THROW(Predicate::below(Column::compliance, ventilation::Elastance(20.0f)), std::invalid_argument);
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
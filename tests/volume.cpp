@@ -166,6 +166,15 @@ TEST(MULTIPLICATION, EXCEPTION) {
             );
 }
 
+TEST(HASH, CONSISTENT) {
+    // Equal at comparison granularity, though stored differently
+    const ventilation::Volume xs(0.0001f);
+    const ventilation::Volume ys(0.0002f);
+    ASSERT_EQ(xs, ys);
+    EXPECT_EQ(std::hash<ventilation::Volume>()(xs), std::hash<ventilation::Volume>()(ys));
+    EXPECT_EQ(std::hash<ventilation::Volume>()(-xs), std::hash<ventilation::Volume>()(ventilation::Volume()));
+}
+
 int
 main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <rapidcheck.h>
+#include <rapidcheck/gtest.h>
+#include <ventilation/ventilation.hpp>
+
+namespace rc {
+    template <>
+    struct Arbitrary<ventilation::Work> {
+        static Gen<ventilation::Work>
+        arbitrary() {
+            const Gen<std::int32_t> value = gen::inRange(-1000, 1000);
+            return gen::construct<ventilation::Work>(
+                    gen::map(value, [](std::int32_t v) { return static_cast<float>(v) * 1e-3f; })
+            );
+        }
+    };
+} // namespace rc
+
+TEST(CONSTRUCTOR, ZERO) {
+    EXPECT_EQ(static_cast<float>(ventilation::Work()), 0.0f);
+}
+
+TEST(CONSTRUCTOR, EXCEPTION) {
+    EXPECT_ANY_THROW(
+            ventilation::Work(std::numeric_limits<float>::quiet_NaN())
+            );
+    EXPECT_ANY_THROW(
+            ventilation::Work(std::numeric_limits<float>::infinity())
+            );
+}
+
+TEST(COMPARISON, EQ) {
+    EXPECT_EQ(ventilation::Work(1.0f), ventilation::Work(1.0f));
+}
+
+TEST(COMPARISON, NE) {
+    EXPECT_NE(ventilation::Work(1.0f), ventilation::Work(2.0f));
+}
+
+TEST(COMPARISON, LT) {
+    EXPECT_LT(ventilation::Work(1.0f), ventilation::Work(2.0f));
+}
+
+TEST(COMPARISON, LE) {
+    EXPECT_LE(ventilation::Work(1.0f), ventilation::Work(1.0f));
+    EXPECT_LE(ventilation::Work(1.0f), ventilation::Work(2.0f));
+}
+
+TEST(COMPARISON, GT) {
+    EXPECT_GT(ventilation::Work(2.0f), ventilation::Work(1.0f));
+}
+
+TEST(COMPARISON, GE) {
+    EXPECT_GE(ventilation::Work(1.0f), ventilation::Work(1.0f));
+    EXPECT_GE(ventilation::Work(2.0f), ventilation::Work(1.0f));
+}
+
+RC_GTEST_PROP(
+      ADDITION
+    , IDENTITY
+    , (const ventilation::Work& xs)
+    )
+{
+    RC_ASSERT((xs + ventilation::Work()) == xs);
+}
+
+RC_GTEST_PROP(
+      ADDITION
+    , COMMUTATIVE
+    , (const ventilation::Work& xs, const ventilation::Work& ys)
+    )
+{
+    RC_ASSERT((xs + ys) == (ys + xs));
+}
+
+RC_GTEST_PROP(
+      ADDITION
+    , ASSOCIATIVE
+    , (const ventilation::Work& xs, const ventilation::Work& ys, const ventilation::Work& zs)
+    )
+{
+    RC_ASSERT((xs + ys) + zs == (xs + ys + zs));
+}
+
+RC_GTEST_PROP(
+      SUBTRACTION
+    , NEUTRAL
+    , (const ventilation::Work& xs)
+    )
+{
+    RC_ASSERT((xs - ventilation::Work()) == xs);
+}
+
+RC_GTEST_PROP(
+      SUBTRACTION
+    , NEGATE
+    , (const ventilation::Work& xs)
+    )
+{
+    RC_ASSERT((ventilation::Work() - xs) == -xs);
+}
+
+RC_GTEST_PROP(
+      SUBTRACTION
+    , ANTICOMMUTATIVE
+    , (const ventilation::Work& xs, const ventilation::Work& ys)
+    )
+{
+    RC_ASSERT((xs - ys) == -(ys - xs));
+}
+
+RC_GTEST_PROP(
+      MULTIPLICATION
+    , IDENTITY
+    , (const ventilation::Work& xs)
+    )
+{
+    RC_ASSERT((xs * 1.0f) == xs);
+    RC_ASSERT((1.0f * xs) == xs);
+}
+
+RC_GTEST_PROP(
+      MULTIPLICATION
+    , DEFINITION
+    , (const ventilation::Work& xs)
+    )
+{
+    RC_ASSERT((xs * 2.0f) == (xs + xs));
+    RC_ASSERT((2.0f * xs) == (xs + xs));
+}
+
+RC_GTEST_PROP(
+      MULTIPLICATION
+    , ZERO
+    , (const ventilation::Work& xs)
+    )
+{
+    RC_ASSERT((xs * 0.0f) == ventilation::Work());
+    RC_ASSERT((0.0f * xs) == ventilation::Work());
+}
+
+RC_GTEST_PROP(
+      MULTIPLICATION
+    , COMMUTATIVE
+    , (const ventilation::Work& xs, float scalar)
+    )
+{
+    RC_PRE(std::isfinite(scalar));
+    RC_ASSERT((xs * scalar) == (scalar * xs));
+}
+
+TEST(MULTIPLICATION, EXCEPTION) {
+    ventilation::Work work;
+    EXPECT_ANY_THROW(
+            work * std::numeric_limits<float>::quiet_NaN()
+            );
+    EXPECT_ANY_THROW(
+            std::numeric_limits<float>::quiet_NaN() * work
+            );
+    EXPECT_ANY_THROW(
+            work * std::numeric_limits<float>::infinity()
+            );
+    EXPECT_ANY_THROW(
+            std::numeric_limits<float>::infinity() * work
+            );
+}
+
+TEST(HASH, CONSISTENT) {
+    // Equal at comparison granularity, though stored differently
+    const ventilation::Work xs(0.0001f);
+    const ventilation::Work ys(0.0002f);
+    ASSERT_EQ(xs, ys);
+    EXPECT_EQ(std::hash<ventilation::Work>()(xs), std::hash<ventilation::Work>()(ys));
+    EXPECT_EQ(std::hash<ventilation::Work>()(-xs), std::hash<ventilation::Work>()(ventilation::Work()));
+}
+
+int
+main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}